@@ -82,6 +82,11 @@ function(ivw_private_generate_module_registration_file mod)
     else()
         set(module_protected "ProtectedModule::off")
     endif()
+    if(${${mod}_concurrent})
+        set(module_concurrent "ConcurrentModule::on")
+    else()
+        set(module_concurrent "ConcurrentModule::off")
+    endif()
 
     ivw_private_generate_license_header(MOD ${mod} RETVAL module_license_vector)
     set(fuction_args
@@ -94,7 +99,8 @@ function(ivw_private_generate_module_registration_file mod)
         "        ${module_alias_vector}, // List of aliases\n"
         "        // List of license information\n"
         "        ${module_license_vector},\n"
-        "        ${module_protected} // protected"
+        "        ${module_protected}, // protected\n"
+        "        ${module_concurrent} // concurrent"
     )
 
     ivw_join(";" "" fuction_args ${fuction_args})
@@ -168,14 +168,16 @@ function(ivw_private_setup_module_data)
     set("${mod}_sharedLibHpp" "${sharedLibHpp}"       CACHE INTERNAL "Shared lib Header")
 
     # Check of there is a depends.cmake
-    # Optionally defines: dependencies, aliases, protected, EnableByDefault
+    # Optionally defines: dependencies, aliases, protected, concurrent, EnableByDefault
     # Save dependencies to INVIWO<NAME>MODULE_dependencies
     # Save aliases to INVIWO<NAME>MODULE_aliases
     # Save protected to INVIWO<NAME>MODULE_protected
+    # Save concurrent to INVIWO<NAME>MODULE_concurrent
     # Save EnableByDefault to INVIWO<NAME>MODULE_EnableByDefault
     set(dependencies "")
     set(aliases "")
     set(protected OFF)
+    set(concurrent OFF)
     set(EnableByDefault OFF)
     if(EXISTS "${${mod}_path}/depends.cmake")
         include(${${mod}_path}/depends.cmake)
@@ -196,9 +198,11 @@ function(ivw_private_setup_module_data)
         set("${mod}_enableByDefault" ${EnableByDefault}                CACHE INTERNAL "Enable module by default")
     endif()
     set("${mod}_aliases" ${aliases} CACHE INTERNAL "Module aliases")
+    set("${mod}_concurrent" ${concurrent} CACHE INTERNAL "Construct the module on the thread pool")
     unset(dependencies)
     unset(aliases)
     unset(protected)
+    unset(concurrent)
 
     # Check if there is a readme.md of the module. 
     # In that case set to INVIWO<NAME>MODULE_description
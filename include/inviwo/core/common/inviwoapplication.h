@@ -60,6 +60,7 @@ namespace inviwo {
 
 class ProcessorNetwork;
 class ProcessorNetworkEvaluator;
+class ProcessorNetworkStatistics;
 class CommandLineParser;
 struct AppResourceManagerObserver;
 
@@ -164,6 +165,11 @@ public:
 
     ProcessorNetwork* getProcessorNetwork();
     ProcessorNetworkEvaluator* getProcessorNetworkEvaluator();
+    /**
+     * Per processor performance statistics, disabled by default. Enabled from start with the
+     * --statistics command line argument.
+     */
+    ProcessorNetworkStatistics* getProcessorNetworkStatistics();
     WorkspaceManager* getWorkspaceManager();
     PropertyPresetManager* getPropertyPresetManager();
     PortInspectorManager* getPortInspectorManager();
@@ -479,11 +485,13 @@ protected:
     ModuleManager moduleManager_;
     std::unique_ptr<ProcessorNetwork> processorNetwork_;
     std::unique_ptr<ProcessorNetworkEvaluator> processorNetworkEvaluator_;
+    std::unique_ptr<ProcessorNetworkStatistics> processorNetworkStatistics_;
     std::unique_ptr<WorkspaceManager> workspaceManager_;
     std::unique_ptr<PropertyPresetManager> propertyPresetManager_;
     std::unique_ptr<PortInspectorManager> portInspectorManager_;
     WorkspaceManager::ClearHandle networkClearHandle_;
     WorkspaceManager::SerializationHandle networkSerializationHandle_;
+    WorkspaceManager::SerializationHandle portInspectorsSerializationHandle_;
     WorkspaceManager::DeserializationHandle networkDeserializationHandle_;
 
     WorkspaceManager::ClearHandle presetsClearHandle_;
@@ -67,6 +67,7 @@
 
 #include <vector>
 #include <memory>
+#include <functional>
 
 namespace inviwo {
 
@@ -80,6 +81,7 @@ class MeshDrawer;
 class PropertyConverter;
 class VersionConverter;
 class DataVisualizer;
+class ModuleManager;
 
 enum class ModulePath {
     Data,               // /data
@@ -325,6 +327,30 @@ protected:
     InviwoApplication* app_;  // reference to the app that we belong to
 
 private:
+    friend ModuleManager;
+
+    /**
+     * Modules constructed on the current thread while deferring is enabled queue their
+     * registrations instead of touching the application factories, see ConcurrentModule.
+     */
+    static void setDeferRegistrations(bool defer);
+    /**
+     * Register everything queued during construction. Has to be called on the main thread.
+     */
+    void applyDeferredRegistrations();
+    /**
+     * Queue the registration if deferring is enabled for this module, returns true if the
+     * registration was queued.
+     */
+    bool deferRegistration(std::function<void()> registration);
+    template <typename T>
+    bool deferRegistration(void (InviwoModule::*reg)(std::unique_ptr<T>),
+                           std::unique_ptr<T>& object) {
+        if (!deferRegistrations_) return false;
+        auto obj = std::make_shared<std::unique_ptr<T>>(std::move(object));
+        return deferRegistration([this, reg, obj]() { (this->*reg)(std::move(*obj)); });
+    }
+
     template <typename T>
     std::vector<T*> uniqueToPtr(std::vector<std::unique_ptr<T>>& v) {
         std::vector<T*> res;
@@ -349,6 +375,8 @@ private:
     }
 
     const std::string identifier_;  ///< Module folder name
+    bool deferRegistrations_;
+    std::vector<std::function<void()>> deferredRegistrations_;
 
     std::vector<std::unique_ptr<CameraFactoryObject>> cameras_;
     std::vector<std::unique_ptr<Capabilities>> capabilities_;
@@ -443,7 +471,9 @@ void InviwoModule::registerPropertyWidget(std::string semantics) {
 template <typename BaseRepr>
 void InviwoModule::registerRepresentationConverter(
     std::unique_ptr<RepresentationConverter<BaseRepr>> converter) {
-
+    if (deferRegistration(&InviwoModule::registerRepresentationConverter<BaseRepr>, converter)) {
+        return;
+    }
     if (auto factory = app_->getRepresentationConverterFactory<BaseRepr>()) {
         if (factory->registerObject(converter.get())) {
             representationConvertersUnRegFunctors_.push_back(
@@ -456,6 +486,10 @@ void InviwoModule::registerRepresentationConverter(
 template <typename BaseRepr>
 void InviwoModule::registerRepresentationFactoryObject(
     std::unique_ptr<RepresentationFactoryObject<BaseRepr>> representation) {
+    if (deferRegistration(&InviwoModule::registerRepresentationFactoryObject<BaseRepr>,
+                          representation)) {
+        return;
+    }
     if (auto factory = app_->getRepresentationFactory<BaseRepr>()) {
         if (factory->registerObject(representation.get())) {
             representationUnRegFunctors_.push_back(
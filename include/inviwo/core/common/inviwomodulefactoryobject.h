@@ -45,6 +45,13 @@ class InviwoApplication;
 // A protected module does not participate in runtime reloading
 enum class ProtectedModule : bool { on, off };
 
+// A concurrent module is constructed on the thread pool as soon as its dependencies are
+// registered, see ModuleManager::registerModules. Its constructor may only use the register
+// functions of InviwoModule, which are applied on the main thread once the module is constructed,
+// and must not access other modules or the application. Modules are constructed on the main
+// thread by default.
+enum class ConcurrentModule : bool { on, off };
+
 class IVW_CORE_API InviwoModuleFactoryObject {
 public:
     InviwoModuleFactoryObject(const std::string& name, Version version,
@@ -52,7 +59,8 @@ public:
                               std::vector<std::string> dependencies,
                               std::vector<Version> dependenciesVersion,
                               std::vector<std::string> aliases, std::vector<LicenseInfo> licenses,
-                              ProtectedModule protectedModule);
+                              ProtectedModule protectedModule,
+                              ConcurrentModule concurrentModule = ConcurrentModule::off);
     virtual ~InviwoModuleFactoryObject() = default;
 
     virtual std::unique_ptr<InviwoModule> create(InviwoApplication* app) = 0;
@@ -70,6 +78,8 @@ public:
     const std::vector<LicenseInfo> licenses;
     // A protected module does not participate in runtime reloading
     const ProtectedModule protectedModule;
+    // A concurrent module is constructed on the thread pool
+    const ConcurrentModule concurrentModule;
 };
 
 template <typename T>
@@ -81,7 +91,8 @@ public:
                                       std::vector<Version> dependenciesVersion,
                                       std::vector<std::string> aliases,
                                       std::vector<LicenseInfo> licenses,
-                                      ProtectedModule protectedModule);
+                                      ProtectedModule protectedModule,
+                                      ConcurrentModule concurrentModule = ConcurrentModule::off);
 
     virtual std::unique_ptr<InviwoModule> create(InviwoApplication* app) override {
         return std::make_unique<T>(app);
@@ -103,9 +114,11 @@ InviwoModuleFactoryObjectTemplate<T>::InviwoModuleFactoryObjectTemplate(
     const std::string& name, Version version, const std::string& description,
     Version inviwoCoreVersion, std::vector<std::string> dependencies,
     std::vector<Version> dependenciesVersion, std::vector<std::string> aliases,
-    std::vector<LicenseInfo> licenses, ProtectedModule protectedModule)
+    std::vector<LicenseInfo> licenses, ProtectedModule protectedModule,
+    ConcurrentModule concurrentModule)
     : InviwoModuleFactoryObject(name, version, description, inviwoCoreVersion, dependencies,
-                                dependenciesVersion, aliases, licenses, protectedModule) {}
+                                dependenciesVersion, aliases, licenses, protectedModule,
+                                concurrentModule) {}
 
 /**
  * \brief Topological sort to make sure that we load modules in correct order
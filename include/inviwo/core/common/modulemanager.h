@@ -43,6 +43,8 @@
 #include <set>
 #include <vector>
 #include <memory>
+#include <chrono>
+#include <string>
 #include <warn/pop>
 
 namespace inviwo {
@@ -60,6 +62,16 @@ class IVW_CORE_API ModuleManager {
 public:
     using IdSet = std::set<std::string, CaseInsensitiveCompare>;
 
+    /**
+     * Time spent loading the shared library of a module, zero for statically linked modules,
+     * and time spent in the module constructor.
+     */
+    struct ModuleLoadTiming {
+        std::string name;
+        std::chrono::nanoseconds libraryLoad{0};
+        std::chrono::nanoseconds construction{0};
+    };
+
     ModuleManager(InviwoApplication* app);
     ModuleManager(const ModuleManager& rhs) = delete;
     ModuleManager& operator=(const ModuleManager& that) = delete;
@@ -74,6 +86,8 @@ public:
     /**
      * \brief Registers modules from factories and takes ownership of input module factories.
      * Module is registered if dependencies exist and they have correct version.
+     * Modules marked with ConcurrentModule::on are constructed on the thread pool as soon as their
+     * dependencies are registered, other modules are constructed on the main thread.
      */
     void registerModules(std::vector<std::unique_ptr<InviwoModuleFactoryObject>> moduleFactories);
     /**
@@ -134,11 +148,26 @@ public:
     static std::function<bool(const std::string&)> getEnabledFilter();
     void reloadModules();
 
+    /**
+     * \brief Library load and construction time of the registered modules, in registration order.
+     */
+    const std::vector<ModuleLoadTiming>& getModuleLoadTimings() const;
+    /**
+     * \brief Time spent searching for and copying module libraries in
+     * registerModules(RuntimeModuleLoading).
+     */
+    std::chrono::nanoseconds getLibrarySearchTime() const;
+    /**
+     * \brief A table of the module load timings, sorted by total time.
+     */
+    std::string getStartupReport() const;
+
 private:
     void registerModule(std::unique_ptr<InviwoModule> module);
     bool checkDependencies(const InviwoModuleFactoryObject& obj) const;
     std::vector<std::string> deregisterDependetModules(
         const std::vector<std::string>& toDeregister);
+    ModuleLoadTiming& getModuleLoadTiming(const std::string& name);
     static auto getProtectedDependencies(
         const IdSet& ptotectedIds,
         const std::vector<std::unique_ptr<InviwoModuleFactoryObject>>& modules) -> IdSet;
@@ -156,6 +185,8 @@ private:
     std::vector<std::unique_ptr<InviwoModuleFactoryObject>> factoryObjects_;
     std::vector<std::unique_ptr<InviwoModule>> modules_;
     util::OnScopeExit clearModules_;
+    std::vector<ModuleLoadTiming> timings_;
+    std::chrono::nanoseconds librarySearchTime_{0};
 };
 
 template <class T>
@@ -56,6 +56,10 @@ public:
      * Return size of buffer element in bytes.
      */
     virtual size_t getSizeOfElement() const;
+    /**
+     * Size of the data in bytes, i.e. the number of elements times the size of an element.
+     */
+    size_t getSizeInBytes() const;
     BufferUsage getBufferUsage() const;
     BufferTarget getBufferTarget() const;
 
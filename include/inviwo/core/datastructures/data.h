@@ -33,9 +33,18 @@
 #include <inviwo/core/datastructures/representationfactory.h>
 #include <inviwo/core/datastructures/representationconverterfactory.h>
 #include <inviwo/core/datastructures/representationfactorymanager.h>
-
+#include <inviwo/core/datastructures/representationmemorymanager.h>
+#include <inviwo/core/datastructures/diskrepresentation.h>
+#include <inviwo/core/util/introspection.h>
+#include <inviwo/core/util/raiiutils.h>
+#include <inviwo/core/util/stringconversion.h>
+#include <inviwo/core/util/tracing.h>
+
+#include <chrono>
+#include <algorithm>
 #include <typeindex>
 #include <mutex>
+#include <shared_mutex>
 #include <unordered_map>
 #include <memory>
 
@@ -94,7 +103,7 @@ public:
     using repr = Repr;
 
     virtual Data<Self, Repr>* clone() const = 0;
-    virtual ~Data() = default;
+    virtual ~Data();
 
     /**
      * Get a representation of type T. If there already is a valid representation of type T, just
@@ -102,6 +111,8 @@ public:
      * valid. It there is no representation of type T, create it from the last valid representation.
      * If there are no representations create a default representation and from that create a
      * representation of type T.
+     * Getting an already valid representation only takes a shared lock, hence concurrent readers
+     * do not block each other.
      */
     template <typename T>
     const T* getRepresentation() const;
@@ -125,6 +136,14 @@ public:
     template <typename T>
     bool hasRepresentation() const;
 
+    /**
+     * Check if a valid representation of type T exists, i.e. if getRepresentation<T>() can return
+     * it without updating it.
+     * @return true if existing and valid, false otherwise.
+     */
+    template <typename T>
+    bool hasValidRepresentation() const;
+
     /**
      * Check if the Data object has any representation.
      * @return true if any representation exist, false otherwise.
@@ -176,12 +195,31 @@ protected:
 
     std::shared_ptr<Repr> addRepresentationInternal(std::shared_ptr<Repr> representation) const;
 
-    mutable std::mutex mutex_;
+    /**
+     * Called by the RepresentationMemoryManager to remove a representation that can be recreated.
+     * @return true if the representation was removed
+     */
+    bool evictRepresentation(const void* repr) const;
+
+    mutable std::shared_mutex mutex_;
     mutable std::unordered_map<std::type_index, std::shared_ptr<Repr>> representations_;
     // A pointer to the the most recently updated representation. Makes updates and creation faster.
     mutable std::shared_ptr<Repr> lastValidRepresentation_;
+
+    // Memory accounting of the representations, @see RepresentationMemoryManager
+    mutable std::unordered_map<std::type_index,
+                               std::shared_ptr<RepresentationMemoryManager::Record>>
+        records_;
+    std::shared_ptr<RepresentationMemoryManager::Owner> memoryOwner_ =
+        std::make_shared<RepresentationMemoryManager::Owner>(
+            [this](const void* repr) { return evictRepresentation(repr); });
 };
 
+template <typename Self, typename Repr>
+Data<Self, Repr>::~Data() {
+    memoryOwner_->release();
+}
+
 template <typename Self, typename Repr>
 Data<Self, Repr>::Data(const Data<Self, Repr>& rhs) : lastValidRepresentation_{nullptr} {
     rhs.copyRepresentationsTo(this);
@@ -198,7 +236,19 @@ Data<Self, Repr>& Data<Self, Repr>::operator=(const Data<Self, Repr>& that) {
 template <typename Self, typename Repr>
 template <typename T>
 const T* Data<Self, Repr>::getRepresentation() const {
-    std::unique_lock<std::mutex> lock(mutex_);
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        auto it = representations_.find(std::type_index(typeid(T)));
+        // Only take the fast path if lastValidRepresentation_ does not need to be updated
+        if (it != representations_.end() && it->second == lastValidRepresentation_ &&
+            it->second->isValid()) {
+            if (auto rit = records_.find(it->first); rit != records_.end()) rit->second->touch();
+            // Representations are stored by their type index, so this is always a T
+            return static_cast<const T*>(it->second.get());
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mutex_);
     if (representations_.empty()) {
         lock.unlock();
         auto factory = RepresentationFactoryManager::getRepresentationFactory<Repr>();
@@ -211,6 +261,7 @@ const T* Data<Self, Repr>::getRepresentation() const {
 
     auto it = representations_.find(std::type_index(typeid(T)));
     if (it != representations_.end() && it->second->isValid()) {
+        if (auto rit = records_.find(it->first); rit != records_.end()) rit->second->touch();
         lastValidRepresentation_ = it->second;
         return dynamic_cast<const T*>(lastValidRepresentation_.get());
     } else {
@@ -224,8 +275,17 @@ const T* Data<Self, Repr>::getValidRepresentation() const {
     auto factory = RepresentationFactoryManager::getRepresentationConverterFactory<Repr>();
     if (auto package = factory->getRepresentationConverter(lastValidRepresentation_->getTypeIndex(),
                                                            std::type_index(typeid(T)))) {
+        using namespace std::chrono;
+        const auto start = steady_clock::now();
+        util::OnScopeExit accumulate{[start]() {
+            util::addRepresentationConversionTime(
+                duration_cast<nanoseconds>(steady_clock::now() - start));
+        }};
         for (auto converter : package->getConverters()) {
-            auto dest = converter->getConverterID().second;
+            IVW_TRACE_SCOPE("representation.convert",
+                            [&]() { return parseTypeIdName(typeid(*converter).name()); });
+            const auto [source, dest] = converter->getConverterID();
+            const auto conversionStart = steady_clock::now();
             auto it = representations_.find(dest);
             if (it != representations_.end()) {  // Next repr. already exist, just update it
                 converter->update(lastValidRepresentation_, it->second);
@@ -236,6 +296,12 @@ const T* Data<Self, Repr>::getValidRepresentation() const {
                 if (!result) throw ConverterException("Converter failed to create", IVW_CONTEXT);
                 lastValidRepresentation_ = addRepresentationInternal(result);
             }
+            RepresentationMemoryManager::get().recordConversion(
+                source, dest, duration_cast<nanoseconds>(steady_clock::now() - conversionStart));
+        }
+        if (auto rit = records_.find(lastValidRepresentation_->getTypeIndex());
+            rit != records_.end()) {
+            rit->second->touch();
         }
         return dynamic_cast<const T*>(lastValidRepresentation_.get());
     } else {
@@ -254,14 +320,22 @@ T* Data<Self, Repr>::getEditableRepresentation() {
 template <typename Self, typename Repr>
 template <typename T>
 bool Data<Self, Repr>::hasRepresentation() const {
-    std::unique_lock<std::mutex> lock(mutex_);
+    std::shared_lock<std::shared_mutex> lock(mutex_);
     return util::has_key(representations_, std::type_index(typeid(T)));
 }
 
+template <typename Self, typename Repr>
+template <typename T>
+bool Data<Self, Repr>::hasValidRepresentation() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto it = representations_.find(std::type_index(typeid(T)));
+    return it != representations_.end() && it->second->isValid();
+}
+
 template <typename Self, typename Repr>
 void Data<Self, Repr>::invalidateAllOther(const Repr* repr) {
     bool found = false;
-    std::unique_lock<std::mutex> lock(mutex_);
+    std::unique_lock<std::shared_mutex> lock(mutex_);
     for (auto& elem : representations_) {
         if (elem.second.get() != repr) {
             elem.second->setValid(false);
@@ -276,8 +350,9 @@ void Data<Self, Repr>::invalidateAllOther(const Repr* repr) {
 
 template <typename Self, typename Repr>
 void Data<Self, Repr>::clearRepresentations() {
-    std::unique_lock<std::mutex> lock(mutex_);
+    std::unique_lock<std::shared_mutex> lock(mutex_);
     representations_.clear();
+    records_.clear();
 }
 
 template <typename Self, typename Repr>
@@ -296,21 +371,53 @@ std::shared_ptr<Repr> Data<Self, Repr>::addRepresentationInternal(
     repr->setValid(true);
     repr->setOwner(static_cast<const Self*>(this));
     representations_[repr->getTypeIndex()] = repr;
+
+    // Disk representations do not keep their data in memory
+    const size_t bytes =
+        dynamic_cast<const DiskRepresentationBase*>(repr.get()) ? 0 : util::sizeInBytes(*repr);
+    records_[repr->getTypeIndex()] = RepresentationMemoryManager::get().add(
+        repr, bytes,
+        is_evictable<Self>::value ? std::weak_ptr<RepresentationMemoryManager::Owner>{memoryOwner_}
+                                  : std::weak_ptr<RepresentationMemoryManager::Owner>{});
     return repr;
 }
 
+template <typename Self, typename Repr>
+bool Data<Self, Repr>::evictRepresentation(const void* repr) const {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    if (!lastValidRepresentation_ || lastValidRepresentation_.get() == repr) return false;
+
+    auto it = std::find_if(representations_.begin(), representations_.end(),
+                           [&](const auto& elem) { return elem.second.get() == repr; });
+    if (it == representations_.end()) return false;
+
+    // A valid representation can only be removed if it can be recreated from the last valid one.
+    // Invalid representations will be updated before use anyway.
+    if (it->second->isValid()) {
+        auto factory = RepresentationFactoryManager::getRepresentationConverterFactory<Repr>();
+        if (!factory->getRepresentationConverter(lastValidRepresentation_->getTypeIndex(),
+                                                 it->first)) {
+            return false;
+        }
+    }
+    records_.erase(it->first);
+    representations_.erase(it);
+    return true;
+}
+
 template <typename Self, typename Repr>
 void Data<Self, Repr>::addRepresentation(std::shared_ptr<Repr> representation) {
-    std::unique_lock<std::mutex> lock(mutex_);
+    std::unique_lock<std::shared_mutex> lock(mutex_);
     lastValidRepresentation_ = addRepresentationInternal(representation);
 }
 
 template <typename Self, typename Repr>
 void Data<Self, Repr>::removeRepresentation(const Repr* representation) {
-    std::unique_lock<std::mutex> lock(mutex_);
+    std::unique_lock<std::shared_mutex> lock(mutex_);
 
     for (auto& elem : representations_) {
         if (elem.second.get() == representation) {
+            records_.erase(elem.first);
             representations_.erase(elem.first);
             break;
         }
@@ -329,7 +436,7 @@ void Data<Self, Repr>::removeRepresentation(const Repr* representation) {
 
 template <typename Self, typename Repr>
 void Data<Self, Repr>::removeOtherRepresentations(const Repr* representation) {
-    std::unique_lock<std::mutex> lock(mutex_);
+    std::unique_lock<std::shared_mutex> lock(mutex_);
 
     std::unordered_map<std::type_index, std::shared_ptr<Repr>> repr;
     for (auto& elem : representations_) {
@@ -346,11 +453,14 @@ void Data<Self, Repr>::removeOtherRepresentations(const Repr* representation) {
         }
     }
     std::swap(repr, representations_);
+    for (auto it = records_.begin(); it != records_.end();) {
+        it = representations_.count(it->first) ? std::next(it) : records_.erase(it);
+    }
 }
 
 template <typename Self, typename Repr>
 bool Data<Self, Repr>::hasRepresentations() const {
-    std::unique_lock<std::mutex> lock(mutex_);
+    std::shared_lock<std::shared_mutex> lock(mutex_);
     return !representations_.empty();
 }
 
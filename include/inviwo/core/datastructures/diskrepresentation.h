@@ -41,12 +41,22 @@ namespace inviwo {
 template <typename Repr>
 class DiskRepresentationLoader;
 
+/**
+ * \ingroup datastructures
+ * Non template base class of DiskRepresentation, used to identify representations that do not
+ * keep their data in memory.
+ */
+class DiskRepresentationBase {
+public:
+    virtual ~DiskRepresentationBase() = default;
+};
+
 /**
  * \ingroup datastructures
  * Base class for all DiskRepresentations \see Data, DataRepresentation
  */
 template <typename Repr, typename Self>
-class DiskRepresentation {
+class DiskRepresentation : public DiskRepresentationBase {
 public:
     DiskRepresentation() = default;
     DiskRepresentation(const std::string& srcFile,
@@ -60,6 +70,7 @@ public:
     bool hasSourceFile() const;
 
     void setLoader(DiskRepresentationLoader<Repr>* loader);
+    const DiskRepresentationLoader<Repr>* getLoader() const;
 
     std::shared_ptr<Repr> createRepresentation() const;
     void updateRepresentation(std::shared_ptr<Repr> dest) const;
@@ -96,6 +107,11 @@ void DiskRepresentation<Repr, Self>::setLoader(DiskRepresentationLoader<Repr>* l
     loader_.reset(loader);
 }
 
+template <typename Repr, typename Self>
+const DiskRepresentationLoader<Repr>* DiskRepresentation<Repr, Self>::getLoader() const {
+    return loader_.get();
+}
+
 template <typename Repr, typename Self>
 std::shared_ptr<Repr> DiskRepresentation<Repr, Self>::createRepresentation() const {
     if (!loader_) throw Exception("No loader available to create representation", IVW_CONTEXT);
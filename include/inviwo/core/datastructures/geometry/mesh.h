@@ -240,6 +240,11 @@ public:
     size_t getNumberOfBuffers() const;
     size_t getNumberOfIndicies() const;
 
+    /**
+     * Combined size in bytes of all buffers and index buffers of the mesh.
+     */
+    size_t getSizeInBytes() const;
+
     /**
      * \brief Append another mesh to this mesh
      *
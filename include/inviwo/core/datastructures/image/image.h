@@ -43,6 +43,9 @@ namespace inviwo {
 
 /**
  * \ingroup datastructures
+ * An Image consists of one or more color layers, a depth layer, and a picking layer. The depth and
+ * picking layers do not allocate any data until a representation of them is requested, for
+ * example when rendering into the image or when accessing them through ImageRAM.
  */
 class IVW_CORE_API Image : public DataGroup<Image, ImageRepresentation>, public MetaDataOwner {
 public:
@@ -73,6 +76,13 @@ public:
 
     size2_t getDimensions() const;
 
+    /**
+     * Combined size in bytes of all layers of the image. Depth and picking layers that have not
+     * been used yet, i.e. without any representation, are not counted.
+     * @see Layer::getSizeInBytes
+     */
+    size_t getSizeInBytes() const;
+
     /**
      * Resize all representation to dimension. This is destructive, the data will not be
      * preserved. Use copyRepresentationsTo to update the data.
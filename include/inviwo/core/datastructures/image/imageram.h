@@ -54,6 +54,10 @@ public:
     virtual size_t priority() const override;
 
     LayerRAM* getColorLayerRAM(size_t idx = 0);
+    /**
+     * The depth and picking layer representations are created on first access, images that
+     * never use them do not allocate them.
+     */
     LayerRAM* getDepthLayerRAM();
     LayerRAM* getPickingLayerRAM();
     size_t getNumberOfColorLayers() const;
@@ -73,9 +77,13 @@ public:
     virtual void update(bool editable) override;
 
 private:
-    std::vector<LayerRAM*> colorLayersRAM_;  //< non-owning reference
-    LayerRAM* depthLayerRAM_ = nullptr;      //< non-owning reference
-    LayerRAM* pickingLayerRAM_ = nullptr;    //< non-owning reference
+    bool hasLayerRAM(LayerType type) const;
+    LayerRAM* layerRAM(LayerType type) const;
+
+    std::vector<LayerRAM*> colorLayersRAM_;        //< non-owning reference
+    mutable LayerRAM* depthLayerRAM_ = nullptr;    //< non-owning reference, created on demand
+    mutable LayerRAM* pickingLayerRAM_ = nullptr;  //< non-owning reference, created on demand
+    bool editable_ = false;
 };
 
 }  // namespace inviwo
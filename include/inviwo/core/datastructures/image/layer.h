@@ -81,6 +81,12 @@ public:
     const DataFormatBase* getDataFormat() const;
     // clang-format on
 
+    /**
+     * Size of the pixel data in bytes, i.e. the number of pixels times the size of the data
+     * format. Does not depend on which representations exist.
+     */
+    size_t getSizeInBytes() const;
+
     /**
      * \brief update the swizzle mask of the channels for sampling color layers
      * The swizzle mask is only affecting Color layers.
@@ -51,7 +51,8 @@ public:
     virtual ~LayerRAM() = default;
 
     /**
-     * Copy and resize the representations of this onto the target.
+     * Copy and resize the representations of this onto the target. The data is resampled into the
+     * largest centered region of the target that keeps the aspect ratio, see util::resampleToFit.
      */
     virtual bool copyRepresentationsTo(LayerRepresentation*) const override;
 
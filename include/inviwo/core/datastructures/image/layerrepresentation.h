@@ -52,6 +52,10 @@ public:
      */
     virtual void setDimensions(size2_t dimensions) = 0;
     virtual const size2_t& getDimensions() const = 0;
+    /**
+     * Size of the data in bytes, i.e. the number of pixels times the size of the data format.
+     */
+    size_t getSizeInBytes() const;
 
     /**
      * \brief update the swizzle mask of the channels for sampling color layers
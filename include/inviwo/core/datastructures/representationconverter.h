@@ -32,6 +32,7 @@
 #include <inviwo/core/common/inviwocoredefine.h>
 #include <inviwo/core/util/exception.h>
 
+#include <chrono>
 #include <memory>
 #include <string>
 #include <vector>
@@ -39,6 +40,19 @@
 
 namespace inviwo {
 
+namespace util {
+/**
+ * Accumulated time spent converting representations on all threads, including conversions done
+ * by thread pool jobs. The counter is never reset, observers take a snapshot before and after an
+ * operation and use the difference.
+ */
+IVW_CORE_API std::chrono::nanoseconds representationConversionTime();
+/**
+ * Add \p time to the accumulated conversion time, see representationConversionTime().
+ */
+IVW_CORE_API void addRepresentationConversionTime(std::chrono::nanoseconds time);
+}  // namespace util
+
 class IVW_CORE_API ConverterException : public Exception {
 public:
     ConverterException(const std::string& message = "",
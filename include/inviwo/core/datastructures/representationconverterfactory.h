@@ -37,6 +37,7 @@
 #include <warn/ignore/all>
 #include <memory>
 #include <mutex>
+#include <shared_mutex>
 #include <typeindex>
 #include <unordered_set>
 #include <unordered_map>
@@ -69,9 +70,8 @@ class RepresentationConverterFactory : public BaseRepresentationConverterFactory
 public:
     using ConverterID = typename RepresentationConverter<BaseRepr>::ConverterID;
     using RepMap = std::unordered_map<ConverterID, RepresentationConverter<BaseRepr>*>;
-    using PackageMap =
-        std::unordered_multimap<ConverterID,
-                                std::unique_ptr<RepresentationConverterPackage<BaseRepr>>>;
+    using Package = RepresentationConverterPackage<BaseRepr>;
+    using PackageMap = std::unordered_map<ConverterID, std::shared_ptr<const Package>>;
     RepresentationConverterFactory() = default;
     virtual ~RepresentationConverterFactory() = default;
 
@@ -81,20 +81,30 @@ public:
     bool registerObject(RepresentationConverter<BaseRepr>* representationConverter);
     bool unRegisterObject(RepresentationConverter<BaseRepr>* representationConverter);
 
-    // Get best converter
-    const RepresentationConverterPackage<BaseRepr>* getRepresentationConverter(ConverterID);
-    const RepresentationConverterPackage<BaseRepr>* getRepresentationConverter(std::type_index from,
-                                                                               std::type_index to);
+    /**
+     * Get the shortest chain of converters from one representation type to another. The result is
+     * cached per pair of types, including when no chain was found, hence repeated lookups only
+     * take a shared lock. The returned package stays valid when converters are registered
+     * concurrently, which replaces the cache.
+     * @return a converter package or nullptr if there is no chain of converters
+     */
+    std::shared_ptr<const Package> getRepresentationConverter(ConverterID);
+    std::shared_ptr<const Package> getRepresentationConverter(std::type_index from,
+                                                              std::type_index to);
 
 private:
-    const RepresentationConverterPackage<BaseRepr>* createConverterPackage(ConverterID id);
+    std::shared_ptr<const Package> createConverterPackage(ConverterID id);
+
+    // Guards converters_ and packages_
+    std::shared_mutex mutex_;
 
     // converters are owned by the Module
     RepMap converters_;
 
-    // All the converter packages created locally;
-    std::mutex mutex_;
+    // All the converter packages created locally, nullptr for pairs without a chain of converters
     PackageMap packages_;
+    // Incremented whenever the converters change, to not cache packages of the old converters
+    size_t generation_ = 0;
 };
 
 template <typename BaseRepr>
@@ -105,20 +115,29 @@ auto RepresentationConverterFactory<BaseRepr>::getBaseReprId() -> BaseReprId {
 template <typename BaseRepr>
 bool RepresentationConverterFactory<BaseRepr>::registerObject(
     RepresentationConverter<BaseRepr>* converter) {
+    // Destroy the old packages after unlocking, readers might still hold some of them
+    PackageMap packages;
+    std::unique_lock<std::shared_mutex> lock(mutex_);
     if (!util::insert_unique(converters_, converter->getConverterID(), converter))
         throw(ConverterException("Converter with supplied ID already registered", IVW_CONTEXT));
 
+    // The new converter might give new or shorter chains
+    std::swap(packages, packages_);
+    ++generation_;
     return true;
 }
 
 template <typename BaseRepr>
 bool RepresentationConverterFactory<BaseRepr>::unRegisterObject(
     RepresentationConverter<BaseRepr>* converter) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
     size_t removed = util::map_erase_remove_if(
         converters_,
         [converter](typename RepMap::value_type& elem) { return elem.second == converter; });
+    ++generation_;
 
     util::map_erase_remove_if(packages_, [converter](typename PackageMap::value_type& elem) {
+        if (!elem.second) return false;
         for (auto& conv : elem.second->getConverters()) {
             if (conv == converter) return true;
         }
@@ -129,39 +148,31 @@ bool RepresentationConverterFactory<BaseRepr>::unRegisterObject(
 }
 
 template <typename BaseRepr>
-const RepresentationConverterPackage<BaseRepr>*
-RepresentationConverterFactory<BaseRepr>::getRepresentationConverter(ConverterID id) {
-    RepresentationConverterPackage<BaseRepr>* res = nullptr;
-    constexpr size_t steps = std::numeric_limits<size_t>::max();
+auto RepresentationConverterFactory<BaseRepr>::getRepresentationConverter(ConverterID id)
+    -> std::shared_ptr<const Package> {
     {
-        std::unique_lock<std::mutex> lock(mutex_);
-        auto range = packages_.equal_range(id);
-        for (auto it = range.first; it != range.second; ++it) {
-            if (it->second->steps() < steps) {
-                res = it->second.get();
-            }
-        }
-    }
-    if (res) {
-        return res;
-    } else {
-        return createConverterPackage(id);
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        auto it = packages_.find(id);
+        if (it != packages_.end()) return it->second;
     }
+    return createConverterPackage(id);
 }
 
 template <typename BaseRepr>
-const RepresentationConverterPackage<BaseRepr>*
-RepresentationConverterFactory<BaseRepr>::getRepresentationConverter(std::type_index from,
-                                                                     std::type_index to) {
+auto RepresentationConverterFactory<BaseRepr>::getRepresentationConverter(std::type_index from,
+                                                                          std::type_index to)
+    -> std::shared_ptr<const Package> {
     return getRepresentationConverter(ConverterID(from, to));
 }
 
 template <typename BaseRepr>
-const RepresentationConverterPackage<BaseRepr>*
-RepresentationConverterFactory<BaseRepr>::createConverterPackage(ConverterID id) {
+auto RepresentationConverterFactory<BaseRepr>::createConverterPackage(ConverterID id)
+    -> std::shared_ptr<const Package> {
     /* Implementation of Dijkstra's algorithm following
      * https://en.wikipedia.org/wiki/Dijkstra's_algorithm#Pseudocode
      */
+    std::shared_lock<std::shared_mutex> sharedLock(mutex_);
+    const auto generation = generation_;
     std::type_index source = id.first;
     std::type_index target = id.second;
 
@@ -203,7 +214,7 @@ RepresentationConverterFactory<BaseRepr>::createConverterPackage(ConverterID id)
                 size_t alt = dist[u] + 1;
                 if (alt < dist[v]) {
                     dist[v] = alt;
-                    prev.emplace(std::make_pair(v, u));
+                    prev.insert_or_assign(v, u);
                 }
             }
         }
@@ -212,26 +223,27 @@ RepresentationConverterFactory<BaseRepr>::createConverterPackage(ConverterID id)
     std::vector<const RepresentationConverter<BaseRepr>*> S;
     std::type_index u = target;
     while (util::has_key(prev, u)) {
-        auto conv = converters_[ConverterID(prev.at(u), u)];
-        S.push_back(conv);
+        S.push_back(converters_.at(ConverterID(prev.at(u), u)));
         u = prev.at(u);
     }
 
+    sharedLock.unlock();
+
+    std::shared_ptr<Package> package;
     if (!S.empty() && S.back()->getConverterID().first == source &&
         S.front()->getConverterID().second == target) {
-        auto package = std::make_unique<RepresentationConverterPackage<BaseRepr>>();
+        package = std::make_shared<Package>();
         for (auto it = S.crbegin(); it != S.crend(); it++) {
             package->addConverter(*it);
         }
-        auto res = package.get();
-        {
-            std::unique_lock<std::mutex> lock(mutex_);
-            packages_.emplace(std::make_pair(package->getConverterID(), std::move(package)));
-        }
-        return res;
-    } else {
-        return nullptr;
     }
+
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    // The converters changed while we were searching, don't cache a possibly outdated package
+    if (generation != generation_) return package;
+    // Another thread might have created the same package while we were searching
+    auto it = packages_.try_emplace(id, std::move(package)).first;
+    return it->second;
 }
 
 }  // namespace inviwo
@@ -0,0 +1,204 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <typeindex>
+#include <type_traits>
+#include <vector>
+
+namespace inviwo {
+
+/**
+ * Trait to let the RepresentationMemoryManager evict representations of a data type. Disabled by
+ * default since some representations refer to representations of other data objects, e.g. ImageGL
+ * refers to the LayerGL representations of its layers and MeshGL to the BufferGL representations
+ * of its buffers.
+ */
+template <typename T>
+struct is_evictable : std::false_type {};
+
+/**
+ * \ingroup datastructures
+ * \brief Keeps track of the memory used by data representations and of representation conversions.
+ *
+ * Data registers every representation it creates together with its size in bytes, and marks it as
+ * used every time it is accessed. When a budget is set, enforceBudget() will evict the least
+ * recently used representations until the budget is met. Only representations that can be
+ * recreated are evicted, i.e. the last valid representation of a Data object is never evicted, and
+ * a valid representation is only evicted if there is a converter to recreate it from the last
+ * valid one. Representations that were used in the current or previous epoch are never evicted.
+ *
+ * Eviction only happens in enforceBudget(), which is called by the ProcessorNetworkEvaluator when a
+ * network evaluation has finished and there are no background jobs or pool tasks running, and
+ * where each call starts a new epoch. Hence, pointers to representations should not be kept
+ * between network evaluations, other than by tasks running on the thread pool.
+ *
+ * The manager also records the number of conversions and the time spent for each pair of source
+ * and target representation types.
+ * @see Data
+ */
+class IVW_CORE_API RepresentationMemoryManager {
+public:
+    using duration = std::chrono::duration<double, std::milli>;
+
+    /**
+     * Handle shared between a Data object and the manager, used to evict representations from
+     * the Data object. The Data object releases the handle when it is destroyed.
+     */
+    class IVW_CORE_API Owner {
+    public:
+        using Evict = std::function<bool(const void* repr)>;
+        Owner(Evict evict);
+        void release();
+        bool evict(const void* repr);
+
+    private:
+        std::mutex mutex_;
+        Evict evict_;
+    };
+
+    /**
+     * Record of a single representation, owned by the Data object.
+     */
+    struct IVW_CORE_API Record {
+        Record(std::weak_ptr<const void> repr, std::type_index type, size_t bytes,
+               std::weak_ptr<Owner> owner);
+        void touch() noexcept;
+
+        std::weak_ptr<const void> repr;
+        std::type_index type;
+        size_t bytes;
+        std::weak_ptr<Owner> owner;
+        std::atomic<std::uint64_t> lastUse;
+    };
+
+    struct ConversionStatistics {
+        std::string source;
+        std::string target;
+        size_t count = 0;
+        duration time{0};
+    };
+
+    struct MemoryStatistics {
+        std::string type;
+        size_t count = 0;
+        size_t bytes = 0;
+    };
+
+    static RepresentationMemoryManager& get();
+
+    /**
+     * Register a representation
+     * @param repr the representation
+     * @param bytes the amount of memory used by the representation
+     * @param owner handle to the data object of the representation
+     * @return a record that should be kept for as long as the representation exists, and touched
+     * whenever the representation is used.
+     */
+    template <typename Repr>
+    std::shared_ptr<Record> add(const std::shared_ptr<Repr>& repr, size_t bytes,
+                                std::weak_ptr<Owner> owner);
+
+    /**
+     * Set the memory budget in bytes, 0 means unlimited.
+     */
+    void setBudget(size_t bytes);
+    size_t getBudget() const;
+
+    /**
+     * Evict least recently used representations until the used memory is within the budget and
+     * start a new epoch.
+     * @return the number of bytes evicted
+     */
+    size_t enforceBudget();
+
+    size_t getUsedBytes() const;
+    size_t getEvictionCount() const;
+    size_t getEvictedBytes() const;
+
+    /**
+     * Memory used by the currently registered representations, grouped by representation type.
+     */
+    std::vector<MemoryStatistics> getMemoryStatistics() const;
+
+    void recordConversion(std::type_index source, std::type_index target,
+                          std::chrono::nanoseconds time);
+    /**
+     * Conversion counts and times for each pair of representation types, sorted by time in
+     * descending order.
+     */
+    std::vector<ConversionStatistics> getConversionStatistics() const;
+
+    /**
+     * Reset the conversion and eviction statistics
+     */
+    void clearStatistics();
+
+private:
+    RepresentationMemoryManager() = default;
+
+    std::shared_ptr<Record> add(std::weak_ptr<const void> repr, std::type_index type, size_t bytes,
+                                std::weak_ptr<Owner> owner);
+    void prune();  // Remove expired records, requires the mutex to be locked
+
+    friend Record;
+    static std::atomic<std::uint64_t> epoch_;
+
+    mutable std::mutex mutex_;
+    size_t budget_ = 0;
+    size_t evictions_ = 0;
+    size_t evictedBytes_ = 0;
+    std::vector<std::weak_ptr<Record>> records_;
+    struct Conversions {
+        size_t count = 0;
+        std::chrono::nanoseconds time{0};
+    };
+    std::map<std::pair<std::type_index, std::type_index>, Conversions> conversions_;
+};
+
+template <typename Repr>
+std::shared_ptr<RepresentationMemoryManager::Record> RepresentationMemoryManager::add(
+    const std::shared_ptr<Repr>& repr, size_t bytes, std::weak_ptr<Owner> owner) {
+    return add(std::weak_ptr<const void>{std::shared_ptr<const void>{repr}},
+               repr->getTypeIndex(), bytes, std::move(owner));
+}
+
+}  // namespace inviwo
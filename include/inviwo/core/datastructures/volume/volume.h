@@ -48,6 +48,14 @@
 namespace inviwo {
 
 class Camera;
+class Volume;
+
+/**
+ * No representation refers to the representations of a volume, so unused volume representations
+ * can be evicted by the RepresentationMemoryManager.
+ */
+template <>
+struct is_evictable<Volume> : std::true_type {};
 
 /**
  * \ingroup datastructures
@@ -97,6 +105,12 @@ public:
     const DataFormatBase* getDataFormat() const;
     // clang-format on
 
+    /**
+     * Size of the voxel data in bytes, i.e. the number of voxels times the size of the data
+     * format. Does not depend on which representations exist.
+     */
+    size_t getSizeInBytes() const;
+
     /**
      * \brief update the swizzle mask of the color channels when sampling the volume
      *
@@ -36,6 +36,8 @@
 
 namespace inviwo {
 
+class VolumeRAM;
+
 /**
  * \ingroup datastructures
  */
@@ -83,6 +85,25 @@ private:
     Wrapping3D wrapping_;
 };
 
+/**
+ * \ingroup datastructures
+ * \brief A loader that can read a sub region of a volume without loading all of it.
+ * Loaders of chunked or sliced file formats implement this to let util::readVolumeRegion only
+ * read the needed part of the file.
+ */
+class IVW_CORE_API VolumeRegionLoader : public DiskRepresentationLoader<VolumeRepresentation> {
+public:
+    virtual ~VolumeRegionLoader() = default;
+    virtual VolumeRegionLoader* clone() const override = 0;
+
+    /**
+     * Read the voxels in [offset, offset + dims) of \p src into a new VolumeRAM with the format,
+     * swizzle mask, interpolation, and wrapping of \p src.
+     */
+    virtual std::shared_ptr<VolumeRAM> readRegion(const VolumeRepresentation& src, size3_t offset,
+                                                  size3_t dims) const = 0;
+};
+
 template <>
 struct representation_traits<Volume, kind::Disk> {
     using type = VolumeDisk;
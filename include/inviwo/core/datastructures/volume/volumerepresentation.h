@@ -50,6 +50,10 @@ public:
     // Needs to be overloaded by child classes.
     virtual void setDimensions(size3_t dimensions) = 0;
     virtual const size3_t& getDimensions() const = 0;
+    /**
+     * Size of the data in bytes, i.e. the number of voxels times the size of the data format.
+     */
+    size_t getSizeInBytes() const;
 
     /**
      * \brief update the swizzle mask of the color channels when sampling the volume
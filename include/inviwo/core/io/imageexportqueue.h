@@ -0,0 +1,155 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+#include <inviwo/core/datastructures/image/layer.h>
+#include <inviwo/core/io/datawriter.h>
+#include <inviwo/core/util/fileextension.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace inviwo {
+
+/**
+ * \ingroup dataio
+ * \brief Writes layers to disk on a set of background encoder threads.
+ *
+ * enqueue() takes an immutable LayerRAM snapshot of the layer on the calling thread, which is
+ * where any download from the GPU has to happen, and hands it to one of the encoder threads. The
+ * caller can then continue rendering the next frame while previous frames are compressed and
+ * written. The number of frames waiting or being written is bounded by the max pending count,
+ * once reached enqueue() blocks until an encoder finishes a frame. This keeps the memory used by
+ * the snapshots bounded when frames are produced faster than they can be written.
+ *
+ * The output file name is decided by the caller, i.e. frames keep their names independent of
+ * the order in which the encoders finish them.
+ *
+ * \code{.cpp}
+ * ImageExportQueue queue;
+ * for (size_t frame = 0; frame < frames; ++frame) {
+ *     // render frame ...
+ *     queue.enqueue(*canvas->getVisibleLayer(), fmt::format("frame{:04}.png", frame));
+ * }
+ * queue.wait();
+ * LogInfo(queue.getFramesPerSecond() << " frames/s");
+ * \endcode
+ */
+class IVW_CORE_API ImageExportQueue {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @param threads     number of encoder threads, at least one is used
+     * @param maxPending  max number of frames queued or being written before enqueue() blocks
+     */
+    explicit ImageExportQueue(size_t threads = 2, size_t maxPending = 8);
+    ImageExportQueue(const ImageExportQueue&) = delete;
+    ImageExportQueue& operator=(const ImageExportQueue&) = delete;
+    /**
+     * Waits for all pending frames to be written
+     */
+    ~ImageExportQueue();
+
+    /**
+     * Queue \p layer to be written to \p path. A writer is looked up for \p extension, or for the
+     * extension of \p path if that fails.
+     * @return false if no writer could be found, in that case nothing is queued
+     */
+    bool enqueue(const Layer& layer, std::string_view path,
+                 const FileExtension& extension = FileExtension(), bool overwrite = true);
+
+    /**
+     * Queue \p layer to be written to \p path using \p writer. \p written is called on the
+     * encoder thread once the file has been written successfully.
+     */
+    void enqueue(const Layer& layer, std::string_view path,
+                 std::unique_ptr<DataWriterType<Layer>> writer,
+                 std::function<void(const std::string& path)> written = nullptr);
+
+    /**
+     * Block until all queued frames have been written
+     */
+    void wait();
+
+    /**
+     * Number of frames that are queued or being written
+     */
+    size_t getPending() const;
+    /**
+     * Number of frames written successfully
+     */
+    size_t getWritten() const;
+    /**
+     * Number of frames that could not be written
+     */
+    size_t getFailed() const;
+    /**
+     * Average throughput of the written frames, measured from the first enqueued frame to the
+     * last finished one.
+     */
+    double getFramesPerSecond() const;
+
+private:
+    struct Job {
+        std::shared_ptr<const Layer> layer;
+        std::unique_ptr<DataWriterType<Layer>> writer;
+        std::string path;
+        std::function<void(const std::string&)> written;
+    };
+
+    void work();
+
+    mutable std::mutex mutex_;
+    std::condition_variable hasWork_;
+    std::condition_variable hasSpace_;
+    std::condition_variable finished_;
+    std::deque<Job> jobs_;
+    size_t maxPending_;
+    size_t active_ = 0;
+    size_t written_ = 0;
+    size_t failed_ = 0;
+    bool stop_ = false;
+    std::optional<Clock::time_point> start_;
+    Clock::time_point last_;
+    std::vector<std::thread> threads_;
+};
+
+}  // namespace inviwo
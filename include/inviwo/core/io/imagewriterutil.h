@@ -32,13 +32,23 @@
 #include <inviwo/core/common/inviwocoredefine.h>
 #include <inviwo/core/util/fileextension.h>
 #include <inviwo/core/datastructures/image/layer.h>
+#include <inviwo/core/io/datawriter.h>
 
+#include <memory>
 #include <string>
 
 namespace inviwo {
 
 namespace util {
 
+/**
+ * Find a layer writer for \p extension, or for the file extension of \p path if there is no
+ * writer for \p extension.
+ * @return the writer or nullptr if none was found
+ */
+IVW_CORE_API std::unique_ptr<DataWriterType<Layer>> getLayerWriter(
+    std::string_view path, const FileExtension& extension = FileExtension());
+
 IVW_CORE_API void saveLayer(const Layer& layer, std::string_view path,
                             const FileExtension& extension = FileExtension());
 
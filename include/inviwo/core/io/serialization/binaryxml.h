@@ -0,0 +1,145 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+#include <inviwo/core/io/serialization/serializebase.h>
+
+#include <iosfwd>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace inviwo {
+
+/**
+ * Compact binary encoding of the xml documents written by the Serializer.
+ *
+ * All element names, attribute names, and text are stored once in a string table at the start of
+ * the data, and only referred to by index afterwards. Attribute values that are integers or
+ * floating point numbers are stored as varints and as 4 or 8 byte binary values instead of text.
+ * Runs of sibling elements with the same name and attributes and no children, which is what
+ * containers of simple types serialize to, are stored as one header followed by one contiguous
+ * array per attribute. Every element records the size of its content so that a reader can skip
+ * over it.
+ *
+ * A number is only stored in binary form if formatting it again, the way the Serializer does,
+ * gives back the original text. The document is therefore reconstructed exactly, i.e. converting
+ * xml to binary and back gives the same xml.
+ *
+ * The Deserializer detects binary data automatically and reads it with a LazyReader, the
+ * Serializer writes it with Serializer::writeBinaryFile().
+ */
+namespace binaryxml {
+
+/**
+ * Elements nested deeper than this are rejected by the readers.
+ */
+constexpr size_t maxDepth = 256;
+
+/**
+ * Check if \p stream starts with binary xml data. Does not consume any data.
+ */
+IVW_CORE_API bool isBinary(std::istream& stream);
+
+/**
+ * Write \p doc in the binary encoding to \p stream.
+ * @throws SerializationException if the document contains nodes that can not be encoded.
+ */
+IVW_CORE_API void write(const TxDocument& doc, std::ostream& stream);
+
+/**
+ * Read binary data from \p stream and append all nodes to \p doc.
+ * @throws SerializationException if the data is not valid or nested deeper than maxDepth.
+ */
+IVW_CORE_API void read(std::istream& stream, TxDocument& doc);
+
+/**
+ * Convert a xml document to the binary encoding
+ */
+IVW_CORE_API void fromXml(std::istream& xml, std::ostream& binary);
+
+/**
+ * Convert binary data to a formatted xml document
+ */
+IVW_CORE_API void toXml(std::istream& binary, std::ostream& xml);
+
+/**
+ * Reads binary data into a document while deferring the decoding of large subtrees, the binary
+ * counterpart of LazyXml.
+ *
+ * Elements at least `minDepth` levels below the document root whose encoded content is larger
+ * than `minSize` bytes are added as empty placeholder elements with the same name and attributes,
+ * marked with LazyXml::marker. Their content is decoded when materialize() is called for them,
+ * which the Deserializer does when it switches to the node. The data is released once every
+ * placeholder is decoded.
+ */
+class IVW_CORE_API LazyReader {
+public:
+    /**
+     * Decode \p data into \p doc deferring large subtrees.
+     * @throws SerializationException if the data is not valid or nested deeper than maxDepth.
+     */
+    LazyReader(std::string data, TxDocument& doc, size_t minDepth = 3, size_t minSize = 1024);
+
+    /**
+     * Decode the deferred content of \p node, does nothing if \p node is not a placeholder.
+     * @throws SerializationException if the data is not valid or nested deeper than maxDepth.
+     */
+    void materialize(TxElement& node);
+
+    /**
+     * Decode the deferred content of \p node and of all its descendants.
+     */
+    void materializeAll(TxElement& node);
+
+    /**
+     * The number of placeholders that are not materialized yet.
+     */
+    size_t getDeferred() const;
+
+    struct Range {
+        size_t begin;
+        size_t end;
+        size_t depth;  ///< number of element ancestors of the deferred children
+    };
+
+private:
+    std::string data_;
+    std::vector<std::string_view> strings_;
+    std::vector<Range> deferred_;
+    size_t minDepth_;
+    size_t minSize_;
+    size_t remaining_ = 0;
+};
+
+}  // namespace binaryxml
+
+}  // namespace inviwo
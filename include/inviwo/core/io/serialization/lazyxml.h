@@ -0,0 +1,94 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+#include <inviwo/core/io/serialization/serializebase.h>
+
+#include <string>
+#include <vector>
+
+namespace inviwo {
+
+/**
+ * Loads an xml document while deferring the parsing of large subtrees.
+ *
+ * The source text is first scanned to find the extent of every element. Elements at least
+ * `minDepth` levels below the document root whose content is larger than `minSize` bytes are
+ * replaced by empty placeholder elements, with the same name and attributes, and only the
+ * remaining skeleton is parsed into the document. The content of a placeholder is parsed when
+ * materialize() is called for it, which the Deserializer does when it switches to the node. Only
+ * the outermost large elements are deferred, i.e. a materialized subtree is complete. Only the
+ * text of the deferred elements is kept after the skeleton is parsed, and the text of each one is
+ * released when it is materialized.
+ *
+ * If the scan finds the source malformed the whole document is parsed directly, to get the
+ * regular parse errors.
+ */
+class IVW_CORE_API LazyXml {
+public:
+    /**
+     * Parse \p source into \p doc deferring large subtrees.
+     * @throws TxException if the source can not be parsed.
+     */
+    LazyXml(std::string source, TxDocument& doc, size_t minDepth = 3, size_t minSize = 1024);
+
+    /**
+     * Parse the deferred content of \p node, does nothing if \p node is not a placeholder.
+     */
+    void materialize(TxElement& node);
+
+    /**
+     * Parse the deferred content of \p node and of all its descendants.
+     */
+    void materializeAll(TxElement& node);
+
+    /**
+     * The number of placeholders that are not materialized yet.
+     */
+    size_t getDeferred() const;
+
+    /**
+     * The number of bytes of source text kept for the placeholders that are not materialized yet.
+     */
+    size_t getDeferredBytes() const;
+
+    /**
+     * Name of the attribute used to mark placeholder elements.
+     */
+    static constexpr std::string_view marker = "ivw-deferred";
+
+private:
+    std::vector<std::string> deferred_;
+    size_t minDepth_;
+    size_t remaining_ = 0;
+};
+
+}  // namespace inviwo
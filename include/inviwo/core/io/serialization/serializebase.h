@@ -47,6 +47,11 @@ namespace inviwo {
 using TxElement = ticpp::Element;
 using TxDocument = ticpp::Document;
 
+class LazyXml;
+namespace binaryxml {
+class LazyReader;
+}
+
 namespace config {
 #if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
 constexpr bool charconv = true;
@@ -162,8 +167,24 @@ public:
 protected:
     friend class NodeSwitch;
 
+    /**
+     * Read xml or binary xml data from \p stream into the document. Large subtrees are only
+     * parsed when switched to, see LazyXml and binaryxml::LazyReader.
+     */
+    void read(std::istream& stream);
+    /**
+     * Parse any deferred content of \p node, called by NodeSwitch when switching to a node.
+     */
+    void materialize(TxElement* node);
+    /**
+     * Parse any deferred content of \p node and of all its descendants.
+     */
+    void materializeAll(TxElement* node);
+
     std::string fileName_;
     std::unique_ptr<TxDocument> doc_;
+    std::unique_ptr<LazyXml> lazy_;
+    std::unique_ptr<binaryxml::LazyReader> lazyBinary_;
     TxElement* rootElement_;
     bool retrieveChild_;
 };
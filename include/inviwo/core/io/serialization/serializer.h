@@ -78,6 +78,12 @@ public:
      * @throws SerializationException
      */
     virtual void writeFile(std::ostream& stream, bool format = false);
+    /**
+     * \brief Writes serialized data to stream using the compact binary encoding of binaryxml.h.
+     * The data can be read back by the Deserializer like regular xml.
+     * @throws SerializationException
+     */
+    virtual void writeBinaryFile(std::ostream& stream);
 
     // std containers
     template <typename T, typename Pred = util::alwaysTrue, typename Proj = util::identity>
@@ -0,0 +1,152 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace inviwo {
+
+class Processor;
+class ProcessorNetwork;
+
+/**
+ * \brief The state of a ProcessorNetwork stored as one serialized string per processor.
+ *
+ * Connections and links are stored as pairs of port and property paths. A snapshot can be built
+ * from a previous one, then only the processors that have changed are serialized again and the
+ * others share their string with the previous snapshot. Keeping many snapshots of a large network
+ * is therefore cheap as long as each step only touches a few processors.
+ * @see NetworkDelta
+ */
+class IVW_CORE_API NetworkSnapshot {
+public:
+    using Edge = std::pair<std::string, std::string>;
+    using Processors = std::map<std::string, std::shared_ptr<const std::string>, std::less<>>;
+
+    NetworkSnapshot() = default;
+    /**
+     * Serialize all processors of \p network.
+     */
+    NetworkSnapshot(const ProcessorNetwork& network, const std::string& refPath);
+    /**
+     * Serialize the processors of \p network for which \p isDirty returns true, or that are not
+     * part of \p previous. All other processors reuse the serialized string in \p previous, as do
+     * dirty processors whose state turns out to be unchanged.
+     */
+    NetworkSnapshot(const ProcessorNetwork& network, const std::string& refPath,
+                    const NetworkSnapshot& previous,
+                    const std::function<bool(const Processor&)>& isDirty);
+
+    const Processors& getProcessors() const;
+    const std::set<Edge>& getConnections() const;
+    const std::set<Edge>& getLinks() const;
+
+    static std::shared_ptr<const std::string> serialize(const Processor& processor,
+                                                        const std::string& refPath);
+
+private:
+    friend class NetworkDelta;
+
+    Processors processors_;
+    std::set<Edge> connections_;
+    std::set<Edge> links_;
+};
+
+/**
+ * \brief The difference between two NetworkSnapshots.
+ *
+ * Holds the added, removed, and changed processors together with the added and removed
+ * connections and links. The delta can be applied to a live network in either direction, only
+ * touching the processors, connections, and links that differ. Changed processors are updated in
+ * place by deserializing their stored state, added and removed processors are created and
+ * deleted. Renamed processors are renamed and updated in place as well.
+ */
+class IVW_CORE_API NetworkDelta {
+public:
+    /// Pairs of old and new processor identifiers
+    using Renames = std::vector<std::pair<std::string, std::string>>;
+
+    /**
+     * Compare \p before and \p after. Processors listed in \p renames that are only part of
+     * \p before under the old identifier and only part of \p after under the new one are
+     * recorded as renamed instead of removed and added.
+     */
+    NetworkDelta(const NetworkSnapshot& before, const NetworkSnapshot& after,
+                 const Renames& renames = {});
+
+    bool empty() const;
+
+    /**
+     * Patch \p network and \p snapshot from the after state back to the before state.
+     */
+    void undo(ProcessorNetwork& network, NetworkSnapshot& snapshot,
+              const std::string& refPath) const;
+    /**
+     * Patch \p network and \p snapshot from the before state to the after state.
+     */
+    void redo(ProcessorNetwork& network, NetworkSnapshot& snapshot,
+              const std::string& refPath) const;
+
+    /**
+     * Identifiers of the processors that differ between the two states.
+     */
+    std::vector<std::string> getProcessors() const;
+    size_t getChangedEdges() const;
+
+private:
+    struct ProcessorChange {
+        std::string identifier;
+        std::string previousIdentifier;             /// empty unless the processor was renamed
+        std::shared_ptr<const std::string> before;  /// nullptr if the processor was added
+        std::shared_ptr<const std::string> after;   /// nullptr if the processor was removed
+    };
+    struct Changes {
+        std::vector<NetworkSnapshot::Edge> removedConnections;
+        std::vector<NetworkSnapshot::Edge> addedConnections;
+        std::vector<NetworkSnapshot::Edge> removedLinks;
+        std::vector<NetworkSnapshot::Edge> addedLinks;
+    };
+
+    void apply(ProcessorNetwork& network, NetworkSnapshot& snapshot, const std::string& refPath,
+               bool forward) const;
+
+    std::vector<ProcessorChange> processors_;
+    Changes edges_;
+};
+
+}  // namespace inviwo
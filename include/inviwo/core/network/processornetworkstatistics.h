@@ -0,0 +1,160 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+#include <inviwo/core/network/processornetworkobserver.h>
+#include <inviwo/core/network/processornetworkevaluationobserver.h>
+#include <inviwo/core/processors/processorobserver.h>
+
+#include <chrono>
+#include <iosfwd>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace inviwo {
+
+class Processor;
+class ProcessorNetwork;
+class ProcessorNetworkEvaluator;
+
+/**
+ * \ingroup network
+ * Collects per processor performance statistics while the network is evaluated. For each
+ * processor the time spent in Processor::process() is recorded together with the time spent
+ * converting data representations during that call, and the size of the data on its outports.
+ * The collector is disabled by default and only observes the network while enabled.
+ *
+ * Statistics of processors that are removed from the network are kept until clear() is called.
+ * @see InviwoApplication::getProcessorNetworkStatistics
+ */
+class IVW_CORE_API ProcessorNetworkStatistics : public ProcessorNetworkObserver,
+                                                public ProcessorObserver,
+                                                public ProcessorNetworkEvaluationObserver {
+public:
+    using duration = std::chrono::duration<double, std::milli>;
+
+    struct IVW_CORE_API ProcessorStatistics {
+        std::string identifier;
+        std::string classIdentifier;
+        size_t count = 0;
+        duration min{0};
+        duration mean{0};
+        /// 95th percentile of the most recent samples, @see ProcessorNetworkStatistics::window
+        duration p95{0};
+        duration max{0};
+        duration total{0};
+        /// Total time spent converting representations during process(), on any thread
+        /// @see util::representationConversionTime
+        duration conversionTime{0};
+        /// Size of the outport data after the last process()
+        size_t bytesProduced = 0;
+        /// Accumulated size of the outport data over all process() calls
+        size_t totalBytesProduced = 0;
+    };
+
+    /// Number of samples kept for the percentile estimate
+    static constexpr size_t window = 1024;
+
+    ProcessorNetworkStatistics(ProcessorNetwork* network, ProcessorNetworkEvaluator* evaluator);
+    ProcessorNetworkStatistics(const ProcessorNetworkStatistics&) = delete;
+    ProcessorNetworkStatistics& operator=(const ProcessorNetworkStatistics&) = delete;
+    virtual ~ProcessorNetworkStatistics();
+
+    void setEnabled(bool enabled);
+    bool isEnabled() const;
+
+    /**
+     * Statistics for all processors that have been evaluated, sorted by total time in descending
+     * order.
+     */
+    std::vector<ProcessorStatistics> getStatistics() const;
+    std::optional<ProcessorStatistics> getStatistics(const Processor* processor) const;
+
+    size_t getEvaluationCount() const;
+    duration getEvaluationTime() const;
+
+    void clear();
+
+    /**
+     * Write the statistics as CSV with one processor per row. Times are in milliseconds.
+     * Fields containing a separator, quote, or line break are quoted.
+     */
+    void writeCSV(std::ostream& os) const;
+    /**
+     * Write the statistics as JSON, including the network evaluation count and time.
+     * Times are in milliseconds. The identifiers are escaped as JSON strings.
+     */
+    void writeJSON(std::ostream& os) const;
+    /**
+     * Save the statistics to file, as JSON if the extension is "json" otherwise as CSV.
+     * @throw Exception if the file could not be opened.
+     */
+    void save(const std::string& filename) const;
+
+private:
+    struct Entry {
+        ProcessorStatistics stats;
+        std::vector<double> samples;  // ring buffer of the last process times in ms
+        size_t next = 0;
+        std::chrono::steady_clock::time_point start;
+        std::chrono::nanoseconds conversionStart{0};
+    };
+
+    // ProcessorNetworkObserver overrides
+    virtual void onProcessorNetworkDidAddProcessor(Processor* processor) override;
+    virtual void onProcessorNetworkWillRemoveProcessor(Processor* processor) override;
+
+    // ProcessorObserver overrides
+    virtual void onProcessorAboutToProcess(Processor* processor) override;
+    virtual void onProcessorFinishedProcess(Processor* processor) override;
+
+    // ProcessorNetworkEvaluationObserver overrides
+    virtual void onProcessorNetworkEvaluationBegin() override;
+    virtual void onProcessorNetworkEvaluationEnd() override;
+
+    static ProcessorStatistics summarize(const Entry& entry);
+
+    ProcessorNetwork* network_;
+    ProcessorNetworkEvaluator* evaluator_;
+    bool enabled_ = false;
+
+    std::unordered_map<const Processor*, Entry> entries_;
+    std::vector<ProcessorStatistics> removed_;
+
+    size_t evaluations_ = 0;
+    duration evaluationTime_{0};
+    std::chrono::steady_clock::time_point evaluationStart_;
+};
+
+}  // namespace inviwo
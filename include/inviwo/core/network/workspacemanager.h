@@ -46,10 +46,22 @@ namespace inviwo {
 class FactoryBase;
 class InviwoApplication;
 
-enum class WorkspaceSaveMode { Disk = 1 << 0, Undo = 1 << 1 };
+/**
+ * Disk and Undo save the complete workspace. UndoWithoutNetwork is used by the undo stack to save
+ * the parts of the workspace outside of the processor network, such as animations and presets,
+ * since it tracks the processor network separately. Loading such a workspace leaves the processor
+ * network untouched.
+ */
+enum class WorkspaceSaveMode { Disk = 1 << 0, Undo = 1 << 1, UndoWithoutNetwork = 1 << 2 };
 ALLOW_FLAGS_FOR_ENUM(WorkspaceSaveMode)
 using WorkspaceSaveModes = flags::flags<WorkspaceSaveMode>;
 
+/**
+ * Encoding of a saved workspace. Binary workspaces use the encoding in binaryxml.h and are
+ * saved with the file extension ".invb".
+ */
+enum class WorkspaceFormat { Xml, Binary };
+
 /**
  * The WorkspaceManager is responsible for clearing, loading, and saving a workspace. Different
  * items such as the processor network can register callbacks for clearing, loading, or saving a
@@ -92,13 +104,16 @@ public:
      *      saved file.
      * \param exceptionHandler A callback for handling errors.
      * \param mode to indicate if we are saving to disk or undo-stack
+     * \param format write formatted xml or the compact binary encoding
      */
     void save(std::ostream& stream, const std::string& refPath,
               const ExceptionHandler& exceptionHandler = StandardExceptionHandler(),
-              WorkspaceSaveMode mode = WorkspaceSaveMode::Disk);
+              WorkspaceSaveMode mode = WorkspaceSaveMode::Disk,
+              WorkspaceFormat format = WorkspaceFormat::Xml);
 
     /**
-     * Save the current workspace to a file
+     * Save the current workspace to a file. Files with the extension ".invb" are saved in the
+     * binary format.
      * \param path the file to save into.
      * \param exceptionHandler A callback for handling errors.
      * \param mode to indicate if we are saving to disk or undo-stack
@@ -119,7 +134,7 @@ public:
               const ExceptionHandler& exceptionHandler = StandardExceptionHandler());
 
     /**
-     * Load a workspace from a file
+     * Load a workspace from a file, xml and binary workspaces are detected automatically
      * \param path the file to read from.
      * \param exceptionHandler A callback for handling errors.
      */
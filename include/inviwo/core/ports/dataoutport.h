@@ -88,6 +88,7 @@ public:
     void setData(T&& data);
 
     virtual bool hasData() const override;
+    virtual size_t getDataSizeInBytes() const override;
 
 protected:
     std::shared_ptr<const T> data_;
@@ -155,6 +156,11 @@ bool DataOutport<T>::hasData() const {
     return data_.get() != nullptr;
 }
 
+template <typename T>
+size_t DataOutport<T>::getDataSizeInBytes() const {
+    return data_ ? util::sizeInBytes(*data_) : 0;
+}
+
 template <typename T>
 void DataOutport<T>::clear() {
     data_.reset();
@@ -98,6 +98,12 @@ public:
      */
     virtual bool hasData() const = 0;
 
+    /**
+     * Size in bytes of the data in the port. Returns 0 if there is no data or if the size of the
+     * kind of data is unknown.
+     */
+    virtual size_t getDataSizeInBytes() const;
+
     /**
      * Clear the outport of any data
      */
@@ -48,6 +48,7 @@ namespace inviwo {
 class Canvas;
 class CanvasProcessorWidget;
 class ProcessorNetworkEvaluator;
+class ImageExportQueue;
 template <typename T>
 class DataWriterType;
 
@@ -65,6 +66,10 @@ public:
     bool getUseCustomDimensions() const;
     size2_t getCustomDimensions() const;
 
+    /**
+     * Save a snapshot of the visible layer to the snapshot directory. The layer is written in the
+     * background, the canvas can keep rendering while the image is encoded.
+     */
     void saveImageLayer();
     void saveImageLayer(std::string_view filePath,
                         const FileExtension& extension = FileExtension());
@@ -126,6 +131,7 @@ private:
 
     size2_t previousImageSize_;
     ProcessorWidgetMetaData* widgetMetaData_;
+    std::unique_ptr<ImageExportQueue> snapshotQueue_;
 };
 
 }  // namespace inviwo
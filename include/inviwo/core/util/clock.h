@@ -32,6 +32,7 @@
 #include <inviwo/core/common/inviwocoredefine.h>
 #include <inviwo/core/util/stringconversion.h>
 #include <inviwo/core/util/logcentral.h>
+#include <inviwo/core/util/tracing.h>
 
 #include <sstream>
 #include <string>
@@ -200,7 +201,9 @@ using ScopedClockCPU = ScopedClock<Clock>;
 
 /**
  * \def IVW_CPU_PROFILING(message)
- * creates a scoped CPU clock with the given message.
+ * creates a scoped CPU clock with the given message. The elapsed time is also recorded as a trace
+ * event when the Tracer is enabled.
+ * Does nothing unless IVW_PROFILING is defined.
  *
  * @param src      source of the log message
  */
@@ -208,6 +211,7 @@ using ScopedClockCPU = ScopedClock<Clock>;
 /**
  * \def IVW_CPU_PROFILING_CUSTOM(src, message)
  * creates a scoped CPU clock with the given source and message.
+ * The elapsed time is also recorded as a trace event when the Tracer is enabled.
  * Does nothing unless IVW_PROFILING is defined.
  *
  * @param src      source of the log message
@@ -217,6 +221,7 @@ using ScopedClockCPU = ScopedClock<Clock>;
 /**
  * \def IVW_CPU_PROFILING_IF(time, message)
  * creates a scoped CPU clock with the given message and minimum duration.
+ * The elapsed time is always recorded as a trace event when the Tracer is enabled.
  * Does nothing unless IVW_PROFILING is defined.
  *
  * @param time     either a std::chrono::duration or a double value (milliseconds)
@@ -226,6 +231,7 @@ using ScopedClockCPU = ScopedClock<Clock>;
 /**
  * \def IVW_CPU_PROFILING_IF_CUSTOM(time, src, message)
  * creates a scoped CPU clock with the given source, message, and minimum duration.
+ * The elapsed time is always recorded as a trace event when the Tracer is enabled.
  * Does nothing unless IVW_PROFILING is defined.
  *
  * @param time     either a std::chrono::duration or a double value (milliseconds)
@@ -238,16 +244,18 @@ using ScopedClockCPU = ScopedClock<Clock>;
     std::ostringstream IVW_ADDLINE(__stream);                                              \
     IVW_ADDLINE(__stream) << message;                                                      \
     ScopedClockCPU IVW_ADDLINE(__clock)(parseTypeIdName(std::string(typeid(this).name())), \
-                                        IVW_ADDLINE(__stream).str());
+                                        IVW_ADDLINE(__stream).str());                      \
+    ::inviwo::TraceScope IVW_ADDLINE(__trace)("profiling", IVW_ADDLINE(__stream).str());
 #else
 #define IVW_CPU_PROFILING(message)
 #endif
 
 #if IVW_PROFILING
-#define IVW_CPU_PROFILING_CUSTOM(src, message) \
-    std::ostringstream IVW_ADDLINE(__stream);  \
-    IVW_ADDLINE(__stream) << message;          \
-    ScopedClockCPU IVW_ADDLINE(__clock)(src, IVW_ADDLINE(__stream).str());
+#define IVW_CPU_PROFILING_CUSTOM(src, message)                                           \
+    std::ostringstream IVW_ADDLINE(__stream);                                            \
+    IVW_ADDLINE(__stream) << message;                                                    \
+    ScopedClockCPU IVW_ADDLINE(__clock)(src, IVW_ADDLINE(__stream).str());               \
+    ::inviwo::TraceScope IVW_ADDLINE(__trace)("profiling", IVW_ADDLINE(__stream).str());
 #else
 #define IVW_CPU_PROFILING_CUSTOM(src, message)
 #endif
@@ -257,16 +265,18 @@ using ScopedClockCPU = ScopedClock<Clock>;
     std::ostringstream IVW_ADDLINE(__stream);                                              \
     IVW_ADDLINE(__stream) << message;                                                      \
     ScopedClockCPU IVW_ADDLINE(__clock)(parseTypeIdName(std::string(typeid(this).name())), \
-                                        IVW_ADDLINE(__stream).str(), time);
+                                        IVW_ADDLINE(__stream).str(), time);                \
+    ::inviwo::TraceScope IVW_ADDLINE(__trace)("profiling", IVW_ADDLINE(__stream).str());
 #else
 #define IVW_CPU_PROFILING_IF(time, message)
 #endif
 
 #if IVW_PROFILING
-#define IVW_CPU_PROFILING_IF_CUSTOM(time, src, message) \
-    std::ostringstream IVW_ADDLINE(__stream);           \
-    IVW_ADDLINE(__stream) << message;                   \
-    ScopedClockCPU IVW_ADDLINE(__clock)(src, IVW_ADDLINE(__stream).str(), time);
+#define IVW_CPU_PROFILING_IF_CUSTOM(time, src, message)                                  \
+    std::ostringstream IVW_ADDLINE(__stream);                                            \
+    IVW_ADDLINE(__stream) << message;                                                    \
+    ScopedClockCPU IVW_ADDLINE(__clock)(src, IVW_ADDLINE(__stream).str(), time);         \
+    ::inviwo::TraceScope IVW_ADDLINE(__trace)("profiling", IVW_ADDLINE(__stream).str());
 #else
 #define IVW_CPU_PROFILING_IF_CUSTOM(time, src, message)
 #endif
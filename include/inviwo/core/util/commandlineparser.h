@@ -103,11 +103,16 @@ public:
     const std::string getOutputPath() const;
     const std::string getWorkspacePath() const;
     const std::string getLogToFileFileName() const;
+    const std::string getTraceFileName() const;
+    const std::string getStatisticsFileName() const;
     bool getQuitApplicationAfterStartup() const;
     bool getLoadWorkspaceFromArg() const;
     bool getShowSplashScreen() const;
     bool getLogToFile() const;
     bool getLogToConsole() const;
+    bool getTrace() const;
+    bool getStatistics() const;
+    bool getStartupReport() const;
     bool getDisableResourceManager() const;
 
     int getARGC() const;
@@ -129,6 +134,9 @@ private:
     TCLAP::ValueArg<std::string> outputPath_;
     TCLAP::ValueArg<std::string> logfile_;
     TCLAP::SwitchArg logConsole_;
+    TCLAP::ValueArg<std::string> trace_;
+    TCLAP::ValueArg<std::string> statistics_;
+    TCLAP::SwitchArg startupReport_;
     TCLAP::SwitchArg noSplashScreen_;
     TCLAP::SwitchArg quitAfterStartup_;
     WildCardArg wildcard_;
@@ -0,0 +1,133 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+#include <inviwo/core/util/glm.h>
+
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <type_traits>
+
+namespace inviwo {
+
+class DataFormatBase;
+
+namespace util {
+
+/**
+ * \brief convert the scalar \p v to type \p Dst, values outside of the range of \p Dst are clamped.
+ * Floating point values are truncated when converted to integers, and NaN is converted to zero.
+ */
+template <typename Dst, typename Src>
+constexpr Dst saturate_cast(Src v) {
+    if constexpr (std::is_same_v<Dst, Src>) {
+        return v;
+    } else if constexpr (util::is_floating_point<Dst>::value) {
+        if constexpr (std::is_same_v<Src, half_float::half>) {
+            return static_cast<Dst>(static_cast<float>(v));
+        } else {
+            return static_cast<Dst>(v);
+        }
+    } else if constexpr (util::is_floating_point<Src>::value) {
+        constexpr auto lowest = static_cast<double>(std::numeric_limits<Dst>::lowest());
+        constexpr auto max = static_cast<double>(std::numeric_limits<Dst>::max());
+        const auto d = static_cast<double>(v);
+        if (d >= lowest && d < max) return static_cast<Dst>(d);
+        if (d >= max) return std::numeric_limits<Dst>::max();
+        return d < lowest ? std::numeric_limits<Dst>::lowest() : Dst{0};
+    } else if constexpr (std::is_signed_v<Src> && std::is_unsigned_v<Dst>) {
+        if (v < 0) return Dst{0};
+        return static_cast<std::uint64_t>(v) > std::numeric_limits<Dst>::max()
+                   ? std::numeric_limits<Dst>::max()
+                   : static_cast<Dst>(v);
+    } else if constexpr (std::is_unsigned_v<Src> && std::is_signed_v<Dst>) {
+        return static_cast<std::uint64_t>(v) >
+                       static_cast<std::uint64_t>(std::numeric_limits<Dst>::max())
+                   ? std::numeric_limits<Dst>::max()
+                   : static_cast<Dst>(v);
+    } else {
+        if (v < std::numeric_limits<Dst>::lowest()) return std::numeric_limits<Dst>::lowest();
+        if (v > std::numeric_limits<Dst>::max()) return std::numeric_limits<Dst>::max();
+        return static_cast<Dst>(v);
+    }
+}
+
+/**
+ * \brief Linear mapping of values from one range to another, i.e. from the data range of the
+ * DataMapper of a source to the data range of a destination.
+ */
+struct IVW_CORE_API LinearMapping {
+    LinearMapping() = default;
+    LinearMapping(dvec2 from, dvec2 to);
+
+    double operator()(double v) const { return v * scale + offset; }
+
+    double scale = 1.0;
+    double offset = 0.0;
+};
+
+/**
+ * \brief convert \p size scalars from \p src to \p dst using saturate_cast. The loop is kept free
+ * of dependencies between iterations to allow the compiler to vectorize it.
+ */
+template <typename Dst, typename Src>
+void convertValues(const Src* src, Dst* dst, size_t size) {
+    for (size_t i = 0; i < size; ++i) {
+        dst[i] = saturate_cast<Dst>(src[i]);
+    }
+}
+
+/**
+ * \brief convert \p size scalars from \p src to \p dst, applying \p mapping to each value before
+ * the saturate_cast.
+ */
+template <typename Dst, typename Src>
+void convertValues(const Src* src, Dst* dst, size_t size, LinearMapping mapping) {
+    for (size_t i = 0; i < size; ++i) {
+        dst[i] = saturate_cast<Dst>(mapping(static_cast<double>(src[i])));
+    }
+}
+
+/**
+ * \brief convert \p size elements of format \p srcFormat to \p dstFormat, see convertValues.
+ * Both formats need to have the same number of components, the mapping is applied to each
+ * component. Large arrays are converted in chunks in parallel on the thread pool, this function
+ * should therefore not be called from within a thread pool task.
+ * @throws Exception if the formats have a different number of components
+ */
+IVW_CORE_API void convertData(const DataFormatBase* srcFormat, const void* src,
+                              const DataFormatBase* dstFormat, void* dst, size_t size,
+                              std::optional<LinearMapping> mapping = std::nullopt);
+
+}  // namespace util
+
+}  // namespace inviwo
@@ -33,6 +33,8 @@
 #include <inviwo/core/common/inviwoapplication.h>
 #include <inviwo/core/util/settings/systemsettings.h>
 
+#include <cstddef>
+#include <functional>
 #include <utility>
 
 namespace inviwo {
@@ -141,6 +143,26 @@ void forEachParallel(const Iterable& iterable, Callback&& callback, size_t jobs
     }
 }
 
+/**
+ * Call \p func(begin, end, job) for \p jobs consecutive ranges covering [0, \p count). The
+ * calling thread takes part in the work and ranges are claimed by whichever thread is free, hence
+ * the caller only ever waits for ranges that are already running. This makes it safe to call from
+ * within a thread pool task, where waiting on queued jobs could deadlock. The ranges are run in
+ * order on the calling thread if there is no thread pool. The first exception thrown by \p func
+ * is rethrown once all ranges are done.
+ */
+IVW_CORE_API void forEachRange(
+    size_t count, size_t jobs,
+    const std::function<void(size_t begin, size_t end, size_t job)>& func);
+
+/**
+ * The number of jobs to split \p count items into for forEachRange, given the cost of each item,
+ * for example in bytes. At most four jobs per pool thread, and each job gets at least
+ * \p minCostPerJob, which defaults to a megabyte.
+ */
+IVW_CORE_API size_t jobCount(size_t count, size_t costPerItem,
+                             size_t minCostPerJob = size_t{1} << 20);
+
 }  // namespace util
 
 }  // namespace inviwo
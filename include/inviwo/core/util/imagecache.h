@@ -36,6 +36,8 @@
 
 #include <unordered_map>
 #include <memory>
+#include <limits>
+#include <optional>
 
 namespace inviwo {
 
@@ -71,12 +73,42 @@ public:
     std::shared_ptr<Image> getUnusedImage(const std::vector<size2_t>& dimensions);
     size_t size() const;
 
+    /**
+     * Limit the combined size of the cached images, not counting the master. When a new image is
+     * added and the limit is exceeded, the least recently requested images are removed. Without a
+     * limit of its own the cache uses the default limit. Requests are only tracked while there is
+     * a limit.
+     * @see setDefaultMaxSizeInBytes
+     */
+    void setMaxSizeInBytes(size_t bytes);
+    size_t getMaxSizeInBytes() const;
+
+    /**
+     * The limit of all caches that have no limit of their own, unlimited by default. The
+     * application sets it from the "Image Cache Budget" system setting. A changed limit is
+     * applied the next time an image is added to a cache.
+     */
+    static void setDefaultMaxSizeInBytes(size_t bytes);
+    static size_t getDefaultMaxSizeInBytes();
+    /**
+     * Combined size in bytes of all cached images, not counting the master.
+     * @see Image::getSizeInBytes
+     */
+    size_t getSizeInBytes() const;
+
 private:
+    void touch(const size2_t dimensions) const;
+    void evict(const size2_t keep) const;
+
     mutable bool valid_;
     std::shared_ptr<const Image> master_;  // non-owning reference.
 
     using Cache = std::unordered_map<glm::size2_t, std::shared_ptr<Image>>;
     mutable Cache cache_;
+
+    std::optional<size_t> maxSizeInBytes_;
+    mutable size_t useCounter_ = 0;
+    mutable std::unordered_map<glm::size2_t, size_t> lastUse_;
 };
 
 }  // namespace inviwo
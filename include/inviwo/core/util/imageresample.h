@@ -0,0 +1,75 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+#include <inviwo/core/util/glm.h>
+
+namespace inviwo {
+
+class LayerRAM;
+
+namespace util {
+
+enum class ResampleFilter {
+    Nearest,   ///< nearest source pixel
+    Box,       ///< average of the covered source pixels
+    Bilinear,  ///< tent filter, linear interpolation when magnifying
+    Lanczos3   ///< windowed sinc with three lobes, sharpest but may ring at edges
+};
+
+/**
+ * \brief Resample \p src into the region of \p dst starting at \p offset with extent \p size.
+ * The filter is separable and is widened when minifying to avoid aliasing. Rows are processed in
+ * parallel on the thread pool, hence this function should not be called from within a thread pool
+ * task. The pixels of \p dst outside of the region are not modified.
+ * @throws Exception if the formats of \p src and \p dst differ or the region is outside of \p dst
+ */
+IVW_CORE_API void resample(const LayerRAM& src, LayerRAM& dst, size2_t offset, size2_t size,
+                           ResampleFilter filter = ResampleFilter::Bilinear);
+
+/**
+ * \brief Resample \p src to fill all of \p dst.
+ * @see resample(const LayerRAM&, LayerRAM&, size2_t, size2_t, ResampleFilter)
+ */
+IVW_CORE_API void resample(const LayerRAM& src, LayerRAM& dst,
+                           ResampleFilter filter = ResampleFilter::Bilinear);
+
+/**
+ * \brief Resample \p src into the largest centered region of \p dst that keeps the aspect ratio of
+ * \p src, the remaining pixels of \p dst are set to zero.
+ * @see resample(const LayerRAM&, LayerRAM&, size2_t, size2_t, ResampleFilter)
+ */
+IVW_CORE_API void resampleToFit(const LayerRAM& src, LayerRAM& dst,
+                                ResampleFilter filter = ResampleFilter::Bilinear);
+
+}  // namespace util
+
+}  // namespace inviwo
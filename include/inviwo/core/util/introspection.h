@@ -74,6 +74,9 @@ using dataInfoType = decltype(std::declval<T>().getDataInfo());
 template <typename T>
 using infoType = decltype(std::declval<T>().getInfo());
 
+template <typename T>
+using sizeInBytesType = decltype(std::declval<const T&>().getSizeInBytes());
+
 }  // namespace detail
 
 template <class T>
@@ -162,6 +165,22 @@ Document info(const T& data) {
     }
 }
 
+template <typename T>
+using HasSizeInBytes = is_detected_convertible<size_t, detail::sizeInBytesType, T>;
+
+/**
+ * Size of the data in bytes. Will use the member function T::getSizeInBytes() if it is found,
+ * otherwise 0 is returned.
+ */
+template <typename T>
+size_t sizeInBytes(const T& data) {
+    if constexpr (HasSizeInBytes<T>::value) {
+        return data.getSizeInBytes();
+    } else {
+        return 0;
+    }
+}
+
 }  // namespace util
 
 }  // namespace inviwo
@@ -59,6 +59,8 @@ public:
     BoolProperty logStackTraceProperty_;
     BoolProperty runtimeModuleReloading_;
     BoolProperty enableResourceManager_;
+    IntSizeTProperty representationMemoryBudget_;
+    IntSizeTProperty imageCacheBudget_;
     TemplateOptionProperty<MessageBreakLevel> breakOnMessage_;
     BoolProperty breakOnException_;
     BoolProperty stackTraceInException_;
@@ -242,6 +242,11 @@ IVW_CORE_API std::vector<std::string_view> splitStringView(std::string_view str,
 // trim from both ends
 IVW_CORE_API std::string_view trim(std::string_view s);
 
+/**
+ * \brief Write str as a quoted JSON string, escaping quotes, backslashes, and control characters
+ */
+IVW_CORE_API void writeJsonString(std::ostream& os, std::string_view str);
+
 }  // namespace util
 
 // Keep this here to avoid breaking old code
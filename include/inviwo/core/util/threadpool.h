@@ -97,6 +97,11 @@ public:
 
     size_t getQueueSize();
 
+    /**
+     * True if there are no queued tasks and no worker is running a task.
+     */
+    bool isIdle();
+
 private:
     enum class State {
         Free,     //< Worker is waiting for tasks.
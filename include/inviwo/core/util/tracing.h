@@ -0,0 +1,193 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <chrono>
+#include <atomic>
+#include <mutex>
+#include <memory>
+#include <iosfwd>
+#include <cstdint>
+#include <type_traits>
+#include <functional>
+
+namespace inviwo {
+
+/**
+ * \class Tracer
+ * \brief Records scoped trace events into per thread ring buffers.
+ *
+ * Each thread that records events gets its own fixed size ring buffer, when the buffer is full the
+ * oldest events are overwritten. Recording is off by default and is turned on with setEnabled().
+ * The recorded events can be exported in the Chrome trace event format and then be inspected in a
+ * timeline viewer like chrome://tracing or https://ui.perfetto.dev.
+ *
+ * Events are usually not recorded directly but using the IVW_TRACE_SCOPE macros, which compile to
+ * nothing unless IVW_PROFILING is defined (IVW_CFG_PROFILING in CMake).
+ * \code{.cpp}
+ *     void MyProcessor::process() {
+ *         IVW_TRACE_SCOPE("processor", getIdentifier());
+ *         ...
+ *     }
+ * \endcode
+ * @see TraceScope
+ */
+class IVW_CORE_API Tracer {
+public:
+    using clock = std::chrono::steady_clock;
+
+    struct Event {
+        std::string_view category;  //< Needs to be a string with static storage, i.e. a literal
+        std::string name;
+        std::uint32_t threadId;
+        std::int64_t start;     //< Nanoseconds since the construction of the tracer
+        std::int64_t duration;  //< Nanoseconds
+    };
+
+    static Tracer& get();
+
+    /**
+     * Query whether events are recorded. Cheap enough to call before every event.
+     */
+    static bool isEnabled() noexcept { return enabled_.load(std::memory_order_relaxed); }
+    static void setEnabled(bool enabled);
+
+    /**
+     * Set the number of events kept for each thread. Will clear all recorded events.
+     */
+    void setBufferCapacity(size_t capacity);
+    size_t getBufferCapacity() const;
+
+    /**
+     * Set a name for the calling thread, shown in the trace viewer.
+     */
+    void setThreadName(std::string_view name);
+
+    void record(std::string_view category, std::string_view name, clock::time_point start,
+                clock::time_point end);
+
+    /**
+     * Remove all recorded events
+     */
+    void clear();
+
+    /**
+     * Get a copy of all currently recorded events from all threads, sorted by start time.
+     */
+    std::vector<Event> getEvents() const;
+
+    /**
+     * Write all recorded events as a json object in the Chrome trace event format.
+     */
+    void exportChromeTrace(std::ostream& os) const;
+    void exportChromeTrace(const std::string& filename) const;
+
+private:
+    struct ThreadBuffer;
+
+    Tracer();
+    ThreadBuffer& threadBuffer();
+
+    static std::atomic<bool> enabled_;
+
+    const clock::time_point epoch_;
+    mutable std::mutex mutex_;
+    size_t capacity_;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers_;
+};
+
+/**
+ * \class TraceScope
+ * \brief Records a trace event covering the life time of the object.
+ * Does nothing, not even copying the name, if the Tracer is not enabled at construction. The name
+ * can also be given as a callable returning a std::string, it will then only be invoked when the
+ * Tracer is enabled, which avoids paying for expensive names when not tracing.
+ * @see Tracer
+ * @see IVW_TRACE_SCOPE
+ */
+class IVW_CORE_API TraceScope {
+public:
+    TraceScope(std::string_view category, std::string_view name)
+        : active_{Tracer::isEnabled()} {
+        if (active_) {
+            category_ = category;
+            name_ = name;
+            start_ = Tracer::clock::now();
+        }
+    }
+    template <typename F, typename = std::enable_if_t<std::is_invocable_r_v<std::string, F>>>
+    TraceScope(std::string_view category, F&& nameGenerator) : active_{Tracer::isEnabled()} {
+        if (active_) {
+            category_ = category;
+            name_ = std::invoke(std::forward<F>(nameGenerator));
+            start_ = Tracer::clock::now();
+        }
+    }
+    TraceScope(const TraceScope&) = delete;
+    TraceScope(TraceScope&&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+    TraceScope& operator=(TraceScope&&) = delete;
+    ~TraceScope() {
+        if (active_) Tracer::get().record(category_, name_, start_, Tracer::clock::now());
+    }
+
+private:
+    bool active_;
+    std::string_view category_;
+    std::string name_;
+    Tracer::clock::time_point start_;
+};
+
+#define IVW_TRACE_ADDLINE_PART1(x, y) x##y
+#define IVW_TRACE_ADDLINE_PART2(x, y) IVW_TRACE_ADDLINE_PART1(x, y)
+#define IVW_TRACE_ADDLINE(x) IVW_TRACE_ADDLINE_PART2(x, __LINE__)
+
+/**
+ * \def IVW_TRACE_SCOPE(category, name)
+ * Records a trace event from here until the end of the current scope.
+ * Does nothing unless IVW_PROFILING is defined.
+ *
+ * @param category a string literal used to group events, i.e. "processor" or "serialization"
+ * @param name     anything convertible to a std::string_view, or a callable returning a
+ *                 std::string
+ */
+#if IVW_PROFILING
+#define IVW_TRACE_SCOPE(category, name)                                  \
+    ::inviwo::TraceScope IVW_TRACE_ADDLINE(__traceScope)(category, name)
+#else
+#define IVW_TRACE_SCOPE(category, name)
+#endif
+
+}  // namespace inviwo
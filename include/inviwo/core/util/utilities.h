@@ -37,6 +37,7 @@
 namespace inviwo {
 
 class ProcessorNetwork;
+class ImageExportQueue;
 
 class Property;
 class ProcessorWidget;
@@ -45,9 +46,15 @@ namespace util {
 
 IVW_CORE_API void saveNetwork(ProcessorNetwork* network, std::string_view filename);
 
+/**
+ * Save the visible layer of all canvases in \p network to \p dir. If \p queue is given the
+ * layers are handed to the queue and written in the background, otherwise they are written
+ * before the function returns.
+ */
 IVW_CORE_API void saveAllCanvases(ProcessorNetwork* network, std::string_view dir,
                                   std::string_view name = "UPN", std::string_view ext = ".png",
-                                  bool onlyActiveCanvases = false);
+                                  bool onlyActiveCanvases = false,
+                                  ImageExportQueue* queue = nullptr);
 
 IVW_CORE_API bool isValidIdentifierCharacter(char c, std::string_view extra = "");
 
@@ -0,0 +1,100 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+#include <inviwo/core/util/glmvec.h>
+
+#include <array>
+#include <memory>
+
+namespace inviwo {
+
+class VolumeRAM;
+
+namespace util {
+
+/**
+ * \brief A permutation and flip of the three axes of a volume.
+ * Axis i of the result is axis permutation[i] of the source, reversed if flip[i] is set. For
+ * example {{1, 0, 2}, {false, false, true}} swaps x and y and flips z.
+ */
+struct IVW_CORE_API AxisReorientation {
+    std::array<size_t, 3> permutation = {0, 1, 2};
+    std::array<bool, 3> flip = {false, false, false};
+
+    bool isIdentity() const;
+    /**
+     * True if the axes are only flipped, in that case the dimensions do not change.
+     */
+    bool isFlipOnly() const;
+    /**
+     * The dimensions of the result for a source with dimensions \p dims
+     */
+    size3_t apply(size3_t dims) const;
+};
+
+/**
+ * \brief Copy the voxels of \p src with dimensions \p srcDims reoriented into \p dst.
+ * Rows that stay rows are copied as a whole, axes that are swapped with x are transposed in cache
+ * sized tiles. The work is split over the thread pool with util::forEachRange, which also makes it
+ * safe to call from within a thread pool task. \p src and \p dst must not overlap.
+ * @param elemSize the size of a voxel in bytes
+ * @throws Exception if the permutation is invalid
+ */
+IVW_CORE_API void reorient(const void* src, void* dst, size3_t srcDims, size_t elemSize,
+                           const AxisReorientation& reorientation);
+
+/**
+ * \brief Reorient the voxels of \p data in place, the dimensions afterwards are
+ * reorientation.apply(dims). Flips are done by swapping voxels without a temporary copy, a
+ * permutation of the axes needs a temporary copy of the data.
+ * @see reorient
+ */
+IVW_CORE_API void reorientInPlace(void* data, size3_t dims, size_t elemSize,
+                                  const AxisReorientation& reorientation);
+
+/**
+ * \brief Create a reoriented copy of \p volume, the wrapping is permuted along with the axes.
+ * @see reorient
+ */
+IVW_CORE_API std::shared_ptr<VolumeRAM> reorient(const VolumeRAM& volume,
+                                                 const AxisReorientation& reorientation);
+
+/**
+ * \brief Reorient \p volume in place. Only flips avoid the temporary copy, a permutation of the
+ * axes changes the dimensions, and hence reallocates the data of \p volume.
+ * @see reorientInPlace
+ */
+IVW_CORE_API void reorientInPlace(VolumeRAM& volume, const AxisReorientation& reorientation);
+
+}  // namespace util
+
+}  // namespace inviwo
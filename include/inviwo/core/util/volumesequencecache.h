@@ -0,0 +1,113 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+#include <inviwo/core/util/volumesequenceutils.h>
+
+#include <cstddef>
+#include <future>
+#include <memory>
+#include <unordered_map>
+
+namespace inviwo {
+
+/**
+ * \brief Streams the time steps of a VolumeSequence through RAM during playback.
+ *
+ * Every call to get() loads the RAM representation of the requested time step, and prefetches the
+ * next time steps in the playback direction on the thread pool. The playback direction is given by
+ * the previous index, and prefetching wraps around at the ends of the sequence to support looping.
+ *
+ * When the RAM representations of the sequence use more memory than the budget, the time steps
+ * furthest away in the playback direction are evicted, i.e. the ones that were just played are
+ * evicted first. Only time steps with a valid disk representation are evicted, since they can be
+ * loaded again. Eviction only removes the RAM representation, the volumes might be used elsewhere
+ * in the network and other representations, for example on the GPU, are kept. Time steps in the
+ * prefetch window are never evicted.
+ * @see VolumeSequenceElementSelectorProcessor
+ */
+class IVW_CORE_API VolumeSequenceCache {
+public:
+    /**
+     * @param budget max number of bytes of RAM representations to keep, 0 means unlimited
+     * @param prefetch number of time steps to prefetch in the playback direction
+     */
+    VolumeSequenceCache(size_t budget = 0, size_t prefetch = 2);
+    VolumeSequenceCache(const VolumeSequenceCache&) = delete;
+    VolumeSequenceCache& operator=(const VolumeSequenceCache&) = delete;
+    /**
+     * Waits for all prefetches to finish.
+     */
+    ~VolumeSequenceCache();
+
+    /**
+     * Set the sequence to stream, waits for prefetches of the previous sequence to finish.
+     */
+    void setSequence(std::shared_ptr<const VolumeSequence> sequence);
+    const std::shared_ptr<const VolumeSequence>& getSequence() const;
+
+    void setBudget(size_t bytes);
+    size_t getBudget() const;
+
+    void setPrefetchCount(size_t count);
+    size_t getPrefetchCount() const;
+
+    /**
+     * Get the time step at index with a loaded RAM representation. Starts prefetching of the
+     * following time steps and evicts distant time steps if the budget is exceeded.
+     * Should only be called from the main thread.
+     */
+    std::shared_ptr<Volume> get(size_t index);
+
+    /**
+     * The number of bytes used by the RAM representations of the sequence
+     */
+    size_t getUsedBytes() const;
+    size_t getEvictionCount() const;
+
+private:
+    void wait(size_t index);
+    void waitAll();
+    void prefetch(size_t index);
+    void evict(size_t index);
+    size_t distance(size_t from, size_t to) const;
+
+    std::shared_ptr<const VolumeSequence> sequence_;
+    size_t budget_;
+    size_t prefetch_;
+    size_t evictions_ = 0;
+    size_t lastIndex_ = 0;
+    bool forward_ = true;
+    std::unordered_map<size_t, std::future<void>> pending_;
+};
+
+}  // namespace inviwo
@@ -34,22 +34,35 @@
 #include <inviwo/core/util/spatial4dsampler.h>
 #include <inviwo/core/util/volumesampler.h>
 
+#include <atomic>
+#include <future>
+#include <mutex>
+
 namespace inviwo {
 
+/**
+ * \brief Samples a sequence of volumes, interpolating linearly in time.
+ *
+ * The sampler of each time step is created, and its RAM representation loaded, the first time the
+ * time step is sampled. To bound the memory used when tracing over long sequences, call
+ * setTimeWindow() with the time interval that will be sampled next, which releases the time steps
+ * outside the interval and prefetches the following ones on the thread pool.
+ * The input volumes are shared with the rest of the network and are never modified. Time steps
+ * that only have a disk representation are loaded into a volume owned by the sampler, which is
+ * freed again when the time step is released.
+ */
 class IVW_CORE_API VolumeSequenceSampler : public Spatial4DSampler<3, double> {
     struct Wrapper {
         std::weak_ptr<Wrapper> next_;
         double duration_;
         double timestamp_;
         std::shared_ptr<Volume> volume_;
-        VolumeDoubleSampler<4> sampler_;
 
         Wrapper(std::shared_ptr<Volume> volume)
             : next_()
             , duration_(std::numeric_limits<double>::infinity())
             , timestamp_(std::numeric_limits<double>::infinity())
-            , volume_(volume)
-            , sampler_(volume) {
+            , volume_(volume) {
             if (volume_->hasMetaData<DoubleMetaData>("timestamp")) {
                 timestamp_ = volume_->getMetaData<DoubleMetaData>("timestamp")->get();
             }
@@ -57,28 +70,106 @@ class IVW_CORE_API VolumeSequenceSampler : public Spatial4DSampler<3, double> {
                 duration_ = volume_->getMetaData<DoubleMetaData>("duration")->get();
             }
         }
+        Wrapper(const Wrapper &) = delete;
+        Wrapper &operator=(const Wrapper &) = delete;
+        ~Wrapper();
 
         bool operator<(const Wrapper &w) const { return timestamp_ < w.timestamp_; }
+
+        /**
+         * Get the sampler, creates it on first use. Thread safe.
+         */
+        const VolumeDoubleSampler<4> &sampler();
+        bool isResident() const { return sampler_.load(std::memory_order_acquire) != nullptr; }
+        void prefetch();
+        /**
+         * Release the sampler, and the volume loaded for it if any.
+         * Must not be called concurrently with sampler().
+         */
+        void release();
+        /**
+         * The volume to sample, a volume of our own if the time step has to be loaded from disk
+         */
+        std::shared_ptr<const Volume> load() const;
+
+    private:
+        std::mutex mutex_;
+        std::unique_ptr<VolumeDoubleSampler<4>> storage_;
+        std::atomic<const VolumeDoubleSampler<4> *> sampler_{nullptr};
+        std::future<void> prefetch_;
     };
 
 public:
     VolumeSequenceSampler(
         std::shared_ptr<const std::vector<std::shared_ptr<Volume>>> volumeSequence,
         bool allowLooping = true);
+    /**
+     * Create a sampler of the same time steps, with its own time window
+     */
+    VolumeSequenceSampler(const VolumeSequenceSampler &rhs);
+    VolumeSequenceSampler &operator=(const VolumeSequenceSampler &) = delete;
     virtual ~VolumeSequenceSampler();
 
     void setAllowedLooping(bool allowed = true) { allowLooping_ = allowed; }
 
+    /**
+     * Keep only the time steps needed to sample the time interval [t0, t1] in memory, and
+     * prefetch the next time steps after the interval, or before it if forward is false. Time
+     * steps outside of the window are loaded again if sampled, hence the window only affects
+     * memory use and not the sampled values.
+     * Must not be called concurrently with sampling. Samplers are usually shared through ports, use
+     * a copy to change the time window of one.
+     * @param t0 start of the time interval
+     * @param t1 end of the time interval
+     * @param forward the direction to prefetch in
+     * @param prefetch the number of time steps to prefetch
+     */
+    void setTimeWindow(double t0, double t1, bool forward = true, size_t prefetch = 1);
+    /**
+     * Release all time steps.
+     */
+    void clearTimeWindow();
+
+    /**
+     * The timestamps of the time steps in sorted order
+     */
+    std::vector<double> getTimestamps() const;
+    /**
+     * The time range covered by the sequence, from the first timestamp to the end of the last
+     * time step.
+     */
+    dvec2 getTimeRange() const;
+    /**
+     * The number of time steps that currently have a sampler
+     */
+    size_t getResidentCount() const;
+
 protected:
     virtual dvec3 sampleDataSpace(const dvec4 &pos) const;
     virtual bool withinBoundsDataSpace(const dvec4 &pos) const;
 
 private:
-    std::vector<std::shared_ptr<Wrapper>> wrappers_;
+    /**
+     * Index of the time step containing t, after wrapping if looping is allowed.
+     * Returns the size of the sequence if t is outside of the sequence.
+     */
+    size_t indexOf(double t) const;
+    /**
+     * Drop the last time step if it has the same data as the first one, i.e. if the sequence
+     * loops. Comparing the data requires loading both time steps, hence it is done on first use.
+     */
+    void removeDuplicateLastTimeStep() const;
+    void updateTimeRange() const;
+
+    // Modified once by removeDuplicateLastTimeStep()
+    mutable std::vector<std::shared_ptr<Wrapper>> wrappers_;
+    mutable std::once_flag duplicateCheck_;
+    mutable std::shared_ptr<Wrapper> first_;
+    mutable std::shared_ptr<Wrapper> last_;
 
     bool allowLooping_;
-    dvec2 timeRange_;
-    double totDuration_;
+    mutable dvec2 timeRange_;
+    mutable double totDuration_;
 };
 
 }  // namespace inviwo
@@ -39,6 +39,7 @@
 namespace inviwo {
 
 class Volume;
+class VolumeRAM;
 
 namespace util {
 
@@ -70,6 +71,16 @@ size3_t IVW_CORE_API getVolumeDimensions(const std::shared_ptr<const Volume> &vo
  */
 double IVW_CORE_API voxelVolume(const Volume &volume);
 
+/**
+ * Read the voxels in [offset, offset + dims) of \p volume directly from disk. This only works if
+ * the volume has no valid VolumeRAM representation and its VolumeDisk has a VolumeRegionLoader,
+ * in that case only the needed part of the file is read.
+ * @return the region or nullptr if it can not be read from disk, use the VolumeRAM then.
+ * @throw Exception if the region is outside of the volume
+ */
+std::shared_ptr<VolumeRAM> IVW_CORE_API readVolumeRegion(const Volume &volume, size3_t offset,
+                                                         size3_t dims);
+
 }  // namespace util
 
 }  // namespace inviwo
@@ -34,10 +34,14 @@
 #include <inviwo/core/common/inviwo.h>
 #include <inviwo/core/network/processornetworkobserver.h>
 #include <inviwo/core/network/workspacemanager.h>
+#include <inviwo/core/network/networkdelta.h>
 
 #include <memory>
 #include <optional>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 class QAction;
 class QEvent;
@@ -49,6 +53,13 @@ class AutoSaver;
 
 /**
  * \class UndoManager
+ * Keeps an undo stack of NetworkDeltas. Each pushed state only serializes the processors that
+ * have changed since the previous state, and undo/redo patches the live network with the stored
+ * delta instead of reloading the workspace. The parts of the workspace outside of the processor
+ * network, such as animations, presets, and port inspectors, are serialized on every push and
+ * reloaded by undo/redo when they differ. Changes that are not observed, for example to custom
+ * meta data, are picked up by serializing all processors after markDirty() and periodically. A
+ * full workspace snapshot is written periodically for crash recovery.
  */
 class IVW_QTEDITOR_API UndoManager : public ProcessorNetworkObserver {
 public:
@@ -60,6 +71,10 @@ public:
     virtual ~UndoManager();
 
     void pushStateIfDirty();
+    /**
+     * Mark the workspace as changed in a way that is not observed by the undo manager. The next
+     * push serializes all processors.
+     */
     void markDirty();
 
     void pushState();
@@ -74,13 +89,26 @@ public:
     void restore();
 
 private:
-    using DiffType = std::vector<std::string>::iterator::difference_type;
+    class ProcessorTracker;
+
+    struct Step {
+        NetworkDelta network;
+        /// Workspace state outside of the processor network, nullptr if unchanged
+        std::shared_ptr<const std::string> before;
+        std::shared_ptr<const std::string> after;
+    };
 
     void updateActions();
+    void saveCheckpoint();
+    void track(Processor* processor);
+    void renamed(const std::string& from, const std::string& to);
+    std::shared_ptr<const std::string> serializeWorkspaceState() const;
+    void loadWorkspaceState(const std::string& state);
 
     // ProcessorNetworkObserver overrides;
     virtual void onProcessorNetworkChange() override;
     virtual void onProcessorNetworkDidAddProcessor(Processor* processor) override;
+    virtual void onProcessorNetworkWillRemoveProcessor(Processor* processor) override;
     virtual void onProcessorNetworkDidRemoveProcessor(Processor* processor) override;
     virtual void onProcessorNetworkDidAddConnection(const PortConnection& connection) override;
     virtual void onProcessorNetworkDidRemoveConnection(const PortConnection& connection) override;
@@ -93,8 +121,25 @@ private:
 
     bool dirty_ = true;
     bool isRestoring = false;
-    DiffType head_ = -1;
-    std::vector<std::shared_ptr<const std::string>> undoBuffer_;
+    /// Serialize all processors on the next push, and use the result as the new base state
+    bool reset_ = true;
+    /// Serialize all processors on the next push to catch changes that are not tracked
+    bool refreshAll_ = false;
+    /// Number of steps in undoBuffer_ that are applied to the workspace
+    size_t head_ = 0;
+    std::vector<Step> undoBuffer_;
+    NetworkSnapshot snapshot_;
+    std::shared_ptr<const std::string> workspaceState_;
+
+    std::unordered_set<const Processor*> dirtyProcessors_;
+    NetworkDelta::Renames renames_;
+    std::unordered_map<const Processor*, std::unique_ptr<ProcessorTracker>> trackers_;
+
+    /// Number of pushed states between two full snapshots for crash recovery, and between two
+    /// pushes that serialize all processors
+    static constexpr size_t checkpointInterval_ = 10;
+    size_t sinceCheckpoint_ = 0;
+    size_t sinceRefresh_ = 0;
 
     QAction* undoAction_;
     QAction* redoAction_;
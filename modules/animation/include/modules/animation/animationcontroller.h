@@ -47,6 +47,8 @@
 
 namespace inviwo {
 
+class ImageExportQueue;
+
 namespace animation {
 
 /** The AnimationController is responsible for steering the animation.
@@ -185,6 +187,9 @@ protected:
 
     /// State needed during rendering
     RenderState renderState_;
+
+    /// Writes the rendered frames in the background while the next frame is rendered
+    std::unique_ptr<ImageExportQueue> exportQueue_;
 };
 
 }  // namespace animation
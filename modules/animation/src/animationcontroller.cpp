@@ -31,13 +31,16 @@
 #include <modules/animation/animationcontrollerobserver.h>
 #include <modules/animation/datastructures/controltrack.h>
 #include <inviwo/core/io/datawriterfactory.h>
+#include <inviwo/core/io/imageexportqueue.h>
 #include <inviwo/core/network/networklock.h>
 #include <inviwo/core/processors/canvasprocessor.h>
 #include <inviwo/core/util/utilities.h>
 #include <inviwo/core/util/stdextensions.h>
 #include <inviwo/core/util/stringconversion.h>
 
+#include <iomanip>
 #include <string_view>
+#include <thread>
 
 namespace inviwo {
 
@@ -320,6 +323,10 @@ void AnimationController::render() {
     renderAction.setVisible(false);
     renderActionStop.setVisible(true);
 
+    // Encode and write frames on background threads while the next frame renders
+    exportQueue_ = std::make_unique<ImageExportQueue>(
+        std::max(2u, std::thread::hardware_concurrency() / 2), 16);
+
     // Go for it!
     setState(AnimationState::Rendering);
 }
@@ -329,6 +336,16 @@ void AnimationController::afterRender() {
     renderActionStop.setVisible(false);
     renderAction.setVisible(true);
 
+    // Wait for the remaining frames to be written
+    if (exportQueue_) {
+        exportQueue_->wait();
+        LogInfoCustom("AnimationController",
+                      "Exported " << exportQueue_->getWritten() << " images at " << std::fixed
+                                  << std::setprecision(1) << exportQueue_->getFramesPerSecond()
+                                  << " frames/s");
+        exportQueue_.reset();
+    }
+
     // Restore original state of Canvases
     auto network = app_->getProcessorNetwork();
     NetworkLock lock(network);
@@ -440,7 +457,7 @@ void AnimationController::tickRender() {
         auto ext = FileExtension::createFileExtensionFromString(renderImageExtension.get());
         // - save active canvases
         util::saveAllCanvases(app_->getProcessorNetwork(), renderLocation.get(),
-                              fileNamePattern.str(), ext.extension_, true);
+                              fileNamePattern.str(), ext.extension_, true, exportQueue_.get());
     }
 
     // Next!
@@ -45,8 +45,12 @@ namespace inviwo {
 
 void exposeVolumeOperations(pybind11::module& m) {
 
-    m.def("curlVolume", [](Volume& vol) { return util::curlVolume(vol).release(); });
-    m.def("divergenceVolume", [](Volume& vol) { return util::divergenceVolume(vol).release(); });
+    using release = pybind11::call_guard<pybind11::gil_scoped_release>;
+
+    m.def("curlVolume", [](Volume& vol) { return util::curlVolume(vol).release(); }, release{});
+    m.def(
+        "divergenceVolume", [](Volume& vol) { return util::divergenceVolume(vol).release(); },
+        release{});
 }
 
 }  // namespace inviwo
@@ -43,9 +43,14 @@ namespace inviwo {
 
 void exposeVolumeWriteMethods(pybind11::module& m) {
 
-    m.def("saveDatVolume", &util::writeDatVolume);
-    m.def("saveIvfVolume", &util::writeIvfVolume);
-    m.def("saveIvfVolumeSequence", &util::writeIvfVolumeSequence);
+    using release = pybind11::call_guard<pybind11::gil_scoped_release>;
+
+    m.def("saveDatVolume", &util::writeDatVolume, release{});
+    m.def("saveIvfVolume", &util::writeIvfVolume, release{});
+    m.def("saveCompressedIvfVolume", &util::writeCompressedIvfVolume, pybind11::arg("volume"),
+          pybind11::arg("path"), pybind11::arg("overwrite") = false,
+          pybind11::arg("brickSize") = size3_t{64}, pybind11::arg("level") = 6, release{});
+    m.def("saveIvfVolumeSequence", &util::writeIvfVolumeSequence, release{});
     m.def("saveIvfVolumeSequence", [](pybind11::list list, std::string name, std::string path,
                                       std::string reltivePathToTimesteps, bool overwrite) {
         VolumeSequence seq;
@@ -53,6 +58,7 @@ void exposeVolumeWriteMethods(pybind11::module& m) {
             seq.push_back(v.cast<std::shared_ptr<Volume>>());
         }
 
+        pybind11::gil_scoped_release release;
         return util::writeIvfVolumeSequence(seq, name, path, reltivePathToTimesteps, overwrite);
     });
 }
@@ -38,6 +38,8 @@
 #include <inviwo/core/datastructures/image/layerram.h>
 #include <inviwo/core/datastructures/image/layerramprecision.h>
 
+#include <optional>
+
 namespace inviwo {
 
 class IVW_MODULE_BASE_API ImageReuseCache {
@@ -50,8 +52,21 @@ public:
     std::pair<std::shared_ptr<Image>, LayerRAMPrecision<T>*> getTypedUnused(const size2_t& dim);
     void add(std::shared_ptr<Image> image);
 
+    /**
+     * Limit the combined size of the cached images. When an image is added and the limit is
+     * exceeded, the oldest images that are not used elsewhere are dropped. Without a limit of its
+     * own the cache uses the default limit of the port image caches.
+     * @see ImageCache::setDefaultMaxSizeInBytes
+     */
+    void setMaxSizeInBytes(size_t bytes);
+    size_t getMaxSizeInBytes() const;
+    size_t getSizeInBytes() const;
+
 private:
+    void evict();
+
     std::vector<std::shared_ptr<Image>> imageCache_;
+    std::optional<size_t> maxSizeInBytes_;
 };
 
 template <typename T>
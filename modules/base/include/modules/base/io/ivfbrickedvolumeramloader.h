@@ -0,0 +1,101 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <modules/base/basemoduledefine.h>
+#include <inviwo/core/datastructures/volume/volumedisk.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace inviwo {
+
+class VolumeRAM;
+
+/**
+ * \ingroup dataio
+ * \brief Reads volumes stored as independently compressed bricks, see util::writeIvfBricks.
+ * The brick file starts with a header and an index holding the offset, the compressed size, and
+ * a CRC-32 checksum of every brick. Bricks are decompressed in parallel on the thread pool, and
+ * readRegion only decompresses the bricks overlapping the region, see util::readVolumeRegion.
+ * Used by the IvfVolumeReader for ivf files with zlib compression.
+ */
+class IVW_MODULE_BASE_API IvfBrickedVolumeRAMLoader : public VolumeRegionLoader {
+public:
+    struct Brick {
+        std::uint64_t offset;    // In bytes from the start of the file
+        std::uint64_t size;      // Compressed size in bytes
+        std::uint32_t checksum;  // CRC-32 of the uncompressed voxels
+    };
+
+    /**
+     * Reads the header and the brick index of \p file.
+     * @throws DataReaderException if the file can not be read or if it does not match
+     *         \p dimensions, \p brickSize, or the size of \p format
+     */
+    IvfBrickedVolumeRAMLoader(std::string file, size3_t dimensions, size3_t brickSize,
+                              const DataFormatBase* format);
+    virtual IvfBrickedVolumeRAMLoader* clone() const override;
+    virtual ~IvfBrickedVolumeRAMLoader() = default;
+
+    virtual std::shared_ptr<VolumeRepresentation> createRepresentation(
+        const VolumeRepresentation& src) const override;
+    virtual void updateRepresentation(std::shared_ptr<VolumeRepresentation> dest,
+                                      const VolumeRepresentation& src) const override;
+    virtual std::shared_ptr<VolumeRAM> readRegion(const VolumeRepresentation& src, size3_t offset,
+                                                  size3_t dims) const override;
+
+    const std::vector<Brick>& getBricks() const;
+
+private:
+    void read(size3_t offset, VolumeRAM& dest) const;
+
+    std::string file_;
+    size3_t dimensions_;
+    size3_t brickSize_;
+    size_t elemSize_;
+    std::vector<Brick> bricks_;
+};
+
+namespace util {
+
+/**
+ * Write the voxels of \p volume to \p file as bricks of \p brickSize voxels, each compressed with
+ * zlib at the given compression \p level (0-9). Bricks at the upper borders are cropped to the
+ * volume. The bricks are compressed in parallel on the thread pool.
+ * @throws DataWriterException if the file can not be written
+ */
+IVW_MODULE_BASE_API void writeIvfBricks(const VolumeRAM& volume, const std::string& file,
+                                        size3_t brickSize = size3_t{64}, int level = 6);
+
+}  // namespace util
+
+}  // namespace inviwo
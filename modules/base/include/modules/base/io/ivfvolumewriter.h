@@ -42,18 +42,41 @@ namespace inviwo {
  */
 class IVW_MODULE_BASE_API IvfVolumeWriter : public DataWriterType<Volume> {
 public:
-    IvfVolumeWriter();
+    enum class Compression {
+        None,  ///< Write the voxels to a raw file
+        Zlib   ///< Write the voxels as zlib compressed bricks, see util::writeCompressedIvfVolume
+    };
+    explicit IvfVolumeWriter(Compression compression = Compression::None);
     IvfVolumeWriter(const IvfVolumeWriter& rhs);
     IvfVolumeWriter& operator=(const IvfVolumeWriter& that);
     virtual IvfVolumeWriter* clone() const;
     virtual ~IvfVolumeWriter() {}
 
     virtual void writeData(const Volume* data, const std::string filePath) const;
+
+    /**
+     * Select how the voxels are written. The writer is registered once for the "ivf" extension,
+     * and writes uncompressed files unless the compression is set to Compression::Zlib.
+     */
+    void setCompression(Compression compression);
+    Compression getCompression() const;
+
+private:
+    Compression compression_;
 };
 
 namespace util {
 IVW_MODULE_BASE_API void writeIvfVolume(const Volume& data, const std::string filePath,
                                         bool overwrite = false);
+
+/**
+ * Write \p data as an ivf file where the voxels are stored as independently zlib compressed bricks
+ * in a separate .bricks file, see util::writeIvfBricks. The IvfVolumeReader only decompresses the
+ * bricks that are needed, see util::readVolumeRegion.
+ */
+IVW_MODULE_BASE_API void writeCompressedIvfVolume(const Volume& data, const std::string filePath,
+                                                  bool overwrite = false,
+                                                  size3_t brickSize = size3_t{64}, int level = 6);
 }
 
 }  // namespace inviwo
@@ -62,6 +62,11 @@ public:
 
 protected:
     void exportData();
+    /**
+     * Write \p data to the selected file. The default implementation writes the data before
+     * returning, derived classes can hand the data over to be written asynchronously.
+     */
+    virtual void writeData(const DataType* data, std::unique_ptr<DataWriterType<DataType>> writer);
 
     virtual const DataType* getData() = 0;
 
@@ -112,14 +117,8 @@ void DataExport<DataType, PortType>::exportData() {
             return;
         }
 
-        try {
-            writer->setOverwrite(overwrite_.get());
-            writer->writeData(data, file_.get());
-            util::log(IVW_CONTEXT, "Data exported to disk: " + file_.get(), LogLevel::Info,
-                      LogAudience::User);
-        } catch (DataWriterException const& e) {
-            util::log(e.getContext(), e.getMessage(), LogLevel::Error, LogAudience::User);
-        }
+        writer->setOverwrite(overwrite_.get());
+        writeData(data, std::move(writer));
 
     } else if (file_.get().empty()) {
         LogProcessorWarn("Error: Please specify a file to write to");
@@ -128,6 +127,18 @@ void DataExport<DataType, PortType>::exportData() {
     }
 }
 
+template <typename DataType, typename PortType>
+void DataExport<DataType, PortType>::writeData(const DataType* data,
+                                               std::unique_ptr<DataWriterType<DataType>> writer) {
+    try {
+        writer->writeData(data, file_.get());
+        util::log(IVW_CONTEXT, "Data exported to disk: " + file_.get(), LogLevel::Info,
+                  LogAudience::User);
+    } catch (DataWriterException const& e) {
+        util::log(e.getContext(), e.getMessage(), LogLevel::Error, LogAudience::User);
+    }
+}
+
 template <typename DataType, typename PortType>
 void DataExport<DataType, PortType>::process() {
     if (exportQueued_) exportData();
@@ -38,15 +38,19 @@
 #include <inviwo/core/datastructures/image/layer.h>
 #include <inviwo/core/ports/imageport.h>
 #include <inviwo/core/network/processornetworkobserver.h>
+#include <inviwo/core/io/imageexportqueue.h>
 
 #include <modules/base/processors/dataexport.h>
 
+#include <memory>
+
 namespace inviwo {
 
 /** \docpage{org.inviwo.ImageExport, Image Export}
  * ![](org.inviwo.ImageExport.png?classIdentifier=org.inviwo.ImageExport)
  *
- * A procesor to save images to disk
+ * A procesor to save images to disk. The image is copied when exported and written in the
+ * background, the network can continue to evaluate while the image is encoded.
  *
  * ### Inports
  *   * __image__ The image to save.
@@ -76,10 +80,13 @@ protected:
     void sendResizeEvent();
 
     virtual const Layer* getData() override;
+    virtual void writeData(const Layer* data,
+                           std::unique_ptr<DataWriterType<Layer>> writer) override;
     virtual void onProcessorNetworkDidAddConnection(const PortConnection&) override;
     virtual void onProcessorNetworkDidRemoveConnection(const PortConnection&) override;
 
     size2_t prevSize_;
+    std::unique_ptr<ImageExportQueue> queue_;
 };
 
 }  // namespace inviwo
@@ -57,6 +57,13 @@ public:
     void process() override;
 
 protected:
+    /**
+     * The element to set as output, \p index is within the bounds of \p data. Override to, for
+     * example, load the element before it is passed on.
+     */
+    virtual std::shared_ptr<T> select(std::shared_ptr<const std::vector<std::shared_ptr<T>>> data,
+                                      size_t index);
+
     DataInport<std::vector<std::shared_ptr<T>>> inport_;
     OutportType outport_;
     SequenceTimerProperty timeStep_;
@@ -144,10 +151,16 @@ void VectorElementSelectorProcessor<T, OutportType>::process() {
         }
         size_t index = std::min(data->size() - 1, static_cast<size_t>(timeStep_.index_.get() - 1));
 
-        outport_.setData((*data)[index]);
+        outport_.setData(select(data, index));
     }
 }
 
+template <typename T, typename OutportType>
+std::shared_ptr<T> VectorElementSelectorProcessor<T, OutportType>::select(
+    std::shared_ptr<const std::vector<std::shared_ptr<T>>> data, size_t index) {
+    return (*data)[index];
+}
+
 }  // namespace inviwo
 
 #endif  // IVW_VECTORELEMENTSELECTORPROCESSOR_H
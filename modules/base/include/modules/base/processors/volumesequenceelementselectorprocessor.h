@@ -34,6 +34,9 @@
 #include <inviwo/core/common/inviwo.h>
 #include <inviwo/core/datastructures/volume/volume.h>
 #include <inviwo/core/ports/volumeport.h>
+#include <inviwo/core/properties/compositeproperty.h>
+#include <inviwo/core/properties/ordinalproperty.h>
+#include <inviwo/core/util/volumesequencecache.h>
 #include <modules/base/processors/vectorelementselectorprocessor.h>
 
 namespace inviwo {
@@ -50,6 +53,9 @@ namespace inviwo {
  *
  * ### Properties
  *   * __Step__ The volume sequence index to extract
+ *   * __Prefetch__ Number of time steps to load in the background in the playback direction
+ *   * __Memory Budget__ Max memory (MB) used by the time steps in RAM, 0 means unlimited. Time
+ *     steps that were read from disk are evicted when the budget is exceeded.
  */
 class IVW_MODULE_BASE_API VolumeSequenceElementSelectorProcessor
     : public VectorElementSelectorProcessor<Volume> {
@@ -59,6 +65,16 @@ public:
 
     virtual const ProcessorInfo getProcessorInfo() const override;
     static const ProcessorInfo processorInfo_;
+
+protected:
+    virtual std::shared_ptr<Volume> select(std::shared_ptr<const VolumeSequence> data,
+                                           size_t index) override;
+
+private:
+    CompositeProperty streaming_;
+    IntSizeTProperty prefetch_;
+    IntSizeTProperty memoryBudget_;
+    VolumeSequenceCache cache_;
 };
 
 }  // namespace inviwo
@@ -28,6 +28,9 @@
  *********************************************************************************/
 
 #include <modules/base/datastructures/imagereusecache.h>
+#include <inviwo/core/util/imagecache.h>
+
+#include <limits>
 
 namespace inviwo {
 
@@ -43,6 +46,40 @@ std::shared_ptr<Image> ImageReuseCache::getUnused() {
     }
 }
 
-void ImageReuseCache::add(std::shared_ptr<Image> image) { imageCache_.push_back(image); }
+void ImageReuseCache::add(std::shared_ptr<Image> image) {
+    imageCache_.push_back(image);
+    evict();
+}
+
+void ImageReuseCache::setMaxSizeInBytes(size_t bytes) {
+    maxSizeInBytes_ = bytes;
+    evict();
+}
+
+size_t ImageReuseCache::getMaxSizeInBytes() const {
+    return maxSizeInBytes_ ? *maxSizeInBytes_ : ImageCache::getDefaultMaxSizeInBytes();
+}
+
+size_t ImageReuseCache::getSizeInBytes() const {
+    size_t size = 0;
+    for (const auto& image : imageCache_) size += image->getSizeInBytes();
+    return size;
+}
+
+void ImageReuseCache::evict() {
+    const auto maxSizeInBytes = getMaxSizeInBytes();
+    if (maxSizeInBytes == std::numeric_limits<size_t>::max()) return;
+
+    auto size = getSizeInBytes();
+    // images are added at the back, drop the oldest unused ones first
+    for (auto it = imageCache_.begin(); it != imageCache_.end() && size > maxSizeInBytes;) {
+        if (it->use_count() == 1) {
+            size -= (*it)->getSizeInBytes();
+            it = imageCache_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
 
 }  // namespace inviwo
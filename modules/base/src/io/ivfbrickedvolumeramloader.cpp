@@ -0,0 +1,349 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/base/io/ivfbrickedvolumeramloader.h>
+
+#include <inviwo/core/datastructures/volume/volumeram.h>
+#include <inviwo/core/io/datareaderexception.h>
+#include <inviwo/core/io/datawriterexception.h>
+#include <inviwo/core/util/filesystem.h>
+#include <inviwo/core/util/foreach.h>
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <limits>
+
+namespace inviwo {
+
+namespace {
+
+constexpr std::array<char, 8> magic = {'I', 'V', 'F', 'B', 'R', 'I', 'C', 'K'};
+constexpr std::uint32_t version = 1;
+
+template <typename T>
+void put(std::ostream& out, T value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+T get(std::istream& in) {
+    T value{};
+    in.read(reinterpret_cast<char*>(&value), sizeof(T));
+    return value;
+}
+
+size3_t brickCount(size3_t dims, size3_t brickSize) {
+    return (dims + brickSize - size3_t{1}) / brickSize;
+}
+
+// Header: magic, version, element size, dimensions, brick size, and brick count
+constexpr size_t headerSize = 8 + 4 + 4 + 3 * 8 + 3 * 8 + 8;
+// Index entry: offset, compressed size, and checksum
+constexpr size_t entrySize = 8 + 8 + 4;
+
+/**
+ * The voxels of one brick, given by its first voxel and its extent, in the volume
+ */
+struct BrickRegion {
+    size3_t origin;
+    size3_t extent;
+};
+
+BrickRegion brickRegion(size_t index, size3_t dims, size3_t brickSize) {
+    const auto count = brickCount(dims, brickSize);
+    const size3_t pos{index % count.x, (index / count.x) % count.y, index / (count.x * count.y)};
+    const auto origin = pos * brickSize;
+    return {origin, glm::min(brickSize, dims - origin)};
+}
+
+// Copy the rows of the box [from, from + extent) between two x-fastest buffers
+void copyBox(const char* src, size3_t srcDims, size3_t srcPos, char* dst, size3_t dstDims,
+             size3_t dstPos, size3_t extent, size_t elemSize) {
+    const size_t rowBytes = extent.x * elemSize;
+    for (size_t z = 0; z < extent.z; ++z) {
+        for (size_t y = 0; y < extent.y; ++y) {
+            const auto from =
+                srcPos.x + (srcPos.y + y) * srcDims.x + (srcPos.z + z) * srcDims.x * srcDims.y;
+            const auto to =
+                dstPos.x + (dstPos.y + y) * dstDims.x + (dstPos.z + z) * dstDims.x * dstDims.y;
+            std::memcpy(dst + to * elemSize, src + from * elemSize, rowBytes);
+        }
+    }
+}
+
+}  // namespace
+
+IvfBrickedVolumeRAMLoader::IvfBrickedVolumeRAMLoader(std::string file, size3_t dimensions,
+                                                     size3_t brickSize,
+                                                     const DataFormatBase* format)
+    : file_{std::move(file)}
+    , dimensions_{dimensions}
+    , brickSize_{brickSize}
+    , elemSize_{format->getSize()}
+    , bricks_{} {
+
+    auto in = filesystem::ifstream(file_, std::ios::in | std::ios::binary);
+    if (!in) {
+        throw DataReaderException("Could not open brick file: " + file_, IVW_CONTEXT);
+    }
+
+    std::array<char, 8> fileMagic{};
+    in.read(fileMagic.data(), fileMagic.size());
+    const auto fileVersion = get<std::uint32_t>(in);
+    const auto fileElemSize = get<std::uint32_t>(in);
+    size3_t fileDims{0};
+    size3_t fileBrickSize{0};
+    for (size_t i = 0; i < 3; ++i) fileDims[i] = get<std::uint64_t>(in);
+    for (size_t i = 0; i < 3; ++i) fileBrickSize[i] = get<std::uint64_t>(in);
+    const auto count = get<std::uint64_t>(in);
+
+    if (!in || fileMagic != magic || fileVersion != version) {
+        throw DataReaderException("Not a valid brick file: " + file_, IVW_CONTEXT);
+    }
+    // Validate the brick size before using it to compute the brick count
+    if (glm::any(glm::equal(brickSize_, size3_t{0})) ||
+        glm::compMul(dvec3{brickSize_}) * elemSize_ > std::numeric_limits<uInt>::max()) {
+        throw DataReaderException("Invalid brick size in: " + file_, IVW_CONTEXT);
+    }
+    if (fileElemSize != elemSize_ || fileDims != dimensions_ || fileBrickSize != brickSize_ ||
+        count != glm::compMul(brickCount(dimensions_, brickSize_))) {
+        throw DataReaderException("Brick file does not match the ivf file: " + file_,
+                                  IVW_CONTEXT);
+    }
+
+    // Validate the index against the file size before allocating or reading anything from it
+    const auto indexEnd = in.tellg();
+    in.seekg(0, std::ios::end);
+    const auto fileSize = static_cast<std::uint64_t>(in.tellg());
+    in.seekg(indexEnd);
+    if (!in || count > (fileSize - headerSize) / entrySize) {
+        throw DataReaderException("Could not read the brick index of: " + file_, IVW_CONTEXT);
+    }
+    const auto dataStart = headerSize + count * entrySize;
+
+    bricks_.resize(count);
+    for (size_t index = 0; index < count; ++index) {
+        auto& brick = bricks_[index];
+        brick.offset = get<std::uint64_t>(in);
+        brick.size = get<std::uint64_t>(in);
+        brick.checksum = get<std::uint32_t>(in);
+
+        const auto region = brickRegion(index, dimensions_, brickSize_);
+        const auto bytes = glm::compMul(region.extent) * elemSize_;
+        if (brick.offset < dataStart || brick.offset > fileSize ||
+            brick.size > fileSize - brick.offset ||
+            brick.size > compressBound(static_cast<uLong>(bytes))) {
+            throw DataReaderException(
+                "Invalid offset or size of brick " + std::to_string(index) + " in: " + file_,
+                IVW_CONTEXT);
+        }
+    }
+    if (!in) {
+        throw DataReaderException("Could not read the brick index of: " + file_, IVW_CONTEXT);
+    }
+}
+
+IvfBrickedVolumeRAMLoader* IvfBrickedVolumeRAMLoader::clone() const {
+    return new IvfBrickedVolumeRAMLoader(*this);
+}
+
+std::shared_ptr<VolumeRepresentation> IvfBrickedVolumeRAMLoader::createRepresentation(
+    const VolumeRepresentation& src) const {
+    return readRegion(src, size3_t{0}, dimensions_);
+}
+
+void IvfBrickedVolumeRAMLoader::updateRepresentation(std::shared_ptr<VolumeRepresentation> dest,
+                                                     const VolumeRepresentation& src) const {
+    auto volumeDst = std::static_pointer_cast<VolumeRAM>(dest);
+    if (volumeDst->getDimensions() != dimensions_) {
+        volumeDst->setDimensions(dimensions_);
+    }
+    read(size3_t{0}, *volumeDst);
+
+    volumeDst->setSwizzleMask(src.getSwizzleMask());
+    volumeDst->setInterpolation(src.getInterpolation());
+    volumeDst->setWrapping(src.getWrapping());
+}
+
+std::shared_ptr<VolumeRAM> IvfBrickedVolumeRAMLoader::readRegion(const VolumeRepresentation& src,
+                                                                 size3_t offset,
+                                                                 size3_t dims) const {
+    auto volumeRAM = createVolumeRAM(dims, src.getDataFormat(), nullptr, src.getSwizzleMask(),
+                                     src.getInterpolation(), src.getWrapping());
+    read(offset, *volumeRAM);
+    return volumeRAM;
+}
+
+const std::vector<IvfBrickedVolumeRAMLoader::Brick>& IvfBrickedVolumeRAMLoader::getBricks() const {
+    return bricks_;
+}
+
+void IvfBrickedVolumeRAMLoader::read(size3_t offset, VolumeRAM& dest) const {
+    const auto dims = dest.getDimensions();
+    if (glm::any(glm::greaterThan(dims, dimensions_)) ||
+        glm::any(glm::greaterThan(offset, dimensions_ - dims))) {
+        throw DataReaderException("Region outside of the volume: " + file_, IVW_CONTEXT);
+    }
+    if (glm::compMul(dims) == 0) return;
+
+    // The bricks overlapping [offset, offset + dims)
+    const auto count = brickCount(dimensions_, brickSize_);
+    const auto first = offset / brickSize_;
+    const auto last = (offset + dims - size3_t{1}) / brickSize_;
+    std::vector<size_t> overlapping;
+    for (size_t z = first.z; z <= last.z; ++z) {
+        for (size_t y = first.y; y <= last.y; ++y) {
+            for (size_t x = first.x; x <= last.x; ++x) {
+                overlapping.push_back(x + y * count.x + z * count.x * count.y);
+            }
+        }
+    }
+
+    char* data = static_cast<char*>(dest.getData());
+    const size_t brickBytes = glm::compMul(brickSize_) * elemSize_;
+    const auto jobs = util::jobCount(overlapping.size(), brickBytes);
+    util::forEachRange(overlapping.size(), jobs, [&](size_t begin, size_t end, size_t) {
+        auto in = filesystem::ifstream(file_, std::ios::in | std::ios::binary);
+        if (!in) {
+            throw DataReaderException("Could not open brick file: " + file_, IVW_CONTEXT);
+        }
+        std::vector<char> compressed;
+        std::vector<char> voxels(brickBytes);
+        for (size_t i = begin; i < end; ++i) {
+            const auto index = overlapping[i];
+            const auto& brick = bricks_[index];
+            const auto region = brickRegion(index, dimensions_, brickSize_);
+
+            compressed.resize(brick.size);
+            in.seekg(static_cast<std::streamoff>(brick.offset));
+            in.read(compressed.data(), compressed.size());
+
+            const auto bytes = glm::compMul(region.extent) * elemSize_;
+            auto size = static_cast<uLongf>(bytes);
+            if (!in ||
+                uncompress(reinterpret_cast<Bytef*>(voxels.data()), &size,
+                           reinterpret_cast<const Bytef*>(compressed.data()),
+                           static_cast<uLong>(compressed.size())) != Z_OK ||
+                size != bytes) {
+                throw DataReaderException(
+                    "Could not read brick " + std::to_string(index) + " of: " + file_,
+                    IVW_CONTEXT);
+            }
+            if (crc32(0L, reinterpret_cast<const Bytef*>(voxels.data()),
+                      static_cast<uInt>(bytes)) != brick.checksum) {
+                throw DataReaderException(
+                    "Checksum mismatch in brick " + std::to_string(index) + " of: " + file_,
+                    IVW_CONTEXT);
+            }
+
+            // The part of the brick inside the region
+            const auto lower = glm::max(region.origin, offset);
+            const auto upper = glm::min(region.origin + region.extent, offset + dims);
+            copyBox(voxels.data(), region.extent, lower - region.origin, data, dims,
+                    lower - offset, upper - lower, elemSize_);
+        }
+    });
+}
+
+namespace util {
+
+void writeIvfBricks(const VolumeRAM& volume, const std::string& file, size3_t brickSize,
+                    int level) {
+    const auto dims = volume.getDimensions();
+    const auto elemSize = volume.getDataFormat()->getSize();
+    const size_t brickBytes = glm::compMul(brickSize) * elemSize;
+    if (glm::compMul(brickSize) == 0 || brickBytes > std::numeric_limits<uInt>::max()) {
+        throw DataWriterException("Invalid brick size",
+                                  IVW_CONTEXT_CUSTOM("util::writeIvfBricks"));
+    }
+
+    const auto count = glm::compMul(brickCount(dims, brickSize));
+    const char* data = static_cast<const char*>(volume.getData());
+
+    std::vector<std::vector<char>> compressed(count);
+    std::vector<std::uint32_t> checksums(count);
+    forEachRange(count, jobCount(count, brickBytes), [&](size_t begin, size_t end, size_t) {
+        std::vector<char> voxels(brickBytes);
+        for (size_t index = begin; index < end; ++index) {
+            const auto region = brickRegion(index, dims, brickSize);
+            const auto bytes = glm::compMul(region.extent) * elemSize;
+            copyBox(data, dims, region.origin, voxels.data(), region.extent, size3_t{0},
+                    region.extent, elemSize);
+
+            auto& dst = compressed[index];
+            auto size = compressBound(static_cast<uLong>(bytes));
+            dst.resize(size);
+            if (compress2(reinterpret_cast<Bytef*>(dst.data()), &size,
+                          reinterpret_cast<const Bytef*>(voxels.data()),
+                          static_cast<uLong>(bytes), level) != Z_OK) {
+                throw DataWriterException("Could not compress brick " + std::to_string(index),
+                                          IVW_CONTEXT_CUSTOM("util::writeIvfBricks"));
+            }
+            dst.resize(size);
+            checksums[index] = static_cast<std::uint32_t>(
+                crc32(0L, reinterpret_cast<const Bytef*>(voxels.data()), static_cast<uInt>(bytes)));
+        }
+    });
+
+    auto out = filesystem::ofstream(file, std::ios::out | std::ios::binary);
+    if (!out) {
+        throw DataWriterException("Could not write to brick file: " + file,
+                                  IVW_CONTEXT_CUSTOM("util::writeIvfBricks"));
+    }
+
+    out.write(magic.data(), magic.size());
+    put<std::uint32_t>(out, version);
+    put<std::uint32_t>(out, static_cast<std::uint32_t>(elemSize));
+    for (size_t i = 0; i < 3; ++i) put<std::uint64_t>(out, dims[i]);
+    for (size_t i = 0; i < 3; ++i) put<std::uint64_t>(out, brickSize[i]);
+    put<std::uint64_t>(out, count);
+
+    std::uint64_t offset = headerSize + count * entrySize;
+    for (size_t index = 0; index < count; ++index) {
+        put<std::uint64_t>(out, offset);
+        put<std::uint64_t>(out, compressed[index].size());
+        put<std::uint32_t>(out, checksums[index]);
+        offset += compressed[index].size();
+    }
+    for (const auto& brick : compressed) {
+        out.write(brick.data(), brick.size());
+    }
+    if (!out) {
+        throw DataWriterException("Could not write to brick file: " + file,
+                                  IVW_CONTEXT_CUSTOM("util::writeIvfBricks"));
+    }
+}
+
+}  // namespace util
+
+}  // namespace inviwo
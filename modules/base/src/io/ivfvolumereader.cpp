@@ -28,6 +28,7 @@
  *********************************************************************************/
 
 #include <modules/base/io/ivfvolumereader.h>
+#include <modules/base/io/ivfbrickedvolumeramloader.h>
 #include <inviwo/core/datastructures/volume/volumeramprecision.h>
 #include <inviwo/core/datastructures/volume/volumedisk.h>
 #include <inviwo/core/util/filesystem.h>
@@ -75,6 +76,11 @@ std::shared_ptr<Volume> IvfVolumeReader::readData(const std::string& filePath) {
     d.deserialize("Interpolation", interpolation);
     d.deserialize("Wrapping", wrapping);
 
+    std::string compression;
+    size3_t brickSize{0u};
+    d.deserialize("Compression", compression);
+    d.deserialize("BrickSize", brickSize);
+
     auto volume =
         std::make_shared<Volume>(dimensions, format, swizzleMask, interpolation, wrapping);
     mat4 basisAndOffset = volume->getModelMatrix();
@@ -93,8 +99,17 @@ std::shared_ptr<Volume> IvfVolumeReader::readData(const std::string& filePath) {
     auto vd = std::make_shared<VolumeDisk>(filePath, dimensions, format, swizzleMask, interpolation,
                                            wrapping);
 
-    auto loader = std::make_unique<RawVolumeRAMLoader>(rawFile, byteOffset, littleEndian);
-    vd->setLoader(loader.release());
+    if (compression.empty()) {
+        auto loader = std::make_unique<RawVolumeRAMLoader>(rawFile, byteOffset, littleEndian);
+        vd->setLoader(loader.release());
+    } else if (compression == "zlib") {
+        auto loader =
+            std::make_unique<IvfBrickedVolumeRAMLoader>(rawFile, dimensions, brickSize, format);
+        vd->setLoader(loader.release());
+    } else {
+        throw DataReaderException("Unsupported compression '" + compression + "' in " + filePath,
+                                  IVW_CONTEXT);
+    }
 
     volume->addRepresentation(vd);
     return volume;
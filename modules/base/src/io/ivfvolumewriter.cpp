@@ -28,13 +28,17 @@
  *********************************************************************************/
 
 #include <modules/base/io/ivfvolumewriter.h>
+#include <modules/base/io/ivfbrickedvolumeramloader.h>
 #include <inviwo/core/util/filesystem.h>
 #include <inviwo/core/datastructures/volume/volumeram.h>
 #include <inviwo/core/io/datawriterexception.h>
 
+#include <optional>
+
 namespace inviwo {
 
-IvfVolumeWriter::IvfVolumeWriter() : DataWriterType<Volume>() {
+IvfVolumeWriter::IvfVolumeWriter(Compression compression)
+    : DataWriterType<Volume>(), compression_{compression} {
     addExtension(FileExtension("ivf", "Inviwo ivf file format"));
 }
 
@@ -45,12 +49,27 @@ IvfVolumeWriter& IvfVolumeWriter::operator=(const IvfVolumeWriter& that) = defau
 IvfVolumeWriter* IvfVolumeWriter::clone() const { return new IvfVolumeWriter(*this); }
 
 void IvfVolumeWriter::writeData(const Volume* volume, const std::string filePath) const {
-    util::writeIvfVolume(*volume, filePath, getOverwrite());
+    if (compression_ == Compression::Zlib) {
+        util::writeCompressedIvfVolume(*volume, filePath, getOverwrite());
+    } else {
+        util::writeIvfVolume(*volume, filePath, getOverwrite());
+    }
 }
 
-namespace util {
-void writeIvfVolume(const Volume& data, const std::string filePath, bool overwrite) {
-    std::string rawPath = filesystem::replaceFileExtension(filePath, "raw");
+void IvfVolumeWriter::setCompression(Compression compression) { compression_ = compression; }
+
+IvfVolumeWriter::Compression IvfVolumeWriter::getCompression() const { return compression_; }
+
+namespace {
+struct Bricks {
+    size3_t brickSize;
+    int level;
+};
+
+void writeIvf(const Volume& data, const std::string& filePath, bool overwrite,
+              std::optional<Bricks> bricks) {
+    const std::string rawExtension = bricks ? "bricks" : "raw";
+    std::string rawPath = filesystem::replaceFileExtension(filePath, rawExtension);
 
     if (filesystem::fileExists(filePath) && !overwrite)
         throw DataWriterException("Output file: " + filePath + " already exists",
@@ -63,7 +82,7 @@ void writeIvfVolume(const Volume& data, const std::string filePath, bool overwri
     const std::string fileName = filesystem::getFileNameWithoutExtension(filePath);
     const VolumeRAM* vr = data.getRepresentation<VolumeRAM>();
     Serializer s(filePath);
-    s.serialize("RawFile", fileName + ".raw");
+    s.serialize("RawFile", fileName + "." + rawExtension);
     s.serialize("Format", vr->getDataFormatString());
     s.serialize("ByteOffset", 0u);
     s.serialize("BasisAndOffset", data.getModelMatrix());
@@ -76,11 +95,17 @@ void writeIvfVolume(const Volume& data, const std::string filePath, bool overwri
     s.serialize("SwizzleMask", vr->getSwizzleMask());
     s.serialize("Interpolation", vr->getInterpolation());
     s.serialize("Wrapping", vr->getWrapping());
+    if (bricks) {
+        s.serialize("Compression", std::string{"zlib"});
+        s.serialize("BrickSize", bricks->brickSize);
+    }
 
     data.getMetaDataMap()->serialize(s);
     s.writeFile();
 
-    if (auto fout = filesystem::ofstream(rawPath, std::ios::out | std::ios::binary)) {
+    if (bricks) {
+        util::writeIvfBricks(*vr, rawPath, bricks->brickSize, bricks->level);
+    } else if (auto fout = filesystem::ofstream(rawPath, std::ios::out | std::ios::binary)) {
         fout.write(static_cast<const char*>(vr->getData()),
                    glm::compMul(vr->getDimensions()) * vr->getDataFormat()->getSize());
     } else {
@@ -88,6 +113,17 @@ void writeIvfVolume(const Volume& data, const std::string filePath, bool overwri
                                   IVW_CONTEXT_CUSTOM("util::writeIvfVolume"));
     }
 }
+}  // namespace
+
+namespace util {
+void writeIvfVolume(const Volume& data, const std::string filePath, bool overwrite) {
+    writeIvf(data, filePath, overwrite, std::nullopt);
+}
+
+void writeCompressedIvfVolume(const Volume& data, const std::string filePath, bool overwrite,
+                              size3_t brickSize, int level) {
+    writeIvf(data, filePath, overwrite, Bricks{brickSize, level});
+}
 }  // namespace util
 
 }  // namespace inviwo
@@ -89,6 +89,15 @@ const Layer* ImageExport::getData() {
     return nullptr;
 }
 
+void ImageExport::writeData(const Layer* data, std::unique_ptr<DataWriterType<Layer>> writer) {
+    if (!queue_) queue_ = std::make_unique<ImageExportQueue>(1, 4);
+    queue_->enqueue(*data, file_.get(), std::move(writer),
+                    [context = IVW_CONTEXT](const std::string& path) {
+                        util::log(context, "Data exported to disk: " + path, LogLevel::Info,
+                                  LogAudience::User);
+                    });
+}
+
 void ImageExport::onProcessorNetworkDidAddConnection(const PortConnection& con) {
     const auto successors = util::getSuccessors(con.getInport()->getProcessor());
     if (util::contains(successors, this)) {
@@ -32,6 +32,7 @@
 #include <inviwo/core/datastructures/volume/volumeram.h>
 #include <inviwo/core/datastructures/volume/volumeramprecision.h>
 #include <inviwo/core/datastructures/datamapper.h>
+#include <inviwo/core/util/dataconversion.h>
 
 #include <inviwo/core/util/formats.h>
 #include <inviwo/core/util/foreacharg.h>
@@ -47,54 +48,33 @@ struct Helper {
     }
 };
 
-#include <warn/push>
-#include <warn/ignore/conversion>
-
-struct CopyVol {
-    template <typename Result, typename Format>
-    Result operator()(std::shared_ptr<const Volume> src, bool mapData, dvec2 dstRange) {
-        return src->getRepresentation<VolumeRAM>()->dispatch<std::shared_ptr<Volume>>(
-            [&](auto vrprecision, bool mapData, dvec2 dstRange) {
-                using ValueType = util::PrecisionValueType<decltype(vrprecision)>;
-                const auto dims = vrprecision->getDimensions();
-                const ValueType* srcData = vrprecision->getDataTyped();
-                using T = typename util::same_extent<ValueType, typename Format::type>::type;
-                using Tdouble = typename util::same_extent<ValueType, double>::type;
-
-                auto dstVol = std::make_shared<VolumeRAMPrecision<T>>(
-                    dims, src->getSwizzleMask(), src->getInterpolation(), src->getWrapping());
-                T* dstData = dstVol->getDataTyped();
-
-                if (mapData) {
-                    const dvec2 srcRange{
-                        (src->getDataFormat()->getNumericType() != NumericType::Float)
-                            ? src->dataMap_.dataRange
-                            : dvec2{0.0, 1.0}};
-                    std::transform(srcData, srcData + glm::compMul(dims), dstData,
-                                   [srcRange, dstRange](auto& v) {
-                                       const auto result = (static_cast<Tdouble>(v) - srcRange.x) /
-                                                               (srcRange.y - srcRange.x) *
-                                                               (dstRange.y - dstRange.x) +
-                                                           dstRange.x;
-                                       return static_cast<T>(result);
-                                   });
-                } else {
-                    std::transform(srcData, srcData + glm::compMul(dims), dstData,
-                                   [](auto& v) { return static_cast<T>(v); });
-                }
-
-                auto vol = std::make_shared<Volume>(dstVol);
-                vol->setBasis(src->getBasis());
-                vol->setOffset(src->getOffset());
-                vol->copyMetaDataFrom(*src.get());
-
-                return vol;
-            },
-            mapData, dstRange);
+std::shared_ptr<Volume> convertVolume(const Volume& src, const DataFormatBase* format,
+                                      bool mapData, dvec2 dstRange) {
+    const auto srcRAM = src.getRepresentation<VolumeRAM>();
+    const auto dims = srcRAM->getDimensions();
+    // keep the number of components of the source
+    const auto dstFormat = DataFormatBase::get(
+        format->getNumericType(), src.getDataFormat()->getComponents(), format->getPrecision());
+    auto dstRAM = createVolumeRAM(dims, dstFormat, nullptr, src.getSwizzleMask(),
+                                  src.getInterpolation(), src.getWrapping());
+
+    std::optional<util::LinearMapping> mapping;
+    if (mapData) {
+        const dvec2 srcRange{(src.getDataFormat()->getNumericType() != NumericType::Float)
+                                 ? src.dataMap_.dataRange
+                                 : dvec2{0.0, 1.0}};
+        mapping = util::LinearMapping{srcRange, dstRange};
     }
-};
+    util::convertData(src.getDataFormat(), srcRAM->getData(), dstFormat, dstRAM->getData(),
+                      glm::compMul(dims), mapping);
+
+    auto vol = std::make_shared<Volume>(dstRAM);
+    vol->setBasis(src.getBasis());
+    vol->setOffset(src.getOffset());
+    vol->copyMetaDataFrom(src);
 
-#include <warn/pop>
+    return vol;
+}
 
 }  // namespace detail
 
@@ -194,9 +174,8 @@ void VolumeConverter::process() {
         if (inport_.getData()->getDataFormat()->getId() == format_.get()) {
             return std::shared_ptr<Volume>(inport_.getData()->clone());
         } else {
-            return dispatching::dispatch<std::shared_ptr<Volume>, dispatching::filter::Scalars>(
-                format_.get(), detail::CopyVol{}, inport_.getData(), enableDataMapping_,
-                dstRange.first);
+            return detail::convertVolume(*inport_.getData(), DataFormatBase::get(format_.get()),
+                                         enableDataMapping_, dstRange.first);
         }
     }();
     volume->dataMap_.dataRange = dstRange.first;
@@ -42,9 +42,26 @@ const ProcessorInfo VolumeSequenceElementSelectorProcessor::getProcessorInfo() c
     return processorInfo_;
 }
 VolumeSequenceElementSelectorProcessor::VolumeSequenceElementSelectorProcessor()
-    : VectorElementSelectorProcessor<Volume>() {
+    : VectorElementSelectorProcessor<Volume>()
+    , streaming_("streaming", "Streaming")
+    , prefetch_("prefetch", "Prefetch", 2, 0, 32, 1, InvalidationLevel::Valid)
+    , memoryBudget_("memoryBudget", "Memory Budget (MB)", 0, 0, 1024 * 1024, 1,
+                    InvalidationLevel::Valid)
+    , cache_{} {
     timeStep_.index_.autoLinkToProperty<VolumeSequenceElementSelectorProcessor>(
         "timeStep.selectedSequenceIndex");
+
+    streaming_.addProperties(prefetch_, memoryBudget_);
+    streaming_.setCollapsed(true);
+    addProperty(streaming_);
+}
+
+std::shared_ptr<Volume> VolumeSequenceElementSelectorProcessor::select(
+    std::shared_ptr<const VolumeSequence> data, size_t index) {
+    cache_.setSequence(data);
+    cache_.setPrefetchCount(prefetch_.get());
+    cache_.setBudget(memoryBudget_.get() * 1024 * 1024);
+    return cache_.get(index);
 }
 
 }  // namespace inviwo
@@ -0,0 +1,103 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/base/datastructures/imagereusecache.h>
+#include <inviwo/core/util/imagecache.h>
+
+#include <limits>
+
+namespace inviwo {
+
+namespace {
+const size2_t dims{4, 4};
+constexpr size_t imageBytes = 16 * 4;
+}  // namespace
+
+TEST(ImageReuseCacheTests, DropsOldestUnusedImages) {
+    ImageReuseCache cache;
+    cache.setMaxSizeInBytes(2 * imageBytes);
+
+    auto first = std::make_shared<Image>(dims, DataVec4UInt8::get());
+    auto second = std::make_shared<Image>(dims, DataVec4UInt8::get());
+    auto third = std::make_shared<Image>(dims, DataVec4UInt8::get());
+    std::weak_ptr<Image> secondRef = second;
+
+    // The first image is still in use and is kept, the oldest unused one is dropped instead
+    cache.add(first);
+    cache.add(second);
+    second.reset();
+    cache.add(third);
+    third.reset();
+    EXPECT_TRUE(secondRef.expired());
+    EXPECT_EQ(2 * imageBytes, cache.getSizeInBytes());
+
+    // Once the first image is unused it is the oldest one, and handed out for reuse first
+    const auto firstPtr = first.get();
+    first.reset();
+    EXPECT_EQ(firstPtr, cache.getUnused().get());
+    EXPECT_EQ(imageBytes, cache.getSizeInBytes());
+}
+
+TEST(ImageReuseCacheTests, KeepsImagesInUseOverLimit) {
+    ImageReuseCache cache;
+    cache.setMaxSizeInBytes(imageBytes);
+
+    auto first = std::make_shared<Image>(dims, DataVec4UInt8::get());
+    auto second = std::make_shared<Image>(dims, DataVec4UInt8::get());
+    cache.add(first);
+    cache.add(second);
+    EXPECT_EQ(2 * imageBytes, cache.getSizeInBytes());
+    EXPECT_EQ(nullptr, cache.getUnused());
+
+    // Lowering the limit drops the images that are no longer used
+    first.reset();
+    second.reset();
+    cache.setMaxSizeInBytes(0);
+    EXPECT_EQ(size_t{0}, cache.getSizeInBytes());
+}
+
+TEST(ImageReuseCacheTests, UsesDefaultLimit) {
+    const auto oldDefault = ImageCache::getDefaultMaxSizeInBytes();
+    ImageCache::setDefaultMaxSizeInBytes(imageBytes);
+
+    ImageReuseCache cache;
+    EXPECT_EQ(imageBytes, cache.getMaxSizeInBytes());
+    cache.add(std::make_shared<Image>(dims, DataVec4UInt8::get()));
+    cache.add(std::make_shared<Image>(dims, DataVec4UInt8::get()));
+    EXPECT_EQ(imageBytes, cache.getSizeInBytes());
+
+    ImageCache::setDefaultMaxSizeInBytes(oldDefault);
+}
+
+}  // namespace inviwo
@@ -0,0 +1,191 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/base/io/ivfbrickedvolumeramloader.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/io/datareaderexception.h>
+#include <inviwo/core/io/tempfilehandle.h>
+
+#include <cstdint>
+#include <fstream>
+#include <numeric>
+
+namespace inviwo {
+
+namespace {
+
+const size3_t dims{37, 21, 10};
+const size3_t brickSize{16, 8, 4};
+
+std::shared_ptr<VolumeRAMPrecision<std::uint16_t>> makeVolume() {
+    auto ram = std::make_shared<VolumeRAMPrecision<std::uint16_t>>(dims);
+    auto data = ram->getDataTyped();
+    std::iota(data, data + glm::compMul(dims), std::uint16_t{0});
+    return ram;
+}
+
+void expectRegion(const VolumeRAMPrecision<std::uint16_t>& expected, size3_t offset,
+                  const VolumeRAM& region) {
+    ASSERT_EQ(region.getDataFormat(), DataUInt16::get());
+    const auto regionDims = region.getDimensions();
+    const auto src = expected.getDataTyped();
+    const auto dst = static_cast<const std::uint16_t*>(region.getData());
+    for (size_t z = 0; z < regionDims.z; ++z) {
+        for (size_t y = 0; y < regionDims.y; ++y) {
+            for (size_t x = 0; x < regionDims.x; ++x) {
+                const auto pos = offset + size3_t{x, y, z};
+                ASSERT_EQ(dst[x + y * regionDims.x + z * regionDims.x * regionDims.y],
+                          src[pos.x + pos.y * dims.x + pos.z * dims.x * dims.y])
+                    << "at " << x << ", " << y << ", " << z;
+            }
+        }
+    }
+}
+
+}  // namespace
+
+TEST(IvfBricks, RoundTrip) {
+    util::TempFileHandle tmpFile("ivfbricks", ".bricks");
+    const auto& file = tmpFile.getFileName();
+    auto ram = makeVolume();
+    util::writeIvfBricks(*ram, file, brickSize);
+
+    IvfBrickedVolumeRAMLoader loader(file, dims, brickSize, DataUInt16::get());
+    EXPECT_EQ(loader.getBricks().size(), 3 * 3 * 3);
+
+    auto result = std::dynamic_pointer_cast<VolumeRAM>(loader.createRepresentation(*ram));
+    ASSERT_TRUE(result);
+    EXPECT_EQ(result->getDimensions(), dims);
+    expectRegion(*ram, size3_t{0}, *result);
+}
+
+TEST(IvfBricks, RegionCoveringPartialBricks) {
+    util::TempFileHandle tmpFile("ivfbricks", ".bricks");
+    const auto& file = tmpFile.getFileName();
+    auto ram = makeVolume();
+    util::writeIvfBricks(*ram, file, brickSize);
+
+    IvfBrickedVolumeRAMLoader loader(file, dims, brickSize, DataUInt16::get());
+
+    // Starts inside the first bricks and ends in the cropped bricks at the upper borders
+    const size3_t offset{5, 3, 2};
+    const size3_t regionDims{dims - offset};
+    auto region = loader.readRegion(*ram, offset, regionDims);
+    ASSERT_TRUE(region);
+    EXPECT_EQ(region->getDimensions(), regionDims);
+    expectRegion(*ram, offset, *region);
+
+    // Inside a single brick
+    auto inner = loader.readRegion(*ram, size3_t{17, 9, 5}, size3_t{2, 3, 1});
+    expectRegion(*ram, size3_t{17, 9, 5}, *inner);
+}
+
+TEST(IvfBricks, ChecksumMismatch) {
+    util::TempFileHandle tmpFile("ivfbricks", ".bricks");
+    const auto& file = tmpFile.getFileName();
+    auto ram = makeVolume();
+    util::writeIvfBricks(*ram, file, brickSize);
+
+    {
+        // Flip a bit in the checksum of the first brick, which follows the header (72 bytes),
+        // and the offset and size of the first index entry (16 bytes)
+        std::fstream f(file, std::ios::in | std::ios::out | std::ios::binary);
+        f.seekg(72 + 16);
+        char c{};
+        f.read(&c, 1);
+        c ^= 1;
+        f.seekp(72 + 16);
+        f.write(&c, 1);
+    }
+
+    IvfBrickedVolumeRAMLoader loader(file, dims, brickSize, DataUInt16::get());
+    EXPECT_THROW(loader.createRepresentation(*ram), DataReaderException);
+    // Regions that do not touch the first brick are still readable
+    auto region = loader.readRegion(*ram, size3_t{16, 8, 4}, size3_t{4});
+    expectRegion(*ram, size3_t{16, 8, 4}, *region);
+}
+
+TEST(IvfBricks, RejectsZeroBrickSize) {
+    util::TempFileHandle tmpFile("ivfbricks", ".bricks");
+    const auto& file = tmpFile.getFileName();
+    auto ram = makeVolume();
+    util::writeIvfBricks(*ram, file, brickSize);
+
+    {
+        // Zero the x component of the brick size in the header, which follows the magic (8
+        // bytes), the version and element size (4 + 4 bytes), and the dimensions (3 * 8 bytes)
+        std::fstream f(file, std::ios::in | std::ios::out | std::ios::binary);
+        f.seekp(40);
+        const std::uint64_t zero = 0;
+        f.write(reinterpret_cast<const char*>(&zero), sizeof(zero));
+    }
+
+    EXPECT_THROW(IvfBrickedVolumeRAMLoader(file, dims, size3_t{0, 8, 4}, DataUInt16::get()),
+                 DataReaderException);
+}
+
+TEST(IvfBricks, RejectsRegionOutsideVolume) {
+    util::TempFileHandle tmpFile("ivfbricks", ".bricks");
+    const auto& file = tmpFile.getFileName();
+    auto ram = makeVolume();
+    util::writeIvfBricks(*ram, file, brickSize);
+
+    IvfBrickedVolumeRAMLoader loader(file, dims, brickSize, DataUInt16::get());
+    EXPECT_THROW(loader.readRegion(*ram, size3_t{30, 0, 0}, size3_t{8, 1, 1}),
+                 DataReaderException);
+    EXPECT_THROW(loader.readRegion(*ram, size3_t{0}, dims + size3_t{0, 0, 1}),
+                 DataReaderException);
+    EXPECT_THROW(loader.readRegion(*ram, size3_t{0, 0, 11}, size3_t{0}), DataReaderException);
+}
+
+TEST(IvfBricks, RejectsBrickOutsideFile) {
+    util::TempFileHandle tmpFile("ivfbricks", ".bricks");
+    const auto& file = tmpFile.getFileName();
+    auto ram = makeVolume();
+    util::writeIvfBricks(*ram, file, brickSize);
+
+    {
+        // Make the compressed size of the first brick, which follows the header (72 bytes) and
+        // the offset of the first index entry (8 bytes), run past the end of the file
+        std::fstream f(file, std::ios::in | std::ios::out | std::ios::binary);
+        f.seekp(72 + 8);
+        const std::uint64_t size = std::uint64_t{1} << 40;
+        f.write(reinterpret_cast<const char*>(&size), sizeof(size));
+    }
+
+    EXPECT_THROW(IvfBrickedVolumeRAMLoader(file, dims, brickSize, DataUInt16::get()),
+                 DataReaderException);
+}
+
+}  // namespace inviwo
@@ -4,3 +4,5 @@
 set(dependencies
 )
 set(EnableByDefault ON)
+
+set(concurrent ON)
@@ -108,6 +108,21 @@ void* loadTIFFLayerData(void* dst, const std::string& filePath, TIFFHeader heade
  */
 void* loadTIFFVolumeData(void* dst, const std::string& filePath, TIFFHeader header);
 
+/**
+ * Load the voxels in [offset, offset + dims) of a TIFF stack into \p dst, which has to hold
+ * glm::compMul(dims) voxels of \p header.format. Only the pages in the z range are read, and they
+ * are decoded directly into \p dst with libtiff, in parallel on the thread pool. Pages that need
+ * conversion, i.e. palette, YCbCr, CMYK, JPEG compressed, or sub-byte pages, are decoded with
+ * CImg as in loadTIFFVolumeData. Like loadTIFFVolumeData the rows are flipped, such that y points
+ * up.
+ * @throws DataReaderException if the region is outside of the stack or a page can not be read
+ * \see TIFFStackVolumeRAMLoader
+ * \see getTIFFHeader
+ */
+IVW_MODULE_CIMG_API void loadTIFFVolumeRegion(void* dst, const std::string& filePath,
+                                              const TIFFHeader& header, size3_t offset,
+                                              size3_t dims);
+
 /**
  * \brief Rescales Layer of given image data
  *
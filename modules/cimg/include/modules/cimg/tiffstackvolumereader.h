@@ -57,8 +57,11 @@ public:
     virtual std::shared_ptr<Volume> readData(const std::string& filePath) override;
 };
 
-class IVW_MODULE_CIMG_API TIFFStackVolumeRAMLoader
-    : public DiskRepresentationLoader<VolumeRepresentation> {
+/**
+ * \brief Loads the pages of a TIFF stack into a VolumeRAM, see cimgutil::loadTIFFVolumeRegion.
+ * readRegion only decodes the pages within the requested z range.
+ */
+class IVW_MODULE_CIMG_API TIFFStackVolumeRAMLoader : public VolumeRegionLoader {
 public:
     TIFFStackVolumeRAMLoader(const std::string& sourceFile);
     virtual TIFFStackVolumeRAMLoader* clone() const override;
@@ -68,8 +71,12 @@ public:
         const VolumeRepresentation& src) const override;
     virtual void updateRepresentation(std::shared_ptr<VolumeRepresentation> dest,
                                       const VolumeRepresentation& src) const override;
+    virtual std::shared_ptr<VolumeRAM> readRegion(const VolumeRepresentation& src, size3_t offset,
+                                                  size3_t dims) const override;
 
 private:
+    std::string getFile() const;
+
     std::string sourceFile_;
 };
 
@@ -31,10 +31,13 @@
 #include <modules/cimg/cimgsavebuffer.h>
 #include <inviwo/core/datastructures/image/layerramprecision.h>
 #include <inviwo/core/util/filesystem.h>
+#include <inviwo/core/util/foreach.h>
 #include <inviwo/core/util/raiiutils.h>
+#include <inviwo/core/util/imageresample.h>
 #include <inviwo/core/io/datawriterexception.h>
 #include <inviwo/core/io/datareaderexception.h>
 #include <algorithm>
+#include <cstring>
 #include <limits>
 
 #include <inviwo/core/util/glm.h>
@@ -436,6 +439,44 @@ struct CImgLoadVolumeDispatcher {
     }
 };
 
+// Decodes a whole TIFF stack with CImg and copies the voxels in [offset, offset + dims) to dst
+struct CImgLoadVolumeRegionDispatcher {
+    using type = void;
+    template <typename Result, typename DF>
+    void operator()(void* dst, const std::string& filePath, size3_t stackDims, size3_t offset,
+                    size3_t dims) {
+        using T = typename DF::primitive;
+        cimg_library::CImg<T> img;
+        try {
+            img.load(filePath.c_str());
+        } catch (cimg_library::CImgIOException& e) {
+            throw DataReaderException(std::string(e.what()), IVW_CONTEXT);
+        }
+        if (size3_t(img.width(), img.height(), img.depth()) != stackDims ||
+            static_cast<size_t>(img.spectrum()) != DF::components()) {
+            throw DataReaderException("Unsupported TIFF layout in: " + filePath, IVW_CONTEXT);
+        }
+
+        // Image is up-side-down
+        img.mirror("y");
+        if (img.spectrum() > 1) {
+            img.permute_axes("cxyz");
+        }
+
+        const size_t channels = DF::components();
+        const auto src = img.data();
+        auto data = static_cast<T*>(dst);
+        for (size_t z = 0; z < dims.z; ++z) {
+            for (size_t y = 0; y < dims.y; ++y) {
+                const auto from =
+                    offset.x + (offset.y + y + (offset.z + z) * stackDims.y) * stackDims.x;
+                std::copy_n(src + from * channels, dims.x * channels,
+                            data + (y + z * dims.y) * dims.x * channels);
+            }
+        }
+    }
+};
+
 ////////////////////// CImgUtils ///////////////////////////////////////////////////
 
 void* loadLayerData(void* dst, const std::string& filePath, uvec2& dimensions,
@@ -511,72 +552,13 @@ void* rescaleLayerRAM(const LayerRAM* srcLayerRam, uvec2 dst_dim) {
         srcLayerRam->getDataFormat()->getId(), disp, srcLayerRam, dst_dim);
 }
 
-struct CImgRescaleLayerRamToLayerRamDispatcher {
-    using type = bool;
-    template <typename Result, typename T>
-    bool operator()(const LayerRAM* source, LayerRAM* target) {
-        using E = typename T::type;       // elem type i.e. vec3
-        using P = typename T::primitive;  // comp type i.e float
-        const size_t rank = util::rank<E>::value;
-
-        const uvec2 sourceDim = source->getDimensions();
-        const uvec2 targetDim = target->getDimensions();
-
-        const double sourceAspect =
-            static_cast<double>(sourceDim.x) / static_cast<double>(sourceDim.y);
-        const double targetAspect =
-            static_cast<double>(targetDim.x) / static_cast<double>(targetDim.y);
-
-        const uvec2 resizeDim{
-            sourceAspect > targetAspect ? targetDim.x : targetDim.y * sourceAspect,
-            sourceAspect > targetAspect ? targetDim.x / sourceAspect : targetDim.y};
-
-        auto srcData = static_cast<const P*>(source->getData());
-        P* dstData = static_cast<P*>(target->getData());
-
-        if (rank == 0) {
-            cimg_library::CImg<P> src(srcData, sourceDim.x, sourceDim.y, 1, 1, true);
-            auto resized = src.get_resize(resizeDim.x, resizeDim.y, -100, -100,
-                                          static_cast<int>(InterpolationType::Linear));
-
-            cimg_library::CImg<P> dst(dstData, targetDim.x, targetDim.y, 1, 1, true);
-            dst.fill(P{0});
-            dst.draw_image(targetDim.x / 2 - resizeDim.x / 2, targetDim.y / 2 - resizeDim.y / 2,
-                           resized);
-        } else {
-            // Inviwo store pixels interleaved (RGBRGBRGB),
-            // CImg stores pixels in a planar format (RRRRGGGGBBBB).
-            // Permute from interleaved to planar format,
-            // we need to specify yzcx as input instead of cxyz
-
-            size_t comp = util::extent<E>::value;
-
-            cimg_library::CImg<P> src(srcData, comp, sourceDim.x, sourceDim.y, 1, true);
-            auto temp = src.get_permute_axes("yzcx");  // put first index last
-
-            temp.resize(resizeDim.x, resizeDim.y, -100, -100,
-                        static_cast<int>(InterpolationType::Linear));
-
-            cimg_library::CImg<P> dst(dstData, targetDim.x, targetDim.y, 1, comp, true);
-            dst.fill(P{0});
-            dst.draw_image(targetDim.x / 2 - resizeDim.x / 2, targetDim.y / 2 - resizeDim.y / 2,
-                           temp);
-
-            dst.permute_axes("cxyz");  // put last index first
-        }
-
-        return true;
-    }
-};
-
 bool rescaleLayerRamToLayerRam(const LayerRAM* source, LayerRAM* target) {
     if (!source->getData()) return false;
     if (!target->getData()) return false;
     if (source->getDataFormatId() != target->getDataFormatId()) return false;
 
-    CImgRescaleLayerRamToLayerRamDispatcher disp;
-    return dispatching::dispatch<bool, dispatching::filter::All>(source->getDataFormat()->getId(),
-                                                                 disp, source, target);
+    util::resampleToFit(*source, *target, util::ResampleFilter::Bilinear);
+    return true;
 }
 
 std::string getLibJPGVersion() {
@@ -627,6 +609,20 @@ TIFFHeader getTIFFHeader(const std::string& filename) {
         sampleFormat = 1;
     }
 
+    // CImg decodes palette, YCbCr, and CMYK images to RGB, and bilevel images to 8 bit
+    // luminance, report the format of the decoded voxels
+    uint16 photometric = PHOTOMETRIC_MINISBLACK;
+    TIFFGetField(tif, TIFFTAG_PHOTOMETRIC, &photometric);
+    if (photometric >= PHOTOMETRIC_PALETTE) {
+        if (sampleFormat == SAMPLEFORMAT_UINT && (bitsPerSample == 4 || bitsPerSample == 8) &&
+            (samplesPerPixel == 1 || samplesPerPixel == 3 || samplesPerPixel == 4)) {
+            bitsPerSample = 8;
+        }
+        samplesPerPixel = 3;
+    } else if (bitsPerSample == 1 && samplesPerPixel == 1) {
+        bitsPerSample = 8;
+    }
+
     float xres = 1.0f;
     float yres = 1.0f;
     // X and Y resolution tags are stored as float
@@ -689,6 +685,10 @@ TIFFHeader getTIFFHeader(const std::string& filename) {
     }
 
     auto df = DataFormatBase::get(numericType, samplesPerPixel, bitsPerSample);
+    if (!df) {
+        throw DataReaderException("Unsupported TIFF format",
+                                  IVW_CONTEXT_CUSTOM("cimgutil::getTIFFDataFormat()"));
+    }
 
     return {df, size3_t{x, y, z}, res, resolutionUnit, swizzleMask};
 #else
@@ -697,6 +697,184 @@ TIFFHeader getTIFFHeader(const std::string& filename) {
 #endif
 }
 
+#ifdef cimg_use_tiff
+namespace {
+
+/**
+ * Checks if the samples of the pages [first, last) are stored as \p format, such that decoded
+ * scanlines and tiles can be copied as is. Palette, YCbCr, CMYK, JPEG compressed, and sub-byte
+ * pages need the conversions done by CImg.
+ */
+bool hasPlainSamples(const std::string& filePath, const DataFormatBase* format, size_t first,
+                     size_t last) {
+    TIFF* tif = TIFFOpen(filePath.c_str(), "r");
+    util::OnScopeExit closeFile([tif]() {
+        if (tif) TIFFClose(tif);
+    });
+    if (!tif || !TIFFSetDirectory(tif, static_cast<tdir_t>(first))) return false;
+
+    for (size_t page = first; page < last; ++page) {
+        if (page != first && !TIFFReadDirectory(tif)) return false;
+
+        uint16 photometric = PHOTOMETRIC_MINISBLACK, compression = COMPRESSION_NONE;
+        uint16 samplesPerPixel = 1, bitsPerSample = 8;
+        TIFFGetField(tif, TIFFTAG_PHOTOMETRIC, &photometric);
+        TIFFGetFieldDefaulted(tif, TIFFTAG_COMPRESSION, &compression);
+        TIFFGetFieldDefaulted(tif, TIFFTAG_SAMPLESPERPIXEL, &samplesPerPixel);
+        TIFFGetFieldDefaulted(tif, TIFFTAG_BITSPERSAMPLE, &bitsPerSample);
+
+        if (photometric > PHOTOMETRIC_RGB || compression == COMPRESSION_JPEG ||
+            compression == COMPRESSION_OJPEG || bitsPerSample < 8 ||
+            samplesPerPixel != format->getComponents() ||
+            size_t{bitsPerSample} * samplesPerPixel != format->getSize() * 8) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+#endif
+
+void loadTIFFVolumeRegion(void* dst, const std::string& filePath, const TIFFHeader& header,
+                          size3_t offset, size3_t dims) {
+#ifdef cimg_use_tiff
+    if (glm::any(glm::greaterThan(offset + dims, header.dimensions))) {
+        throw DataReaderException("Region outside of the TIFF stack: " + filePath,
+                                  IVW_CONTEXT_CUSTOM("cimgutil::loadTIFFVolumeRegion()"));
+    }
+    if (glm::compMul(dims) == 0) return;
+
+    if (!hasPlainSamples(filePath, header.format, offset.z, offset.z + dims.z)) {
+        CImgLoadVolumeRegionDispatcher disp;
+        return dispatching::dispatch<void, dispatching::filter::All>(
+            header.format->getId(), disp, dst, filePath, header.dimensions, offset, dims);
+    }
+
+    const size_t elemSize = header.format->getSize();
+    const size_t channels = header.format->getComponents();
+    const size_t sliceBytes = dims.x * dims.y * elemSize;
+    const size_t rowBytes = dims.x * elemSize;
+    // TIFF rows are stored top to bottom, the rows of the region are [firstRow, lastRow)
+    const size_t firstRow = header.dimensions.y - offset.y - dims.y;
+    const size_t lastRow = firstRow + dims.y;
+    auto data = static_cast<unsigned char*>(dst);
+
+    // Every job reads a consecutive range of pages through its own handle, since a TIFF handle
+    // can not be shared between threads and directories are only found by walking the chain
+    const auto jobs = util::jobCount(dims.z, sliceBytes);
+    util::forEachRange(dims.z, jobs, [&](size_t begin, size_t end, size_t) {
+        const auto error = [&](size_t page) {
+            return DataReaderException(
+                "Error reading page " + std::to_string(offset.z + page) + " of: " + filePath,
+                IVW_CONTEXT_CUSTOM("cimgutil::loadTIFFVolumeRegion()"));
+        };
+
+        TIFF* tif = TIFFOpen(filePath.c_str(), "r");
+        util::OnScopeExit closeFile([tif]() {
+            if (tif) TIFFClose(tif);
+        });
+        if (!tif || !TIFFSetDirectory(tif, static_cast<tdir_t>(offset.z + begin))) {
+            throw error(begin);
+        }
+
+        std::vector<unsigned char> buffer;
+        for (size_t z = begin; z < end; ++z) {
+            if (z != begin && !TIFFReadDirectory(tif)) throw error(z);
+
+            uint32 width = 0, height = 0;
+            uint16 planar = PLANARCONFIG_CONTIG;
+            TIFFGetFieldDefaulted(tif, TIFFTAG_IMAGEWIDTH, &width);
+            TIFFGetFieldDefaulted(tif, TIFFTAG_IMAGELENGTH, &height);
+            TIFFGetFieldDefaulted(tif, TIFFTAG_PLANARCONFIG, &planar);
+            if (width != header.dimensions.x || height != header.dimensions.y) throw error(z);
+
+            // With separate planes every sample is read on its own and interleaved here
+            const bool separate = planar == PLANARCONFIG_SEPARATE && channels > 1;
+            const size_t samples = separate ? channels : 1;
+            const size_t pixelBytes = separate ? elemSize / channels : elemSize;
+            const auto copyPixels = [&](const unsigned char* src, unsigned char* dstRow,
+                                        size_t count, size_t sample) {
+                if (!separate) {
+                    std::memcpy(dstRow, src, count * elemSize);
+                    return;
+                }
+                for (size_t i = 0; i < count; ++i) {
+                    std::memcpy(dstRow + i * elemSize + sample * pixelBytes, src + i * pixelBytes,
+                                pixelBytes);
+                }
+            };
+            // Volume rows are stored bottom to top
+            const auto slice = data + z * sliceBytes;
+            const auto dstRow = [&](size_t row) {
+                return slice + (header.dimensions.y - 1 - row - offset.y) * rowBytes;
+            };
+
+            if (TIFFIsTiled(tif)) {
+                uint32 tileWidth = 0, tileHeight = 0;
+                TIFFGetField(tif, TIFFTAG_TILEWIDTH, &tileWidth);
+                TIFFGetField(tif, TIFFTAG_TILELENGTH, &tileHeight);
+                if (tileWidth == 0 || tileHeight == 0) throw error(z);
+                buffer.resize(static_cast<size_t>(TIFFTileSize(tif)));
+
+                for (size_t sample = 0; sample < samples; ++sample) {
+                    for (size_t ty = firstRow / tileHeight * tileHeight; ty < lastRow;
+                         ty += tileHeight) {
+                        for (size_t tx = offset.x / tileWidth * tileWidth; tx < offset.x + dims.x;
+                             tx += tileWidth) {
+                            if (TIFFReadTile(tif, buffer.data(), static_cast<uint32>(tx),
+                                             static_cast<uint32>(ty), 0,
+                                             static_cast<tsample_t>(sample)) < 0) {
+                                throw error(z);
+                            }
+                            const auto x0 = std::max(tx, offset.x);
+                            const auto x1 = std::min(tx + tileWidth, offset.x + dims.x);
+                            const auto y0 = std::max(ty, firstRow);
+                            const auto y1 = std::min(ty + tileHeight, lastRow);
+                            for (size_t row = y0; row < y1; ++row) {
+                                copyPixels(buffer.data() +
+                                               ((row - ty) * tileWidth + (x0 - tx)) * pixelBytes,
+                                           dstRow(row) + (x0 - offset.x) * elemSize, x1 - x0,
+                                           sample);
+                            }
+                        }
+                    }
+                }
+            } else {
+                // Whole strips are decoded, since most codecs can not start within a strip
+                uint32 rowsPerStrip = 0;
+                TIFFGetFieldDefaulted(tif, TIFFTAG_ROWSPERSTRIP, &rowsPerStrip);
+                rowsPerStrip = std::min(rowsPerStrip, height);
+                if (rowsPerStrip == 0) throw error(z);
+                const auto scanlineBytes = static_cast<size_t>(TIFFScanlineSize(tif));
+                buffer.resize(static_cast<size_t>(TIFFStripSize(tif)));
+
+                for (size_t sample = 0; sample < samples; ++sample) {
+                    for (size_t sy = firstRow / rowsPerStrip * rowsPerStrip; sy < lastRow;
+                         sy += rowsPerStrip) {
+                        const auto strip = TIFFComputeStrip(tif, static_cast<uint32>(sy),
+                                                            static_cast<tsample_t>(sample));
+                        if (TIFFReadEncodedStrip(tif, strip, buffer.data(),
+                                                 static_cast<tmsize_t>(buffer.size())) < 0) {
+                            throw error(z);
+                        }
+                        const auto y0 = std::max(sy, firstRow);
+                        const auto y1 = std::min(sy + rowsPerStrip, lastRow);
+                        for (size_t row = y0; row < y1; ++row) {
+                            copyPixels(buffer.data() + (row - sy) * scanlineBytes +
+                                           offset.x * pixelBytes,
+                                       dstRow(row), dims.x, sample);
+                        }
+                    }
+                }
+            }
+        }
+    });
+#else
+    throw Exception("TIFF not available", IVW_CONTEXT_CUSTOM("cimgutil::loadTIFFVolumeRegion()"));
+#endif
+}
+
 }  // namespace cimgutil
 
 }  // namespace inviwo
@@ -86,50 +86,46 @@ TIFFStackVolumeRAMLoader* TIFFStackVolumeRAMLoader::clone() const {
 
 std::shared_ptr<VolumeRepresentation> TIFFStackVolumeRAMLoader::createRepresentation(
     const VolumeRepresentation& src) const {
-    std::string fileName = sourceFile_;
-
-    if (!filesystem::fileExists(fileName)) {
-        const auto newPath = filesystem::addBasePath(fileName);
+    return readRegion(src, size3_t{0}, src.getDimensions());
+}
 
-        if (filesystem::fileExists(newPath)) {
-            fileName = newPath;
-        } else {
-            throw TIFFStackVolumeReaderException("Error could not find input file: " + fileName,
-                                                 IVW_CONTEXT);
-        }
+void TIFFStackVolumeRAMLoader::updateRepresentation(std::shared_ptr<VolumeRepresentation> dest,
+                                                    const VolumeRepresentation& src) const {
+    auto volumeDst = std::static_pointer_cast<VolumeRAM>(dest);
+    if (volumeDst->getDimensions() != src.getDimensions()) {
+        volumeDst->setDimensions(src.getDimensions());
     }
+
     cimgutil::TIFFHeader header;
     header.format = src.getDataFormat();
     header.dimensions = src.getDimensions();
-    auto data = cimgutil::loadTIFFVolumeData(nullptr, fileName, header);
+    cimgutil::loadTIFFVolumeRegion(volumeDst->getData(), getFile(), header, size3_t{0},
+                                   src.getDimensions());
+}
 
-    auto volumeRAM =
-        createVolumeRAM(src.getDimensions(), src.getDataFormat(), data, src.getSwizzleMask(),
-                        src.getInterpolation(), src.getWrapping());
+std::shared_ptr<VolumeRAM> TIFFStackVolumeRAMLoader::readRegion(const VolumeRepresentation& src,
+                                                                size3_t offset,
+                                                                size3_t dims) const {
+    const auto fileName = getFile();
 
+    cimgutil::TIFFHeader header;
+    header.format = src.getDataFormat();
+    header.dimensions = src.getDimensions();
+
+    auto volumeRAM = createVolumeRAM(dims, src.getDataFormat(), nullptr, src.getSwizzleMask(),
+                                     src.getInterpolation(), src.getWrapping());
+    cimgutil::loadTIFFVolumeRegion(volumeRAM->getData(), fileName, header, offset, dims);
     return volumeRAM;
 }
 
-void TIFFStackVolumeRAMLoader::updateRepresentation(std::shared_ptr<VolumeRepresentation> dest,
-                                                    const VolumeRepresentation& src) const {
-    auto volumeDst = std::static_pointer_cast<VolumeRAM>(dest);
+std::string TIFFStackVolumeRAMLoader::getFile() const {
+    if (filesystem::fileExists(sourceFile_)) return sourceFile_;
 
-    std::string fileName = sourceFile_;
-    if (!filesystem::fileExists(fileName)) {
-        const auto newPath = filesystem::addBasePath(fileName);
+    const auto newPath = filesystem::addBasePath(sourceFile_);
+    if (filesystem::fileExists(newPath)) return newPath;
 
-        if (filesystem::fileExists(newPath)) {
-            fileName = newPath;
-        } else {
-            throw TIFFStackVolumeReaderException("Error could not find input file: " + fileName,
-                                                 IVW_CONTEXT);
-        }
-    }
-
-    cimgutil::TIFFHeader header;
-    header.format = src.getDataFormat();
-    header.dimensions = src.getDimensions();
-    cimgutil::loadTIFFVolumeData(volumeDst->getData(), fileName, header);
+    throw TIFFStackVolumeReaderException("Error could not find input file: " + sourceFile_,
+                                         IVW_CONTEXT);
 }
 
 }  // namespace inviwo
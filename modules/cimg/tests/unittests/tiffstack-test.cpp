@@ -0,0 +1,239 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <tiffio.h>
+#include <warn/pop>
+
+#include <inviwo/core/io/tempfilehandle.h>
+#include <inviwo/core/io/datareaderexception.h>
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/volumeram.h>
+#include <modules/cimg/cimgutils.h>
+#include <modules/cimg/tiffstackvolumereader.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace inviwo {
+
+namespace {
+
+const size3_t stackDims{37, 23, 5};
+constexpr uint32 tileSize = 16;
+constexpr uint32 rowsPerStrip = 4;
+
+// The value of sample c at (x, row, page), with rows counted from the top as stored in the file
+std::uint8_t value(size_t x, size_t row, size_t page, size_t c) {
+    return static_cast<std::uint8_t>(x * 7 + row * 13 + page * 29 + c * 61);
+}
+
+// Write a stack of 8 bit pages, LZW compressed to make libtiff decode the strips or tiles
+void writeStack(const std::string& file, bool tiled, uint16 planar, uint16 samples) {
+    TIFF* tif = TIFFOpen(file.c_str(), "w");
+    ASSERT_TRUE(tif);
+    const bool separate = planar == PLANARCONFIG_SEPARATE;
+    const size_t pixelSamples = separate ? 1 : samples;
+    for (size_t page = 0; page < stackDims.z; ++page) {
+        TIFFSetField(tif, TIFFTAG_IMAGEWIDTH, static_cast<uint32>(stackDims.x));
+        TIFFSetField(tif, TIFFTAG_IMAGELENGTH, static_cast<uint32>(stackDims.y));
+        TIFFSetField(tif, TIFFTAG_BITSPERSAMPLE, 8);
+        TIFFSetField(tif, TIFFTAG_SAMPLESPERPIXEL, samples);
+        TIFFSetField(tif, TIFFTAG_SAMPLEFORMAT, SAMPLEFORMAT_UINT);
+        TIFFSetField(tif, TIFFTAG_PHOTOMETRIC,
+                     samples == 3 ? PHOTOMETRIC_RGB : PHOTOMETRIC_MINISBLACK);
+        TIFFSetField(tif, TIFFTAG_PLANARCONFIG, planar);
+        TIFFSetField(tif, TIFFTAG_COMPRESSION, COMPRESSION_LZW);
+        TIFFSetField(tif, TIFFTAG_SUBFILETYPE, FILETYPE_PAGE);
+        TIFFSetField(tif, TIFFTAG_PAGENUMBER, static_cast<uint16>(page),
+                     static_cast<uint16>(stackDims.z));
+
+        for (uint16 sample = 0; sample < (separate ? samples : 1); ++sample) {
+            const auto fill = [&](std::vector<std::uint8_t>& buffer, size_t x, size_t row,
+                                  size_t i) {
+                for (size_t c = 0; c < pixelSamples; ++c) {
+                    buffer[i * pixelSamples + c] =
+                        x < stackDims.x && row < stackDims.y ? value(x, row, page, c + sample)
+                                                             : std::uint8_t{0};
+                }
+            };
+            if (tiled) {
+                TIFFSetField(tif, TIFFTAG_TILEWIDTH, tileSize);
+                TIFFSetField(tif, TIFFTAG_TILELENGTH, tileSize);
+                std::vector<std::uint8_t> tile(tileSize * tileSize * pixelSamples);
+                for (uint32 ty = 0; ty < stackDims.y; ty += tileSize) {
+                    for (uint32 tx = 0; tx < stackDims.x; tx += tileSize) {
+                        for (size_t y = 0; y < tileSize; ++y) {
+                            for (size_t x = 0; x < tileSize; ++x) {
+                                fill(tile, tx + x, ty + y, x + y * tileSize);
+                            }
+                        }
+                        ASSERT_GE(TIFFWriteTile(tif, tile.data(), tx, ty, 0, sample), 0);
+                    }
+                }
+            } else {
+                TIFFSetField(tif, TIFFTAG_ROWSPERSTRIP, rowsPerStrip);
+                std::vector<std::uint8_t> scanline(stackDims.x * pixelSamples);
+                for (uint32 row = 0; row < stackDims.y; ++row) {
+                    for (size_t x = 0; x < stackDims.x; ++x) fill(scanline, x, row, x);
+                    ASSERT_GE(TIFFWriteScanline(tif, scanline.data(), row, sample), 0);
+                }
+            }
+        }
+        ASSERT_TRUE(TIFFWriteDirectory(tif));
+    }
+    TIFFClose(tif);
+}
+
+// Voxels are stored with y pointing up, i.e. in the reverse row order of the file
+void expectRegion(const std::uint8_t* data, size_t channels, size3_t offset, size3_t dims) {
+    for (size_t z = 0; z < dims.z; ++z) {
+        for (size_t y = 0; y < dims.y; ++y) {
+            for (size_t x = 0; x < dims.x; ++x) {
+                for (size_t c = 0; c < channels; ++c) {
+                    const auto row = stackDims.y - 1 - (offset.y + y);
+                    ASSERT_EQ(data[((z * dims.y + y) * dims.x + x) * channels + c],
+                              value(offset.x + x, row, offset.z + z, c))
+                        << "at " << x << ", " << y << ", " << z << ", channel " << c;
+                }
+            }
+        }
+    }
+}
+
+void testLayout(bool tiled, uint16 planar, uint16 samples) {
+    util::TempFileHandle tmpFile("tiffstack", ".tif");
+    writeStack(tmpFile.getFileName(), tiled, planar, samples);
+
+    const auto header = cimgutil::getTIFFHeader(tmpFile.getFileName());
+    ASSERT_EQ(header.dimensions, stackDims);
+    ASSERT_EQ(header.format, DataFormatBase::get(NumericType::UnsignedInteger, samples, 8));
+
+    // Crosses strip or tile borders in x and y, and skips the first and last pages
+    const size3_t offset{3, 5, 1};
+    const size3_t dims{30, 17, 3};
+    std::vector<std::uint8_t> region(glm::compMul(dims) * samples);
+    cimgutil::loadTIFFVolumeRegion(region.data(), tmpFile.getFileName(), header, offset, dims);
+    expectRegion(region.data(), samples, offset, dims);
+
+    std::vector<std::uint8_t> full(glm::compMul(stackDims) * samples);
+    cimgutil::loadTIFFVolumeRegion(full.data(), tmpFile.getFileName(), header, size3_t{0},
+                                   stackDims);
+    expectRegion(full.data(), samples, size3_t{0}, stackDims);
+}
+
+}  // namespace
+
+TEST(TIFFStack, StrippedRegion) { testLayout(false, PLANARCONFIG_CONTIG, 1); }
+
+TEST(TIFFStack, StrippedSeparatePlanesRegion) { testLayout(false, PLANARCONFIG_SEPARATE, 3); }
+
+TEST(TIFFStack, TiledRegion) { testLayout(true, PLANARCONFIG_CONTIG, 3); }
+
+TEST(TIFFStack, TiledSeparatePlanesRegion) { testLayout(true, PLANARCONFIG_SEPARATE, 3); }
+
+TEST(TIFFStack, ReadFullStack) {
+    util::TempFileHandle tmpFile("tiffstack", ".tif");
+    writeStack(tmpFile.getFileName(), true, PLANARCONFIG_CONTIG, 1);
+
+    TIFFStackVolumeReader reader;
+    auto volume = reader.readData(tmpFile.getFileName());
+    ASSERT_TRUE(volume);
+    EXPECT_EQ(volume->getDimensions(), stackDims);
+
+    const auto ram = volume->getRepresentation<VolumeRAM>();
+    expectRegion(static_cast<const std::uint8_t*>(ram->getData()), 1, size3_t{0}, stackDims);
+}
+
+TEST(TIFFStack, PaletteFallsBackToCImg) {
+    util::TempFileHandle tmpFile("tiffstack", ".tif");
+    {
+        TIFF* tif = TIFFOpen(tmpFile.getFileName().c_str(), "w");
+        ASSERT_TRUE(tif);
+        std::vector<uint16> red(256), green(256), blue(256);
+        for (size_t i = 0; i < 256; ++i) {
+            red[i] = static_cast<uint16>(i * 257);
+            green[i] = static_cast<uint16>((255 - i) * 257);
+            blue[i] = static_cast<uint16>(i / 2 * 257);
+        }
+        for (size_t page = 0; page < stackDims.z; ++page) {
+            TIFFSetField(tif, TIFFTAG_IMAGEWIDTH, static_cast<uint32>(stackDims.x));
+            TIFFSetField(tif, TIFFTAG_IMAGELENGTH, static_cast<uint32>(stackDims.y));
+            TIFFSetField(tif, TIFFTAG_BITSPERSAMPLE, 8);
+            TIFFSetField(tif, TIFFTAG_SAMPLESPERPIXEL, 1);
+            TIFFSetField(tif, TIFFTAG_PHOTOMETRIC, PHOTOMETRIC_PALETTE);
+            TIFFSetField(tif, TIFFTAG_COLORMAP, red.data(), green.data(), blue.data());
+            TIFFSetField(tif, TIFFTAG_ROWSPERSTRIP, rowsPerStrip);
+            TIFFSetField(tif, TIFFTAG_SUBFILETYPE, FILETYPE_PAGE);
+            std::vector<std::uint8_t> scanline(stackDims.x);
+            for (uint32 row = 0; row < stackDims.y; ++row) {
+                for (size_t x = 0; x < stackDims.x; ++x) scanline[x] = value(x, row, page, 0);
+                ASSERT_GE(TIFFWriteScanline(tif, scanline.data(), row, 0), 0);
+            }
+            ASSERT_TRUE(TIFFWriteDirectory(tif));
+        }
+        TIFFClose(tif);
+    }
+
+    // Palette pages are decoded to RGB
+    const auto header = cimgutil::getTIFFHeader(tmpFile.getFileName());
+    ASSERT_EQ(header.format, DataFormat<glm::u8vec3>::get());
+
+    const size3_t offset{3, 5, 1};
+    const size3_t dims{30, 17, 3};
+    std::vector<std::uint8_t> region(glm::compMul(dims) * 3);
+    cimgutil::loadTIFFVolumeRegion(region.data(), tmpFile.getFileName(), header, offset, dims);
+    for (size_t z = 0; z < dims.z; ++z) {
+        for (size_t y = 0; y < dims.y; ++y) {
+            for (size_t x = 0; x < dims.x; ++x) {
+                const auto row = stackDims.y - 1 - (offset.y + y);
+                const auto index = value(offset.x + x, row, offset.z + z, 0);
+                const auto voxel = &region[((z * dims.y + y) * dims.x + x) * 3];
+                ASSERT_EQ(voxel[0], index);
+                ASSERT_EQ(voxel[1], 255 - index);
+                ASSERT_EQ(voxel[2], index / 2);
+            }
+        }
+    }
+}
+
+TEST(TIFFStack, RegionOutsideOfStack) {
+    util::TempFileHandle tmpFile("tiffstack", ".tif");
+    writeStack(tmpFile.getFileName(), false, PLANARCONFIG_CONTIG, 1);
+
+    const auto header = cimgutil::getTIFFHeader(tmpFile.getFileName());
+    std::vector<std::uint8_t> region(glm::compMul(stackDims));
+    EXPECT_THROW(cimgutil::loadTIFFVolumeRegion(region.data(), tmpFile.getFileName(), header,
+                                                size3_t{1, 0, 0}, stackDims),
+                 DataReaderException);
+}
+
+}  // namespace inviwo
@@ -38,6 +38,11 @@
 
 #include <inviwo/dataframe/datastructures/datapoint.h>
 
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <string_view>
+
 namespace inviwo {
 
 class DataPointBase;
@@ -187,10 +192,18 @@ protected:
  *    by 0, 0, 1, 2.
  *    The original string values can be accessed using CategoricalColumn::get(index, true)
  *
+ * The categories are kept in a hashed dictionary. Functions like getIDs(), groupRowsByID(), and
+ * filteredRows() work on the ids and never expand the rows to strings.
+ *
  * \see TemplateColumn, \see CategoricalColumn::get()
  */
 class IVW_MODULE_DATAFRAME_API CategoricalColumn : public TemplateColumn<std::uint32_t> {
 public:
+    /**
+     * Id used for missing categories, \see getID, getIDMapping
+     */
+    static constexpr std::uint32_t InvalidID = std::numeric_limits<std::uint32_t>::max();
+
     CategoricalColumn(const std::string& header, const std::vector<std::string>& values = {});
     CategoricalColumn(const CategoricalColumn& rhs) = default;
     CategoricalColumn(CategoricalColumn&& rhs) = default;
@@ -236,11 +249,32 @@ public:
      */
     void append(const std::vector<std::string>& data);
 
+    /**
+     * \brief append the categorical values in the range [\p begin, \p end)
+     *
+     * The values can be of any type convertible to std::string_view, like std::string_view or
+     * const char*. Strings are only allocated for new categories.
+     */
+    template <typename Iter>
+    void append(Iter begin, Iter end);
+
     /**
      * Returns the unique set of categorical values.
      */
     const std::vector<std::string>& getCategories() const { return lookUpTable_; }
 
+    /**
+     * Returns the category ids of all rows
+     */
+    const std::vector<std::uint32_t>& getIDs() const;
+
+    /**
+     * \brief look up the id of category \p cat without adding it
+     *
+     * @return id of the category, or InvalidID if the category does not exist
+     */
+    std::uint32_t getID(std::string_view cat) const;
+
     /**
      * \brief returns column contents as list of categorical values
      *
@@ -253,14 +287,81 @@ public:
      *
      * @return index of the category
      */
-    std::uint32_t addCategory(const std::string& cat);
+    std::uint32_t addCategory(std::string_view cat);
+
+    /**
+     * \brief add all \p categories, for example the categories of another column, that do not
+     * already exist
+     *
+     * @return for each of the \p categories, its id in this column. Use it to remap the ids of
+     * a column with a different dictionary.
+     */
+    std::vector<std::uint32_t> addCategories(const std::vector<std::string>& categories);
+
+    /**
+     * \brief map the category ids of \p other to the ids of this column, without modifying it.
+     *
+     * @return for each category of \p other, the id of the same category in this column, or
+     * InvalidID if it does not exist.
+     */
+    std::vector<std::uint32_t> getIDMapping(const CategoricalColumn& other) const;
+
+    /**
+     * \brief group the rows by category
+     *
+     * @return for each category id, the rows with that category, in ascending order
+     */
+    std::vector<std::vector<size_t>> groupRowsByID() const;
+
+    /**
+     * \brief returns the rows where the category fulfills \p pred
+     *
+     * The predicate is called once per category, and not for every row.
+     * @param pred predicate taking the category as a const std::string&
+     * @return list of row indices in ascending order
+     */
+    template <typename Pred>
+    std::vector<size_t> filteredRows(Pred pred) const;
 
 private:
-    virtual glm::uint32_t addOrGetID(const std::string& str);
+    virtual glm::uint32_t addOrGetID(std::string_view str);
+    void insertHash(std::uint32_t id);
+    void rehash();
 
     std::vector<std::string> lookUpTable_;
+    // Open addressing hash table, with linear probing, of the ids in lookUpTable_ offset by one.
+    // Zero marks an empty slot. The size is always a power of two and at least twice the number
+    // of categories.
+    std::vector<std::uint32_t> hashTable_;
 };
 
+template <typename Iter>
+void CategoricalColumn::append(Iter begin, Iter end) {
+    auto& data = buffer_->getEditableRAMRepresentation()->getDataContainer();
+    if constexpr (std::is_base_of_v<std::forward_iterator_tag,
+                                    typename std::iterator_traits<Iter>::iterator_category>) {
+        data.reserve(data.size() + static_cast<size_t>(std::distance(begin, end)));
+    }
+    for (; begin != end; ++begin) {
+        data.push_back(addOrGetID(std::string_view{*begin}));
+    }
+}
+
+template <typename Pred>
+std::vector<size_t> CategoricalColumn::filteredRows(Pred pred) const {
+    std::vector<char> keep(lookUpTable_.size());
+    for (size_t i = 0; i < lookUpTable_.size(); ++i) {
+        keep[i] = pred(lookUpTable_[i]) ? 1 : 0;
+    }
+
+    std::vector<size_t> rows;
+    const auto& ids = getIDs();
+    for (size_t row = 0; row < ids.size(); ++row) {
+        if (keep[ids[row]]) rows.push_back(row);
+    }
+    return rows;
+}
+
 template <typename T>
 TemplateColumn<T>::TemplateColumn(const std::string& header, std::shared_ptr<Buffer<T>> buffer)
     : header_(header), buffer_(buffer) {}
@@ -0,0 +1,81 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/dataframe/dataframemoduledefine.h>
+#include <inviwo/core/processors/processor.h>
+#include <inviwo/core/properties/optionproperty.h>
+#include <inviwo/core/properties/ordinalproperty.h>
+#include <inviwo/core/properties/stringproperty.h>
+
+#include <inviwo/dataframe/datastructures/dataframe.h>
+#include <inviwo/dataframe/properties/dataframeproperty.h>
+#include <inviwo/dataframe/util/dataframequery.h>
+
+namespace inviwo {
+
+/** \docpage{org.inviwo.DataFrameFilter, DataFrame Filter}
+ * ![](org.inviwo.DataFrameFilter.png?classIdentifier=org.inviwo.DataFrameFilter)
+ * Keeps the rows of a DataFrame where the value of the selected column fulfills the comparison.
+ * Numerical columns are compared with a number, categorical columns with a category name.
+ *
+ * ### Inports
+ *   * __inport__  source DataFrame
+ *
+ * ### Outports
+ *   * __outport__  DataFrame with the matching rows
+ *
+ * ### Properties
+ *   * __Column__      column used for filtering
+ *   * __Comparison__  comparison between column values and the reference
+ *   * __Value__       reference for numerical columns
+ *   * __Category__    reference for categorical columns
+ */
+class IVW_MODULE_DATAFRAME_API DataFrameFilter : public Processor {
+public:
+    DataFrameFilter();
+    virtual ~DataFrameFilter() = default;
+
+    virtual void process() override;
+
+    virtual const ProcessorInfo getProcessorInfo() const override;
+    static const ProcessorInfo processorInfo_;
+
+private:
+    DataFrameInport inport_;
+    DataFrameOutport outport_;
+
+    DataFrameColumnProperty column_;
+    TemplateOptionProperty<dataframe::CompareOp> op_;
+    DoubleProperty value_;
+    StringProperty category_;
+};
+
+}  // namespace inviwo
@@ -0,0 +1,78 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/dataframe/dataframemoduledefine.h>
+#include <inviwo/core/processors/processor.h>
+#include <inviwo/core/properties/boolproperty.h>
+
+#include <inviwo/dataframe/datastructures/dataframe.h>
+#include <inviwo/dataframe/properties/dataframeproperty.h>
+
+namespace inviwo {
+
+/** \docpage{org.inviwo.DataFrameSort, DataFrame Sort}
+ * ![](org.inviwo.DataFrameSort.png?classIdentifier=org.inviwo.DataFrameSort)
+ * Sorts the rows of a DataFrame by a primary and an optional secondary key column. The sort is
+ * stable, categorical columns are sorted by category name, and NaN values are placed last.
+ *
+ * ### Inports
+ *   * __inport__  source DataFrame
+ *
+ * ### Outports
+ *   * __outport__  sorted DataFrame
+ *
+ * ### Properties
+ *   * __Key Column__            primary sort key
+ *   * __Ascending__             sort order of the primary key
+ *   * __Secondary Key Column__  sort key for rows with equal primary keys
+ *   * __Secondary Ascending__   sort order of the secondary key
+ */
+class IVW_MODULE_DATAFRAME_API DataFrameSort : public Processor {
+public:
+    DataFrameSort();
+    virtual ~DataFrameSort() = default;
+
+    virtual void process() override;
+
+    virtual const ProcessorInfo getProcessorInfo() const override;
+    static const ProcessorInfo processorInfo_;
+
+private:
+    DataFrameInport inport_;
+    DataFrameOutport outport_;
+
+    DataFrameColumnProperty key_;
+    BoolProperty ascending_;
+    DataFrameColumnProperty secondaryKey_;
+    BoolProperty secondaryAscending_;
+};
+
+}  // namespace inviwo
@@ -0,0 +1,135 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/dataframe/dataframemoduledefine.h>
+#include <inviwo/dataframe/datastructures/dataframe.h>
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace inviwo {
+
+namespace dataframe {
+
+/**
+ * Columnar query operations on DataFrames. Each operation dispatches once on the column type and
+ * then runs a tight loop over the column buffer. Large columns are split into row ranges which
+ * are processed on the thread pool.
+ */
+
+enum class CompareOp { Less, LessEqual, Equal, NotEqual, GreaterEqual, Greater };
+
+enum class Aggregation { Count, Sum, Mean, Min, Max };
+
+/**
+ * \brief Selection mask with one entry per row, a non-zero entry means the row is selected
+ */
+using RowMask = std::vector<std::uint8_t>;
+
+struct IVW_MODULE_DATAFRAME_API SortKey {
+    std::string column;
+    bool ascending = true;
+};
+
+struct IVW_MODULE_DATAFRAME_API Aggregate {
+    std::string column;
+    Aggregation aggregation = Aggregation::Count;
+};
+
+/**
+ * \brief compare every value of the numerical column \p col with \p value
+ *
+ * @return mask where selected rows fulfill `col[row] op value`
+ * @throws Exception if \p col is categorical
+ */
+IVW_MODULE_DATAFRAME_API RowMask selectionMask(const Column& col, CompareOp op, double value);
+
+/**
+ * \brief compare the categories of the categorical column \p col with \p value. The comparison is
+ * evaluated once per category and uses lexicographical order.
+ *
+ * @return mask where selected rows fulfill `col[row] op value`
+ * @throws Exception if \p col is not categorical
+ */
+IVW_MODULE_DATAFRAME_API RowMask selectionMask(const Column& col, CompareOp op,
+                                               std::string_view value);
+
+/**
+ * \brief combine two selection masks of equal size, keeping rows selected in both
+ */
+IVW_MODULE_DATAFRAME_API RowMask maskAnd(const RowMask& a, const RowMask& b);
+
+/**
+ * \brief combine two selection masks of equal size, keeping rows selected in either
+ */
+IVW_MODULE_DATAFRAME_API RowMask maskOr(const RowMask& a, const RowMask& b);
+
+/**
+ * \brief convert a selection mask into a list of the selected row indices
+ */
+IVW_MODULE_DATAFRAME_API std::vector<size_t> selectedRows(const RowMask& mask);
+
+/**
+ * \brief stable sort of the rows of \p dataframe with respect to multiple key columns. The first
+ * key is the most significant one. Categorical columns are sorted by category name and NaN values
+ * are always placed last.
+ *
+ * @return permutation of row indices in sorted order, use selectRows() to create the sorted
+ *         DataFrame
+ * @throws Exception if a key column does not exist
+ */
+IVW_MODULE_DATAFRAME_API std::vector<size_t> sortedRows(const DataFrame& dataframe,
+                                                        const std::vector<SortKey>& keys);
+
+/**
+ * \brief group the rows of \p dataframe by the values of the key columns and compute the
+ * aggregates for each group. Groups are listed in order of their first appearance.
+ *
+ * The result contains the key columns followed by one column per aggregate named like
+ * "mean(x)". Count results in a column "count" holding the number of rows in the group and
+ * ignores the column name. The other aggregates are computed in double precision and skip NaN
+ * values, groups without any valid value yield NaN.
+ *
+ * @param keys    headers of the key columns, if empty all rows form a single group
+ * @return DataFrame with one row per group
+ * @throws Exception if a column does not exist or a non-count aggregate uses a categorical column
+ */
+IVW_MODULE_DATAFRAME_API std::shared_ptr<DataFrame> groupBy(
+    const DataFrame& dataframe, const std::vector<std::string>& keys,
+    const std::vector<Aggregate>& aggregates);
+
+IVW_MODULE_DATAFRAME_API std::string_view toString(Aggregation aggregation);
+
+}  // namespace dataframe
+
+}  // namespace inviwo
@@ -111,6 +111,18 @@ std::shared_ptr<DataFrame> IVW_MODULE_DATAFRAME_API
 combineDataFrames(std::vector<std::shared_ptr<DataFrame>> dataframes, bool skipIndexColumn = false,
                   std::string skipcol = "index");
 
+/**
+ * \brief create a new DataFrame holding the rows \p rows of \p dataframe in the given order
+ *
+ * @param rows     row indices in \p dataframe, may contain duplicates
+ * @param columns  headers of the columns to keep, all columns are kept if empty
+ * @return DataFrame with one row per entry in \p rows
+ * @throws Exception if one of the \p columns does not exist
+ */
+std::shared_ptr<DataFrame> IVW_MODULE_DATAFRAME_API
+selectRows(const DataFrame& dataframe, const std::vector<size_t>& rows,
+           const std::vector<std::string>& columns = {});
+
 /**
  * \brief apply predicate \pred to each value of column \col and return the row indices where the
  * predicate evaluates to true.
@@ -148,13 +160,8 @@ std::string IVW_MODULE_DATAFRAME_API createToolTipForRow(const DataFrame& datafr
 template <typename Pred>
 std::vector<size_t> filteredRows(std::shared_ptr<const Column> col, Pred pred) {
     if (auto catCol = dynamic_cast<const CategoricalColumn*>(col.get())) {
-        std::vector<size_t> rows;
-        for (auto&& [row, v] : util::enumerate(catCol->getValues())) {
-            if (pred(v)) {
-                rows.push_back(row);
-            }
-        }
-        return rows;
+        // evaluates the predicate once per category
+        return catCol->filteredRows(pred);
     } else {
         return col->getBuffer()->getRepresentation<BufferRAM>()->dispatch<std::vector<size_t>>(
             [pred](auto typedBuf) {
@@ -30,10 +30,13 @@
 #include <inviwo/dataframe/dataframemodule.h>
 #include <inviwo/dataframe/io/json/dataframepropertyjsonconverter.h>
 #include <inviwo/dataframe/processors/csvsource.h>
+#include <inviwo/dataframe/processors/dataframefilter.h>
 #include <inviwo/dataframe/processors/dataframefloat32converter.h>
+#include <inviwo/dataframe/processors/dataframegroupby.h>
 #include <inviwo/dataframe/processors/dataframejoin.h>
 #include <inviwo/dataframe/processors/dataframesource.h>
 #include <inviwo/dataframe/processors/dataframeexporter.h>
+#include <inviwo/dataframe/processors/dataframesort.h>
 #include <inviwo/dataframe/processors/imagetodataframe.h>
 #include <inviwo/dataframe/processors/syntheticdataframe.h>
 #include <inviwo/dataframe/processors/volumetodataframe.h>
@@ -57,7 +60,10 @@ DataFrameModule::DataFrameModule(InviwoApplication* app) : InviwoModule(app, "Da
     registerProcessor<DataFrameJoin>();
     registerProcessor<DataFrameSource>();
     registerProcessor<DataFrameExporter>();
+    registerProcessor<DataFrameFilter>();
     registerProcessor<DataFrameFloat32Converter>();
+    registerProcessor<DataFrameGroupBy>();
+    registerProcessor<DataFrameSort>();
     registerProcessor<ImageToDataFrame>();
     registerProcessor<SyntheticDataFrame>();
     registerProcessor<VolumeToDataFrame>();
@@ -32,7 +32,7 @@
 #include <inviwo/core/util/zip.h>
 #include <inviwo/core/util/stdextensions.h>
 
-#include <unordered_map>
+#include <functional>
 
 namespace inviwo {
 
@@ -67,72 +67,89 @@ std::vector<std::string> CategoricalColumn::getValues() const {
     return util::transform(data, [&](auto idx) { return lookUpTable_[idx]; });
 }
 
+const std::vector<std::uint32_t>& CategoricalColumn::getIDs() const {
+    return getTypedBuffer()->getRAMRepresentation()->getDataContainer();
+}
+
 void CategoricalColumn::add(const std::string& value) {
     auto id = addOrGetID(value);
     getTypedBuffer()->getEditableRAMRepresentation()->add(id);
 }
 
-namespace detail {
-
-struct AppendHelper {
-    AppendHelper(CategoricalColumn* col, const std::vector<std::string>& lookupTable) : col{col} {
-        for (auto&& [idx, str] : util::enumerate(lookupTable)) {
-            dict[str] = static_cast<std::uint32_t>(idx);
-        }
-    }
-
-    void append(const std::string& value) {
-        auto it = dict.find(value);
-        if (it != dict.end()) {
-            data.push_back(it->second);
-        } else {
-            auto newIdx = col->addCategory(value);
-            dict[value] = newIdx;
-            data.push_back(newIdx);
-        }
-    }
-
-    CategoricalColumn* col;
-    std::unordered_map<std::string, std::uint32_t> dict;
-    std::vector<std::uint32_t> data;
-};
-
-}  // namespace detail
-
 void CategoricalColumn::append(const Column& col) {
     if (col.getSize() == 0) return;
 
     if (auto srccol = dynamic_cast<const CategoricalColumn*>(&col)) {
-        detail::AppendHelper helper{this, lookUpTable_};
-        for (auto idx : srccol->getTypedBuffer()->getRAMRepresentation()->getDataContainer()) {
-            const auto& value = srccol->lookUpTable_[idx];
-            helper.append(value);
-        }
-        buffer_->getEditableRAMRepresentation()->append(helper.data);
+        // Merge the dictionaries and remap the ids of the source column
+        const auto remap = addCategories(srccol->lookUpTable_);
+        auto data = util::transform(srccol->getIDs(), [&](auto id) { return remap[id]; });
+        buffer_->getEditableRAMRepresentation()->append(data);
     } else {
         throw Exception("data formats of columns do not match", IVW_CONTEXT);
     }
 }
 
 void CategoricalColumn::append(const std::vector<std::string>& data) {
-    if (data.empty()) return;
+    append(data.begin(), data.end());
+}
+
+std::uint32_t CategoricalColumn::addCategory(std::string_view cat) { return addOrGetID(cat); }
+
+std::vector<std::uint32_t> CategoricalColumn::addCategories(
+    const std::vector<std::string>& categories) {
+    return util::transform(categories, [&](const std::string& cat) { return addOrGetID(cat); });
+}
 
-    detail::AppendHelper helper{this, lookUpTable_};
-    for (auto& value : data) {
-        helper.append(value);
+std::vector<std::uint32_t> CategoricalColumn::getIDMapping(const CategoricalColumn& other) const {
+    return util::transform(other.lookUpTable_, [&](const std::string& cat) { return getID(cat); });
+}
+
+std::vector<std::vector<size_t>> CategoricalColumn::groupRowsByID() const {
+    std::vector<std::vector<size_t>> groups(lookUpTable_.size());
+    for (auto&& [row, id] : util::enumerate(getIDs())) {
+        groups[id].push_back(row);
+    }
+    return groups;
+}
+
+std::uint32_t CategoricalColumn::getID(std::string_view cat) const {
+    if (hashTable_.empty()) return InvalidID;
+
+    const auto mask = hashTable_.size() - 1;
+    for (auto i = std::hash<std::string_view>{}(cat) & mask;; i = (i + 1) & mask) {
+        const auto slot = hashTable_[i];
+        if (slot == 0) return InvalidID;
+        if (lookUpTable_[slot - 1] == cat) return slot - 1;
     }
-    buffer_->getEditableRAMRepresentation()->append(helper.data);
 }
 
-std::uint32_t CategoricalColumn::addCategory(const std::string& cat) { return addOrGetID(cat); }
+glm::uint32_t CategoricalColumn::addOrGetID(std::string_view str) {
+    if (auto id = getID(str); id != InvalidID) return id;
+
+    const auto id = static_cast<glm::uint32_t>(lookUpTable_.size());
+    lookUpTable_.emplace_back(str);
+    if (2 * lookUpTable_.size() > hashTable_.size()) {
+        rehash();
+    } else {
+        insertHash(id);
+    }
+    return id;
+}
+
+void CategoricalColumn::insertHash(std::uint32_t id) {
+    const auto mask = hashTable_.size() - 1;
+    auto i = std::hash<std::string_view>{}(lookUpTable_[id]) & mask;
+    while (hashTable_[i] != 0) i = (i + 1) & mask;
+    hashTable_[i] = id + 1;
+}
 
-glm::uint32_t CategoricalColumn::addOrGetID(const std::string& str) {
-    auto it = std::find(lookUpTable_.begin(), lookUpTable_.end(), str);
-    if (it != lookUpTable_.end()) {
-        return static_cast<glm::uint32_t>(std::distance(lookUpTable_.begin(), it));
+void CategoricalColumn::rehash() {
+    size_t size = 16;
+    while (size < 2 * lookUpTable_.size()) size *= 2;
+    hashTable_.assign(size, 0);
+    for (size_t id = 0; id < lookUpTable_.size(); ++id) {
+        insertHash(static_cast<std::uint32_t>(id));
     }
-    lookUpTable_.push_back(str);
-    return static_cast<glm::uint32_t>(lookUpTable_.size() - 1);
 }
 
 }  // namespace inviwo
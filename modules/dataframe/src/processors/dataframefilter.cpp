@@ -0,0 +1,84 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/dataframe/processors/dataframefilter.h>
+#include <inviwo/dataframe/util/dataframeutil.h>
+
+#include <limits>
+
+namespace inviwo {
+
+// The Class Identifier has to be globally unique. Use a reverse DNS naming scheme
+const ProcessorInfo DataFrameFilter::processorInfo_{
+    "org.inviwo.DataFrameFilter",  // Class identifier
+    "DataFrame Filter",            // Display name
+    "DataFrame",                   // Category
+    CodeState::Experimental,       // Code state
+    "CPU, DataFrame",              // Tags
+};
+const ProcessorInfo DataFrameFilter::getProcessorInfo() const { return processorInfo_; }
+
+DataFrameFilter::DataFrameFilter()
+    : Processor()
+    , inport_("inport")
+    , outport_("outport")
+    , column_("column", "Column", inport_, false, 1)
+    , op_("comparison", "Comparison",
+          {{"less", "<", dataframe::CompareOp::Less},
+           {"lessEqual", "<=", dataframe::CompareOp::LessEqual},
+           {"equal", "==", dataframe::CompareOp::Equal},
+           {"notEqual", "!=", dataframe::CompareOp::NotEqual},
+           {"greaterEqual", ">=", dataframe::CompareOp::GreaterEqual},
+           {"greater", ">", dataframe::CompareOp::Greater}},
+          2)
+    , value_("value", "Value", 0.0, std::numeric_limits<double>::lowest(),
+             std::numeric_limits<double>::max())
+    , category_("category", "Category") {
+
+    addPort(inport_);
+    addPort(outport_);
+
+    addProperties(column_, op_, value_, category_);
+}
+
+void DataFrameFilter::process() {
+    const auto& dataframe = *inport_.getData();
+    auto col = column_.getColumn();
+    if (!col) {
+        outport_.setData(inport_.getData());
+        return;
+    }
+
+    const auto mask = dynamic_cast<const CategoricalColumn*>(col.get())
+                          ? dataframe::selectionMask(*col, op_, category_.get())
+                          : dataframe::selectionMask(*col, op_, value_.get());
+    outport_.setData(dataframe::selectRows(dataframe, dataframe::selectedRows(mask)));
+}
+
+}  // namespace inviwo
@@ -29,6 +29,8 @@
 
 #include <inviwo/dataframe/processors/dataframefloat32converter.h>
 
+#include <inviwo/core/util/dataconversion.h>
+
 namespace inviwo {
 
 // The Class Identifier has to be globally unique. Use a reverse DNS naming scheme
@@ -61,8 +63,9 @@ void DataFrameFloat32Converter::process() {
                     using ValueType = util::PrecisionValueType<decltype(typedBuf)>;
                     using T = typename util::same_extent<ValueType, float>::type;
 
-                    auto dst = util::transform(typedBuf->getDataContainer(),
-                                               [](const auto& v) { return static_cast<T>(v); });
+                    std::vector<T> dst(typedBuf->getSize());
+                    util::convertData(typedBuf->getDataFormat(), typedBuf->getData(),
+                                      DataFormat<T>::get(), dst.data(), dst.size());
                     dataframe->addColumn(srcCol->getHeader(), std::move(dst));
                 });
         } else {
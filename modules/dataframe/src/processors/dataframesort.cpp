@@ -0,0 +1,75 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/dataframe/processors/dataframesort.h>
+#include <inviwo/dataframe/util/dataframequery.h>
+#include <inviwo/dataframe/util/dataframeutil.h>
+
+namespace inviwo {
+
+// The Class Identifier has to be globally unique. Use a reverse DNS naming scheme
+const ProcessorInfo DataFrameSort::processorInfo_{
+    "org.inviwo.DataFrameSort",  // Class identifier
+    "DataFrame Sort",            // Display name
+    "DataFrame",                 // Category
+    CodeState::Experimental,     // Code state
+    "CPU, DataFrame",            // Tags
+};
+const ProcessorInfo DataFrameSort::getProcessorInfo() const { return processorInfo_; }
+
+DataFrameSort::DataFrameSort()
+    : Processor()
+    , inport_("inport")
+    , outport_("outport")
+    , key_("key", "Key Column", inport_, false, 1)
+    , ascending_("ascending", "Ascending", true)
+    , secondaryKey_("secondaryKey", "Secondary Key Column", inport_, true)
+    , secondaryAscending_("secondaryAscending", "Secondary Ascending", true) {
+
+    addPort(inport_);
+    addPort(outport_);
+
+    secondaryAscending_.visibilityDependsOn(secondaryKey_, [](const auto& p) { return p != -1; });
+    addProperties(key_, ascending_, secondaryKey_, secondaryAscending_);
+}
+
+void DataFrameSort::process() {
+    std::vector<dataframe::SortKey> keys;
+    if (auto col = key_.getColumn()) {
+        keys.push_back({col->getHeader(), ascending_});
+    }
+    if (auto col = secondaryKey_.getColumn()) {
+        keys.push_back({col->getHeader(), secondaryAscending_});
+    }
+
+    const auto& dataframe = *inport_.getData();
+    outport_.setData(dataframe::selectRows(dataframe, dataframe::sortedRows(dataframe, keys)));
+}
+
+}  // namespace inviwo
@@ -0,0 +1,438 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/dataframe/util/dataframequery.h>
+#include <inviwo/dataframe/util/dataframeutil.h>
+
+#include <inviwo/core/datastructures/buffer/bufferram.h>
+#include <inviwo/core/util/exception.h>
+#include <inviwo/core/util/foreach.h>
+#include <inviwo/core/util/formatdispatching.h>
+#include <inviwo/core/util/zip.h>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <optional>
+#include <unordered_map>
+
+namespace inviwo {
+
+namespace dataframe {
+
+namespace {
+
+constexpr size_t minRowsPerJob = size_t{1} << 14;
+
+/**
+ * Number of jobs used for processing \p rows rows, one if the pool is not running
+ */
+size_t jobCount(size_t rows) { return util::jobCount(rows, 1, minRowsPerJob); }
+
+/**
+ * Call \p func(job) for each job, see util::forEachRange
+ */
+template <typename Func>
+void runJobs(size_t jobs, Func&& func) {
+    util::forEachRange(jobs, jobs, [&](size_t job, size_t, size_t) { func(job); });
+}
+
+template <typename Func>
+void dispatchCompare(CompareOp op, Func&& func) {
+    switch (op) {
+        case CompareOp::Less:
+            return func(std::less<>{});
+        case CompareOp::LessEqual:
+            return func(std::less_equal<>{});
+        case CompareOp::Equal:
+            return func(std::equal_to<>{});
+        case CompareOp::NotEqual:
+            return func(std::not_equal_to<>{});
+        case CompareOp::GreaterEqual:
+            return func(std::greater_equal<>{});
+        case CompareOp::Greater:
+            return func(std::greater<>{});
+    }
+}
+
+template <typename T>
+bool isNaN([[maybe_unused]] T value) {
+    if constexpr (std::is_floating_point_v<T>) {
+        return std::isnan(value);
+    } else {
+        return false;
+    }
+}
+
+/**
+ * Stable sort of \p rows, each job sorts a range which are then merged pairwise. The left range
+ * always precedes the right one in a merge which keeps the sort stable.
+ */
+template <typename Comp>
+void stableSort(std::vector<size_t>& rows, Comp comp) {
+    const auto jobs = jobCount(rows.size());
+    const auto bound = [&](size_t job) { return rows.begin() + rows.size() * job / jobs; };
+
+    runJobs(jobs, [&](size_t job) { std::stable_sort(bound(job), bound(job + 1), comp); });
+    for (size_t width = 1; width < jobs; width *= 2) {
+        runJobs((jobs + 2 * width - 1) / (2 * width), [&](size_t merge) {
+            const auto first = merge * 2 * width;
+            if (first + width >= jobs) return;
+            std::inplace_merge(bound(first), bound(first + width),
+                               bound(std::min(first + 2 * width, jobs)), comp);
+        });
+    }
+}
+
+std::shared_ptr<const Column> getColumn(const DataFrame& dataframe, const std::string& header,
+                                        std::string_view context) {
+    if (auto col = dataframe.getColumn(header)) return col;
+    throw Exception(fmt::format("column '{}' not found", header),
+                    IVW_CONTEXT_CUSTOM(std::string{context}));
+}
+
+/**
+ * Dense id for each row of \p col such that rows with equal values share an id. All NaN values
+ * share an id.
+ */
+std::vector<std::uint32_t> valueIDs(const Column& col) {
+    if (auto catCol = dynamic_cast<const CategoricalColumn*>(&col)) {
+        return catCol->getIDs();
+    }
+    return col.getBuffer()
+        ->getRepresentation<BufferRAM>()
+        ->dispatch<std::vector<std::uint32_t>, dispatching::filter::Scalars>([](auto typedBuf) {
+            using ValueType = util::PrecisionValueType<decltype(typedBuf)>;
+            const auto& data = typedBuf->getDataContainer();
+
+            std::vector<std::uint32_t> ids(data.size());
+            std::unordered_map<ValueType, std::uint32_t> map;
+            std::uint32_t next = 0;
+            std::optional<std::uint32_t> nanID;
+            for (auto&& [i, value] : util::enumerate(data)) {
+                if (isNaN(value)) {
+                    if (!nanID) nanID = next++;
+                    ids[i] = *nanID;
+                } else {
+                    auto [it, inserted] = map.try_emplace(value, next);
+                    if (inserted) ++next;
+                    ids[i] = it->second;
+                }
+            }
+            return ids;
+        });
+}
+
+/**
+ * Per group statistics of a column, partial results of each job are merged afterwards
+ */
+struct GroupStats {
+    explicit GroupStats(size_t groups)
+        : sum(groups, 0.0)
+        , min(groups, std::numeric_limits<double>::infinity())
+        , max(groups, -std::numeric_limits<double>::infinity())
+        , valid(groups, 0) {}
+
+    void merge(const GroupStats& other) {
+        for (size_t g = 0; g < sum.size(); ++g) {
+            sum[g] += other.sum[g];
+            min[g] = std::min(min[g], other.min[g]);
+            max[g] = std::max(max[g], other.max[g]);
+            valid[g] += other.valid[g];
+        }
+    }
+
+    std::vector<double> sum;
+    std::vector<double> min;
+    std::vector<double> max;
+    std::vector<size_t> valid;
+};
+
+GroupStats groupStats(const Column& col, const std::vector<std::uint32_t>& groups,
+                      size_t groupCount) {
+    const auto jobs = jobCount(groups.size());
+    std::vector<GroupStats> partials(jobs, GroupStats{groupCount});
+
+    col.getBuffer()->getRepresentation<BufferRAM>()->dispatch<void, dispatching::filter::Scalars>(
+        [&](auto typedBuf) {
+            const auto& data = typedBuf->getDataContainer();
+            util::forEachRange(data.size(), jobs, [&](size_t begin, size_t end, size_t job) {
+                auto& stats = partials[job];
+                for (size_t i = begin; i < end; ++i) {
+                    if (isNaN(data[i])) continue;
+                    const auto value = static_cast<double>(data[i]);
+                    const auto g = groups[i];
+                    stats.sum[g] += value;
+                    stats.min[g] = std::min(stats.min[g], value);
+                    stats.max[g] = std::max(stats.max[g], value);
+                    ++stats.valid[g];
+                }
+            });
+        });
+
+    for (size_t job = 1; job < jobs; ++job) {
+        partials.front().merge(partials[job]);
+    }
+    return std::move(partials.front());
+}
+
+}  // namespace
+
+RowMask selectionMask(const Column& col, CompareOp op, double value) {
+    if (dynamic_cast<const CategoricalColumn*>(&col)) {
+        throw Exception(fmt::format("column '{}' is categorical, compare with a category instead",
+                                    col.getHeader()),
+                        IVW_CONTEXT_CUSTOM("dataframe::selectionMask"));
+    }
+
+    RowMask mask(col.getSize());
+    col.getBuffer()->getRepresentation<BufferRAM>()->dispatch<void, dispatching::filter::Scalars>(
+        [&](auto typedBuf) {
+            const auto* data = typedBuf->getDataContainer().data();
+            dispatchCompare(op, [&](auto cmp) {
+                const auto jobs = jobCount(mask.size());
+                util::forEachRange(mask.size(), jobs, [&](size_t begin, size_t end, size_t) {
+                    for (size_t i = begin; i < end; ++i) {
+                        mask[i] = cmp(static_cast<double>(data[i]), value);
+                    }
+                });
+            });
+        });
+    return mask;
+}
+
+RowMask selectionMask(const Column& col, CompareOp op, std::string_view value) {
+    auto catCol = dynamic_cast<const CategoricalColumn*>(&col);
+    if (!catCol) {
+        throw Exception(
+            fmt::format("column '{}' is not categorical, compare with a number instead",
+                        col.getHeader()),
+            IVW_CONTEXT_CUSTOM("dataframe::selectionMask"));
+    }
+
+    const auto& categories = catCol->getCategories();
+    RowMask lookup(categories.size());
+    dispatchCompare(op, [&](auto cmp) {
+        for (auto&& [id, category] : util::enumerate(categories)) {
+            lookup[id] = cmp(std::string_view{category}, value);
+        }
+    });
+
+    const auto& ids = catCol->getIDs();
+    RowMask mask(ids.size());
+    util::forEachRange(mask.size(), jobCount(mask.size()), [&](size_t begin, size_t end, size_t) {
+        for (size_t i = begin; i < end; ++i) mask[i] = lookup[ids[i]];
+    });
+    return mask;
+}
+
+RowMask maskAnd(const RowMask& a, const RowMask& b) {
+    if (a.size() != b.size()) {
+        throw Exception(fmt::format("mask size mismatch ({} != {})", a.size(), b.size()),
+                        IVW_CONTEXT_CUSTOM("dataframe::maskAnd"));
+    }
+    RowMask mask(a.size());
+    std::transform(a.begin(), a.end(), b.begin(), mask.begin(),
+                   [](auto x, auto y) -> std::uint8_t { return x && y; });
+    return mask;
+}
+
+RowMask maskOr(const RowMask& a, const RowMask& b) {
+    if (a.size() != b.size()) {
+        throw Exception(fmt::format("mask size mismatch ({} != {})", a.size(), b.size()),
+                        IVW_CONTEXT_CUSTOM("dataframe::maskOr"));
+    }
+    RowMask mask(a.size());
+    std::transform(a.begin(), a.end(), b.begin(), mask.begin(),
+                   [](auto x, auto y) -> std::uint8_t { return x || y; });
+    return mask;
+}
+
+std::vector<size_t> selectedRows(const RowMask& mask) {
+    std::vector<size_t> rows;
+    rows.reserve(static_cast<size_t>(
+        std::count_if(mask.begin(), mask.end(), [](auto m) { return m != 0; })));
+    for (size_t i = 0; i < mask.size(); ++i) {
+        if (mask[i]) rows.push_back(i);
+    }
+    return rows;
+}
+
+std::vector<size_t> sortedRows(const DataFrame& dataframe, const std::vector<SortKey>& keys) {
+    std::vector<size_t> rows(dataframe.getNumberOfRows());
+    std::iota(rows.begin(), rows.end(), size_t{0});
+
+    // sort by the least significant key first, each pass is stable and retains the order of the
+    // previous passes for equal keys
+    for (auto key = keys.rbegin(); key != keys.rend(); ++key) {
+        auto col = getColumn(dataframe, key->column, "dataframe::sortedRows");
+        const bool ascending = key->ascending;
+
+        if (auto catCol = dynamic_cast<const CategoricalColumn*>(col.get())) {
+            // sort by the rank of each category name
+            const auto& categories = catCol->getCategories();
+            std::vector<std::uint32_t> order(categories.size());
+            std::iota(order.begin(), order.end(), std::uint32_t{0});
+            std::sort(order.begin(), order.end(),
+                      [&](auto a, auto b) { return categories[a] < categories[b]; });
+            std::vector<std::uint32_t> rank(categories.size());
+            for (auto&& [r, id] : util::enumerate(order)) rank[id] = static_cast<std::uint32_t>(r);
+
+            const auto& ids = catCol->getIDs();
+            stableSort(rows, [&](size_t a, size_t b) {
+                return ascending ? rank[ids[a]] < rank[ids[b]] : rank[ids[a]] > rank[ids[b]];
+            });
+        } else {
+            col->getBuffer()
+                ->getRepresentation<BufferRAM>()
+                ->dispatch<void, dispatching::filter::Scalars>([&](auto typedBuf) {
+                    const auto& data = typedBuf->getDataContainer();
+                    const auto compare = [&](auto cmp) {
+                        return [&data, cmp](size_t a, size_t b) {
+                            if (isNaN(data[a])) return false;
+                            if (isNaN(data[b])) return true;
+                            return cmp(data[a], data[b]);
+                        };
+                    };
+                    if (ascending) {
+                        stableSort(rows, compare(std::less<>{}));
+                    } else {
+                        stableSort(rows, compare(std::greater<>{}));
+                    }
+                });
+        }
+    }
+    return rows;
+}
+
+std::shared_ptr<DataFrame> groupBy(const DataFrame& dataframe, const std::vector<std::string>& keys,
+                                   const std::vector<Aggregate>& aggregates) {
+    constexpr std::string_view context = "dataframe::groupBy";
+    const auto nrows = dataframe.getNumberOfRows();
+
+    // combine the value ids of all key columns into dense group ids, numbered in order of first
+    // appearance
+    std::vector<std::uint32_t> groups(nrows, 0);
+    size_t groupCount = nrows > 0 ? 1 : 0;
+    for (const auto& key : keys) {
+        const auto ids = valueIDs(*getColumn(dataframe, key, context));
+        std::unordered_map<std::uint64_t, std::uint32_t> map;
+        for (size_t i = 0; i < nrows; ++i) {
+            const auto combined = (std::uint64_t{groups[i]} << 32) | ids[i];
+            groups[i] = map.try_emplace(combined, static_cast<std::uint32_t>(map.size()))
+                            .first->second;
+        }
+        groupCount = map.size();
+    }
+
+    std::vector<size_t> firstRows;
+    std::vector<std::uint32_t> counts(groupCount, 0);
+    firstRows.reserve(groupCount);
+    for (size_t i = 0; i < nrows; ++i) {
+        if (counts[groups[i]]++ == 0) firstRows.push_back(i);
+    }
+
+    // selectRows keeps all columns for empty keys, a single group only gets the aggregates
+    auto result =
+        keys.empty() ? std::make_shared<DataFrame>() : selectRows(dataframe, firstRows, keys);
+
+    std::map<std::string, GroupStats> stats;
+    for (const auto& aggregate : aggregates) {
+        const auto header =
+            aggregate.aggregation == Aggregation::Count
+                ? std::string{"count"}
+                : fmt::format("{}({})", toString(aggregate.aggregation), aggregate.column);
+
+        if (aggregate.aggregation == Aggregation::Count) {
+            result->addColumn(header, counts);
+            continue;
+        }
+
+        auto col = getColumn(dataframe, aggregate.column, context);
+        if (dynamic_cast<const CategoricalColumn*>(col.get())) {
+            throw Exception(fmt::format("cannot compute {} of categorical column '{}'",
+                                        toString(aggregate.aggregation), aggregate.column),
+                            IVW_CONTEXT_CUSTOM(std::string{context}));
+        }
+        auto it = stats.find(aggregate.column);
+        if (it == stats.end()) {
+            it = stats.emplace(aggregate.column, groupStats(*col, groups, groupCount)).first;
+        }
+        const auto& s = it->second;
+
+        std::vector<double> values(groupCount, std::numeric_limits<double>::quiet_NaN());
+        for (size_t g = 0; g < groupCount; ++g) {
+            if (s.valid[g] == 0) continue;
+            switch (aggregate.aggregation) {
+                case Aggregation::Sum:
+                    values[g] = s.sum[g];
+                    break;
+                case Aggregation::Mean:
+                    values[g] = s.sum[g] / static_cast<double>(s.valid[g]);
+                    break;
+                case Aggregation::Min:
+                    values[g] = s.min[g];
+                    break;
+                case Aggregation::Max:
+                    values[g] = s.max[g];
+                    break;
+                case Aggregation::Count:
+                    break;
+            }
+        }
+        result->addColumn(header, std::move(values));
+    }
+    result->updateIndexBuffer();
+    return result;
+}
+
+std::string_view toString(Aggregation aggregation) {
+    switch (aggregation) {
+        case Aggregation::Count:
+            return "count";
+        case Aggregation::Sum:
+            return "sum";
+        case Aggregation::Mean:
+            return "mean";
+        case Aggregation::Min:
+            return "min";
+        case Aggregation::Max:
+            return "max";
+    }
+    return "unknown";
+}
+
+}  // namespace dataframe
+
+}  // namespace inviwo
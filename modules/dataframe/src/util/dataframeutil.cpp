@@ -204,17 +204,18 @@ std::vector<std::vector<size_t>> getMatchingRows(std::shared_ptr<const Column> l
         auto catCol2 = dynamic_cast<const CategoricalColumn*>(rightCol.get());
         IVW_ASSERT(catCol2, "right column is not categorical");
 
-        auto valuesRight = catCol2->getValues();
-        for (auto&& [i, key] : util::enumerate(catCol1->getValues())) {
-            // find all matching rows in right column
-            std::vector<size_t> matches;
-            for (auto&& [r, value] : util::enumerate(valuesRight)) {
-                if (key == value) {
-                    matches.emplace_back(r);
-                    if constexpr (firstMatchOnly) break;
-                }
+        // map the ids of the right column to the ids of the left one and group the right rows
+        // by id, then each left row matches the group of its id
+        const auto mapping = catCol1->getIDMapping(*catCol2);
+        std::vector<std::vector<size_t>> rightRows(catCol1->getCategories().size());
+        for (auto&& [r, id] : util::enumerate(catCol2->getIDs())) {
+            if (const auto leftID = mapping[id]; leftID != CategoricalColumn::InvalidID) {
+                if (firstMatchOnly && !rightRows[leftID].empty()) continue;
+                rightRows[leftID].emplace_back(r);
             }
-            rows[i] = std::move(matches);
+        }
+        for (auto&& [i, id] : util::enumerate(catCol1->getIDs())) {
+            rows[i] = rightRows[id];
         }
     } else {
         leftCol->getBuffer()->getRepresentation<BufferRAM>()->dispatch<void>(
@@ -257,12 +258,14 @@ std::vector<std::vector<size_t>> getMatchingRows(const DataFrame& left, const Da
             auto catCol2 = dynamic_cast<const CategoricalColumn*>(rightCol.get());
             IVW_ASSERT(catCol2, "right column is not categorical");
 
-            auto valuesLeft = catCol1->getValues();
-            auto valuesRight = catCol2->getValues();
+            const auto mapping = catCol1->getIDMapping(*catCol2);
+            const auto& idsLeft = catCol1->getIDs();
+            const auto& idsRight = catCol2->getIDs();
             for (auto&& [i, rowMatches] : util::enumerate(rows)) {
-                util::erase_remove_if(rowMatches, [key = valuesLeft[i], &valuesRight](auto row) {
-                    return key != valuesRight[row];
-                });
+                util::erase_remove_if(rowMatches,
+                                      [key = idsLeft[i], &idsRight, &mapping](auto row) {
+                                          return key != mapping[idsRight[row]];
+                                      });
             }
         } else {
             leftCol->getBuffer()->getRepresentation<BufferRAM>()->dispatch<void>(
@@ -285,6 +288,50 @@ std::vector<std::vector<size_t>> getMatchingRows(const DataFrame& left, const Da
     return rows;
 }
 
+/**
+ * \brief create a categorical column with the given rows of \p col, "undefined" for missing rows
+ *
+ * Only the categories of the selected rows are kept, in order of first appearance. Works on the
+ * category ids and looks up each source category only once.
+ */
+template <typename Rows, typename GetRow>
+std::shared_ptr<CategoricalColumn> selectRows(const CategoricalColumn& col, const Rows& rows,
+                                              GetRow getRow) {
+    auto dst = std::make_shared<CategoricalColumn>(col.getHeader());
+    const auto& ids = col.getIDs();
+    const auto& categories = col.getCategories();
+
+    std::vector<std::uint32_t> remap(categories.size(), CategoricalColumn::InvalidID);
+    std::vector<std::uint32_t> data;
+    data.reserve(rows.size());
+    for (const auto& item : rows) {
+        if (const std::optional<size_t> row = getRow(item)) {
+            auto& id = remap[ids[*row]];
+            if (id == CategoricalColumn::InvalidID) id = dst->addCategory(categories[ids[*row]]);
+            data.push_back(id);
+        } else {
+            data.push_back(dst->addCategory("undefined"));
+        }
+    }
+    dst->getTypedBuffer()->getEditableRAMRepresentation()->append(data);
+    return dst;
+}
+
+std::shared_ptr<Column> selectRows(const Column& col, const std::vector<size_t>& rows) {
+    if (auto c = dynamic_cast<const CategoricalColumn*>(&col)) {
+        return selectRows(*c, rows, [](size_t i) { return std::optional<size_t>{i}; });
+    } else {
+        return col.getBuffer()->getRepresentation<BufferRAM>()->dispatch<std::shared_ptr<Column>>(
+            [&](auto typedBuf) -> std::shared_ptr<Column> {
+                using ValueType = util::PrecisionValueType<decltype(typedBuf)>;
+                auto dstData = util::transform(
+                    rows, [& src = typedBuf->getDataContainer()](size_t i) { return src[i]; });
+                return std::make_shared<TemplateColumn<ValueType>>(col.getHeader(),
+                                                                   std::move(dstData));
+            });
+    }
+}
+
 void addColumns(std::shared_ptr<DataFrame> dst, const DataFrame& srcDataFrame,
                 const std::vector<std::string>& keyColumns, bool skipKeyCol) {
     for (auto srcCol : srcDataFrame) {
@@ -305,17 +352,7 @@ void addColumns(std::shared_ptr<DataFrame> dst, const DataFrame& srcDataFrame,
             continue;
         }
 
-        if (auto c = dynamic_cast<CategoricalColumn*>(srcCol.get())) {
-            auto data = util::transform(rows, [src = c->getValues()](size_t i) { return src[i]; });
-            dst->addCategoricalColumn(c->getHeader(), data);
-        } else {
-            srcCol->getBuffer()->getRepresentation<BufferRAM>()->dispatch<void>(
-                [dst, srcCol, header = srcCol->getHeader(), rows](auto typedBuf) {
-                    auto dstData = util::transform(
-                        rows, [& src = typedBuf->getDataContainer()](size_t i) { return src[i]; });
-                    dst->addColumn(header, std::move(dstData));
-                });
-        }
+        dst->addColumn(selectRows(*srcCol, rows));
     }
 }
 
@@ -329,10 +366,7 @@ void addColumns(std::shared_ptr<DataFrame> dst, const DataFrame& srcDataFrame,
         }
 
         if (auto c = dynamic_cast<CategoricalColumn*>(srcCol.get())) {
-            auto data = util::transform(rows, [src = c->getValues()](auto v) {
-                return v.has_value() ? src[v.value()] : "undefined";
-            });
-            dst->addCategoricalColumn(c->getHeader(), data);
+            dst->addColumn(selectRows(*c, rows, [](const std::optional<size_t>& i) { return i; }));
         } else {
             srcCol->getBuffer()->getRepresentation<BufferRAM>()->dispatch<void>(
                 [dst, srcCol, header = srcCol->getHeader(), rows](auto typedBuf) {
@@ -349,6 +383,28 @@ void addColumns(std::shared_ptr<DataFrame> dst, const DataFrame& srcDataFrame,
 
 }  // namespace detail
 
+std::shared_ptr<DataFrame> selectRows(const DataFrame& dataframe, const std::vector<size_t>& rows,
+                                      const std::vector<std::string>& columns) {
+    auto dst = std::make_shared<DataFrame>();
+    if (columns.empty()) {
+        for (auto srcCol : dataframe) {
+            if (srcCol == dataframe.getIndexColumn()) continue;
+            dst->addColumn(detail::selectRows(*srcCol, rows));
+        }
+    } else {
+        for (const auto& header : columns) {
+            auto srcCol = dataframe.getColumn(header);
+            if (!srcCol) {
+                throw Exception(fmt::format("column '{}' not found", header),
+                                IVW_CONTEXT_CUSTOM("dataframe::selectRows"));
+            }
+            dst->addColumn(detail::selectRows(*srcCol, rows));
+        }
+    }
+    dst->updateIndexBuffer();
+    return dst;
+}
+
 std::shared_ptr<DataFrame> innerJoin(const DataFrame& left, const DataFrame& right,
                                      const std::string& keyColumn) {
     detail::columnCheck(left, right, {keyColumn}, "dataframe::innerJoin");
@@ -177,6 +177,70 @@ TEST(ColumnAppend, CategoricalThrow) {
     EXPECT_THROW(col.append(intCol), Exception);
 }
 
+TEST(ColumnAppend, CategoricalIDs) {
+    CategoricalColumn col("Column", {"a", "c", "b", "a"});
+    CategoricalColumn col2("Column 2", {"d", "b", "a"});
+
+    col.append(col2);
+
+    const std::vector<std::uint32_t> expected = {0, 1, 2, 0, 3, 2, 0};
+    EXPECT_EQ(expected, col.getIDs()) << "Ids after append are not remapped correctly";
+    EXPECT_EQ("d", col.getAsString(4));
+}
+
+TEST(ColumnAppend, CategoricalStringViews) {
+    CategoricalColumn col("Column");
+    const std::vector<std::string_view> values = {"x", "y", "x", "z", "y"};
+    col.append(values.begin(), values.end());
+
+    const std::vector<std::string> expected = {"x", "y", "z"};
+    EXPECT_EQ(expected, col.getCategories());
+    EXPECT_EQ(5, col.getSize());
+    EXPECT_EQ("z", col.getAsString(3));
+}
+
+TEST(CategoricalColumn, Lookup) {
+    CategoricalColumn col("Column");
+    for (int i = 0; i < 1000; ++i) {
+        col.add(std::to_string(i % 100));
+    }
+
+    EXPECT_EQ(100, col.getCategories().size());
+    EXPECT_EQ(1000, col.getSize());
+    EXPECT_EQ(42, col.getID("42"));
+    EXPECT_EQ(CategoricalColumn::InvalidID, col.getID("100"));
+    EXPECT_EQ(42, col.addCategory("42"));
+    EXPECT_EQ(100, col.addCategory("100"));
+
+    CategoricalColumn copy(col);
+    EXPECT_EQ(99, copy.getID("99")) << "Dictionary not copied";
+}
+
+TEST(CategoricalColumn, IDMapping) {
+    CategoricalColumn col("Column", {"a", "b", "c"});
+    CategoricalColumn other("Other", {"c", "d", "a"});
+
+    const std::vector<std::uint32_t> expected = {2, CategoricalColumn::InvalidID, 0};
+    EXPECT_EQ(expected, col.getIDMapping(other));
+    EXPECT_EQ(3, col.getCategories().size()) << "Mapping should not add categories";
+}
+
+TEST(CategoricalColumn, GroupAndFilter) {
+    CategoricalColumn col("Column", {"a", "b", "a", "c", "b", "a"});
+
+    const std::vector<std::vector<size_t>> expectedGroups = {{0, 2, 5}, {1, 4}, {3}};
+    EXPECT_EQ(expectedGroups, col.groupRowsByID());
+
+    size_t calls = 0;
+    const auto rows = col.filteredRows([&](const std::string& cat) {
+        ++calls;
+        return cat != "a";
+    });
+    const std::vector<size_t> expectedRows = {1, 3, 4};
+    EXPECT_EQ(expectedRows, rows);
+    EXPECT_EQ(3, calls) << "Predicate should be called once per category";
+}
+
 TEST(ColumnAppend, TypeMismatch) {
     TemplateColumn<int> intCol("IntCol", {0, 1, 2, 3});
     TemplateColumn<float> floatCol("FloatCol", {0.1f, 1.1f, 2.1f, 3.1f});
@@ -0,0 +1,185 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/dataframe/datastructures/column.h>
+#include <inviwo/dataframe/datastructures/dataframe.h>
+#include <inviwo/dataframe/util/dataframequery.h>
+#include <inviwo/dataframe/util/dataframeutil.h>
+
+#include <inviwo/core/datastructures/buffer/buffer.h>
+#include <inviwo/core/datastructures/buffer/bufferramprecision.h>
+#include <inviwo/core/util/exception.h>
+
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace inviwo {
+
+namespace {
+
+template <typename T>
+const std::vector<T>& columnData(const Column& col) {
+    return static_cast<const BufferRAMPrecision<T>*>(
+               col.getBuffer()->getRepresentation<BufferRAM>())
+        ->getDataContainer();
+}
+
+DataFrame createDataFrame() {
+    DataFrame df;
+    df.addCategoricalColumn("cat", {"b", "a", "c", "a", "b", "a"});
+    df.addColumn("int", std::vector<int>{3, 1, 2, 1, 3, 2});
+    df.addColumn("float",
+                 std::vector<float>{1.0f, std::numeric_limits<float>::quiet_NaN(), 3.0f, 4.0f,
+                                    5.0f, 6.0f});
+    df.updateIndexBuffer();
+    return df;
+}
+
+}  // namespace
+
+TEST(DataFrameQuery, SelectionMask) {
+    auto df = createDataFrame();
+
+    auto mask = dataframe::selectionMask(*df.getColumn("int"), dataframe::CompareOp::Less, 2.5);
+    EXPECT_EQ(dataframe::RowMask({0, 1, 1, 1, 0, 1}), mask);
+
+    auto catMask =
+        dataframe::selectionMask(*df.getColumn("cat"), dataframe::CompareOp::Equal, "a");
+    EXPECT_EQ(dataframe::RowMask({0, 1, 0, 1, 0, 1}), catMask);
+
+    // NaN never compares
+    auto floatMask =
+        dataframe::selectionMask(*df.getColumn("float"), dataframe::CompareOp::GreaterEqual, 3.0);
+    EXPECT_EQ(dataframe::RowMask({0, 0, 1, 1, 1, 1}), floatMask);
+
+    EXPECT_EQ(std::vector<size_t>({1, 3, 5}),
+              dataframe::selectedRows(dataframe::maskAnd(mask, catMask)));
+    EXPECT_EQ(std::vector<size_t>({1, 2, 3, 4, 5}),
+              dataframe::selectedRows(dataframe::maskOr(mask, floatMask)));
+
+    EXPECT_THROW(dataframe::selectionMask(*df.getColumn("cat"), dataframe::CompareOp::Less, 1.0),
+                 Exception);
+    EXPECT_THROW(dataframe::selectionMask(*df.getColumn("int"), dataframe::CompareOp::Less, "a"),
+                 Exception);
+}
+
+TEST(DataFrameQuery, SortMultipleKeys) {
+    auto df = createDataFrame();
+
+    auto rows = dataframe::sortedRows(df, {{"cat", true}, {"int", false}});
+    EXPECT_EQ(std::vector<size_t>({5, 1, 3, 0, 4, 2}), rows);
+
+    // stable, NaN last
+    rows = dataframe::sortedRows(df, {{"float", false}});
+    EXPECT_EQ(std::vector<size_t>({5, 4, 3, 2, 0, 1}), rows);
+
+    auto sorted = dataframe::selectRows(df, dataframe::sortedRows(df, {{"int", true}}));
+    ASSERT_EQ(size_t{6}, sorted->getNumberOfRows());
+    EXPECT_EQ(std::vector<int>({1, 1, 2, 2, 3, 3}), columnData<int>(*sorted->getColumn("int")));
+    EXPECT_EQ("a", sorted->getColumn("cat")->getAsString(0));
+    EXPECT_EQ("c", sorted->getColumn("cat")->getAsString(2));
+
+    EXPECT_THROW(dataframe::sortedRows(df, {{"missing", true}}), Exception);
+}
+
+TEST(DataFrameQuery, SortLarge) {
+    // enough rows to be split into several sorted ranges when a thread pool is running. The unit
+    // tests run without an application, hence this only covers the single range path.
+    const size_t size = 200000;
+    std::vector<int> values(size);
+    for (size_t i = 0; i < size; ++i) values[i] = static_cast<int>((i * 7919) % 1000);
+
+    DataFrame df;
+    df.addColumn("int", values);
+    df.updateIndexBuffer();
+
+    const auto rows = dataframe::sortedRows(df, {{"int", true}});
+    ASSERT_EQ(size, rows.size());
+    for (size_t i = 1; i < size; ++i) {
+        ASSERT_TRUE(values[rows[i - 1]] < values[rows[i]] ||
+                    (values[rows[i - 1]] == values[rows[i]] && rows[i - 1] < rows[i]))
+            << "row " << i;
+    }
+}
+
+TEST(DataFrameQuery, GroupBy) {
+    auto df = createDataFrame();
+
+    auto grouped = dataframe::groupBy(df, {"cat"},
+                                      {{"", dataframe::Aggregation::Count},
+                                       {"int", dataframe::Aggregation::Sum},
+                                       {"float", dataframe::Aggregation::Mean},
+                                       {"float", dataframe::Aggregation::Max}});
+
+    ASSERT_EQ(size_t{3}, grouped->getNumberOfRows());
+    EXPECT_EQ("b", grouped->getColumn("cat")->getAsString(0));
+    EXPECT_EQ("a", grouped->getColumn("cat")->getAsString(1));
+    EXPECT_EQ("c", grouped->getColumn("cat")->getAsString(2));
+    EXPECT_EQ(std::vector<std::uint32_t>({2, 3, 1}),
+              columnData<std::uint32_t>(*grouped->getColumn("count")));
+    EXPECT_EQ(std::vector<double>({6.0, 4.0, 2.0}),
+              columnData<double>(*grouped->getColumn("sum(int)")));
+    EXPECT_EQ(std::vector<double>({3.0, 5.0, 3.0}),
+              columnData<double>(*grouped->getColumn("mean(float)")));
+    EXPECT_EQ(std::vector<double>({5.0, 6.0, 3.0}),
+              columnData<double>(*grouped->getColumn("max(float)")));
+
+    EXPECT_THROW(dataframe::groupBy(df, {"int"}, {{"cat", dataframe::Aggregation::Sum}}),
+                 Exception);
+}
+
+TEST(DataFrameQuery, GroupByMultipleKeys) {
+    auto df = createDataFrame();
+
+    auto grouped = dataframe::groupBy(df, {"cat", "int"},
+                                      {{"float", dataframe::Aggregation::Min},
+                                       {"", dataframe::Aggregation::Count}});
+    ASSERT_EQ(size_t{4}, grouped->getNumberOfRows());
+    EXPECT_EQ(std::vector<int>({3, 1, 2, 2}), columnData<int>(*grouped->getColumn("int")));
+    EXPECT_EQ(std::vector<std::uint32_t>({2, 2, 1, 1}),
+              columnData<std::uint32_t>(*grouped->getColumn("count")));
+
+    // group ("a", 1) only contains a NaN and a valid value
+    const auto& mins = columnData<double>(*grouped->getColumn("min(float)"));
+    EXPECT_EQ(std::vector<double>({1.0, 4.0, 3.0, 6.0}), mins);
+
+    auto all = dataframe::groupBy(df, {}, {{"int", dataframe::Aggregation::Sum}});
+    ASSERT_EQ(size_t{1}, all->getNumberOfRows());
+    // only the index and the aggregate column
+    EXPECT_EQ(size_t{2}, all->getNumberOfColumns());
+    EXPECT_EQ(12.0, columnData<double>(*all->getColumn("sum(int)"))[0]);
+}
+
+}  // namespace inviwo
@@ -39,6 +39,7 @@
 #include <inviwo/dataframe/datastructures/column.h>
 #include <inviwo/dataframe/datastructures/dataframe.h>
 #include <inviwo/dataframe/datastructures/datapoint.h>
+#include <inviwo/dataframe/util/dataframequery.h>
 #include <inviwo/dataframe/util/dataframeutil.h>
 
 #include <inviwo/core/util/defaultvalues.h>
@@ -291,6 +292,78 @@ are undefined.
 Parameters
 ----------
 keycolumns    list of headers of the columns used as key for the join operation
+)delim")
+        .def("selectRows", dataframe::selectRows, py::arg("dataframe"), py::arg("rows"),
+             py::arg("columns") = std::vector<std::string>{},
+             R"delim(
+Create a new DataFrame holding the given rows of dataframe in the given order
+
+Parameters
+----------
+rows       list of row indices, may contain duplicates
+columns    headers of the columns to keep, all columns are kept if empty
+)delim");
+
+    py::enum_<dataframe::CompareOp>(m, "CompareOp")
+        .value("Less", dataframe::CompareOp::Less)
+        .value("LessEqual", dataframe::CompareOp::LessEqual)
+        .value("Equal", dataframe::CompareOp::Equal)
+        .value("NotEqual", dataframe::CompareOp::NotEqual)
+        .value("GreaterEqual", dataframe::CompareOp::GreaterEqual)
+        .value("Greater", dataframe::CompareOp::Greater);
+
+    py::enum_<dataframe::Aggregation>(m, "Aggregation")
+        .value("Count", dataframe::Aggregation::Count)
+        .value("Sum", dataframe::Aggregation::Sum)
+        .value("Mean", dataframe::Aggregation::Mean)
+        .value("Min", dataframe::Aggregation::Min)
+        .value("Max", dataframe::Aggregation::Max);
+
+    py::class_<dataframe::SortKey>(m, "SortKey")
+        .def(py::init<std::string, bool>(), py::arg("column"), py::arg("ascending") = true)
+        .def_readwrite("column", &dataframe::SortKey::column)
+        .def_readwrite("ascending", &dataframe::SortKey::ascending);
+
+    py::class_<dataframe::Aggregate>(m, "Aggregate")
+        .def(py::init<std::string, dataframe::Aggregation>(), py::arg("column"),
+             py::arg("aggregation"))
+        .def_readwrite("column", &dataframe::Aggregate::column)
+        .def_readwrite("aggregation", &dataframe::Aggregate::aggregation);
+
+    m.def("selectionMask",
+          py::overload_cast<const Column&, dataframe::CompareOp, double>(
+              dataframe::selectionMask),
+          py::arg("column"), py::arg("op"), py::arg("value"),
+          R"delim(
+Compare every value of a numerical column with value, returns a list with 1 for matching rows
+)delim")
+        .def("selectionMask",
+             py::overload_cast<const Column&, dataframe::CompareOp, std::string_view>(
+                 dataframe::selectionMask),
+             py::arg("column"), py::arg("op"), py::arg("value"),
+             R"delim(
+Compare the categories of a categorical column with value, returns a list with 1 for
+matching rows
+)delim")
+        .def("maskAnd", dataframe::maskAnd, py::arg("a"), py::arg("b"))
+        .def("maskOr", dataframe::maskOr, py::arg("a"), py::arg("b"))
+        .def("selectedRows", dataframe::selectedRows, py::arg("mask"),
+             "Convert a selection mask into a list of the selected row indices")
+        .def("sortedRows", dataframe::sortedRows, py::arg("dataframe"), py::arg("keys"),
+             R"delim(
+Stable sort of the rows of dataframe with respect to a list of SortKeys, the first key being
+the most significant one. Returns the row indices in sorted order.
+)delim")
+        .def("groupBy", dataframe::groupBy, py::arg("dataframe"), py::arg("keys"),
+             py::arg("aggregates"),
+             R"delim(
+Group the rows of dataframe by the values of the key columns and compute the aggregates for
+each group. Returns a DataFrame with one row per group.
+
+Parameters
+----------
+keys          headers of the key columns, all rows form a single group if empty
+aggregates    list of Aggregates, result columns are named like "mean(x)" and "count"
 )delim");
 
     exposeStandardDataPorts<DataFrame>(m, "DataFrame");
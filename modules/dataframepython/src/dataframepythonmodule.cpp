@@ -38,6 +38,7 @@ namespace inviwo {
 DataFramePythonModule::DataFramePythonModule(InviwoApplication* app)
     : InviwoModule(app, "DataFramePython") {
 
+    pybind11::gil_scoped_acquire gil;
     try {
         pybind11::module::import("ivwdataframe");
     } catch (const std::exception& e) {
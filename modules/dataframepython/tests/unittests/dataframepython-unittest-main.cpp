@@ -51,6 +51,11 @@
 #include <gtest/gtest.h>
 #include <warn/pop>
 
+#include <warn/push>
+#include <warn/ignore/shadow>
+#include <pybind11/pybind11.h>
+#include <warn/pop>
+
 int main(int argc, char** argv) {
     using namespace inviwo;
     LogCentral::init();
@@ -82,6 +87,8 @@ int main(int argc, char** argv) {
         ::testing::InitGoogleTest(&argc, argv);
 #endif
         inviwo::ConfigurableGTestEventListener::setup();
+        // The interpreter releases the GIL after initialization, the tests expect to hold it
+        pybind11::gil_scoped_acquire gil;
         ret = RUN_ALL_TESTS();
     }
     return ret;
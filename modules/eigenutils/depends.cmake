@@ -3,3 +3,5 @@
 # List modules on the format "Inviwo<ModuleName>Module"
 set(dependencies
 )
+
+set(concurrent ON)
@@ -4,3 +4,5 @@
 set(dependencies
     InviwoBaseModule
 )
+
+set(concurrent ON)
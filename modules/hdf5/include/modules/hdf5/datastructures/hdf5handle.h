@@ -46,6 +46,7 @@
 #include <modules/hdf5/hdf5exception.h>
 
 #include <limits>
+#include <mutex>
 #include <functional>
 #include <type_traits>
 #include <string>
@@ -87,6 +88,18 @@ public:
                                                   std::vector<Selection> selection,
                                                   const DataFormatBase* type) const;
 
+    /**
+     * Create a volume of the selection without reading any data. The volume only has a disk
+     * representation, the data is read when a VolumeRAM is requested, and util::readVolumeRegion
+     * only reads the needed hyperslab. For integer formats the data range of the volume is set
+     * from the data format, for floating point formats the selection is scanned once, one slab at
+     * a time, without keeping the data.
+     * @see VolumeRAMLoader
+     */
+    std::shared_ptr<Volume> getLazyVolumeAtPathAsType(const Path& path,
+                                                      std::vector<Selection> selection,
+                                                      const DataFormatBase* type) const;
+
     template <typename T>
     std::vector<T> getVectorAtPath(const Path& path) const;
 
@@ -98,6 +111,8 @@ public:
     static const std::string dataName;
 
 private:
+    std::shared_ptr<Volume> createVolume(const Path& path, std::vector<Selection> selection,
+                                         const DataFormatBase* type) const;
     double getMin(const DataFormatBase* type) const;
     double getMax(const DataFormatBase* type) const;
 
@@ -108,6 +123,7 @@ private:
 
 template <typename T>
 std::vector<T> Handle::getVectorAtPath(const Path& path) const {
+    std::lock_guard<std::recursive_mutex> lock{libraryMutex()};
     H5::DataSet ds = data_.openDataSet(path);
     size_t rank = ds.getSpace().getSimpleExtentNdims();
 
@@ -131,6 +147,7 @@ std::vector<T> Handle::getVectorAtPath(const Path& path) const {
 
 template <typename T>
 std::vector<glm::tvec3<T, glm::defaultp>> Handle::getVectorOfVec3AtPath(const Path& path) const {
+    std::lock_guard<std::recursive_mutex> lock{libraryMutex()};
     H5::DataSet ds = data_.openDataSet(path);
     size_t rank = ds.getSpace().getSimpleExtentNdims();
 
@@ -0,0 +1,124 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <modules/hdf5/hdf5moduledefine.h>
+#include <modules/hdf5/datastructures/hdf5handle.h>
+#include <modules/hdf5/datastructures/hdf5path.h>
+
+#include <inviwo/core/datastructures/volume/volumedisk.h>
+#include <inviwo/core/util/glmvec.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace inviwo {
+
+namespace hdf5 {
+
+/**
+ * \brief Reads a selection of a HDF5 data set into a VolumeRAM on demand.
+ * The loader only stores the file name, the path of the data set, and the selection. Reads are
+ * split into slabs aligned to the chunks of the data set, and the chunk cache is made large
+ * enough to hold one slab, such that every chunk is read and decompressed only once. Sub regions
+ * of the selection can be read with readRegion, see util::readVolumeRegion.
+ */
+class IVW_MODULE_HDF5_API VolumeRAMLoader : public VolumeRegionLoader {
+public:
+    /**
+     * @param filename  the HDF5 file
+     * @param path      absolute path of the data set in the file
+     * @param selection one entry per dimension of the data set in column major order, i.e. as
+     *                  passed to Handle::getVolumeAtPathAsType. At most three dimensions can
+     *                  select more than one element.
+     */
+    VolumeRAMLoader(std::string filename, Path path, std::vector<Handle::Selection> selection);
+    virtual VolumeRAMLoader* clone() const override;
+    virtual ~VolumeRAMLoader() = default;
+
+    virtual std::shared_ptr<VolumeRepresentation> createRepresentation(
+        const VolumeRepresentation& src) const override;
+    virtual void updateRepresentation(std::shared_ptr<VolumeRepresentation> dest,
+                                      const VolumeRepresentation& src) const override;
+    virtual std::shared_ptr<VolumeRAM> readRegion(const VolumeRepresentation& src, size3_t offset,
+                                                  size3_t dims) const override;
+
+    /**
+     * Dimensions of the selection as a volume
+     */
+    size3_t getDimensions() const;
+    /**
+     * Format of the data set
+     */
+    const DataFormatBase* getDataFormat() const;
+
+    /**
+     * Scan the selection for its minimum and maximum value, one slab at a time, without keeping
+     * the data. NaN and infinite values are ignored.
+     */
+    dvec2 dataRange(const VolumeRepresentation& src) const;
+
+private:
+    void read(size3_t offset, VolumeRAM& dest) const;
+
+    std::string filename_;
+    Path path_;
+    const DataFormatBase* format_;
+
+    // Row major, one entry per dimension of the data set
+    std::vector<hsize_t> start_;
+    std::vector<hsize_t> count_;
+    std::vector<hsize_t> stride_;
+    std::vector<hsize_t> chunk_;  // Empty if the data set is not chunked
+
+    // The data set dimensions selecting more than one element, slowest varying first. Entry i
+    // corresponds to the volume dimension 2 - i.
+    std::vector<size_t> axes_;
+    size_t cacheChunks_;  // Number of chunks in one slab
+    size_t cacheSize_;    // Bytes of one slab
+};
+
+namespace util {
+
+/**
+ * Split the indices [0, count) of the selection start + i * stride into ranges [begin, end)
+ * that do not cross a boundary of chunks of the given size.
+ */
+IVW_MODULE_HDF5_API std::vector<std::pair<hsize_t, hsize_t>> chunkSlabs(hsize_t start,
+                                                                       hsize_t count,
+                                                                       hsize_t stride,
+                                                                       hsize_t chunk);
+
+}  // namespace util
+
+}  // namespace hdf5
+
+}  // namespace inviwo
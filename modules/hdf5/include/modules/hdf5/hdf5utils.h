@@ -39,6 +39,8 @@
 #include <H5Cpp.h>
 #include <warn/pop>
 
+#include <mutex>
+
 namespace inviwo {
 
 namespace hdf5 {
@@ -57,6 +59,12 @@ IVW_MODULE_HDF5_API Paths findpaths(const H5::Group& grp, const Path& path,
 IVW_MODULE_HDF5_API bool isOfType(const H5::Group& grp, const std::string& type);
 IVW_MODULE_HDF5_API VolumeInfos getVolumeInfo(const H5::DataSet& ds, const Path& path);
 
+/**
+ * The HDF5 library is not built thread safe, and volumes are loaded on demand from background
+ * threads. Every call into the library has to hold this mutex.
+ */
+IVW_MODULE_HDF5_API std::recursive_mutex& libraryMutex();
+
 }  // namespace hdf5
 
 }  // namespace inviwo
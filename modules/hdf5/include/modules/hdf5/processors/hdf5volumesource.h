@@ -79,6 +79,9 @@ namespace hdf5 {
  *   * __Source__ ...
  *   * __Convert to type__ ...
  *   * __Volume__ ...
+ *   * __Load on demand__ Only read the data when it is used, and only the needed part of it for
+ *     example in a Volume Subset. The data range is then not known and is set from the data type,
+ *     use a custom data range to override it.
  *
  */
 class IVW_MODULE_HDF5_API HDF5ToVolume : public Processor {
@@ -164,6 +167,7 @@ private:
     StringProperty valueUnit_;
 
     OptionPropertyInt datatype_;
+    BoolProperty loadOnDemand_;
 
     DimSelections selection_;
 
@@ -28,41 +28,49 @@
  *********************************************************************************/
 
 #include <modules/hdf5/datastructures/hdf5handle.h>
+#include <modules/hdf5/datastructures/hdf5volumeramloader.h>
 #include <inviwo/core/util/stdextensions.h>
 #include <inviwo/core/util/formatdispatching.h>
 #include <inviwo/core/util/raiiutils.h>
 #include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/datastructures/volume/volumedisk.h>
 
 #include <modules/base/algorithm/dataminmax.h>
 
 #include <algorithm>
+#include <mutex>
 
 namespace inviwo {
 
 namespace hdf5 {
 
 Handle::Handle(std::string filename) : filename_(filename), path_("/") {
+    std::lock_guard<std::recursive_mutex> lock{libraryMutex()};
     H5::H5File hdfFile(filename_, H5F_ACC_RDONLY);
     data_ = hdfFile.openGroup(path_);
 }
 
 Handle::Handle(std::string filename, Path path) : filename_(filename), path_(path) {
+    std::lock_guard<std::recursive_mutex> lock{libraryMutex()};
     H5::H5File hdfFile(filename_, H5F_ACC_RDONLY);
     data_ = hdfFile.openGroup(path_);
 }
 
 Handle::Handle(const Handle& rhs) : filename_(rhs.filename_), path_(rhs.path_) {
+    std::lock_guard<std::recursive_mutex> lock{libraryMutex()};
     H5::H5File hdfFile(filename_, H5F_ACC_RDONLY);
     data_ = hdfFile.openGroup(path_);
 }
 
 Handle::Handle(Handle&& rhs) : filename_(rhs.filename_), path_(rhs.path_) {
+    std::lock_guard<std::recursive_mutex> lock{libraryMutex()};
     H5::H5File hdfFile(filename_, H5F_ACC_RDONLY);
     data_ = hdfFile.openGroup(path_);
 }
 
 Handle& Handle::operator=(Handle&& that) {
     if (this != &that) {
+        std::lock_guard<std::recursive_mutex> lock{libraryMutex()};
         filename_ = that.filename_;
         path_ = that.path_;
         data_.close();
@@ -74,6 +82,7 @@ Handle& Handle::operator=(Handle&& that) {
 
 Handle& Handle::operator=(const Handle& that) {
     if (this != &that) {
+        std::lock_guard<std::recursive_mutex> lock{libraryMutex()};
         filename_ = that.filename_;
         path_ = that.path_;
         data_.close();
@@ -83,7 +92,10 @@ Handle& Handle::operator=(const Handle& that) {
     return *this;
 }
 
-Handle::~Handle() { data_.close(); }
+Handle::~Handle() {
+    std::lock_guard<std::recursive_mutex> lock{libraryMutex()};
+    data_.close();
+}
 
 Handle* Handle::getHandleForPath(const std::string& path) const {
     return new Handle(this->filename_, path_ + path);
@@ -126,102 +138,60 @@ std::shared_ptr<Volume> Handle::getVolumeAtPathAsType(const Path& path,
                                                       std::vector<Selection> selection,
                                                       const DataFormatBase* type) const {
 
-    auto dataset = data_.openDataSet(path);
-    ::inviwo::util::OnScopeExit closedataset{[&]() { dataset.close(); }};
-
-    const H5::DataSpace dataSpace = dataset.getSpace();
-    const size_t rank = dataSpace.getSimpleExtentNdims();
-    if (selection.size() != rank) {
-        throw Exception("Selection not of the same rank as the data", IVW_CONTEXT);
-    }
-
-    std::vector<hsize_t> dataDimensions(rank);
-    dataSpace.getSimpleExtentDims(dataDimensions.data());
-    const hsize_t dataSize = dataSpace.getSelectNpoints();
-
-    std::vector<hsize_t> start(rank);
-    std::vector<hsize_t> count(rank);
-    std::vector<hsize_t> stride(rank);
-
-    /*
-     * Column major, i.e. the FIRST listed dimension is the fasted changing
-     * Inviwo, OpenGL, matlab, Fortran
-     *
-     * Row major, i.e. the LAST listed dimension is the fasted changing
-     * HDF, C/C++, Mathematica, Python
-     *
-     * Solution reverse all the dimension lists.
-     * Row major version of the selection to match the hdf row major dataDimensions.
-     */
-    std::reverse(selection.begin(), selection.end());
-
-    size3_t volumeDimensions(1);
-    int resRank = 0;
-    std::vector<hsize_t> memoryDimensions{1, 1, 1};
-
-    for (size_t i = 0; i < rank; ++i) {
-        start[i] = selection[i].start;
-        count[i] =
-            static_cast<hsize_t>((selection[i].end - selection[i].start) / selection[i].stride);
-        stride[i] = selection[i].stride;
-
-        if (count[i] > 1) {
-            if (resRank > 2) throw Exception("Invalid selection, resulting rank > 3", IVW_CONTEXT);
-            memoryDimensions[resRank] = count[i];
-            volumeDimensions[resRank] = count[i];
-            resRank++;
-        }
-    }
-
-    dataSpace.selectHyperslab(H5S_SELECT_SET, count.data(), start.data(), stride.data(), nullptr);
-
-    H5::DataSpace memorySpace(3, memoryDimensions.data());
-    memorySpace.selectAll();
-
-    hsize_t selectionSize = memorySpace.getSelectNpoints();
-
-    LogInfo("Data rank: " << rank << " dims " << joinString(dataDimensions, " x ") << " size "
-                          << dataSize << " selection " << dataSpace.getSelectNpoints()
-                          << " memory size " << memorySpace.getSelectNpoints() << " memory dim "
-                          << volumeDimensions);
-
-    const DataFormatBase* format = type ? type : util::getDataFormatFromDataSet(dataset);
-
-    // Reverse back the Column major
-    std::reverse(&volumeDimensions[0], &volumeDimensions[0] + volumeDimensions.length());
-    auto volumeram = createVolumeRAM(volumeDimensions, format);
+    auto volume = createVolume(path, std::move(selection), type);
+    const auto volumeram = volume->getRepresentation<VolumeRAM>();
 
     auto minmax = volumeram->dispatch<std::pair<dvec4, dvec4>, dispatching::filter::Scalars>(
         [&](auto vrprecision) {
             using ValueType = ::inviwo::util::PrecisionValueType<decltype(vrprecision)>;
 
-            ValueType* data = vrprecision->getDataTyped();
-
-            try {
-                dataset.read(data, TypeMap<ValueType>::getType(), memorySpace, dataSpace);
-            } catch (H5::DataSetIException& e) {
-                throw Exception("HDF: unable to read data: " + e.getDetailMsg(), IVW_CONTEXT);
-            }
-
-            auto res = ::inviwo::util::dataMinMax(data, selectionSize);
+            auto res = ::inviwo::util::dataMinMax(vrprecision->getDataTyped(),
+                                                  glm::compMul(vrprecision->getDimensions()));
 
             LogInfo("Read HDF volume type: " << DataFormat<ValueType>::str()
                                              << " data range: " << res.first << ", " << res.second
-                                             << " file: " << dataset.getFileName());
+                                             << " file: " << filename_ << path);
 
             return res;
         });
 
-    auto volume = std::make_shared<Volume>(volumeDimensions, format);
     volume->dataMap_.dataRange.x = glm::compMin(minmax.first);
     volume->dataMap_.dataRange.y = glm::compMax(minmax.second);
     volume->dataMap_.valueRange = volume->dataMap_.dataRange;
 
-    volume->addRepresentation(volumeram);
+    return volume;
+}
+
+std::shared_ptr<Volume> Handle::getLazyVolumeAtPathAsType(const Path& path,
+                                                          std::vector<Selection> selection,
+                                                          const DataFormatBase* type) const {
+    auto volume = createVolume(path, std::move(selection), type);
+    const auto format = volume->getDataFormat();
+
+    if (format->getNumericType() == NumericType::Float) {
+        // There is no meaningful range for floating point formats, scan the data slab by slab
+        const auto disk = volume->getRepresentation<VolumeDisk>();
+        const auto loader = static_cast<const VolumeRAMLoader*>(disk->getLoader());
+        volume->dataMap_.dataRange = loader->dataRange(*disk);
+    } else {
+        volume->dataMap_.dataRange = dvec2(getMin(format), getMax(format));
+    }
+    volume->dataMap_.valueRange = volume->dataMap_.dataRange;
 
     return volume;
 }
 
+std::shared_ptr<Volume> Handle::createVolume(const Path& path, std::vector<Selection> selection,
+                                             const DataFormatBase* type) const {
+    auto loader = std::make_unique<VolumeRAMLoader>(filename_, path, std::move(selection));
+    const DataFormatBase* format = type ? type : loader->getDataFormat();
+
+    auto disk = std::make_shared<VolumeDisk>(filename_, loader->getDimensions(), format);
+    disk->setLoader(loader.release());
+
+    return std::make_shared<Volume>(disk);
+}
+
 const uvec3 Handle::colorCode = uvec3(101, 101, 188);
 
 const std::string Handle::classIdentifier = "org.inviwo.hdf5.handle";
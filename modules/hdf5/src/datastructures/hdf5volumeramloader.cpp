@@ -0,0 +1,263 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/hdf5/datastructures/hdf5volumeramloader.h>
+#include <modules/hdf5/hdf5types.h>
+#include <modules/hdf5/hdf5utils.h>
+
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/util/formatdispatching.h>
+#include <inviwo/core/util/raiiutils.h>
+
+#include <modules/base/algorithm/dataminmax.h>
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <mutex>
+
+namespace inviwo {
+
+namespace hdf5 {
+
+namespace util {
+
+std::vector<std::pair<hsize_t, hsize_t>> chunkSlabs(hsize_t start, hsize_t count, hsize_t stride,
+                                                    hsize_t chunk) {
+    std::vector<std::pair<hsize_t, hsize_t>> slabs;
+    for (hsize_t i = 0; i < count;) {
+        const auto pos = start + i * stride;
+        const auto boundary = (pos / chunk + 1) * chunk;
+        const auto next = std::min(count, i + (boundary - pos + stride - 1) / stride);
+        slabs.emplace_back(i, next);
+        i = next;
+    }
+    return slabs;
+}
+
+}  // namespace util
+
+VolumeRAMLoader::VolumeRAMLoader(std::string filename, Path path,
+                                 std::vector<Handle::Selection> selection)
+    : filename_{std::move(filename)}
+    , path_{std::move(path)}
+    , format_{nullptr}
+    , cacheChunks_{0}
+    , cacheSize_{0} {
+
+    std::lock_guard<std::recursive_mutex> lock{libraryMutex()};
+    H5::H5File file(filename_, H5F_ACC_RDONLY);
+    auto dataset = file.openDataSet(path_);
+    ::inviwo::util::OnScopeExit closedataset{[&]() { dataset.close(); }};
+
+    const size_t rank = dataset.getSpace().getSimpleExtentNdims();
+    if (selection.size() != rank) {
+        throw Exception("Selection not of the same rank as the data", IVW_CONTEXT);
+    }
+
+    // The selection is column major, hdf5 is row major
+    std::reverse(selection.begin(), selection.end());
+    for (size_t i = 0; i < rank; ++i) {
+        start_.push_back(selection[i].start);
+        count_.push_back((selection[i].end - selection[i].start) / selection[i].stride);
+        stride_.push_back(selection[i].stride);
+        if (count_.back() > 1) {
+            if (axes_.size() > 2) {
+                throw Exception("Invalid selection, resulting rank > 3", IVW_CONTEXT);
+            }
+            axes_.push_back(i);
+        }
+    }
+
+    format_ = util::getDataFormatFromDataSet(dataset);
+
+    const auto plist = dataset.getCreatePlist();
+    if (plist.getLayout() == H5D_CHUNKED) {
+        chunk_.resize(rank);
+        plist.getChunk(static_cast<int>(rank), chunk_.data());
+
+        // A slab is one chunk thick along the slowest varying dimension of the selection
+        size_t chunks = 1;
+        size_t chunkSize = dataset.getDataType().getSize();
+        for (size_t i = 0; i < rank; ++i) {
+            chunkSize *= chunk_[i];
+            if (!axes_.empty() && i == axes_.front()) continue;
+            const auto last = start_[i] + (std::max<hsize_t>(count_[i], 1) - 1) * stride_[i];
+            chunks *= last / chunk_[i] - start_[i] / chunk_[i] + 1;
+        }
+        cacheChunks_ = chunks;
+        cacheSize_ = chunks * chunkSize;
+    }
+}
+
+VolumeRAMLoader* VolumeRAMLoader::clone() const { return new VolumeRAMLoader(*this); }
+
+size3_t VolumeRAMLoader::getDimensions() const {
+    size3_t dims{1};
+    for (size_t i = 0; i < axes_.size(); ++i) {
+        dims[2 - i] = count_[axes_[i]];
+    }
+    return dims;
+}
+
+const DataFormatBase* VolumeRAMLoader::getDataFormat() const { return format_; }
+
+dvec2 VolumeRAMLoader::dataRange(const VolumeRepresentation& src) const {
+    const auto dims = src.getDimensions();
+
+    // Read one chunk thick slabs along the slowest varying dimension, or single slices if the
+    // data set is not chunked. The first axis of the selection is the z axis of the volume.
+    std::vector<std::pair<hsize_t, hsize_t>> slabs;
+    if (axes_.empty()) {
+        slabs.emplace_back(0, 1);
+    } else {
+        const auto axis = axes_.front();
+        slabs = util::chunkSlabs(start_[axis], count_[axis], stride_[axis],
+                                 chunk_.empty() ? 1 : chunk_[axis]);
+    }
+
+    dvec2 range{std::numeric_limits<double>::max(), std::numeric_limits<double>::lowest()};
+    for (const auto& [begin, end] : slabs) {
+        const auto slab =
+            readRegion(src, size3_t{0, 0, begin}, size3_t{dims.x, dims.y, end - begin});
+        const auto minmax = ::inviwo::util::volumeMinMax(slab.get(), IgnoreSpecialValues::Yes);
+        range.x = std::min(range.x, glm::compMin(minmax.first));
+        range.y = std::max(range.y, glm::compMax(minmax.second));
+    }
+    return range;
+}
+
+std::shared_ptr<VolumeRepresentation> VolumeRAMLoader::createRepresentation(
+    const VolumeRepresentation& src) const {
+    return readRegion(src, size3_t{0}, src.getDimensions());
+}
+
+void VolumeRAMLoader::updateRepresentation(std::shared_ptr<VolumeRepresentation> dest,
+                                           const VolumeRepresentation& src) const {
+    auto volumeDst = std::static_pointer_cast<VolumeRAM>(dest);
+
+    if (src.getDimensions() != volumeDst->getDimensions()) {
+        volumeDst->setDimensions(src.getDimensions());
+    }
+
+    read(size3_t{0}, *volumeDst);
+
+    volumeDst->setSwizzleMask(src.getSwizzleMask());
+    volumeDst->setInterpolation(src.getInterpolation());
+    volumeDst->setWrapping(src.getWrapping());
+}
+
+std::shared_ptr<VolumeRAM> VolumeRAMLoader::readRegion(const VolumeRepresentation& src,
+                                                       size3_t offset, size3_t dims) const {
+    auto volumeRAM = createVolumeRAM(dims, src.getDataFormat(), nullptr, src.getSwizzleMask(),
+                                     src.getInterpolation(), src.getWrapping());
+    read(offset, *volumeRAM);
+    return volumeRAM;
+}
+
+void VolumeRAMLoader::read(size3_t offset, VolumeRAM& dest) const {
+    const auto dims = dest.getDimensions();
+
+    // Memory layout, slowest varying dimension first
+    const std::array<hsize_t, 3> memDims{dims.z, dims.y, dims.x};
+    const std::array<hsize_t, 3> memOffset{offset.z, offset.y, offset.x};
+
+    for (size_t i = axes_.size(); i < 3; ++i) {
+        if (memOffset[i] != 0 || memDims[i] != 1) {
+            throw Exception("Region outside of the selection", IVW_CONTEXT);
+        }
+    }
+    auto start = start_;
+    auto count = count_;
+    for (size_t i = 0; i < axes_.size(); ++i) {
+        if (memOffset[i] + memDims[i] > count_[axes_[i]]) {
+            throw Exception("Region outside of the selection", IVW_CONTEXT);
+        }
+        start[axes_[i]] += memOffset[i] * stride_[axes_[i]];
+        count[axes_[i]] = memDims[i];
+    }
+
+    // Split the slowest varying dimension at the chunk boundaries
+    std::vector<std::pair<hsize_t, hsize_t>> slabs;
+    if (axes_.empty() || chunk_.empty()) {
+        slabs.emplace_back(0, memDims[0]);
+    } else {
+        const auto axis = axes_.front();
+        slabs = util::chunkSlabs(start[axis], memDims[0], stride_[axis], chunk_[axis]);
+    }
+
+    std::lock_guard<std::recursive_mutex> lock{libraryMutex()};
+    try {
+        H5::FileAccPropList access;
+        if (cacheSize_ > 0) {
+            int metaCache = 0;
+            size_t slots = 0;
+            size_t bytes = 0;
+            double w0 = 0.0;
+            access.getCache(metaCache, slots, bytes, w0);
+            // Fully read chunks can be evicted first since they are not needed again
+            access.setCache(metaCache, std::max(slots, 10 * cacheChunks_ + 1),
+                            std::max(bytes, cacheSize_), 1.0);
+        }
+        H5::H5File file(filename_, H5F_ACC_RDONLY, H5::FileCreatPropList::DEFAULT, access);
+        auto dataset = file.openDataSet(path_);
+        ::inviwo::util::OnScopeExit closedataset{[&]() { dataset.close(); }};
+
+        auto fileSpace = dataset.getSpace();
+        H5::DataSpace memorySpace(3, memDims.data());
+
+        dest.dispatch<void, dispatching::filter::Scalars>([&](auto vrprecision) {
+            using ValueType = ::inviwo::util::PrecisionValueType<decltype(vrprecision)>;
+            ValueType* data = vrprecision->getDataTyped();
+
+            for (const auto& [begin, end] : slabs) {
+                auto slabStart = start;
+                auto slabCount = count;
+                if (!axes_.empty()) {
+                    slabStart[axes_.front()] += begin * stride_[axes_.front()];
+                    slabCount[axes_.front()] = end - begin;
+                }
+                fileSpace.selectHyperslab(H5S_SELECT_SET, slabCount.data(), slabStart.data(),
+                                          stride_.data());
+
+                const std::array<hsize_t, 3> memStart{begin, 0, 0};
+                const std::array<hsize_t, 3> memCount{end - begin, memDims[1], memDims[2]};
+                memorySpace.selectHyperslab(H5S_SELECT_SET, memCount.data(), memStart.data());
+
+                dataset.read(data, TypeMap<ValueType>::getType(), memorySpace, fileSpace);
+            }
+        });
+    } catch (const H5::Exception& e) {
+        throw Exception("HDF: unable to read data: " + e.getDetailMsg(), IVW_CONTEXT);
+    }
+}
+
+}  // namespace hdf5
+
+}  // namespace inviwo
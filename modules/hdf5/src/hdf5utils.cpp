@@ -94,6 +94,11 @@ bool isOfType(const H5::Group& grp, const std::string& type) {
     return result;
 }
 
+std::recursive_mutex& libraryMutex() {
+    static std::recursive_mutex mutex;
+    return mutex;
+}
+
 }  // namespace hdf5
 
 }  // namespace inviwo
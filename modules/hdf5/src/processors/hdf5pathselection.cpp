@@ -29,6 +29,9 @@
 
 #include <modules/hdf5/processors/hdf5pathselection.h>
 #include <modules/hdf5/datastructures/hdf5metadata.h>
+#include <modules/hdf5/hdf5utils.h>
+
+#include <mutex>
 
 namespace inviwo {
 
@@ -57,6 +60,7 @@ PathSelection::PathSelection()
 void PathSelection::process() {
     if (inport_.hasData()) {
         auto data = inport_.getData();
+        std::lock_guard<std::recursive_mutex> lock{libraryMutex()};
         outport_.setData(data->getHandleForPath(selection_.getSelectedValue()));
     }
 }
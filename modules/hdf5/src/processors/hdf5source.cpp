@@ -29,6 +29,9 @@
 
 #include <modules/hdf5/processors/hdf5source.h>
 #include <modules/hdf5/datastructures/hdf5handle.h>
+#include <modules/hdf5/hdf5utils.h>
+
+#include <mutex>
 
 namespace inviwo {
 
@@ -55,6 +58,7 @@ void Source::process() {
     }
 
     try {
+        std::lock_guard<std::recursive_mutex> lock{libraryMutex()};
         auto data = std::make_shared<Handle>(file_.get());
         port_.setData(data);
     } catch (H5::Exception& e) {
@@ -33,6 +33,7 @@
 #include <inviwo/core/io/datareader.h>
 #include <inviwo/core/io/datareaderexception.h>
 #include <functional>
+#include <mutex>
 #include <numeric>
 #include <limits>
 
@@ -88,6 +89,7 @@ HDF5ToVolume::HDF5ToVolume()
                  {"uchar", "Unsigned Char", 2},
                  {"ushort", "Unsigned Short", 3}},
                 0)
+    , loadOnDemand_("loadOnDemand", "Load on demand", false)
     , selection_("selection", "Selection", 6)
     , dirty_(false) {
 
@@ -111,8 +113,8 @@ HDF5ToVolume::HDF5ToVolume()
     dataRange_.setReadOnly(true);
     information_.addProperties(dataDimensions_, dataRange_);
 
-    outputGroup_.addProperties(datatype_, overrideRange_, outDataRange_, valueRange_, valueUnit_,
-                               selection_);
+    outputGroup_.addProperties(datatype_, loadOnDemand_, overrideRange_, outDataRange_,
+                               valueRange_, valueUnit_, selection_);
     outputGroup_.onChange([this]() {
         if (automaticEvaluation_) {
             dirty_ = true;
@@ -193,6 +195,7 @@ mat4 HDF5ToVolume::getBasisFromMeta(MetaData meta) {
 
     if (inport_.hasData()) {
         const auto data = inport_.getData();
+        std::lock_guard<std::recursive_mutex> lock{libraryMutex()};
         H5::DataSet dataset = data->getGroup().openDataSet(meta.path_);
         H5::DataSpace space = dataset.getSpace();
         int rank = space.getSimpleExtentNdims();
@@ -314,6 +317,7 @@ void HDF5ToVolume::makeVolume() {
         const auto data = inport_.getData();
         MetaData volumeMeta = volumeMatches_[volumeSelection_.getSelectedIndex()];
 
+        std::lock_guard<std::recursive_mutex> lock{libraryMutex()};
         try {
             auto format = [&]() -> const DataFormatBase* {
                 switch (datatype_.getSelectedIndex()) {
@@ -330,9 +334,12 @@ void HDF5ToVolume::makeVolume() {
                 }
             }();
 
-            volume_ = std::shared_ptr<Volume>(
-                data->getVolumeAtPathAsType(Path(data->getGroup().getObjName()) + volumeMeta.path_,
-                                            selection_.getSelection(), format));
+            const auto path = Path(data->getGroup().getObjName()) + volumeMeta.path_;
+            if (loadOnDemand_) {
+                volume_ = data->getLazyVolumeAtPathAsType(path, selection_.getSelection(), format);
+            } else {
+                volume_ = data->getVolumeAtPathAsType(path, selection_.getSelection(), format);
+            }
 
             dataRange_.set(volume_->dataMap_.dataRange);
             outport_.setData(volume_);
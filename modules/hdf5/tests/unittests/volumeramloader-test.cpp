@@ -0,0 +1,162 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/hdf5/datastructures/hdf5volumeramloader.h>
+#include <inviwo/core/datastructures/volume/volumedisk.h>
+#include <inviwo/core/datastructures/volume/volumeram.h>
+#include <inviwo/core/io/tempfilehandle.h>
+#include <inviwo/core/util/exception.h>
+
+#include <array>
+#include <numeric>
+
+namespace inviwo {
+
+namespace hdf5 {
+
+namespace {
+
+// Row major, z, y, x
+const std::array<hsize_t, 3> dims{6, 5, 4};
+const std::array<hsize_t, 3> chunk{2, 2, 2};
+
+void writeDataSet(const std::string& filename) {
+    std::vector<float> data(dims[0] * dims[1] * dims[2]);
+    std::iota(data.begin(), data.end(), 0.0f);
+
+    H5::H5File file(filename, H5F_ACC_TRUNC);
+    H5::DSetCreatPropList plist;
+    plist.setChunk(3, chunk.data());
+    H5::DataSpace space(3, dims.data());
+    auto dataset = file.createDataSet("/data", H5::PredType::NATIVE_FLOAT, space, plist);
+    dataset.write(data.data(), H5::PredType::NATIVE_FLOAT);
+}
+
+double fileValue(size_t x, size_t y, size_t z) {
+    return static_cast<double>(x + y * dims[2] + z * dims[2] * dims[1]);
+}
+
+}  // namespace
+
+TEST(HDF5VolumeRAMLoader, ChunkSlabs) {
+    using Slabs = std::vector<std::pair<hsize_t, hsize_t>>;
+
+    EXPECT_EQ((Slabs{{0, 4}, {4, 8}, {8, 10}}), util::chunkSlabs(0, 10, 1, 4));
+    // Starting inside a chunk
+    EXPECT_EQ((Slabs{{0, 2}, {2, 6}, {6, 8}}), util::chunkSlabs(2, 8, 1, 4));
+    // Positions 1, 4, 7, 10, 13 are in chunk 0, 1, 1, 2, 3
+    EXPECT_EQ((Slabs{{0, 1}, {1, 3}, {3, 4}, {4, 5}}), util::chunkSlabs(1, 5, 3, 4));
+    // A stride larger than the chunk puts every position in its own chunk
+    EXPECT_EQ((Slabs{{0, 1}, {1, 2}, {2, 3}}), util::chunkSlabs(0, 3, 5, 2));
+    // A single chunk
+    EXPECT_EQ((Slabs{{0, 3}}), util::chunkSlabs(4, 3, 1, 8));
+    EXPECT_TRUE(util::chunkSlabs(0, 0, 1, 4).empty());
+}
+
+TEST(HDF5VolumeRAMLoader, ReadStridedRegion) {
+    util::TempFileHandle tmpFile("hdf5loader", ".h5");
+    const auto& file = tmpFile.getFileName();
+    writeDataSet(file);
+
+    // Column major: every x, every y, every second z
+    VolumeRAMLoader loader(file, Path{"/data"}, {{0, 4, 1}, {0, 5, 1}, {0, 6, 2}});
+    EXPECT_EQ(loader.getDimensions(), size3_t(4, 5, 3));
+    EXPECT_EQ(loader.getDataFormat(), DataFloat32::get());
+
+    VolumeDisk disk(file, loader.getDimensions(), loader.getDataFormat());
+
+    auto full = std::dynamic_pointer_cast<VolumeRAM>(loader.createRepresentation(disk));
+    ASSERT_TRUE(full);
+    for (size_t z = 0; z < 3; ++z) {
+        for (size_t y = 0; y < 5; ++y) {
+            for (size_t x = 0; x < 4; ++x) {
+                ASSERT_EQ(full->getAsDouble(size3_t{x, y, z}), fileValue(x, y, 2 * z))
+                    << "at " << x << ", " << y << ", " << z;
+            }
+        }
+    }
+
+    const size3_t offset{1, 1, 1};
+    const size3_t regionDims{2, 3, 2};
+    auto region = loader.readRegion(disk, offset, regionDims);
+    ASSERT_TRUE(region);
+    EXPECT_EQ(region->getDimensions(), regionDims);
+    for (size_t z = 0; z < regionDims.z; ++z) {
+        for (size_t y = 0; y < regionDims.y; ++y) {
+            for (size_t x = 0; x < regionDims.x; ++x) {
+                const auto pos = offset + size3_t{x, y, z};
+                ASSERT_EQ(region->getAsDouble(size3_t{x, y, z}),
+                          fileValue(pos.x, pos.y, 2 * pos.z))
+                    << "at " << x << ", " << y << ", " << z;
+            }
+        }
+    }
+
+    EXPECT_EQ(loader.dataRange(disk), dvec2(0.0, fileValue(3, 4, 4)));
+}
+
+TEST(HDF5VolumeRAMLoader, RegionOutsideSelection) {
+    util::TempFileHandle tmpFile("hdf5loader", ".h5");
+    const auto& file = tmpFile.getFileName();
+    writeDataSet(file);
+
+    VolumeRAMLoader loader(file, Path{"/data"}, {{0, 4, 1}, {0, 5, 1}, {0, 6, 2}});
+    VolumeDisk disk(file, loader.getDimensions(), loader.getDataFormat());
+
+    EXPECT_THROW(loader.readRegion(disk, size3_t{0, 0, 2}, size3_t{4, 5, 2}), Exception);
+    EXPECT_THROW(loader.readRegion(disk, size3_t{3, 0, 0}, size3_t{2, 1, 1}), Exception);
+    EXPECT_NO_THROW(loader.readRegion(disk, size3_t{3, 4, 2}, size3_t{1, 1, 1}));
+
+    // A single z slice gives a two dimensional selection, the x dimension of the volume is unused
+    VolumeRAMLoader slice(file, Path{"/data"}, {{0, 4, 1}, {0, 5, 1}, {3, 4, 1}});
+    EXPECT_EQ(slice.getDimensions(), size3_t(1, 4, 5));
+    VolumeDisk sliceDisk(file, slice.getDimensions(), slice.getDataFormat());
+
+    EXPECT_THROW(slice.readRegion(sliceDisk, size3_t{1, 0, 0}, size3_t{1, 1, 1}), Exception);
+    EXPECT_THROW(slice.readRegion(sliceDisk, size3_t{0}, size3_t{2, 4, 5}), Exception);
+    auto region = slice.readRegion(sliceDisk, size3_t{0, 1, 2}, size3_t{1, 2, 3});
+    EXPECT_EQ(region->getAsDouble(size3_t{0, 0, 0}), fileValue(1, 2, 3));
+}
+
+TEST(HDF5VolumeRAMLoader, SelectionRank) {
+    util::TempFileHandle tmpFile("hdf5loader", ".h5");
+    const auto& file = tmpFile.getFileName();
+    writeDataSet(file);
+
+    EXPECT_THROW(VolumeRAMLoader(file, Path{"/data"}, {{0, 4, 1}, {0, 5, 1}}), Exception);
+}
+
+}  // namespace hdf5
+
+}  // namespace inviwo
@@ -13,3 +13,5 @@ set(dependencies
 # Mark the module as protected to prevent it from being reloaded
 # when using runtime module reloading. 
 #set(protected ON)
+
+set(concurrent ON)
@@ -5,3 +5,5 @@ set(dependencies
 	InviwoBaseModule
 )
 set(EnableByDefault ON)
+
+set(concurrent ON)
@@ -34,6 +34,7 @@
 #include <inviwo/core/util/formatconversion.h>
 #include <inviwo/core/util/formatdispatching.h>
 #include <inviwo/core/util/stringconversion.h>
+#include <inviwo/core/util/volumereorient.h>
 #include <inviwo/core/io/datareaderexception.h>
 
 #include <modules/base/algorithm/dataminmax.h>
@@ -295,31 +296,6 @@ NiftiVolumeRAMLoader* NiftiVolumeRAMLoader::clone() const {
     return new NiftiVolumeRAMLoader(*this);
 }
 
-void flip(char* data, size_t elemSize, size3_t dim, std::array<bool, 3> flipAxis) {
-    // Flip data along axes if necessary
-    if (flipAxis[0] || flipAxis[1] || flipAxis[2]) {
-        const auto size = glm::compMul(dim);
-        auto tmp = std::make_unique<char[]>(elemSize * size);
-        auto copy = tmp.get();
-
-        std::memcpy(copy, data, size * elemSize);
-
-        util::IndexMapper3D mapper(dim);
-        for (size_t z = 0; z < dim[2]; ++z) {
-            const auto idz = flipAxis[2] ? dim[2] - 1 - z : z;
-            for (size_t y = 0; y < dim[1]; ++y) {
-                const auto idy = flipAxis[1] ? dim[1] - 1 - y : y;
-                for (size_t x = 0; x < dim[0]; ++x) {
-                    const auto idx = flipAxis[0] ? dim[0] - 1 - x : x;
-                    const auto from = mapper(x, y, z);
-                    const auto to = mapper(idx, idy, idz);
-                    std::memcpy(data + to * elemSize, copy + from * elemSize, elemSize);
-                }
-            }
-        }
-    }
-}
-
 std::shared_ptr<VolumeRepresentation> NiftiVolumeRAMLoader::createRepresentation(
     const VolumeRepresentation& src) const {
 
@@ -337,7 +313,7 @@ std::shared_ptr<VolumeRepresentation> NiftiVolumeRAMLoader::createRepresentation
     auto readBytes = nifti_read_subregion_image(nim.get(), start.data(), region.data(), &pdata);
 
     const auto dim = size3_t{region_size[0], region_size[1], region_size[2]};
-    flip(data.get(), voxelSize, dim, flipAxis);
+    util::reorientInPlace(data.get(), dim, voxelSize, util::AxisReorientation{{0, 1, 2}, flipAxis});
 
     if (readBytes < 0) {
         throw DataReaderException(
@@ -372,7 +348,7 @@ void NiftiVolumeRAMLoader::updateRepresentation(std::shared_ptr<VolumeRepresenta
     const auto voxelSize = src.getDataFormat()->getSize();
     const auto dim = size3_t{region_size[0], region_size[1], region_size[2]};
 
-    flip(static_cast<char*>(data), voxelSize, dim, flipAxis);
+    util::reorientInPlace(data, dim, voxelSize, util::AxisReorientation{{0, 1, 2}, flipAxis});
 }
 
 }  // namespace inviwo
@@ -34,6 +34,7 @@
 
 #include <modules/opengl/shader/shader.h>
 #include <modules/opengl/shader/shaderobject.h>
+#include <modules/opengl/shader/shadersourcecache.h>
 #include <inviwo/core/util/singleton.h>
 #include <inviwo/core/util/dispatcher.h>
 
@@ -74,6 +75,12 @@ public:
     void addShaderResource(std::shared_ptr<ShaderResource> resource);
     std::shared_ptr<ShaderResource> getShaderResource(std::string_view key);
 
+    /**
+     * The cache of pre-processed shader sources used by all ShaderObjects. It is cleared when a
+     * shader resource is added, since that might change how includes are resolved.
+     */
+    ShaderSourceCache& getSourceCache();
+
     const std::vector<Shader*>& getShaders() const;
     void rebuildAllShaders();
 
@@ -96,6 +103,7 @@ private:
 
     std::vector<std::shared_ptr<ShaderResource>> ownedResources_;
     std::map<std::string, std::weak_ptr<ShaderResource>, std::less<>> shaderResources_;
+    ShaderSourceCache sourceCache_;
 
     TemplateOptionProperty<Shader::UniformWarning>* uniformWarnings_;  // non-owning reference
     TemplateOptionProperty<Shader::OnError>* shaderObjectErrors_;      // non-owning reference
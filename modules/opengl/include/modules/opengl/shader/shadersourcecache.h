@@ -0,0 +1,123 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <modules/opengl/openglmoduledefine.h>
+#include <modules/opengl/shader/linenumberresolver.h>
+#include <modules/opengl/shader/shaderresource.h>
+#include <modules/opengl/shader/shadersegment.h>
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace inviwo {
+
+/**
+ * \brief A cache of pre-processed shader sources, @see utilgl::parseShaderSource.
+ * Entries are keyed by the key and a hash of the source of the shader resource together with the
+ * shader segments. Included resources are observed and any change to them, or to the resource
+ * itself, evicts the entry. Since other onChange callbacks of a resource might run before the
+ * eviction, every hit is also validated: each include path has to resolve to the same resource,
+ * with the same source hash, as when the entry was parsed. The output does not depend on the
+ * shader defines, they are added by
+ * the ShaderObject in front of the pre-processed source, hence all variants of a shader share one
+ * entry. The ShaderManager holds the process-wide instance used by all ShaderObjects.
+ */
+class IVW_MODULE_OPENGL_API ShaderSourceCache {
+public:
+    struct Entry {
+        std::string source;
+        LineNumberResolver lnr;
+        /**
+         * The included resources, in order of inclusion
+         */
+        std::vector<std::weak_ptr<const ShaderResource>> resources;
+        /**
+         * The include path and the source hash of each included resource, in the same order
+         */
+        std::vector<std::pair<std::string, size_t>> includes;
+    };
+    using GetResource = std::function<std::shared_ptr<const ShaderResource>(std::string_view)>;
+
+    ShaderSourceCache() = default;
+    ShaderSourceCache(const ShaderSourceCache&) = delete;
+    ShaderSourceCache& operator=(const ShaderSourceCache&) = delete;
+    ~ShaderSourceCache() = default;
+
+    /**
+     * Returns the pre-processed source of \p resource with \p segments inserted, parsing it if
+     * there is no valid entry. All included resources of the returned entry are alive, and are
+     * the ones \p getResource currently returns for the include paths.
+     * @param resource the shader resource to pre-process
+     * @param segments the segments to insert, in order of insertion
+     * @param getResource used to look up the resource of an include path
+     * @throws OpenGLException if the source can not be parsed or an include is not found
+     */
+    std::shared_ptr<const Entry> get(const std::shared_ptr<const ShaderResource>& resource,
+                                     const std::vector<ShaderSegment>& segments,
+                                     const GetResource& getResource);
+
+    /**
+     * Remove all entries, needed when include paths might resolve to other resources.
+     */
+    void clear();
+    size_t size() const;
+
+private:
+    struct Key {
+        std::string resource;
+        size_t sourceHash;
+        size_t segmentsHash;
+        bool operator==(const Key& rhs) const {
+            return sourceHash == rhs.sourceHash && segmentsHash == rhs.segmentsHash &&
+                   resource == rhs.resource;
+        }
+    };
+    struct KeyHash {
+        size_t operator()(const Key& key) const;
+    };
+    static bool isValid(const Entry& entry, const GetResource& getResource);
+
+    struct Item {
+        std::shared_ptr<const Entry> entry;
+        std::vector<std::shared_ptr<ShaderResource::Callback>> callbacks;
+    };
+
+    mutable std::mutex mutex_;
+    std::unordered_map<Key, Item, KeyHash> items_;
+};
+
+}  // namespace inviwo
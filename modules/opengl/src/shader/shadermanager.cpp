@@ -100,17 +100,20 @@ void ShaderManager::addShaderResource(std::string key, std::string src) {
     auto resource = std::make_shared<StringShaderResource>(key, src);
     ownedResources_.push_back(resource);
     shaderResources_[key] = std::weak_ptr<ShaderResource>(resource);
+    sourceCache_.clear();
 }
 
 void ShaderManager::addShaderResource(std::unique_ptr<ShaderResource> resource) {
     std::shared_ptr<ShaderResource> res(std::move(resource));
     ownedResources_.push_back(res);
     shaderResources_[res->key()] = std::weak_ptr<ShaderResource>(res);
+    sourceCache_.clear();
 }
 
 void ShaderManager::addShaderResource(std::shared_ptr<ShaderResource> resource) {
     ownedResources_.push_back(resource);
     shaderResources_[resource->key()] = std::weak_ptr<ShaderResource>(resource);
+    sourceCache_.clear();
 }
 
 std::shared_ptr<ShaderResource> ShaderManager::getShaderResource(std::string_view key) {
@@ -155,6 +158,8 @@ std::shared_ptr<ShaderResource> ShaderManager::getShaderResource(std::string_vie
     return nullptr;
 }
 
+ShaderSourceCache& ShaderManager::getSourceCache() { return sourceCache_; }
+
 OpenGLCapabilities* ShaderManager::getOpenGLCapabilities() {
     if (!openGLInfoRef_) {
         if (auto openGLModule = InviwoApplication::getPtr()->getModuleByType<OpenGLModule>())
@@ -166,6 +171,7 @@ OpenGLCapabilities* ShaderManager::getOpenGLCapabilities() {
 void ShaderManager::rebuildAllShaders() {
     if (shaders_.empty()) return;
 
+    sourceCache_.clear();
     for (auto& shader : shaders_) {
         shader->build();
     }
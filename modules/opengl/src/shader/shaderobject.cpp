@@ -503,40 +503,33 @@ void ShaderObject::addStandardVertexInDeclarations() {
 }
 
 void ShaderObject::parseSource(std::ostringstream& output) {
-    includeResources_.push_back(resource_);
-    resourceCallbacks_.push_back(
-        resource_->onChange([this](const ShaderResource*) { callbacks_.invoke(this); }));
-
-    auto getSource =
-        [this](std::string_view path) -> std::optional<std::pair<std::string, std::string>> {
-        auto inc = ShaderManager::getPtr()->getShaderResource(path);
-        if (!inc) {
-            throw OpenGLException(
-                fmt::format("Include file '{}' not found in shader search paths.", path),
-                IVW_CONTEXT);
-        }
-        // Only include files once.
-        if (util::find(includeResources_, inc) == includeResources_.end()) {
-            includeResources_.push_back(inc);
-            resourceCallbacks_.push_back(
-                inc->onChange([this](const ShaderResource*) { callbacks_.invoke(this); }));
-            return std::pair{inc->key(), inc->source()};
-        } else {
-            return std::nullopt;
-        }
-    };
-
     std::sort(shaderSegments_.begin(), shaderSegments_.end(),
               [](const ShaderSegment& a, const ShaderSegment& b) {
                   return std::tie(a.type, a.priority) < std::tie(b.type, b.priority);
               });
-    std::unordered_map<typename ShaderSegment::Type, std::vector<ShaderSegment>> replacements;
-    for (const auto& segment : shaderSegments_) {
-        replacements[segment.type].push_back(segment);
+
+    auto manager = ShaderManager::getPtr();
+    const auto entry = manager->getSourceCache().get(
+        resource_, shaderSegments_,
+        [manager](std::string_view path) -> std::shared_ptr<const ShaderResource> {
+            return manager->getShaderResource(path);
+        });
+
+    output << entry->source;
+    for (const auto& [file, line] : entry->lnr) {
+        lnr_.addLine(file, line);
     }
 
-    utilgl::parseShaderSource(resource_->key(), resource_->source(), output, lnr_, replacements,
-                              getSource);
+    includeResources_.push_back(resource_);
+    resourceCallbacks_.push_back(
+        resource_->onChange([this](const ShaderResource*) { callbacks_.invoke(this); }));
+    for (const auto& resource : entry->resources) {
+        if (auto res = resource.lock()) {
+            includeResources_.push_back(res);
+            resourceCallbacks_.push_back(
+                res->onChange([this](const ShaderResource*) { callbacks_.invoke(this); }));
+        }
+    }
 }
 
 std::string ShaderObject::resolveLog(std::string_view compileLog) const {
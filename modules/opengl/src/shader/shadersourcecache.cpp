@@ -0,0 +1,150 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/opengl/shader/shadersourcecache.h>
+
+#include <inviwo/core/util/hashcombine.h>
+#include <inviwo/core/util/stdextensions.h>
+#include <modules/opengl/openglexception.h>
+#include <modules/opengl/shader/shaderobject.h>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <optional>
+#include <sstream>
+
+namespace inviwo {
+
+size_t ShaderSourceCache::KeyHash::operator()(const Key& key) const {
+    size_t hash = std::hash<std::string>{}(key.resource);
+    util::hash_combine(hash, key.sourceHash);
+    util::hash_combine(hash, key.segmentsHash);
+    return hash;
+}
+
+std::shared_ptr<const ShaderSourceCache::Entry> ShaderSourceCache::get(
+    const std::shared_ptr<const ShaderResource>& resource,
+    const std::vector<ShaderSegment>& segments, const GetResource& getResource) {
+
+    size_t segmentsHash = 0;
+    for (const auto& segment : segments) {
+        util::hash_combine(segmentsHash, segment.type.getString());
+        util::hash_combine(segmentsHash, segment.name);
+        util::hash_combine(segmentsHash, segment.snippet);
+        util::hash_combine(segmentsHash, segment.priority);
+    }
+    Key key{resource->key(), std::hash<std::string>{}(resource->source()), segmentsHash};
+
+    std::shared_ptr<const Entry> cached;
+    {
+        std::scoped_lock lock{mutex_};
+        if (auto it = items_.find(key); it != items_.end()) cached = it->second.entry;
+    }
+    // Validate without holding the lock, getResource might call back into the ShaderManager
+    if (cached) {
+        if (isValid(*cached, getResource)) return cached;
+        std::scoped_lock lock{mutex_};
+        if (auto it = items_.find(key); it != items_.end() && it->second.entry == cached) {
+            items_.erase(it);
+        }
+    }
+
+    // Parse without holding the lock, the resources are kept alive until we are done
+    auto entry = std::make_shared<Entry>();
+    std::vector<std::shared_ptr<const ShaderResource>> resources{resource};
+    auto getSource =
+        [&](std::string_view path) -> std::optional<std::pair<std::string, std::string>> {
+        auto inc = getResource(path);
+        if (!inc) {
+            throw OpenGLException(
+                fmt::format("Include file '{}' not found in shader search paths.", path),
+                IVW_CONTEXT);
+        }
+        // Only include files once.
+        if (util::find(resources, inc) == resources.end()) {
+            resources.push_back(inc);
+            entry->includes.emplace_back(path, std::hash<std::string>{}(inc->source()));
+            return std::pair{inc->key(), inc->source()};
+        } else {
+            return std::nullopt;
+        }
+    };
+
+    std::unordered_map<typename ShaderSegment::Type, std::vector<ShaderSegment>> replacements;
+    for (const auto& segment : segments) {
+        replacements[segment.type].push_back(segment);
+    }
+
+    std::ostringstream output;
+    utilgl::parseShaderSource(resource->key(), resource->source(), output, entry->lnr,
+                              replacements, getSource);
+    entry->source = std::move(output).str();
+    entry->resources.assign(std::next(resources.begin()), resources.end());
+
+    Item item{entry, {}};
+    for (const auto& res : resources) {
+        item.callbacks.push_back(res->onChange([this, key](const ShaderResource*) {
+            std::scoped_lock lock{mutex_};
+            items_.erase(key);
+        }));
+    }
+
+    std::scoped_lock lock{mutex_};
+    util::map_erase_remove_if(items_, [](const auto& elem) {
+        const auto& res = elem.second.entry->resources;
+        return std::any_of(res.begin(), res.end(), [](const auto& r) { return r.expired(); });
+    });
+    items_.insert_or_assign(std::move(key), std::move(item));
+    return entry;
+}
+
+bool ShaderSourceCache::isValid(const Entry& entry, const GetResource& getResource) {
+    for (size_t i = 0; i < entry.resources.size(); ++i) {
+        const auto res = entry.resources[i].lock();
+        const auto& [path, sourceHash] = entry.includes[i];
+        if (!res || getResource(path) != res ||
+            std::hash<std::string>{}(res->source()) != sourceHash) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void ShaderSourceCache::clear() {
+    std::scoped_lock lock{mutex_};
+    items_.clear();
+}
+
+size_t ShaderSourceCache::size() const {
+    std::scoped_lock lock{mutex_};
+    return items_.size();
+}
+
+}  // namespace inviwo
@@ -0,0 +1,136 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/opengl/shader/shaderobject.h>
+#include <modules/opengl/shader/shadersourcecache.h>
+#include <modules/opengl/shader/shaderresource.h>
+
+#include <benchmark/benchmark.h>
+
+#include <fmt/format.h>
+
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+
+using namespace inviwo;
+
+namespace {
+
+/**
+ * A shader including \p includes resources of about 60 lines each, similar to the raycasting
+ * shaders of the base modules. No OpenGL context is needed.
+ */
+struct Shaders {
+    explicit Shaders(size_t includes) {
+        std::string main;
+        for (size_t i = 0; i < includes; ++i) {
+            const auto key = fmt::format("utils/include{}.glsl", i);
+            std::string source = fmt::format("#ifndef IVW_INCLUDE{0}\n#define IVW_INCLUDE{0}\n", i);
+            if (i > 0) source += fmt::format("#include \"utils/include{}.glsl\"\n", i - 1);
+            for (size_t j = 0; j < 10; ++j) {
+                source += fmt::format(
+                    "/*\n * Function {1} of include {0}\n */\n"
+                    "vec4 function{0}_{1}(vec4 color, float t) {{\n"
+                    "    // blend the color\n    return mix(color, vec4(t), 0.5);\n}}\n",
+                    i, j);
+            }
+            source += "#endif\n";
+            resources.emplace(key, std::make_shared<StringShaderResource>(key, source));
+            main += fmt::format("#include \"{}\"\n", key);
+        }
+        main += "\nvoid main() {\n    FragData0 = function0_0(vec4(1.0), 0.5);\n    MAIN\n}\n";
+        resource = std::make_shared<StringShaderResource>("main.frag", main);
+        segments.push_back(ShaderSegment{ShaderSegment::Type{"MAIN"}, "main", "PickingData = 0;"});
+    }
+
+    std::shared_ptr<const ShaderResource> getResource(std::string_view path) const {
+        auto it = resources.find(std::string{path});
+        return it != resources.end() ? it->second : nullptr;
+    }
+
+    std::shared_ptr<const ShaderResource> resource;
+    std::map<std::string, std::shared_ptr<const ShaderResource>> resources;
+    std::vector<ShaderSegment> segments;
+};
+
+}  // namespace
+
+static void Parse(benchmark::State& state) {
+    const Shaders shaders{static_cast<size_t>(state.range(0))};
+    size_t bytes = 0;
+
+    for (auto _ : state) {
+        std::vector<std::shared_ptr<const ShaderResource>> included;
+        auto getSource =
+            [&](std::string_view path) -> std::optional<std::pair<std::string, std::string>> {
+            auto inc = shaders.getResource(path);
+            if (std::find(included.begin(), included.end(), inc) != included.end()) {
+                return std::nullopt;
+            }
+            included.push_back(inc);
+            return std::pair{inc->key(), inc->source()};
+        };
+        std::unordered_map<typename ShaderSegment::Type, std::vector<ShaderSegment>> replacements{
+            {shaders.segments.front().type, shaders.segments}};
+
+        LineNumberResolver lnr;
+        std::ostringstream output;
+        utilgl::parseShaderSource(shaders.resource->key(), shaders.resource->source(), output,
+                                  lnr, replacements, getSource);
+        bytes = output.str().size();
+        benchmark::DoNotOptimize(bytes);
+    }
+    state.counters["Bytes"] = static_cast<double>(bytes);
+}
+
+static void Cached(benchmark::State& state) {
+    const Shaders shaders{static_cast<size_t>(state.range(0))};
+    ShaderSourceCache cache;
+    size_t bytes = 0;
+
+    for (auto _ : state) {
+        const auto entry =
+            cache.get(shaders.resource, shaders.segments,
+                      [&](std::string_view path) { return shaders.getResource(path); });
+        bytes = entry->source.size();
+        benchmark::DoNotOptimize(bytes);
+    }
+    state.counters["Bytes"] = static_cast<double>(bytes);
+}
+
+BENCHMARK(Parse)->RangeMultiplier(4)->Range(1, 64);
+BENCHMARK(Cached)->RangeMultiplier(4)->Range(1, 64);
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
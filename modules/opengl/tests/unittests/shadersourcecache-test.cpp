@@ -0,0 +1,190 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/common/inviwo.h>
+#include <modules/opengl/shader/shadersourcecache.h>
+#include <modules/opengl/shader/shaderresource.h>
+#include <modules/opengl/openglexception.h>
+
+#include <map>
+
+namespace inviwo {
+
+namespace {
+
+struct Resources {
+    Resources()
+        : main{std::make_shared<StringShaderResource>(
+              "main.frag", "#include \"inc1\"\n#include \"inc2\"\nvoid main() {\n    REPL\n}\n")}
+        , inc1{std::make_shared<StringShaderResource>("inc1", "Inc1\n#include \"inc2\"")}
+        , inc2{std::make_shared<StringShaderResource>("inc2", "Inc2")} {}
+
+    ShaderSourceCache::GetResource getResource() {
+        return [this](std::string_view path) -> std::shared_ptr<const ShaderResource> {
+            ++lookups;
+            if (path == "inc1") return inc1;
+            if (path == "inc2") return inc2;
+            return nullptr;
+        };
+    }
+
+    std::shared_ptr<ShaderResource> main;
+    std::shared_ptr<ShaderResource> inc1;
+    std::shared_ptr<ShaderResource> inc2;
+    size_t lookups = 0;
+};
+
+using SegType = typename ShaderSegment::Type;
+
+}  // namespace
+
+TEST(ShaderSourceCache, parse) {
+    Resources res;
+    ShaderSourceCache cache;
+
+    auto entry = cache.get(res.main, {}, res.getResource());
+    EXPECT_EQ(entry->source, "Inc1\nInc2\n\nvoid main() {\n    REPL\n}\n");
+    ASSERT_EQ(entry->resources.size(), 2);
+    EXPECT_EQ(entry->resources[0].lock(), res.inc1);
+    EXPECT_EQ(entry->resources[1].lock(), res.inc2);
+    EXPECT_EQ(cache.size(), 1);
+}
+
+TEST(ShaderSourceCache, hit) {
+    Resources res;
+    ShaderSourceCache cache;
+
+    auto entry1 = cache.get(res.main, {}, res.getResource());
+    const auto lookups = res.lookups;
+    auto entry2 = cache.get(res.main, {}, res.getResource());
+    EXPECT_EQ(entry1, entry2);
+    // A hit only resolves every include once to validate the entry
+    EXPECT_EQ(res.lookups, lookups + 2);
+
+    // The same source in another resource object shares the entry
+    auto copy = res.main->clone();
+    auto entry3 = cache.get(std::shared_ptr<const ShaderResource>{std::move(copy)}, {},
+                            res.getResource());
+    EXPECT_EQ(entry1, entry3);
+}
+
+TEST(ShaderSourceCache, segments) {
+    Resources res;
+    ShaderSourceCache cache;
+
+    std::vector<ShaderSegment> segments{{SegType{"REPL"}, "Repl", "code;", 1000}};
+    auto entry1 = cache.get(res.main, {}, res.getResource());
+    auto entry2 = cache.get(res.main, segments, res.getResource());
+    EXPECT_NE(entry1, entry2);
+    EXPECT_EQ(entry2->source, "Inc1\nInc2\n\nvoid main() {\n    code;\n}\n");
+
+    segments.front().snippet = "other;";
+    auto entry3 = cache.get(res.main, segments, res.getResource());
+    EXPECT_NE(entry2, entry3);
+    EXPECT_EQ(entry3->source, "Inc1\nInc2\n\nvoid main() {\n    other;\n}\n");
+    EXPECT_EQ(cache.size(), 3);
+}
+
+TEST(ShaderSourceCache, invalidate) {
+    Resources res;
+    ShaderSourceCache cache;
+
+    auto entry1 = cache.get(res.main, {}, res.getResource());
+    res.inc2->setSource("Inc2 changed");
+    EXPECT_EQ(cache.size(), 0);
+
+    auto entry2 = cache.get(res.main, {}, res.getResource());
+    EXPECT_NE(entry1, entry2);
+    EXPECT_EQ(entry2->source, "Inc1\nInc2 changed\n\nvoid main() {\n    REPL\n}\n");
+
+    res.main->setSource("void main() {}");
+    EXPECT_EQ(cache.size(), 0);
+    auto entry3 = cache.get(res.main, {}, res.getResource());
+    EXPECT_EQ(entry3->source, "void main() {}");
+    EXPECT_TRUE(entry3->resources.empty());
+}
+
+TEST(ShaderSourceCache, changedBeforeEviction) {
+    Resources res;
+    ShaderSourceCache cache;
+
+    // A callback registered before the cache's own runs before the entry is evicted
+    std::shared_ptr<const ShaderSourceCache::Entry> rebuilt;
+    auto callback = res.inc2->onChange([&](const ShaderResource*) {
+        rebuilt = cache.get(res.main, {}, res.getResource());
+    });
+
+    auto entry1 = cache.get(res.main, {}, res.getResource());
+    res.inc2->setSource("Inc2 changed");
+    ASSERT_TRUE(rebuilt);
+    EXPECT_NE(entry1, rebuilt);
+    EXPECT_EQ(rebuilt->source, "Inc1\nInc2 changed\n\nvoid main() {\n    REPL\n}\n");
+}
+
+TEST(ShaderSourceCache, includeResolvesToOtherResource) {
+    Resources res;
+    ShaderSourceCache cache;
+
+    auto entry1 = cache.get(res.main, {}, res.getResource());
+    // A resource added to the ShaderManager might shadow the include, while the old one is alive
+    auto old = res.inc2;
+    res.inc2 = std::make_shared<StringShaderResource>("inc2", "Inc2 other");
+    auto entry2 = cache.get(res.main, {}, res.getResource());
+    EXPECT_NE(entry1, entry2);
+    EXPECT_EQ(entry2->source, "Inc1\nInc2 other\n\nvoid main() {\n    REPL\n}\n");
+}
+
+TEST(ShaderSourceCache, expired) {
+    Resources res;
+    ShaderSourceCache cache;
+
+    auto entry1 = cache.get(res.main, {}, res.getResource());
+    // A new include resource with the same content must not reuse the old entry
+    res.inc1 = std::make_shared<StringShaderResource>("inc1", "Inc1\n#include \"inc2\"");
+    auto entry2 = cache.get(res.main, {}, res.getResource());
+    EXPECT_NE(entry1, entry2);
+    EXPECT_EQ(entry2->resources[0].lock(), res.inc1);
+    EXPECT_EQ(cache.size(), 1);
+}
+
+TEST(ShaderSourceCache, missingInclude) {
+    Resources res;
+    ShaderSourceCache cache;
+
+    res.main->setSource("#include \"missing\"\n");
+    EXPECT_THROW(cache.get(res.main, {}, res.getResource()), OpenGLException);
+    EXPECT_EQ(cache.size(), 0);
+}
+
+}  // namespace inviwo
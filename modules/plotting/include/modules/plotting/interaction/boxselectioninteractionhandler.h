@@ -31,10 +31,12 @@
 #include <modules/plotting/plottingmoduledefine.h>
 #include <modules/plotting/properties/axisproperty.h>
 #include <modules/plotting/properties/boxselectionproperty.h>
+#include <modules/plotting/utils/pointindex2d.h>
 #include <inviwo/core/common/inviwo.h>
 #include <inviwo/core/datastructures/buffer/buffer.h>
 #include <inviwo/core/interaction/interactionhandler.h>
 
+#include <future>
 #include <optional>
 #include <unordered_set>
 
@@ -91,6 +93,13 @@ public:
      */
     std::optional<std::array<dvec2, 2>> getDragRectangle() const { return dragRect_; }
 
+    /**
+     * \brief Spatial index of the current x and y data for fast selection queries. The index is
+     * built in the background on the thread pool when first requested after the data changed.
+     * Returns null while the index is being built or if there is no valid data.
+     */
+    std::shared_ptr<const PointIndex2D> getPointIndex();
+
 protected:
     /**
      * \brief React to rectangle drag changes. Input is in data-space of each axis.
@@ -109,6 +118,7 @@ protected:
 
     std::function<dvec2(dvec2 p, const size2_t& dims)> screenToData_;
     std::optional<std::array<dvec2, 2>> dragRect_;
+    std::shared_future<std::shared_ptr<const PointIndex2D>> pointIndex_;
 };
 
 }  // namespace plot
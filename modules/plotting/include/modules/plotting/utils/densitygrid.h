@@ -0,0 +1,93 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <modules/plotting/plottingmoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/datastructures/buffer/buffer.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace inviwo {
+
+class BufferRAM;
+
+namespace plot {
+
+/**
+ * \brief Regular 2D grid of point counts, used for aggregated rendering of large data sets.
+ * For parallel coordinates, the grid of two neighboring axes holds the binned line bundles
+ * between them.
+ */
+struct IVW_MODULE_PLOTTING_API DensityGrid {
+    size2_t dims{0};
+    dvec2 min{0.0};
+    dvec2 max{1.0};
+    std::vector<std::uint32_t> counts;  ///< number of points per bin, row-major
+    std::vector<double> sums;           ///< sum of the values per bin, empty if no values given
+
+    size_t size() const { return counts.size(); }
+    std::uint32_t maxCount() const;
+    dvec2 binCenter(size_t bin) const;
+};
+
+/**
+ * \brief count the points (x[row], y[row]) in each bin of a regular grid covering [min, max].
+ * Points outside of the range or with NaN coordinates are not counted. The rows are processed in
+ * parallel on the thread pool.
+ *
+ * @param x       scalar buffer with the x coordinates
+ * @param y       scalar buffer with the y coordinates
+ * @param dims    number of bins along x and y
+ * @param rows    rows to consider, all rows if null
+ * @param values  optional scalar buffer, the values are summed per bin
+ * @param stride  only use every stride'th row, to get a quick preview of large data sets
+ */
+IVW_MODULE_PLOTTING_API DensityGrid densityGrid(const BufferBase& x, const BufferBase& y,
+                                                size2_t dims, dvec2 min, dvec2 max,
+                                                const std::vector<std::uint32_t>* rows = nullptr,
+                                                const BufferBase* values = nullptr,
+                                                size_t stride = 1);
+
+/**
+ * \brief overload for the RAM representations of the buffers
+ * The representations can be taken on the main thread and then binned on a background thread,
+ * since the buffers are not accessed.
+ */
+IVW_MODULE_PLOTTING_API DensityGrid densityGrid(const BufferRAM& x, const BufferRAM& y,
+                                                size2_t dims, dvec2 min, dvec2 max,
+                                                const std::vector<std::uint32_t>* rows = nullptr,
+                                                const BufferRAM* values = nullptr,
+                                                size_t stride = 1);
+
+}  // namespace plot
+
+}  // namespace inviwo
@@ -0,0 +1,102 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <modules/plotting/plottingmoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/datastructures/buffer/buffer.h>
+
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <vector>
+
+namespace inviwo {
+
+namespace plot {
+
+/**
+ * \brief Uniform grid over 2D points for rectangle, lasso, and nearest point queries
+ *
+ * The points are sorted by grid cell, each query only visits the cells overlapping the query
+ * region and only tests the points of cells which are not entirely inside of it. Query results are
+ * sorted lists of point indices. Points with a NaN coordinate are not indexed and never returned.
+ */
+class IVW_MODULE_PLOTTING_API PointIndex2D {
+public:
+    /**
+     * \brief build the index for the scalar buffers \p x and \p y
+     * @throws Exception if the buffers differ in size
+     */
+    PointIndex2D(const BufferBase& x, const BufferBase& y);
+    explicit PointIndex2D(const std::vector<dvec2>& points);
+
+    /**
+     * \brief number of points, including the ones that are not indexed
+     */
+    size_t size() const { return size_; }
+
+    /**
+     * \brief all points p with \p min <= p <= \p max
+     */
+    std::vector<std::uint32_t> rect(const dvec2& min, const dvec2& max) const;
+
+    /**
+     * \brief all points inside of the closed \p polygon, using the even-odd rule
+     */
+    std::vector<std::uint32_t> lasso(const std::vector<dvec2>& polygon) const;
+
+    /**
+     * \brief the point closest to \p pos
+     * @param scale        per axis scaling of the distance, for example the size of a data unit
+     *                     in pixels for picking on screen
+     * @param maxDistance  only consider points closer than this, in scaled units
+     */
+    std::optional<std::uint32_t> nearest(
+        const dvec2& pos, const dvec2& scale = dvec2{1.0},
+        double maxDistance = std::numeric_limits<double>::infinity()) const;
+
+private:
+    void build(const std::vector<dvec2>& points);
+    ivec2 cellOf(const dvec2& p) const;
+    size_t cellIndex(const ivec2& cell) const;
+
+    size_t size_ = 0;
+    dvec2 min_{0.0};
+    dvec2 cellSize_{1.0};
+    ivec2 dims_{0};
+    std::vector<std::uint32_t> cellStart_;  ///< first entry of each cell in indices_ and points_
+    std::vector<std::uint32_t> indices_;    ///< point indices sorted by cell
+    std::vector<dvec2> points_;             ///< point positions sorted by cell
+};
+
+}  // namespace plot
+
+}  // namespace inviwo
@@ -29,6 +29,7 @@
 
 #include <modules/plotting/interaction/boxselectioninteractionhandler.h>
 
+#include <inviwo/core/common/inviwoapplication.h>
 #include <inviwo/core/interaction/events/mouseevent.h>
 #include <inviwo/core/interaction/events/touchevent.h>
 #include <inviwo/core/util/zip.h>
@@ -55,6 +56,8 @@ void BoxSelectionInteractionHandler::invokeEvent(Event* event) {
         auto append = me->modifiers().contains(KeyModifier::Control);
         if ((me->button() == MouseButton::Left) && (me->state() == MouseState::Press)) {
             dragRect_ = {dvec2{me->pos().x, me->pos().y}, dvec2{me->pos().x, me->pos().y}};
+            // start building the index, if needed, while the rectangle is being dragged
+            getPointIndex();
             me->setUsed(true);
         } else if ((me->button() == MouseButton::Left) && (me->state() == MouseState::Release)) {
             if (dragRect_ && glm::compMax(glm::abs(me->pos() - (*dragRect_)[0])) <= 1) {
@@ -104,10 +107,40 @@ auto BoxSelectionInteractionHandler::addFilteringChangedCallback(
 
 void BoxSelectionInteractionHandler::setXAxisData(std::shared_ptr<const BufferBase> buffer) {
     xAxis_ = buffer;
+    pointIndex_ = {};
 }
 
 void BoxSelectionInteractionHandler::setYAxisData(std::shared_ptr<const BufferBase> buffer) {
     yAxis_ = buffer;
+    pointIndex_ = {};
+}
+
+std::shared_ptr<const PointIndex2D> BoxSelectionInteractionHandler::getPointIndex() {
+    if (!pointIndex_.valid()) {
+        if (!xAxis_ || !yAxis_ || xAxis_->getSize() != yAxis_->getSize()) return nullptr;
+
+        auto build = [x = xAxis_, y = yAxis_]() -> std::shared_ptr<const PointIndex2D> {
+            return std::make_shared<const PointIndex2D>(*x, *y);
+        };
+        if (InviwoApplication::getPtr()->getPoolSize() > 0) {
+            pointIndex_ = InviwoApplication::getPtr()->dispatchPool(std::move(build)).share();
+        } else {
+            pointIndex_ = std::async(std::launch::deferred, std::move(build)).share();
+        }
+    }
+    switch (pointIndex_.wait_for(std::chrono::seconds{0})) {
+        case std::future_status::ready:
+        case std::future_status::deferred:
+            try {
+                return pointIndex_.get();
+            } catch (const Exception& e) {
+                LogError("Failed to build point index: " << e.getMessage());
+                return nullptr;
+            }
+        case std::future_status::timeout:
+        default:
+            return nullptr;
+    }
 }
 
 void BoxSelectionInteractionHandler::dragRectChanged(const dvec2& start, const dvec2& end,
@@ -135,6 +168,15 @@ std::vector<bool> BoxSelectionInteractionHandler::boxSelect(const dvec2& start,
         return std::vector<bool>();
     }
 
+    if (xAxis == xAxis_.get() && yAxis == yAxis_.get()) {
+        if (auto index = getPointIndex()) {
+            std::vector<bool> selected(index->size(), false);
+            for (auto i : index->rect(start, end)) selected[i] = true;
+            return selected;
+        }
+    }
+
+    // Fall back to scanning the data while the index is not available.
     // For efficiency:
     // 1. Determine selection along x-axis
     // 2. Determine selection along y-axis using the subset from 1
@@ -166,9 +208,9 @@ std::vector<bool> BoxSelectionInteractionHandler::boxSelect(const dvec2& start,
     // Use indices filted by x-axis as input
     auto ybuf = yAxis->getRepresentation<BufferRAM>();
     auto selectedIndices = ybuf->dispatch<std::vector<bool>, dispatching::filter::Scalars>(
-        [selectedIndicesX, min = start[1], max = end[1]](auto brprecision) {
+        [&selectedIndicesX, min = start[1], max = end[1]](auto brprecision) {
             using ValueType = util::PrecisionValueType<decltype(brprecision)>;
-            auto data = brprecision->getDataContainer();
+            const auto& data = brprecision->getDataContainer();
             std::vector<bool> selected(brprecision->getSize(), false);
             // Avoid conversions in the loop
             const auto tmin = std::numeric_limits<ValueType>::is_integer
@@ -199,6 +241,16 @@ std::vector<bool> BoxSelectionInteractionHandler::boxFilter(const dvec2& start,
     if (xAxis == nullptr || yAxis == nullptr) {
         return std::vector<bool>();
     }
+
+    if (xAxis == xAxis_.get() && yAxis == yAxis_.get()) {
+        if (auto index = getPointIndex()) {
+            // filter everything outside of the box
+            std::vector<bool> filtered(index->size(), true);
+            for (auto i : index->rect(start, end)) filtered[i] = false;
+            return filtered;
+        }
+    }
+
     auto xbuf = xAxis->getRepresentation<BufferRAM>();
 #include <warn/push>
 #include <warn/ignore/conversion>  // Ignore double->float warnings
@@ -212,9 +264,9 @@ std::vector<bool> BoxSelectionInteractionHandler::boxFilter(const dvec2& start,
             const auto tmaxX = std::numeric_limits<ValueTypeX>::is_integer
                                    ? static_cast<ValueTypeX>(std::floor(end[0]))
                                    : static_cast<ValueTypeX>(end[0]);
-            auto xData = brprecision->getDataContainer();
+            const auto& xData = brprecision->getDataContainer();
             return ybuf->dispatch<std::vector<bool>, dispatching::filter::Scalars>(
-                [tminX, tmaxX, start, end, xData](auto brprecision) {
+                [tminX, tmaxX, start, end, &xData](auto brprecision) {
                     using ValueTypeY = util::PrecisionValueType<decltype(brprecision)>;
                     std::vector<bool> filtered(brprecision->getSize(), false);
                     const auto tminY = std::numeric_limits<ValueTypeY>::is_integer
@@ -0,0 +1,176 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/plotting/utils/densitygrid.h>
+
+#include <inviwo/core/datastructures/buffer/bufferram.h>
+#include <inviwo/core/util/foreach.h>
+#include <inviwo/core/util/formatdispatching.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace inviwo {
+
+namespace plot {
+
+namespace {
+
+constexpr size_t chunkSize = size_t{1} << 14;
+constexpr size_t minSamplesPerJob = size_t{1} << 16;
+constexpr size_t maxPartialBytes = size_t{256} << 20;
+
+struct Samples {
+    const std::vector<std::uint32_t>* rows;
+    size_t stride;
+
+    size_t row(size_t sample) const {
+        return rows ? (*rows)[sample * stride] : sample * stride;
+    }
+};
+
+/**
+ * Bin along one axis for the samples [first, first + out.size()), -1 if outside of [lo, hi]
+ */
+void axisBins(const BufferRAM& buffer, const Samples& samples, size_t first, double lo,
+              double hi, size_t bins, std::vector<int>& out) {
+    const auto scale = hi > lo ? static_cast<double>(bins) / (hi - lo) : 0.0;
+    const auto last = static_cast<int>(bins) - 1;
+    buffer.dispatch<void, dispatching::filter::Scalars>([&](auto typedBuf) {
+        const auto& data = typedBuf->getDataContainer();
+        for (size_t i = 0; i < out.size(); ++i) {
+            const auto v = static_cast<double>(data[samples.row(first + i)]);
+            // NaN fails both comparisons
+            if (v >= lo && v <= hi) {
+                out[i] = std::min(static_cast<int>((v - lo) * scale), last);
+            } else {
+                out[i] = -1;
+            }
+        }
+    });
+}
+
+void sampleValues(const BufferRAM& buffer, const Samples& samples, size_t first,
+                  std::vector<double>& out) {
+    buffer.dispatch<void, dispatching::filter::Scalars>([&](auto typedBuf) {
+        const auto& data = typedBuf->getDataContainer();
+        for (size_t i = 0; i < out.size(); ++i) {
+            out[i] = static_cast<double>(data[samples.row(first + i)]);
+        }
+    });
+}
+
+}  // namespace
+
+std::uint32_t DensityGrid::maxCount() const {
+    return counts.empty() ? 0 : *std::max_element(counts.begin(), counts.end());
+}
+
+dvec2 DensityGrid::binCenter(size_t bin) const {
+    const dvec2 pos{static_cast<double>(bin % dims.x), static_cast<double>(bin / dims.x)};
+    return min + (pos + 0.5) * (max - min) / dvec2{dims};
+}
+
+DensityGrid densityGrid(const BufferBase& x, const BufferBase& y, size2_t dims, dvec2 min,
+                        dvec2 max, const std::vector<std::uint32_t>* rows,
+                        const BufferBase* values, size_t stride) {
+    return densityGrid(*x.getRepresentation<BufferRAM>(), *y.getRepresentation<BufferRAM>(), dims,
+                       min, max, rows, values ? values->getRepresentation<BufferRAM>() : nullptr,
+                       stride);
+}
+
+DensityGrid densityGrid(const BufferRAM& x, const BufferRAM& y, size2_t dims, dvec2 min,
+                        dvec2 max, const std::vector<std::uint32_t>* rows, const BufferRAM* values,
+                        size_t stride) {
+    DensityGrid grid;
+    grid.dims = dims;
+    grid.min = min;
+    grid.max = max;
+    const auto cells = dims.x * dims.y;
+    grid.counts.assign(cells, 0);
+    if (values) grid.sums.assign(cells, 0.0);
+    if (cells == 0) return grid;
+
+    const Samples samples{rows, std::max(size_t{1}, stride)};
+    const size_t count = rows ? rows->size() : std::min(x.getSize(), y.getSize());
+    const size_t nSamples = (count + samples.stride - 1) / samples.stride;
+
+    const auto xram = &x;
+    const auto yram = &y;
+    const auto vram = values;
+
+    const size_t bytesPerPartial = cells * (sizeof(std::uint32_t) + (values ? sizeof(double) : 0));
+    const size_t jobs =
+        std::max(size_t{1}, std::min(util::jobCount(nSamples, 1, minSamplesPerJob),
+                                     maxPartialBytes / bytesPerPartial));
+
+    // each job accumulates into its own grid, the first job uses the result grid
+    std::vector<DensityGrid> partials(jobs - 1);
+    for (auto& partial : partials) {
+        partial.counts.assign(cells, 0);
+        if (values) partial.sums.assign(cells, 0.0);
+    }
+
+    util::forEachRange(nSamples, jobs, [&](size_t begin, size_t end, size_t job) {
+        auto& dst = job == 0 ? grid : partials[job - 1];
+        std::vector<int> binX;
+        std::vector<int> binY;
+        std::vector<double> vals;
+        for (auto first = begin; first < end; first += chunkSize) {
+            const auto n = std::min(chunkSize, end - first);
+            binX.resize(n);
+            binY.resize(n);
+            axisBins(*xram, samples, first, min.x, max.x, dims.x, binX);
+            axisBins(*yram, samples, first, min.y, max.y, dims.y, binY);
+            if (vram) {
+                vals.resize(n);
+                sampleValues(*vram, samples, first, vals);
+            }
+            for (size_t i = 0; i < n; ++i) {
+                if (binX[i] < 0 || binY[i] < 0) continue;
+                const auto bin =
+                    static_cast<size_t>(binY[i]) * dims.x + static_cast<size_t>(binX[i]);
+                ++dst.counts[bin];
+                if (vram) dst.sums[bin] += vals[i];
+            }
+        }
+    });
+
+    for (const auto& partial : partials) {
+        for (size_t i = 0; i < cells; ++i) {
+            grid.counts[i] += partial.counts[i];
+            if (values) grid.sums[i] += partial.sums[i];
+        }
+    }
+    return grid;
+}
+
+}  // namespace plot
+
+}  // namespace inviwo
@@ -0,0 +1,270 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/plotting/utils/pointindex2d.h>
+
+#include <inviwo/core/datastructures/buffer/bufferram.h>
+#include <inviwo/core/util/exception.h>
+#include <inviwo/core/util/formatdispatching.h>
+#include <inviwo/core/util/zip.h>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace inviwo {
+
+namespace plot {
+
+namespace {
+
+constexpr double pointsPerCell = 8.0;
+constexpr int maxCellsPerAxis = 2048;
+
+bool isFinite(const dvec2& p) { return std::isfinite(p.x) && std::isfinite(p.y); }
+
+bool insidePolygon(const dvec2& p, const std::vector<dvec2>& polygon) {
+    bool inside = false;
+    for (size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++) {
+        const auto& a = polygon[i];
+        const auto& b = polygon[j];
+        if ((a.y > p.y) != (b.y > p.y) && p.x < (b.x - a.x) * (p.y - a.y) / (b.y - a.y) + a.x) {
+            inside = !inside;
+        }
+    }
+    return inside;
+}
+
+}  // namespace
+
+PointIndex2D::PointIndex2D(const BufferBase& x, const BufferBase& y) {
+    if (x.getSize() != y.getSize()) {
+        throw Exception(fmt::format("Size mismatch between x ({}) and y ({}) buffer", x.getSize(),
+                                    y.getSize()),
+                        IVW_CONTEXT);
+    }
+
+    std::vector<dvec2> points(x.getSize());
+    const auto copy = [&](const BufferBase& buffer, int component) {
+        buffer.getRepresentation<BufferRAM>()->dispatch<void, dispatching::filter::Scalars>(
+            [&](auto typedBuf) {
+                for (auto&& [i, value] : util::enumerate(typedBuf->getDataContainer())) {
+                    points[i][component] = static_cast<double>(value);
+                }
+            });
+    };
+    copy(x, 0);
+    copy(y, 1);
+    build(points);
+}
+
+PointIndex2D::PointIndex2D(const std::vector<dvec2>& points) { build(points); }
+
+void PointIndex2D::build(const std::vector<dvec2>& points) {
+    size_ = points.size();
+
+    dvec2 min{std::numeric_limits<double>::infinity()};
+    dvec2 max{-std::numeric_limits<double>::infinity()};
+    size_t valid = 0;
+    for (const auto& p : points) {
+        if (!isFinite(p)) continue;
+        min = glm::min(min, p);
+        max = glm::max(max, p);
+        ++valid;
+    }
+    if (valid == 0) return;
+
+    const auto side = std::clamp(
+        static_cast<int>(std::sqrt(static_cast<double>(valid) / pointsPerCell)), 1,
+        maxCellsPerAxis);
+    const auto extent = max - min;
+    dims_ = ivec2{side};
+    min_ = min;
+    cellSize_ = dvec2{extent.x > 0.0 ? extent.x / side : 1.0,
+                      extent.y > 0.0 ? extent.y / side : 1.0};
+
+    // counting sort of the points by cell
+    constexpr auto invalid = std::numeric_limits<std::uint32_t>::max();
+    std::vector<std::uint32_t> cells(points.size(), invalid);
+    cellStart_.assign(static_cast<size_t>(side) * side + 1, 0);
+    for (auto&& [i, p] : util::enumerate(points)) {
+        if (!isFinite(p)) continue;
+        cells[i] = static_cast<std::uint32_t>(cellIndex(cellOf(p)));
+        ++cellStart_[cells[i] + 1];
+    }
+    std::partial_sum(cellStart_.begin(), cellStart_.end(), cellStart_.begin());
+
+    indices_.resize(valid);
+    points_.resize(valid);
+    std::vector<std::uint32_t> next(cellStart_.begin(), cellStart_.end() - 1);
+    for (auto&& [i, p] : util::enumerate(points)) {
+        if (cells[i] == invalid) continue;
+        const auto dst = next[cells[i]]++;
+        indices_[dst] = static_cast<std::uint32_t>(i);
+        points_[dst] = p;
+    }
+}
+
+ivec2 PointIndex2D::cellOf(const dvec2& p) const {
+    return ivec2{glm::clamp(glm::floor((p - min_) / cellSize_), dvec2{0.0}, dvec2{dims_ - 1})};
+}
+
+size_t PointIndex2D::cellIndex(const ivec2& cell) const {
+    return static_cast<size_t>(cell.y) * static_cast<size_t>(dims_.x) +
+           static_cast<size_t>(cell.x);
+}
+
+std::vector<std::uint32_t> PointIndex2D::rect(const dvec2& min, const dvec2& max) const {
+    std::vector<std::uint32_t> result;
+    if (points_.empty() || glm::any(glm::isnan(min)) || glm::any(glm::isnan(max)) ||
+        glm::any(glm::lessThan(max, min))) {
+        return result;
+    }
+
+    // cellOf is monotonic, hence all points of cells strictly between the cells of min and max
+    // are inside the rectangle and only the border cells need to be tested
+    const auto lo = cellOf(min);
+    const auto hi = cellOf(max);
+    for (int y = lo.y; y <= hi.y; ++y) {
+        for (int x = lo.x; x <= hi.x; ++x) {
+            const auto cell = cellIndex(ivec2{x, y});
+            const auto begin = cellStart_[cell];
+            const auto end = cellStart_[cell + 1];
+            if (x > lo.x && x < hi.x && y > lo.y && y < hi.y) {
+                result.insert(result.end(), indices_.begin() + begin, indices_.begin() + end);
+            } else {
+                for (auto i = begin; i < end; ++i) {
+                    const auto& p = points_[i];
+                    if (p.x >= min.x && p.x <= max.x && p.y >= min.y && p.y <= max.y) {
+                        result.push_back(indices_[i]);
+                    }
+                }
+            }
+        }
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+std::vector<std::uint32_t> PointIndex2D::lasso(const std::vector<dvec2>& polygon) const {
+    std::vector<std::uint32_t> result;
+    if (points_.empty() || polygon.size() < 3) return result;
+
+    dvec2 min{std::numeric_limits<double>::infinity()};
+    dvec2 max{-std::numeric_limits<double>::infinity()};
+    for (const auto& p : polygon) {
+        min = glm::min(min, p);
+        max = glm::max(max, p);
+    }
+    if (!isFinite(min) || !isFinite(max)) return result;
+
+    const auto lo = cellOf(min);
+    const auto hi = cellOf(max);
+    for (int y = lo.y; y <= hi.y; ++y) {
+        for (int x = lo.x; x <= hi.x; ++x) {
+            const auto cell = cellIndex(ivec2{x, y});
+            for (auto i = cellStart_[cell]; i < cellStart_[cell + 1]; ++i) {
+                const auto& p = points_[i];
+                if (p.x >= min.x && p.x <= max.x && p.y >= min.y && p.y <= max.y &&
+                    insidePolygon(p, polygon)) {
+                    result.push_back(indices_[i]);
+                }
+            }
+        }
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+std::optional<std::uint32_t> PointIndex2D::nearest(const dvec2& pos, const dvec2& scale,
+                                                   double maxDistance) const {
+    if (points_.empty() || glm::any(glm::isnan(pos))) return std::nullopt;
+
+    const auto absScale = glm::abs(scale);
+    const auto distance2 = [&](const dvec2& p) {
+        const auto d = (p - pos) * absScale;
+        return glm::dot(d, d);
+    };
+
+    std::optional<std::uint32_t> best;
+    double bestDistance2 = maxDistance * maxDistance;
+    const auto visit = [&](int x, int y) {
+        if (x < 0 || y < 0 || x >= dims_.x || y >= dims_.y) return;
+        const auto cell = cellIndex(ivec2{x, y});
+        for (auto i = cellStart_[cell]; i < cellStart_[cell + 1]; ++i) {
+            const auto d2 = distance2(points_[i]);
+            if (d2 < bestDistance2) {
+                bestDistance2 = d2;
+                best = indices_[i];
+            }
+        }
+    };
+
+    // search rings of cells around the cell of pos. The distances from pos clamped to the grid
+    // are lower bounds for the distances from pos, which might be outside of the grid.
+    const auto q = glm::clamp(pos, min_, min_ + cellSize_ * dvec2{dims_});
+    const auto center = cellOf(q);
+    for (int r = 0;; ++r) {
+        const auto lo = center - r;
+        const auto hi = center + r;
+        if (r == 0) {
+            visit(center.x, center.y);
+        } else {
+            for (int x = lo.x; x <= hi.x; ++x) {
+                visit(x, lo.y);
+                visit(x, hi.y);
+            }
+            for (int y = lo.y + 1; y < hi.y; ++y) {
+                visit(lo.x, y);
+                visit(hi.x, y);
+            }
+        }
+
+        // points in rings further out are outside of the box of visited cells
+        auto bound = std::numeric_limits<double>::infinity();
+        if (lo.x > 0) bound = std::min(bound, (q.x - (min_.x + lo.x * cellSize_.x)) * absScale.x);
+        if (lo.y > 0) bound = std::min(bound, (q.y - (min_.y + lo.y * cellSize_.y)) * absScale.y);
+        if (hi.x < dims_.x - 1) {
+            bound = std::min(bound, (min_.x + (hi.x + 1) * cellSize_.x - q.x) * absScale.x);
+        }
+        if (hi.y < dims_.y - 1) {
+            bound = std::min(bound, (min_.y + (hi.y + 1) * cellSize_.y - q.y) * absScale.y);
+        }
+        if (std::isinf(bound)) break;  // all cells visited
+        bound = std::max(bound, 0.0);
+        if (bound * bound >= bestDistance2) break;
+    }
+    return best;
+}
+
+}  // namespace plot
+
+}  // namespace inviwo
@@ -0,0 +1,86 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/plotting/utils/densitygrid.h>
+#include <inviwo/core/datastructures/buffer/bufferramprecision.h>
+
+#include <cmath>
+
+namespace inviwo {
+
+TEST(DensityGrid, Counts) {
+    Buffer<float> x;
+    Buffer<int> y;
+    Buffer<double> values;
+    x.getEditableRAMRepresentation()->getDataContainer() = {0.0f, 0.5f, 1.5f, 2.0f,
+                                                            std::nanf(""), 5.0f};
+    y.getEditableRAMRepresentation()->getDataContainer() = {0, 0, 1, 2, 0, 0};
+    values.getEditableRAMRepresentation()->getDataContainer() = {1.0, 2.0, 3.0, 4.0, 5.0, 6.0};
+
+    auto grid = plot::densityGrid(x, y, size2_t{2, 2}, dvec2{0.0}, dvec2{2.0}, nullptr, &values);
+    ASSERT_EQ(size_t{4}, grid.size());
+    // NaN and points outside of the range are ignored, max is included in the last bin
+    EXPECT_EQ(std::vector<std::uint32_t>({2, 0, 0, 2}), grid.counts);
+    EXPECT_EQ(std::vector<double>({3.0, 0.0, 0.0, 7.0}), grid.sums);
+    EXPECT_EQ(std::uint32_t{2}, grid.maxCount());
+    EXPECT_EQ(dvec2(0.5, 1.5), grid.binCenter(2));
+
+    const std::vector<std::uint32_t> rows{0, 2, 3};
+    grid = plot::densityGrid(x, y, size2_t{2, 2}, dvec2{0.0}, dvec2{2.0}, &rows);
+    EXPECT_EQ(std::vector<std::uint32_t>({1, 0, 0, 2}), grid.counts);
+    EXPECT_TRUE(grid.sums.empty());
+
+    // every second of the rows
+    grid = plot::densityGrid(x, y, size2_t{2, 2}, dvec2{0.0}, dvec2{2.0}, &rows, nullptr, 2);
+    EXPECT_EQ(std::vector<std::uint32_t>({1, 0, 0, 1}), grid.counts);
+}
+
+TEST(DensityGrid, Large) {
+    const size_t size = 300000;
+    Buffer<double> x;
+    Buffer<double> y;
+    auto& xs = x.getEditableRAMRepresentation()->getDataContainer();
+    auto& ys = y.getEditableRAMRepresentation()->getDataContainer();
+    for (size_t i = 0; i < size; ++i) {
+        xs.push_back(static_cast<double>(i % 100));
+        ys.push_back(static_cast<double>((i / 100) % 10));
+    }
+
+    auto grid = plot::densityGrid(x, y, size2_t{10, 10}, dvec2{0.0}, dvec2{100.0, 10.0});
+    for (auto count : grid.counts) {
+        EXPECT_EQ(std::uint32_t{size / 100}, count);
+    }
+}
+
+}  // namespace inviwo
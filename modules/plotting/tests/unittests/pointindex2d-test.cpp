@@ -0,0 +1,135 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/plotting/utils/pointindex2d.h>
+#include <inviwo/core/datastructures/buffer/bufferramprecision.h>
+#include <inviwo/core/util/exception.h>
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <utility>
+
+namespace inviwo {
+
+namespace {
+
+std::vector<dvec2> randomPoints(size_t count) {
+    std::mt19937 rand(42);
+    std::normal_distribution<double> dist(0.0, 10.0);
+    std::vector<dvec2> points(count);
+    for (auto& p : points) p = dvec2{dist(rand), 0.1 * dist(rand)};
+    return points;
+}
+
+}  // namespace
+
+TEST(PointIndex2D, Rect) {
+    auto points = randomPoints(10000);
+    points[5] = dvec2{std::nan(""), 0.0};
+    plot::PointIndex2D index(points);
+    EXPECT_EQ(size_t{10000}, index.size());
+
+    for (auto [min, max] : {std::pair{dvec2{-5.0, -0.5}, dvec2{7.0, 1.0}},
+                            std::pair{dvec2{-100.0, -100.0}, dvec2{100.0, 100.0}},
+                            std::pair{dvec2{20.0, 0.0}, dvec2{25.0, 0.1}},
+                            std::pair{dvec2{200.0, 0.0}, dvec2{250.0, 1.0}}}) {
+        std::vector<std::uint32_t> expected;
+        for (size_t i = 0; i < points.size(); ++i) {
+            const auto& p = points[i];
+            if (p.x >= min.x && p.x <= max.x && p.y >= min.y && p.y <= max.y) {
+                expected.push_back(static_cast<std::uint32_t>(i));
+            }
+        }
+        EXPECT_EQ(expected, index.rect(min, max));
+    }
+}
+
+TEST(PointIndex2D, Lasso) {
+    const auto points = randomPoints(10000);
+    plot::PointIndex2D index(points);
+
+    // a triangle
+    const std::vector<dvec2> polygon{{-10.0, -1.0}, {10.0, -1.0}, {0.0, 1.0}};
+    const auto result = index.lasso(polygon);
+
+    std::vector<std::uint32_t> expected;
+    for (size_t i = 0; i < points.size(); ++i) {
+        const auto& p = points[i];
+        // inside if above the base and below both sides
+        if (p.y > -1.0 && p.y < 1.0 - std::abs(p.x) * 0.2) {
+            expected.push_back(static_cast<std::uint32_t>(i));
+        }
+    }
+    EXPECT_EQ(expected, result);
+}
+
+TEST(PointIndex2D, Nearest) {
+    const auto points = randomPoints(10000);
+    plot::PointIndex2D index(points);
+
+    const dvec2 scale{1.0, 100.0};
+    for (const auto& pos : {dvec2{0.0, 0.0}, dvec2{3.3, -0.2}, dvec2{-60.0, 5.0}}) {
+        std::uint32_t expected = 0;
+        double best = std::numeric_limits<double>::infinity();
+        for (size_t i = 0; i < points.size(); ++i) {
+            const auto d = (points[i] - pos) * scale;
+            if (glm::dot(d, d) < best) {
+                best = glm::dot(d, d);
+                expected = static_cast<std::uint32_t>(i);
+            }
+        }
+        auto result = index.nearest(pos, scale);
+        ASSERT_TRUE(result.has_value());
+        EXPECT_EQ(expected, *result);
+    }
+
+    EXPECT_FALSE(index.nearest(dvec2{1000.0, 0.0}, scale, 1.0).has_value());
+    EXPECT_FALSE(plot::PointIndex2D(std::vector<dvec2>{}).nearest(dvec2{0.0}).has_value());
+}
+
+TEST(PointIndex2D, Buffers) {
+    Buffer<int> x;
+    Buffer<float> y;
+    x.getEditableRAMRepresentation()->getDataContainer() = {1, 2, 3, 4};
+    y.getEditableRAMRepresentation()->getDataContainer() = {1.0f, 2.0f, 3.0f, 4.0f};
+
+    plot::PointIndex2D index(x, y);
+    EXPECT_EQ(std::vector<std::uint32_t>({1, 2}), index.rect(dvec2{1.5}, dvec2{3.0}));
+
+    Buffer<int> small;
+    EXPECT_THROW(plot::PointIndex2D(small, y), Exception);
+}
+
+}  // namespace inviwo
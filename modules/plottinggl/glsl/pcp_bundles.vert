@@ -0,0 +1,52 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include "pcp_common.glsl"
+
+out float vScalarMeta;
+flat out uint vPicking;
+out float vWidthScale;
+
+uniform float axisPositions[NUMBER_OF_AXIS];
+uniform bool axisFlipped[NUMBER_OF_AXIS];
+
+// One line segment per bin of the density grid between two neighboring axes.
+// in_Vertex is the column index of the axis and the normalized value of the bin center,
+// in_Radii the relative number of lines in the bin.
+void main() {
+    vScalarMeta = in_ScalarMeta;
+    vPicking = 0u;
+    vWidthScale = in_Radii;
+
+    int axisIndex = int(in_Vertex.x + 0.5);
+
+    float xPos = axisPositions[axisIndex];
+    float yPos = mix(in_Vertex.y, 1.0 - in_Vertex.y, axisFlipped[axisIndex]);
+    gl_Position = vec4(getPosWithSpacing(vec2(xPos, yPos)), 0.0, 1.0);
+}
@@ -31,6 +31,7 @@
 
 out float vScalarMeta;
 flat out uint vPicking;
+out float vWidthScale;
 
 uniform float axisPositions[NUMBER_OF_AXIS];
 uniform bool axisFlipped[NUMBER_OF_AXIS];
@@ -38,6 +39,7 @@ uniform bool axisFlipped[NUMBER_OF_AXIS];
 void main() {
     vScalarMeta = in_ScalarMeta;
     vPicking = in_Picking;
+    vWidthScale = 1.0;
 
     int axisIndex = gl_VertexID % NUMBER_OF_AXIS;
 
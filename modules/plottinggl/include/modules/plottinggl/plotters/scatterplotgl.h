@@ -50,6 +50,7 @@
 #include <modules/plotting/properties/marginproperty.h>
 #include <modules/plotting/properties/axisproperty.h>
 #include <modules/plotting/properties/axisstyleproperty.h>
+#include <modules/plotting/utils/densitygrid.h>
 
 #include <modules/plottinggl/rendering/boxselectionrenderer.h>
 #include <modules/plottinggl/utils/axisrenderer.h>
@@ -105,16 +106,23 @@ public:
         AxisProperty xAxis_;
         AxisProperty yAxis_;
 
+        CompositeProperty levelOfDetail_;
+        BoolProperty aggregate_;
+        IntSizeTProperty aggregationThreshold_;
+        IntProperty binSize_;
+
     private:
         auto props() {
             return std::tie(radiusRange_, useCircle_, minRadius_, tf_, color_, hoverColor_,
                             selectionColor_, boxSelectionSettings_, margins_, axisMargin_,
-                            borderWidth_, borderColor_, hovering_, axisStyle_, xAxis_, yAxis_);
+                            borderWidth_, borderColor_, hovering_, axisStyle_, xAxis_, yAxis_,
+                            levelOfDetail_);
         }
         auto props() const {
             return std::tie(radiusRange_, useCircle_, minRadius_, tf_, color_, hoverColor_,
                             selectionColor_, boxSelectionSettings_, margins_, axisMargin_,
-                            borderWidth_, borderColor_, hovering_, axisStyle_, xAxis_, yAxis_);
+                            borderWidth_, borderColor_, hovering_, axisStyle_, xAxis_, yAxis_,
+                            levelOfDetail_);
         }
     };
 
@@ -145,6 +153,12 @@ public:
     void setIndexColumn(std::shared_ptr<const TemplateColumn<uint32_t>> indexcol);
 
     void setSelectedIndices(const std::unordered_set<size_t>& indices);
+    /**
+     * Notify the plot that the rows of the index buffer given to plot() changed. The given rows
+     * are not compared every frame, the radius order and the aggregated density grid are only
+     * recomputed after this call or if the number of rows changes.
+     */
+    void setIndicesChanged();
 
     ToolTipCallbackHandle addToolTipCallback(std::function<ToolTipFunc> callback);
     SelectionCallbackHandle addSelectionChangedCallback(std::function<SelectionFunc> callback);
@@ -160,6 +174,14 @@ public:
 protected:
     void plot(const size2_t& dims, IndexBuffer* indices, bool useAxisRanges);
     void renderAxis(const size2_t& dims);
+    /**
+     * Draw one point per non-empty bin of a density grid of \p rows, sized by the number of
+     * points in the bin and colored by their mean color value. For large inputs the grid is first
+     * computed from a subset of the rows, and refined from all rows on the thread pool.
+     */
+    void renderAggregated(const size2_t& dims, const std::vector<uint32_t>& rows,
+                          const vec2& minmaxX, const vec2& minmaxY);
+    void setLodGrid(DensityGrid grid);
 
     void objectPicked(PickingEvent* p);
     uint32_t getGlobalPickId(uint32_t localIndex) const;
@@ -198,6 +220,21 @@ protected:
 
     std::unique_ptr<IndexBuffer> indices_;
     std::unique_ptr<BufferObjectArray> boa_;
+    bool radiusSortDirty_ = true;
+    bool indicesDirty_ = true;
+    bool externalIndices_ = false;  ///< indices_ is a copy of the given index buffer
+    size_t externalRowCount_ = 0;
+
+    DensityGrid lodGrid_;
+    bool lodDirty_ = true;
+    size_t lodRequest_ = 0;  ///< refined grids of older requests are dropped
+    std::optional<DensityGrid> lodRefined_;
+    std::shared_ptr<Buffer<float>> lodX_;
+    std::shared_ptr<Buffer<float>> lodY_;
+    std::shared_ptr<Buffer<float>> lodC_;
+    std::shared_ptr<Buffer<float>> lodR_;
+    std::unique_ptr<BufferObjectArray> lodBoa_;
+    std::shared_ptr<bool> alive_ = std::make_shared<bool>(true);
 
     Processor* processor_;
 
@@ -54,9 +54,12 @@
 #include <inviwo/dataframe/properties/dataframeproperty.h>
 #include <inviwo/dataframe/properties/dataframecolormapproperty.h>
 #include <modules/plotting/properties/marginproperty.h>
+#include <modules/plotting/utils/densitygrid.h>
 
 #include <modules/plottinggl/utils/axisrenderer.h>
 
+#include <optional>
+
 namespace inviwo {
 class PickingEvent;
 
@@ -71,6 +74,12 @@ class PickingEvent;
  * ### Outports
  *   * __outport__   rendered image of the parallel coordinate plot
  *
+ * ### Properties
+ *   * __Level of Detail__ If the data frame has more rows than the threshold, the lines that
+ *     are neither filtered nor selected are drawn as bundles. The values of each pair of
+ *     neighboring axes are binned into a density grid on the thread pool, and one line is drawn
+ *     per non-empty bin, with a width given by the number of lines in the bin.
+ *
  */
 namespace plot {
 
@@ -117,6 +126,10 @@ public:
     FloatVec3Property filterColor_;
     FloatProperty filterAlpha_;
     FloatProperty filterIntensity_;
+    CompositeProperty levelOfDetail_;
+    BoolProperty aggregate_;
+    IntSizeTProperty aggregationThreshold_;
+    IntProperty binSize_;
 
     FontProperty captionSettings_;
     TemplateOptionProperty<LabelPosition> captionPosition_;
@@ -169,6 +182,9 @@ private:
     void drawAxis(size2_t size);
     void drawHandles(size2_t size);
     void drawLines(size2_t size);
+    bool aggregating() const;
+    void buildBundles(size2_t size);
+    void setBundles(const std::vector<DensityGrid>& grids);
 
     void updateBrushing();
 
@@ -217,6 +233,21 @@ private:
     };
     Lines lines_;
 
+    Shader bundleShader_;
+    struct Bundles {
+        TypedMesh<buffertraits::PositionsBuffer2D, buffertraits::RadiiBuffer,
+                  buffertraits::ScalarMetaBuffer>
+            mesh{DrawType::Lines, ConnectivityType::None};
+        std::vector<std::shared_ptr<Buffer<float>>> normalized;  ///< normalized values per column
+        size_t bins = 0;
+        bool dirty = true;
+        size_t request = 0;  ///< results of older requests are dropped
+        std::vector<std::pair<size_t, size_t>> axisPairs;  ///< column ids of the binned axes
+        std::optional<std::vector<DensityGrid>> result;    ///< one grid per axis pair
+    };
+    Bundles bundles_;
+    std::shared_ptr<bool> alive_ = std::make_shared<bool>(true);
+
     std::pair<vec2, vec2> marginsInternal_;  // Margins with/without considering labels
     int hoveredLine_ = -1;
     int hoveredAxis_ = -1;
@@ -35,6 +35,7 @@
 #include <modules/opengl/texture/textureutils.h>
 #include <modules/opengl/openglutils.h>
 
+#include <inviwo/core/common/inviwoapplication.h>
 #include <inviwo/core/processors/processor.h>
 #include <inviwo/core/interaction/events/pickingevent.h>
 #include <inviwo/core/interaction/events/mouseevent.h>
@@ -47,6 +48,8 @@
 #include <inviwo/core/util/zip.h>
 #include <modules/opengl/buffer/bufferobjectarray.h>
 
+#include <cmath>
+
 namespace inviwo {
 
 namespace plot {
@@ -78,12 +81,19 @@ ScatterPlotGL::Properties::Properties(std::string identifier, std::string displa
 
     , axisStyle_("axisStyle", "Global Axis Style")
     , xAxis_("xAxis", "X Axis")
-    , yAxis_("yAxis", "Y Axis", AxisProperty::Orientation::Vertical) {
+    , yAxis_("yAxis", "Y Axis", AxisProperty::Orientation::Vertical)
+    , levelOfDetail_("levelOfDetail", "Level of Detail")
+    , aggregate_("aggregate", "Aggregate Large Data", true)
+    , aggregationThreshold_("aggregationThreshold", "Aggregation Threshold", 1000000, 1000,
+                            100000000)
+    , binSize_("binSize", "Bin Size (pixels)", 4, 1, 32) {
     hoverColor_.setSemantics(PropertySemantics::Color);
     selectionColor_.setSemantics(PropertySemantics::Color);
     borderColor_.setSemantics(PropertySemantics::Color);
 
     util::for_each_in_tuple([&](auto& e) { this->addProperty(e); }, props());
+    levelOfDetail_.addProperties(aggregate_, aggregationThreshold_, binSize_);
+    levelOfDetail_.setCollapsed(true);
 
     axisStyle_.registerProperties(xAxis_, yAxis_);
 
@@ -113,8 +123,13 @@ ScatterPlotGL::Properties::Properties(const ScatterPlotGL::Properties& rhs)
     , hovering_(rhs.hovering_)
     , axisStyle_(rhs.axisStyle_)
     , xAxis_(rhs.xAxis_)
-    , yAxis_(rhs.yAxis_) {
+    , yAxis_(rhs.yAxis_)
+    , levelOfDetail_(rhs.levelOfDetail_)
+    , aggregate_(rhs.aggregate_)
+    , aggregationThreshold_(rhs.aggregationThreshold_)
+    , binSize_(rhs.binSize_) {
     util::for_each_in_tuple([&](auto& e) { this->addProperty(e); }, props());
+    levelOfDetail_.addProperties(aggregate_, aggregationThreshold_, binSize_);
     axisStyle_.unregisterAll();
     axisStyle_.registerProperties(xAxis_, yAxis_);
 }
@@ -351,44 +366,84 @@ void ScatterPlotGL::plot(const size2_t& dims, IndexBuffer* indexBuffer, bool use
                          [this](auto val) { return !filtered_[val]; });
         }
         filteringDirty_ = false;
+        radiusSortDirty_ = true;
+        lodDirty_ = true;
     };
     IndexBuffer* indices;
-    if (radius_) {
-
-        if (indexBuffer) {
-            // copy selected indices
-            indices_ = std::unique_ptr<IndexBuffer>(indexBuffer->clone());
+    if (indexBuffer) {
+        // the given rows are not compared, see setIndicesChanged()
+        if (!externalIndices_ || indexBuffer->getSize() != externalRowCount_) {
+            indicesDirty_ = true;
+        }
+        externalIndices_ = true;
+        externalRowCount_ = indexBuffer->getSize();
+        if (indicesDirty_) {
+            indicesDirty_ = false;
+            radiusSortDirty_ = true;
+            lodDirty_ = true;
+            // indices_ no longer holds the internally filtered indices
+            filteringDirty_ = true;
+        }
+        // aggregated points are not drawn in radius order, use the given rows without a copy
+        const bool aggregated = properties_.aggregate_ &&
+                                indexBuffer->getSize() > properties_.aggregationThreshold_;
+        if (radius_ && !aggregated) {
+            // copy selected indices, they are sorted by radius below
+            if (radiusSortDirty_) {
+                indices_ = std::unique_ptr<IndexBuffer>(indexBuffer->clone());
+            }
+            indices = indices_.get();
         } else {
-            setupInternalFiltering();
+            indices = indexBuffer;
+        }
+    } else {
+        if (externalIndices_) {
+            externalIndices_ = false;
+            filteringDirty_ = true;
         }
+        setupInternalFiltering();
         indices = indices_.get();
+    }
 
-        // sort according to radii, larger first
-        auto& inds = indices->getEditableRAMRepresentation()->getDataContainer();
-
-        radius_->getRepresentation<BufferRAM>()->dispatch<void, dispatching::filter::Scalars>(
-            [&inds](auto bufferpr) {
-                auto& radii = bufferpr->getDataContainer();
-                std::sort(inds.begin(), inds.end(), [&radii](const uint32_t& a, const uint32_t& b) {
-                    return radii[a] > radii[b];
-                });
-            });
+    const auto& rows = indices->getRAMRepresentation()->getDataContainer();
+    if (properties_.aggregate_ && rows.size() > properties_.aggregationThreshold_) {
+        const auto& minmaxX =
+            useAxisRanges ? vec2(properties_.xAxis_.range_.get()) : minmaxX_;
+        const auto& minmaxY =
+            useAxisRanges ? vec2(properties_.yAxis_.range_.get()) : minmaxY_;
+        renderAggregated(dims, rows, minmaxX, minmaxY);
+
+        // restore the uniforms for drawing selected and hovered points
+        shader_.setUniform("minRadius", minRadius);
+        shader_.setUniform("maxRadius", maxRadius);
+        shader_.setUniform("minmaxC", minmaxC_);
+        shader_.setUniform("minmaxR", minmaxR_);
+        shader_.setUniform("has_radius", radius_ && minmaxR_.x != minmaxR_.y ? 1 : 0);
+        shader_.setUniform("pickingEnabled", picking_.isEnabled());
+        boa_->bind();
     } else {
-        if (indexBuffer) {
-            // copy selected indices
-            indices = indexBuffer;
-        } else {
-            setupInternalFiltering();
-            indices = indices_.get();
+        if (radius_ && radiusSortDirty_) {
+            // sort according to radii, larger first
+            auto& inds = indices->getEditableRAMRepresentation()->getDataContainer();
+
+            radius_->getRepresentation<BufferRAM>()
+                ->dispatch<void, dispatching::filter::Scalars>([&inds](auto bufferpr) {
+                    auto& radii = bufferpr->getDataContainer();
+                    std::sort(inds.begin(), inds.end(),
+                              [&radii](const uint32_t& a, const uint32_t& b) {
+                                  return radii[a] > radii[b];
+                              });
+                });
+            radiusSortDirty_ = false;
         }
-    }
 
-    boa_->bind();
-    auto indicesGL = indices->getRepresentation<BufferGL>();
-    indicesGL->bind();
-    glDrawElements(GL_POINTS, static_cast<uint32_t>(indices->getSize()), indicesGL->getFormatType(),
-                   nullptr);
-    indicesGL->getBufferObject()->unbind();
+        boa_->bind();
+        auto indicesGL = indices->getRepresentation<BufferGL>();
+        indicesGL->bind();
+        glDrawElements(GL_POINTS, static_cast<uint32_t>(indices->getSize()),
+                       indicesGL->getFormatType(), nullptr);
+        indicesGL->getBufferObject()->unbind();
+    }
     // draw selected and hovered points on top
 
     if (selectedIndicesGLDirty_ || nSelectedButNotFiltered_ > 0) {
@@ -453,6 +508,107 @@ void ScatterPlotGL::plot(const size2_t& dims, IndexBuffer* indexBuffer, bool use
     renderAxis(dims);
 }  // namespace plot
 
+void ScatterPlotGL::renderAggregated(const size2_t& dims, const std::vector<uint32_t>& rows,
+                                     const vec2& minmaxX, const vec2& minmaxY) {
+    // one bin per binSize x binSize pixels of the plot area
+    const vec4 margins = properties_.margins_.getAsVec4() + properties_.axisMargin_.get();
+    const vec2 plotSize = glm::max(vec2(dims) - vec2(margins.y + margins.w, margins.x + margins.z),
+                                   vec2(1.0f));
+    const auto binSize = static_cast<float>(properties_.binSize_.get());
+    const size2_t gridDims = glm::max(size2_t(plotSize / binSize), size2_t(1));
+    const dvec2 gridMin{minmaxX.x, minmaxY.x};
+    const dvec2 gridMax{minmaxX.y, minmaxY.y};
+    if (gridDims != lodGrid_.dims || gridMin != lodGrid_.min || gridMax != lodGrid_.max) {
+        lodDirty_ = true;
+    }
+
+    if (lodDirty_) {
+        lodDirty_ = false;
+        lodRefined_.reset();
+        ++lodRequest_;
+
+        const auto xram = xAxis_->getRepresentation<BufferRAM>();
+        const auto yram = yAxis_->getRepresentation<BufferRAM>();
+        const auto cram = color_ ? color_->getRepresentation<BufferRAM>() : nullptr;
+
+        // bin a subset of the rows right away, and all rows on the thread pool
+        constexpr size_t previewRows = size_t{1} << 20;
+        const bool refine =
+            rows.size() > 2 * previewRows && processor_ && InviwoApplication::isInitialized();
+        const size_t stride = refine ? rows.size() / previewRows : 1;
+        setLodGrid(densityGrid(*xram, *yram, gridDims, gridMin, gridMax, &rows, cram, stride));
+
+        if (refine) {
+            // the buffers keep their RAM representations alive while binning
+            dispatchPool([this, alive = std::weak_ptr<bool>(alive_), request = lodRequest_,
+                          buffers = std::make_tuple(xAxis_, yAxis_, color_), xram, yram, cram,
+                          rows = std::make_shared<const std::vector<uint32_t>>(rows), gridDims,
+                          gridMin, gridMax]() {
+                auto grid = densityGrid(*xram, *yram, gridDims, gridMin, gridMax, rows.get(), cram);
+                dispatchFrontAndForget([this, alive, request, grid = std::move(grid)]() mutable {
+                    if (!alive.lock() || request != lodRequest_) return;
+                    lodRefined_ = std::move(grid);
+                    processor_->invalidate(InvalidationLevel::InvalidOutput);
+                });
+            });
+        }
+    } else if (lodRefined_) {
+        setLodGrid(std::move(*lodRefined_));
+        lodRefined_.reset();
+    }
+
+    // bin area grows with the logarithm of the number of points in the bin
+    const float maxCount = std::log1p(static_cast<float>(lodGrid_.maxCount()));
+    const float maxRadius = std::max(0.5f * binSize, 1.0f);
+    shader_.setUniform("minRadius", 0.25f * maxRadius);
+    shader_.setUniform("maxRadius", maxRadius);
+    shader_.setUniform("minmaxR", vec2(0.0f, maxCount));
+    shader_.setUniform("has_radius", maxCount > 0.0f ? 1 : 0);
+    shader_.setUniform("pickingEnabled", false);
+
+    lodBoa_->bind();
+    glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(lodX_->getSize()));
+    lodBoa_->unbind();
+}
+
+void ScatterPlotGL::setLodGrid(DensityGrid grid) {
+    lodGrid_ = std::move(grid);
+
+    std::vector<float> x, y, c, r;
+    for (size_t bin = 0; bin < lodGrid_.size(); ++bin) {
+        const auto count = lodGrid_.counts[bin];
+        if (count == 0) continue;
+        const auto pos = lodGrid_.binCenter(bin);
+        x.push_back(static_cast<float>(pos.x));
+        y.push_back(static_cast<float>(pos.y));
+        r.push_back(std::log1p(static_cast<float>(count)));
+        if (color_) {
+            const auto mean = static_cast<float>(lodGrid_.sums[bin] / count);
+            c.push_back(std::isfinite(mean) ? mean : minmaxC_.x);
+        } else {
+            c.push_back(0.0f);
+        }
+    }
+    lodX_ = util::makeBuffer<float>(std::move(x));
+    lodY_ = util::makeBuffer<float>(std::move(y));
+    lodC_ = util::makeBuffer<float>(std::move(c));
+    lodR_ = util::makeBuffer<float>(std::move(r));
+
+    if (!lodBoa_) {
+        lodBoa_ = std::make_unique<BufferObjectArray>();
+    }
+    lodBoa_->bind();
+    lodBoa_->clear();
+    const auto attach = [&](const Buffer<float>& buffer, GLuint location) {
+        lodBoa_->attachBufferObject(buffer.getRepresentation<BufferGL>()->getBufferObject().get(),
+                                    location, BufferObject::BindingType::ForceFloat);
+    };
+    attach(*lodX_, 0);
+    attach(*lodY_, 1);
+    attach(*lodC_, 2);
+    attach(*lodR_, 3);
+}
+
 void ScatterPlotGL::setXAxisLabel(const std::string& label) {
     properties_.xAxis_.setCaption(label);
 }
@@ -480,6 +636,7 @@ void ScatterPlotGL::setXAxisData(std::shared_ptr<const BufferBase> buffer) {
 
         properties_.xAxis_.setRange(minmaxX_);
     }
+    lodDirty_ = true;
     boxSelectionHandler_.setXAxisData(buffer);
 }
 
@@ -492,6 +649,7 @@ void ScatterPlotGL::setYAxisData(std::shared_ptr<const BufferBase> buffer) {
 
         properties_.yAxis_.setRange(minmaxY_);
     }
+    lodDirty_ = true;
     boxSelectionHandler_.setYAxisData(buffer);
 }
 
@@ -504,6 +662,7 @@ void ScatterPlotGL::setColorData(std::shared_ptr<const BufferBase> buffer) {
     }
     properties_.tf_.setVisible(buffer != nullptr);
     properties_.color_.setVisible(buffer == nullptr);
+    lodDirty_ = true;
 }
 
 void ScatterPlotGL::setRadiusData(std::shared_ptr<const BufferBase> buffer) {
@@ -514,6 +673,7 @@ void ScatterPlotGL::setRadiusData(std::shared_ptr<const BufferBase> buffer) {
         minmaxR_.y = static_cast<float>(minmax.second.x);
     }
     properties_.minRadius_.setVisible(buffer != nullptr);
+    radiusSortDirty_ = true;
 }
 
 void ScatterPlotGL::setIndexColumn(std::shared_ptr<const TemplateColumn<uint32_t>> indexcol) {
@@ -542,6 +702,8 @@ void ScatterPlotGL::setSelectedIndices(const std::unordered_set<size_t>& indices
     selectedIndicesGLDirty_ = true;
 }
 
+void ScatterPlotGL::setIndicesChanged() { indicesDirty_ = true; }
+
 auto ScatterPlotGL::addToolTipCallback(std::function<ToolTipFunc> callback)
     -> ToolTipCallbackHandle {
     return tooltipCallback_.add(callback);
@@ -587,6 +749,10 @@ void ScatterPlotGL::objectPicked(PickingEvent* p) {
             return std::nullopt;
         }
         auto& indexCol = indexColumn_->getTypedBuffer()->getRAMRepresentation()->getDataContainer();
+        // the index column usually maps each row onto itself, avoid searching the column then
+        if (id < indexCol.size() && indexCol[id] == id) {
+            return id;
+        }
         auto it = util::find(indexCol, static_cast<uint32_t>(id));
         if (it != indexCol.end()) {
             return *it;
@@ -31,6 +31,7 @@
 #include <modules/plottinggl/processors/parallelcoordinates/pcpaxissettings.h>
 #include <modules/plottinggl/plottingglmodule.h>
 
+#include <inviwo/core/common/inviwoapplication.h>
 #include <inviwo/core/datastructures/image/layer.h>
 #include <inviwo/core/datastructures/image/imageram.h>
 #include <inviwo/core/interaction/events/mouseevent.h>
@@ -55,6 +56,8 @@
 #include <inviwo/core/util/utilities.h>
 #include <inviwo/core/util/zip.h>
 
+#include <cmath>
+
 namespace inviwo {
 
 namespace plot {
@@ -101,6 +104,11 @@ ParallelCoordinates::ParallelCoordinates()
                    vec4(0.01f), InvalidationLevel::InvalidOutput, PropertySemantics::Color)
     , filterAlpha_("filterAlpha", "Filter Alpha", 0.75f)
     , filterIntensity_("filterIntensity", "Filter Mixing", 0.7f, 0.01f, 1.0f, 0.001f)
+    , levelOfDetail_("levelOfDetail", "Level of Detail")
+    , aggregate_("aggregate", "Bundle Large Data", true)
+    , aggregationThreshold_("aggregationThreshold", "Bundling Threshold", 1000000, 1000,
+                            100000000)
+    , binSize_("binSize", "Bin Size (pixels)", 4, 1, 32)
 
     , captionSettings_("captions", "Caption Settings", "Montserrat-Regular", 24, 0.0f,
                        vec2{0.0f, -1.0f})
@@ -148,6 +156,7 @@ ParallelCoordinates::ParallelCoordinates()
                    [&](PickingEvent* p) { axisPicked(p, p->getPickedId(), PickType::Axis); })
     , lineShader_("pcp_lines.vert", "pcp_lines.geom", "pcp_lines.frag", false)
     , lines_{}
+    , bundleShader_("pcp_bundles.vert", "pcp_lines.geom", "pcp_lines.frag", false)
     , marginsInternal_(0.0f, 0.0f)
     , brushingDirty_(true)  // needs to be true after deserialization
 {
@@ -164,8 +173,10 @@ ParallelCoordinates::ParallelCoordinates()
 
     addProperty(lineSettings_);
     lineSettings_.addProperties(blendMode_, falllofPower_, lineWidth_, selectedLine_, showFiltered_,
-                                filterColor_, filterAlpha_, filterIntensity_);
+                                filterColor_, filterAlpha_, filterIntensity_, levelOfDetail_);
     lineSettings_.setCollapsed(true);
+    levelOfDetail_.addProperties(aggregate_, aggregationThreshold_, binSize_);
+    levelOfDetail_.setCollapsed(true);
 
     addProperty(captionSettings_);
     captionSettings_.insertProperty(0, captionPosition_);
@@ -218,6 +229,18 @@ ParallelCoordinates::ParallelCoordinates()
         lineShader_.onReload([&]() { this->invalidate(InvalidationLevel::InvalidOutput); });
         lineShader_.build();
     }
+    {
+        auto vs = bundleShader_.getVertexShaderObject();
+        vs->clearInDeclarations();
+        vs->addInDeclaration("in_Vertex", buffertraits::PositionsBuffer2D::bi().location, "vec2");
+        vs->addInDeclaration("in_Radii", buffertraits::RadiiBuffer::bi().location, "float");
+        vs->addInDeclaration("in_ScalarMeta", buffertraits::ScalarMetaBuffer::bi().location,
+                             "float");
+        vs->addShaderDefine("NUMBER_OF_AXIS", toString(1));
+
+        bundleShader_.onReload([&]() { this->invalidate(InvalidationLevel::InvalidOutput); });
+        bundleShader_.build();
+    }
 
     dataFrame_.onChange([&]() { createOrUpdateProperties(); });
 
@@ -298,7 +321,8 @@ void ParallelCoordinates::process() {
     }();
 
     if (brushingDirty_) updateBrushing();
-    if (colormap_.isModified() || dataFrame_.isChanged()) {
+    if (colormap_.isModified() || dataFrame_.isChanged() || aggregate_.isModified() ||
+        aggregationThreshold_.isModified()) {
         buildLineMesh();
     } else if (enabledAxesModified_) {
         buildLineIndices();
@@ -317,6 +341,7 @@ void ParallelCoordinates::process() {
     utilgl::activateAndClearTarget(outport_, ImageType::ColorPicking);
     utilgl::GlBoolState depthTest(GL_DEPTH_TEST, false);
 
+    if (aggregating()) buildBundles(dims);
     drawLines(dims);
     drawAxis(dims);
     drawHandles(dims);
@@ -416,16 +441,31 @@ void ParallelCoordinates::buildLineMesh() {
     const auto metaAxisId = colormap_.selectedColorAxis.get();
     const auto metaAxes = axes_[glm::clamp(metaAxisId, 0, static_cast<int>(axes_.size()) - 1)].pcp;
 
+    // the normalized values of each column are kept for binning the bundles
+    const bool bundles = aggregating();
+    std::vector<std::vector<float>> normalized(bundles ? numberOfAxis : 0,
+                                               std::vector<float>(numberOfLines));
+
     for (size_t i = 0; i < numberOfLines; i++) {
         const auto meta = static_cast<float>(metaAxes->getNormalizedAt(i));
         const auto picking = static_cast<uint32_t>(linePicking_.getPickingId(i));
-        for (auto& axis : axes_) {
-            mesh.addVertex(static_cast<float>(axis.pcp->getNormalizedAt(i)), picking, meta);
+        for (size_t j = 0; j < numberOfAxis; ++j) {
+            const auto value = static_cast<float>(axes_[j].pcp->getNormalizedAt(i));
+            mesh.addVertex(value, picking, meta);
+            if (bundles) normalized[j][i] = value;
         }
     }
 
+    bundles_.normalized.clear();
+    for (auto& values : normalized) {
+        bundles_.normalized.push_back(util::makeBuffer<float>(std::move(values)));
+    }
+
     lineShader_.getVertexShaderObject()->addShaderDefine("NUMBER_OF_AXIS", toString(numberOfAxis));
     lineShader_.build();
+    bundleShader_.getVertexShaderObject()->addShaderDefine("NUMBER_OF_AXIS",
+                                                           toString(numberOfAxis));
+    bundleShader_.build();
 
     buildLineIndices();
 }
@@ -495,6 +535,8 @@ void ParallelCoordinates::partitionLines() {
     lines_.offsets[1] = std::distance(lines_.starts.begin(), lastFilteredIt);
     lines_.offsets[2] = std::distance(lines_.starts.begin(), lastRegularIt);
     lines_.offsets[3] = lines_.starts.size();
+
+    bundles_.dirty = true;
 }
 
 void ParallelCoordinates::drawAxis(size2_t size) {
@@ -541,8 +583,6 @@ void ParallelCoordinates::drawHandles(size2_t size) {
 }
 
 void ParallelCoordinates::drawLines(size2_t size) {
-    lineShader_.activate();
-
     auto state = [&]() {
         switch (blendMode_.get()) {
             case BlendMode::Additive:
@@ -569,67 +609,191 @@ void ParallelCoordinates::drawLines(size2_t size) {
     // Draw lines
 
     TextureUnitContainer unit;
-    utilgl::bindAndSetUniforms(lineShader_, unit, colormap_.tf);
-
     bool enableBlending =
         (blendMode_.get() == BlendMode::Additive || blendMode_.get() == BlendMode::Sutractive ||
          blendMode_.get() == BlendMode::Regular);
-    // pcp_common.glsl
-    lineShader_.setUniform("spacing", vec4(marginsInternal_.second.y, marginsInternal_.second.x,
+    for (auto shader : {&bundleShader_, &lineShader_}) {
+        shader->activate();
+        utilgl::bindAndSetUniforms(*shader, unit, colormap_.tf);
+
+        // pcp_common.glsl
+        shader->setUniform("spacing", vec4(marginsInternal_.second.y, marginsInternal_.second.x,
                                            marginsInternal_.first.y, marginsInternal_.first.x));
-    lineShader_.setUniform("dims", ivec2(size));
-    // pcp_lines.vert
-    lineShader_.setUniform("axisPositions", lines_.axisPositions.size(),
+        shader->setUniform("dims", ivec2(size));
+        // pcp_lines.vert, pcp_bundles.vert
+        shader->setUniform("axisPositions", lines_.axisPositions.size(),
                            lines_.axisPositions.data());
-    lineShader_.setUniform("axisFlipped", lines_.axisFlipped.size(), lines_.axisFlipped.data());
-    // pcp_lines.geom
-    // lineWidth;
-
-    // pcp_lines.frag
-    lineShader_.setUniform("additiveBlend", enableBlending);
-    lineShader_.setUniform("subtractiveBelnding", blendMode_.get() == BlendMode::Sutractive);
-    lineShader_.setUniform("fallofPower", falllofPower_.get());
-    lineShader_.setUniform("color", vec4{filterColor_.get(), filterAlpha_.get()});
-    lineShader_.setUniform("selectColor", selectedLineColor_.get());
-    lineShader_.setUniform("filterIntensity", filterIntensity_.get());
+        shader->setUniform("axisFlipped", lines_.axisFlipped.size(), lines_.axisFlipped.data());
+        // pcp_lines.geom
+        // lineWidth;
+
+        // pcp_lines.frag
+        shader->setUniform("additiveBlend", enableBlending);
+        shader->setUniform("subtractiveBelnding", blendMode_.get() == BlendMode::Sutractive);
+        shader->setUniform("fallofPower", falllofPower_.get());
+        shader->setUniform("color", vec4{filterColor_.get(), filterAlpha_.get()});
+        shader->setUniform("selectColor", selectedLineColor_.get());
+        shader->setUniform("filterIntensity", filterIntensity_.get());
+    }
+
+    std::array<float, 3> width = {lineWidth_, lineWidth_, selectedLineWidth_};
+    std::array<float, 3> mixColor = {filterIntensity_, 0.0f, 0.0f};
+    std::array<float, 3> mixSelection = {0.0f, 0.0f,
+                                         selectedLineColorOverride_.isChecked() ? 1.0f : 0.0f};
+    std::array<float, 3> mixAlpha = {1.0, 0.0f, 0.0f};
+
+    // filtered, regular, and selected lines, the regular ones are drawn as bundles if aggregating
+    const bool bundled = aggregating();
+    for (size_t i = showFiltered_ ? 0 : 1; i < lines_.offsets.size() - 1; ++i) {
+        if (i == 1 && bundled) {
+            const auto count = bundles_.mesh.getBuffer(0)->getSize();
+            if (count == 0) continue;
+
+            bundleShader_.activate();
+            bundleShader_.setUniform("lineWidth", width[i]);
+            bundleShader_.setUniform("mixColor", mixColor[i]);
+            bundleShader_.setUniform("mixAlpha", mixAlpha[i]);
+            bundleShader_.setUniform("mixSelection", mixSelection[i]);
+
+            auto meshGL = bundles_.mesh.getRepresentation<MeshGL>();
+            utilgl::Enable<MeshGL> enable{meshGL};
+            glDrawArrays(GL_LINES, 0, static_cast<GLsizei>(count));
+            bundleShader_.deactivate();
+            continue;
+        }
+
+        auto begin = lines_.offsets[i];
+        auto end = lines_.offsets[i + 1];
+        if (end == begin) continue;
+
+        lineShader_.activate();
+        lineShader_.setUniform("lineWidth", width[i]);
+        lineShader_.setUniform("mixColor", mixColor[i]);
+        lineShader_.setUniform("mixAlpha", mixAlpha[i]);
+        lineShader_.setUniform("mixSelection", mixSelection[i]);
+
+        auto meshGL = lines_.mesh.getRepresentation<MeshGL>();
+        utilgl::Enable<MeshGL> enable{meshGL};
+        lines_.indices.getRepresentation<BufferGL>()->bind();
+
+        glMultiDrawElements(GL_LINE_STRIP, lines_.sizes.data() + begin, GL_UNSIGNED_INT,
+                            reinterpret_cast<const GLvoid* const*>(lines_.starts.data() + begin),
+                            static_cast<GLsizei>(end - begin));
+    }
+
+    if (hoveredLine_ >= 0 && hoveredLine_ < static_cast<int>(lines_.sizes.size()) &&
+        !brushingAndLinking_.isFiltered(hoveredLine_)) {
+        lineShader_.activate();
+        lineShader_.setUniform("lineWidth", width[1]);
+        lineShader_.setUniform("mixColor", mixColor[1]);
+        lineShader_.setUniform("mixAlpha", mixAlpha[1]);
+        lineShader_.setUniform("mixSelection", mixSelection[1]);
+        lineShader_.setUniform("fallofPower", 0.5f * falllofPower_.get());
 
-    {
         auto meshGL = lines_.mesh.getRepresentation<MeshGL>();
         utilgl::Enable<MeshGL> enable{meshGL};
         lines_.indices.getRepresentation<BufferGL>()->bind();
 
-        std::array<float, 3> width = {lineWidth_, lineWidth_, selectedLineWidth_};
-        std::array<float, 3> mixColor = {filterIntensity_, 0.0f, 0.0f};
-        std::array<float, 3> mixSelection = {0.0f, 0.0f,
-                                             selectedLineColorOverride_.isChecked() ? 1.0f : 0.0f};
-        std::array<float, 3> mixAlpha = {1.0, 0.0f, 0.0f};
-
-        for (size_t i = showFiltered_ ? 0 : 1; i < lines_.offsets.size() - 1; ++i) {
-            auto begin = lines_.offsets[i];
-            auto end = lines_.offsets[i + 1];
-            if (end == begin) continue;
-
-            lineShader_.setUniform("lineWidth", width[i]);
-            lineShader_.setUniform("mixColor", mixColor[i]);
-            lineShader_.setUniform("mixAlpha", mixAlpha[i]);
-            lineShader_.setUniform("mixSelection", mixSelection[i]);
-
-            glMultiDrawElements(
-                GL_LINE_STRIP, lines_.sizes.data() + begin, GL_UNSIGNED_INT,
-                reinterpret_cast<const GLvoid* const*>(lines_.starts.data() + begin),
-                static_cast<GLsizei>(end - begin));
+        glDrawElements(GL_LINE_STRIP, lines_.sizes[hoveredLine_], GL_UNSIGNED_INT,
+                       reinterpret_cast<GLvoid*>(
+                           Lines::indexToOffset(hoveredLine_, lines_.sizes[hoveredLine_])));
+    }
+    lineShader_.deactivate();
+}
+
+bool ParallelCoordinates::aggregating() const {
+    return aggregate_ && dataFrame_.hasData() &&
+           dataFrame_.getData()->getNumberOfRows() > aggregationThreshold_;
+}
+
+void ParallelCoordinates::buildBundles(size2_t size) {
+    if (bundles_.normalized.size() != axes_.size()) return;
+
+    // one bin per binSize pixels along the axes
+    const auto rect = getDisplayRect(vec2{size});
+    const auto bins = std::max(
+        static_cast<size_t>((rect.second.y - rect.first.y) / static_cast<float>(binSize_.get())),
+        size_t{1});
+    if (bins != bundles_.bins) {
+        bundles_.bins = bins;
+        bundles_.dirty = true;
+    }
+
+    if (bundles_.dirty) {
+        bundles_.dirty = false;
+        bundles_.result.reset();
+        ++bundles_.request;
+
+        // the regular lines, i.e. neither filtered nor selected
+        auto rows = std::make_shared<std::vector<std::uint32_t>>();
+        rows->reserve(lines_.offsets[2] - lines_.offsets[1]);
+        for (size_t i = lines_.offsets[1]; i < lines_.offsets[2]; ++i) {
+            rows->push_back(static_cast<std::uint32_t>(
+                Lines::offsetToIndex(lines_.starts[i], enabledAxes_.size())));
+        }
+
+        // The RAM representations are taken here, the job keeps the buffers alive
+        std::vector<std::pair<const BufferRAM*, const BufferRAM*>> pairs;
+        bundles_.axisPairs.clear();
+        for (size_t i = 1; i < enabledAxes_.size(); ++i) {
+            const auto a = enabledAxes_[i - 1];
+            const auto b = enabledAxes_[i];
+            bundles_.axisPairs.emplace_back(a, b);
+            pairs.emplace_back(bundles_.normalized[a]->getRepresentation<BufferRAM>(),
+                               bundles_.normalized[b]->getRepresentation<BufferRAM>());
         }
+        const auto metaAxisId = colormap_.selectedColorAxis.get();
+        const auto meta =
+            bundles_.normalized[glm::clamp(metaAxisId, 0, static_cast<int>(axes_.size()) - 1)]
+                ->getRepresentation<BufferRAM>();
+
+        dispatchPool([this, alive = std::weak_ptr<bool>(alive_), request = bundles_.request,
+                      buffers = bundles_.normalized, pairs, meta, rows, bins]() {
+            std::vector<DensityGrid> grids;
+            for (const auto& [x, y] : pairs) {
+                grids.push_back(densityGrid(*x, *y, size2_t{bins}, dvec2{0.0}, dvec2{1.0},
+                                            rows.get(), meta));
+            }
+            dispatchFrontAndForget([this, alive, request, grids = std::move(grids)]() mutable {
+                if (!alive.lock() || request != bundles_.request) return;
+                bundles_.result = std::move(grids);
+                invalidate(InvalidationLevel::InvalidOutput);
+            });
+        });
+    } else if (bundles_.result) {
+        setBundles(*bundles_.result);
+        bundles_.result.reset();
+    }
+}
 
-        if (hoveredLine_ >= 0 && hoveredLine_ < static_cast<int>(lines_.sizes.size()) &&
-            !brushingAndLinking_.isFiltered(hoveredLine_)) {
-            lineShader_.setUniform("fallofPower", 0.5f * falllofPower_.get());
+void ParallelCoordinates::setBundles(const std::vector<DensityGrid>& grids) {
+    auto& mesh = bundles_.mesh;
+    for (auto& item : mesh.getBuffers()) {
+        item.second->getEditableRepresentation<BufferRAM>()->clear();
+    }
 
-            glDrawElements(GL_LINE_STRIP, lines_.sizes[hoveredLine_], GL_UNSIGNED_INT,
-                           reinterpret_cast<GLvoid*>(
-                               Lines::indexToOffset(hoveredLine_, lines_.sizes[hoveredLine_])));
+    std::uint32_t maxCount = 1;
+    for (const auto& grid : grids) {
+        maxCount = std::max(maxCount, grid.maxCount());
+    }
+    const auto scale = 1.0f / std::log1p(static_cast<float>(maxCount));
+
+    // the line width grows with the logarithm of the number of lines in the bundle
+    for (size_t i = 0; i < grids.size(); ++i) {
+        const auto& grid = grids[i];
+        const auto& axes = bundles_.axisPairs[i];
+        for (size_t bin = 0; bin < grid.size(); ++bin) {
+            const auto count = grid.counts[bin];
+            if (count == 0) continue;
+            const auto pos = grid.binCenter(bin);
+            const auto width = 0.1f + 0.9f * std::log1p(static_cast<float>(count)) * scale;
+            const auto meta = static_cast<float>(grid.sums[bin] / count);
+            mesh.addVertex(vec2{static_cast<float>(axes.first), static_cast<float>(pos.x)}, width,
+                           meta);
+            mesh.addVertex(vec2{static_cast<float>(axes.second), static_cast<float>(pos.y)},
+                           width, meta);
         }
     }
-    lineShader_.deactivate();
 }
 
 void ParallelCoordinates::linePicked(PickingEvent* p) {
@@ -209,6 +209,12 @@ void ScatterPlotMatrixProcessor::process() {
         auto seq = util::sequence<uint32_t>(0, static_cast<uint32_t>(dfSize), 1);
         std::copy_if(seq.begin(), seq.end(), std::back_inserter(vec),
                      [&](const auto& id) { return !brushing_.isFiltered(indexCol[id]); });
+
+        if (brushing_.isChanged() || dataFrame_.isChanged()) {
+            for (auto& p : plots_) {
+                p->setIndicesChanged();
+            }
+        }
     }
 
     utilgl::activateAndClearTarget(outport_);
@@ -141,6 +141,9 @@ void ScatterPlotProcessor::process() {
         if (brushingPort_.isChanged()) {
             scatterPlot_.setSelectedIndices(brushingPort_.getSelectedIndices());
         }
+        if (brushingPort_.isChanged() || dataFramePort_.isChanged()) {
+            scatterPlot_.setIndicesChanged();
+        }
 
         auto dfSize = dataframe->getNumberOfRows();
 
@@ -2,4 +2,6 @@
 # Dependencies for current module
 set(dependencies
 )
-set(EnableByDefault ON)
\ No newline at end of file
+set(EnableByDefault ON)
+
+set(concurrent ON)
@@ -83,6 +83,24 @@ TIDDS_EXT unsigned char *readPVMvolume(const char *filename,
                              unsigned char **parameter=NULL,
                              unsigned char **comment=NULL);
 
+// read the header of a compressed PVM volume without decoding the whole stream
+// returns the PVM version (1-3) or zero if the file is not a PVM volume
+TIDDS_EXT int readPVMheader(const char *filename,
+                            unsigned int *width,unsigned int *height,unsigned int *depth,unsigned int *components=NULL,
+                            float *scalex=NULL,float *scaley=NULL,float *scalez=NULL);
+
+// decode a compressed PVM volume of the given size directly into a buffer of the caller
+// voxel i is written to volume+i*stride, 16 bit voxels are converted to the native byte order
+// the strings are allocated with malloc and NULL if empty, the caller frees them
+// returns the PVM version or zero if the file could not be decoded or has a different size
+TIDDS_EXT int decodePVMvolume(const char *filename,
+                              unsigned char *volume,size_t stride,
+                              unsigned int width,unsigned int height,unsigned int depth,unsigned int components=1,
+                              unsigned char **description=NULL,
+                              unsigned char **courtesy=NULL,
+                              unsigned char **parameter=NULL,
+                              unsigned char **comment=NULL);
+
 TIDDS_EXT unsigned int checksum(unsigned const char *data, unsigned int bytes);
 
 TIDDS_EXT void swapbytes(unsigned char *data, unsigned int bytes);
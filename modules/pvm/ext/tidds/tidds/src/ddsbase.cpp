@@ -31,13 +31,14 @@
 
 #define DDS_RL (7)
 
-FILE *DDS_file;
+// the stream state is per thread so that several files can be decoded concurrently
+thread_local FILE *DDS_file;
 
 char DDS_ID[]="DDS v3d\n";
 char DDS_ID2[]="DDS v3e\n";
 
-unsigned int DDS_buffer;
-int DDS_bufsize,DDS_bitcnt;
+thread_local unsigned int DDS_buffer;
+thread_local int DDS_bufsize,DDS_bitcnt;
 
 unsigned short int DDS_INTEL=1;
 
@@ -357,20 +358,15 @@ void writeDDSfile(const char *filename,unsigned char *data,size_t bytes,unsigned
    else interleave(data,bytes,skip,DDS_INTERLEAVE);
    }
 
-// read a Differential Data Stream
-unsigned char *readDDSfile(const char *filename,size_t *bytes)
+// open a Differential Data Stream and read its identifier
+// returns the version of the stream or zero if the file is not a DDS file
+static int openDDSfile(const char *filename)
    {
    int version=1;
 
-   unsigned int skip,strip;
-
-   unsigned char *data = 0;
-   unsigned char *ptr  = 0;
-
-   unsigned int cnt,cnt1,cnt2;
-   int bits,act;
+   unsigned int cnt;
 
-   if ((DDS_file=fopen(filename,"rb"))==NULL) return(NULL);
+   if ((DDS_file=fopen(filename,"rb"))==NULL) return(0);
 
    for (cnt=0; DDS_ID[cnt]!='\0'; cnt++)
       if (fgetc(DDS_file)!=DDS_ID[cnt])
@@ -382,18 +378,36 @@ unsigned char *readDDSfile(const char *filename,size_t *bytes)
 
    if (version==0)
       {
-      if ((DDS_file=fopen(filename,"rb"))==NULL) return(NULL);
+      if ((DDS_file=fopen(filename,"rb"))==NULL) return(0);
 
       for (cnt=0; DDS_ID2[cnt]!='\0'; cnt++)
          if (fgetc(DDS_file)!=DDS_ID2[cnt])
             {
             fclose(DDS_file);
-            return(NULL);
+            return(0);
             }
 
       version=2;
       }
 
+   return(version);
+   }
+
+// read a Differential Data Stream
+unsigned char *readDDSfile(const char *filename,size_t *bytes)
+   {
+   int version;
+
+   unsigned int skip,strip;
+
+   unsigned char *data = 0;
+   unsigned char *ptr  = 0;
+
+   unsigned int cnt,cnt1,cnt2;
+   int bits,act;
+
+   if ((version=openDDSfile(filename))==0) return(NULL);
+
    initbuffer();
 
    skip=readbits(DDS_file,2)+1;
@@ -443,6 +457,97 @@ unsigned char *readDDSfile(const char *filename,size_t *bytes)
    return(data);
    }
 
+// decode a Differential Data Stream chunk by chunk without holding the whole stream in memory
+// the decoded bytes are passed to the sink in order, the sink returns zero to stop decoding
+// a chunk has at least minchunk bytes, but streams with several bytes per voxel are passed
+// on in whole interleave blocks, and old v3d streams with several bytes per voxel at once
+// returns the number of decoded bytes
+static size_t decodeDDSfile(const char *filename,size_t minchunk,
+                            int (*sink)(unsigned char *data,size_t bytes,void *user),void *user)
+   {
+   int version;
+
+   unsigned int skip,strip;
+
+   unsigned char *data,*ptr;
+
+   size_t hist,chunk,cnt,total;
+   unsigned int cnt1,cnt2;
+   int bits,act;
+
+   BOOLINT stop=FALSE;
+
+   if ((version=openDDSfile(filename))==0) return(0);
+
+   initbuffer();
+
+   skip=readbits(DDS_file,2)+1;
+   strip=readbits(DDS_file,16)+1;
+
+   // the prediction of a byte needs the previous strip+1 bytes of the stream
+   hist=strip+1;
+
+   if (skip>1 && version==2) chunk=skip*DDS_INTERLEAVE;
+   else chunk=(minchunk>hist)?minchunk:hist;
+
+   if ((data=(unsigned char *)malloc(hist+chunk))==NULL) ERRORMSG();
+
+   ptr=data+hist;
+   cnt=total=0;
+   act=0;
+
+   while (!stop && (cnt1=readbits(DDS_file,DDS_RL))!=0)
+      {
+      bits=DDS_decode(readbits(DDS_file,3));
+
+      for (cnt2=0; cnt2<cnt1 && !stop; cnt2++)
+         {
+         if (total<=strip) act+=readbits(DDS_file,bits)-(1<<bits)/2;
+         else act+=*(ptr-strip)-*(ptr-strip-1)+readbits(DDS_file,bits)-(1<<bits)/2;
+
+         while (act<0) act+=256;
+         while (act>255) act-=256;
+
+         *ptr++=act;
+         total++;
+
+         if (++cnt<chunk) continue;
+
+         // a v3d stream is deinterleaved as a whole
+         if (skip>1 && version==1)
+            {
+            if ((data=(unsigned char *)realloc(data,hist+chunk+DDS_BLOCKSIZE))==NULL) ERRORMSG();
+            chunk+=DDS_BLOCKSIZE;
+            ptr=data+hist+cnt;
+            continue;
+            }
+
+         // keep the end of the chunk in stream order for the prediction of the next chunk
+         memcpy(data,data+chunk,hist);
+
+         interleave(data+hist,cnt,skip,DDS_INTERLEAVE);
+         if (sink(data+hist,cnt,user)==0) stop=TRUE;
+
+         ptr=data+hist;
+         cnt=0;
+         }
+      }
+
+   fclose(DDS_file);
+
+   if (!stop && cnt>0)
+      {
+      if (version==1) interleave(data+hist,cnt,skip);
+      else interleave(data+hist,cnt,skip,DDS_INTERLEAVE);
+
+      sink(data+hist,cnt,user);
+      }
+
+   free(data);
+
+   return(total);
+   }
+
 // write a RAW file
 void writeRAWfile(const char *filename,unsigned char *data,size_t bytes,int nofree)
    {
@@ -668,6 +773,43 @@ void writePVMvolume(const char *filename,unsigned const char *volume,
       }
    }
 
+// parse the header of a decoded PVM volume, data must be zero terminated
+// returns the version and the start of the voxels or zero if the data is not a PVM volume
+static int parsePVMheader(unsigned char *data,
+                          unsigned int *width,unsigned int *height,unsigned int *depth,unsigned int *numc,
+                          float *sx,float *sy,float *sz,
+                          unsigned char **voxels)
+   {
+   unsigned char *ptr;
+
+   int version=1;
+
+   if (strncmp((char *)data,"PVM\n",4)!=0)
+      {
+      if (strncmp((char *)data,"PVM2\n",5)==0) version=2;
+      else if (strncmp((char *)data,"PVM3\n",5)==0) version=3;
+      else return(0);
+
+      if (sscanf((char *)&data[5],"%u %u %u\n%g %g %g\n",width,height,depth,sx,sy,sz)!=6) ERRORMSG();
+      if (*width<1 || *height<1 || *depth<1 || *sx<=0.0f || *sy<=0.0f || *sz<=0.0f) ERRORMSG();
+      ptr=(unsigned char *)strchr((char *)&data[5],'\n')+1;
+      }
+   else
+      {
+      if (sscanf((char *)&data[4],"%u %u %u\n",width,height,depth)!=3) ERRORMSG();
+      if (*width<1 || *height<1 || *depth<1) ERRORMSG();
+      ptr=&data[4];
+      }
+
+   ptr=(unsigned char *)strchr((char *)ptr,'\n')+1;
+   if (sscanf((char *)ptr,"%u\n",numc)!=1) ERRORMSG();
+   if (*numc<1) ERRORMSG();
+
+   *voxels=(unsigned char *)strchr((char *)ptr,'\n')+1;
+
+   return(version);
+   }
+
 // read a compressed PVM volume
 unsigned char *readPVMvolume(const char *filename,
                              unsigned int *width,unsigned int *height,unsigned int *depth,unsigned int *components,
@@ -681,7 +823,7 @@ unsigned char *readPVMvolume(const char *filename,
    size_t bytes;
    unsigned int numc;
 
-   int version=1;
+   int version;
 
    unsigned char *volume;
 
@@ -695,22 +837,8 @@ unsigned char *readPVMvolume(const char *filename,
    if ((data=(unsigned char *)realloc(data,bytes+1))==NULL) ERRORMSG();
    data[bytes]='\0';
 
-   if (strncmp((char *)data,"PVM\n",4)!=0)
-      {
-      if (strncmp((char *)data,"PVM2\n",5)==0) version=2;
-      else if (strncmp((char *)data,"PVM3\n",5)==0) version=3;
-      else { free(data); return(NULL); }
-
-      if (sscanf((char *)&data[5],"%u %u %u\n%g %g %g\n",width,height,depth,&sx,&sy,&sz)!=6) ERRORMSG();
-      if (*width<1 || *height<1 || *depth<1 || sx<=0.0f || sy<=0.0f || sz<=0.0f) ERRORMSG();
-      ptr=(unsigned char *)strchr((char *)&data[5],'\n')+1;
-      }
-   else
-      {
-      if (sscanf((char *)&data[4],"%u %u %u\n",width,height,depth)!=3) ERRORMSG();
-      if (*width<1 || *height<1 || *depth<1) ERRORMSG();
-      ptr=&data[4];
-      }
+   if ((version=parsePVMheader(data,width,height,depth,&numc,&sx,&sy,&sz,&ptr))==0)
+      { free(data); return(NULL); }
 
    if (scalex!=NULL && scaley!=NULL && scalez!=NULL)
       {
@@ -719,23 +847,18 @@ unsigned char *readPVMvolume(const char *filename,
       *scalez=sz;
       }
 
-   ptr=(unsigned char *)strchr((char *)ptr,'\n')+1;
-   if (sscanf((char *)ptr,"%u\n",&numc)!=1) ERRORMSG();
-   if (numc<1) ERRORMSG();
-
    if (components!=NULL) *components=numc;
    else if (numc!=1) ERRORMSG();
 
-   ptr=(unsigned char *)strchr((char *)ptr,'\n')+1;
    if (version==3) len1=strlen((char *)(ptr+(*width)*(*height)*(*depth)*numc))+1;
    if (version==3) len2=strlen((char *)(ptr+(*width)*(*height)*(*depth)*numc+len1))+1;
    if (version==3) len3=strlen((char *)(ptr+(*width)*(*height)*(*depth)*numc+len1+len2))+1;
    if (version==3) len4=strlen((char *)(ptr+(*width)*(*height)*(*depth)*numc+len1+len2+len3))+1;
-   if ((volume=(unsigned char *)malloc((*width)*(*height)*(*depth)*numc+len1+len2+len3+len4))==NULL) ERRORMSG();
    if (data+bytes!=ptr+(*width)*(*height)*(*depth)*numc+len1+len2+len3+len4) ERRORMSG();
 
-   memcpy(volume,ptr,(*width)*(*height)*(*depth)*numc+len1+len2+len3+len4);
-   free(data);
+   // move the voxels to the front instead of copying them to a new buffer
+   memmove(data,ptr,(*width)*(*height)*(*depth)*numc+len1+len2+len3+len4);
+   volume=data;
 
    if (description!=NULL)
       {
@@ -764,6 +887,227 @@ unsigned char *readPVMvolume(const char *filename,
    return(volume);
    }
 
+// state of a PVM volume that is decoded chunk by chunk
+struct PVMsink
+   {
+   // the header
+   char header[4*DDS_MAXSTR+1];
+   size_t hdrlen;
+   int version;
+
+   unsigned int width,height,depth,components;
+   float sx,sy,sz;
+
+   // the voxels, byte i of a voxel is written to out[order[i]], NULL to only read the header
+   unsigned char *out;
+   unsigned int expected[4];
+   size_t stride;
+   unsigned int order[4],comp;
+   size_t pos,bytes;
+
+   // the strings of a PVM3 volume
+   unsigned char *trailer;
+   size_t trllen;
+
+   BOOLINT error;
+   };
+
+// parse the header as soon as all of its lines are decoded
+static size_t PVMsinkheader(PVMsink *s,unsigned char *data,size_t bytes)
+   {
+   unsigned int lines,i;
+   unsigned char *ptr;
+   size_t n;
+
+   for (n=0; n<bytes && s->hdrlen<4*DDS_MAXSTR; n++)
+      {
+      s->header[s->hdrlen++]=data[n];
+      if (data[n]!='\n') continue;
+
+      s->header[s->hdrlen]='\0';
+      lines=(strncmp(s->header,"PVM\n",4)==0)?3:4;
+      for (ptr=(unsigned char *)s->header,i=0; (ptr=(unsigned char *)strchr((char *)ptr,'\n'))!=NULL; ptr++) i++;
+      if (i<lines) continue;
+
+      s->version=parsePVMheader((unsigned char *)s->header,&s->width,&s->height,&s->depth,&s->components,&s->sx,&s->sy,&s->sz,&ptr);
+      if (s->version==0) s->error=TRUE;
+      return(n+1);
+      }
+
+   if (s->hdrlen>=4*DDS_MAXSTR) s->error=TRUE;
+
+   return(n);
+   }
+
+// pass the decoded bytes on to the header, the voxels and the strings
+static int PVMsinkdata(unsigned char *data,size_t bytes,void *user)
+   {
+   PVMsink *s=(PVMsink *)user;
+   unsigned char *ptr,*end;
+   size_t n;
+
+   if (s->version==0)
+      {
+      n=PVMsinkheader(s,data,bytes);
+      if (s->error) return(0);
+      if (s->version==0) return(1);
+      if (s->out==NULL) return(0);
+      if (s->width!=s->expected[0] || s->height!=s->expected[1] ||
+          s->depth!=s->expected[2] || s->components!=s->expected[3]) { s->error=TRUE; return(0); }
+
+      data+=n;
+      bytes-=n;
+      }
+
+   if (s->pos<s->bytes)
+      {
+      n=(bytes<s->bytes-s->pos)?bytes:s->bytes-s->pos;
+
+      if (s->stride==s->components && s->order[0]==0)
+         {
+         memcpy(s->out+s->pos,data,n);
+         s->pos+=n;
+         }
+      else
+         for (ptr=data,end=data+n; ptr<end; ptr++)
+            {
+            s->out[s->order[s->comp]]=*ptr;
+            if (++s->comp==s->components) { s->comp=0; s->out+=s->stride; }
+            s->pos++;
+            }
+
+      data+=n;
+      bytes-=n;
+      }
+
+   if (bytes>0)
+      {
+      if (s->version!=3) { s->error=TRUE; return(0); }
+      if ((s->trailer=(unsigned char *)realloc(s->trailer,s->trllen+bytes))==NULL) ERRORMSG();
+      memcpy(s->trailer+s->trllen,data,bytes);
+      s->trllen+=bytes;
+      }
+
+   return(1);
+   }
+
+// read the header of a compressed PVM volume, only decodes the start of the stream
+// returns the PVM version or zero if the file is not a PVM volume
+int readPVMheader(const char *filename,
+                  unsigned int *width,unsigned int *height,unsigned int *depth,unsigned int *components,
+                  float *scalex,float *scaley,float *scalez)
+   {
+   PVMsink s;
+
+   memset(&s,0,sizeof(s));
+   s.sx=s.sy=s.sz=1.0f;
+
+   decodeDDSfile(filename,DDS_MAXSTR,PVMsinkdata,&s);
+   if (s.version==0 || s.error) return(0);
+
+   *width=s.width;
+   *height=s.height;
+   *depth=s.depth;
+
+   if (components!=NULL) *components=s.components;
+
+   if (scalex!=NULL && scaley!=NULL && scalez!=NULL)
+      {
+      *scalex=s.sx;
+      *scaley=s.sy;
+      *scalez=s.sz;
+      }
+
+   return(s.version);
+   }
+
+// copy the next zero terminated string of the trailer, NULL if it is empty
+static BOOLINT PVMsinkstring(PVMsink *s,size_t *pos,unsigned char **str)
+   {
+   size_t len;
+
+   if (*pos>=s->trllen) return(FALSE);
+   len=strlen((char *)s->trailer+*pos)+1;
+   if (*pos+len>s->trllen) return(FALSE);
+
+   if (str!=NULL)
+      {
+      if (len>1)
+         {
+         if ((*str=(unsigned char *)malloc(len))==NULL) ERRORMSG();
+         memcpy(*str,s->trailer+*pos,len);
+         }
+      else *str=NULL;
+      }
+
+   *pos+=len;
+
+   return(TRUE);
+   }
+
+// decode a compressed PVM volume into a buffer of the caller
+int decodePVMvolume(const char *filename,
+                    unsigned char *volume,size_t stride,
+                    unsigned int width,unsigned int height,unsigned int depth,unsigned int components,
+                    unsigned char **description,
+                    unsigned char **courtesy,
+                    unsigned char **parameter,
+                    unsigned char **comment)
+   {
+   PVMsink s;
+   size_t pos=0;
+   unsigned int i;
+
+   BOOLINT ok=FALSE;
+
+   if (description!=NULL) *description=NULL;
+   if (courtesy!=NULL) *courtesy=NULL;
+   if (parameter!=NULL) *parameter=NULL;
+   if (comment!=NULL) *comment=NULL;
+
+   if (volume==NULL || components<1 || components>4 || stride<components) return(0);
+
+   memset(&s,0,sizeof(s));
+   s.sx=s.sy=s.sz=1.0f;
+
+   s.out=volume;
+   s.expected[0]=width;
+   s.expected[1]=height;
+   s.expected[2]=depth;
+   s.expected[3]=components;
+   s.stride=stride;
+   s.bytes=(size_t)width*height*depth*components;
+
+   // 16 bit voxels are stored with the most significant byte first
+   for (i=0; i<components; i++) s.order[i]=i;
+   if (components==2 && *((unsigned char *)&DDS_INTEL)!=0) { s.order[0]=1; s.order[1]=0; }
+
+   decodeDDSfile(filename,DDS_BLOCKSIZE,PVMsinkdata,&s);
+
+   if (s.version!=0 && !s.error && s.pos==s.bytes)
+      {
+      if (s.version!=3) ok=TRUE;
+      else ok=PVMsinkstring(&s,&pos,description) &&
+              PVMsinkstring(&s,&pos,courtesy) &&
+              PVMsinkstring(&s,&pos,parameter) &&
+              PVMsinkstring(&s,&pos,comment) &&
+              pos==s.trllen;
+      }
+
+   free(s.trailer);
+
+   if (!ok)
+      {
+      if (description!=NULL) { free(*description); *description=NULL; }
+      if (courtesy!=NULL) { free(*courtesy); *courtesy=NULL; }
+      if (parameter!=NULL) { free(*parameter); *parameter=NULL; }
+      if (comment!=NULL) { free(*comment); *comment=NULL; }
+      return(0);
+      }
+
+   return(s.version);
+   }
+
 // simple checksum algorithm
 unsigned int checksum(unsigned char *data, unsigned int bytes)
    {
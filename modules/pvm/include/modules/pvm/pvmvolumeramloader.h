@@ -0,0 +1,88 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <modules/pvm/pvmmoduledefine.h>
+#include <inviwo/core/datastructures/diskrepresentation.h>
+#include <inviwo/core/datastructures/volume/volumerepresentation.h>
+
+#include <string>
+#include <vector>
+
+namespace inviwo {
+
+class VolumeRAM;
+
+/**
+ * \brief The strings stored after the voxels of a PVM3 file, empty if not present.
+ */
+struct IVW_MODULE_PVM_API PVMMetaData {
+    std::string description;
+    std::string courtesy;
+    std::string parameter;
+    std::string comment;
+};
+
+/**
+ * \brief Decodes PVM files into a VolumeRAM when the data is first used.
+ * Each file provides one channel of the volume, such that a MPVM set with several files is
+ * decoded into one multi channel volume. The files are decoded concurrently on the thread pool.
+ * Each file is decoded in blocks straight into its channel of the VolumeRAM, without holding the
+ * whole decoded file in memory.
+ */
+class IVW_MODULE_PVM_API PVMVolumeRAMLoader
+    : public DiskRepresentationLoader<VolumeRepresentation> {
+public:
+    /**
+     * @param files one PVM file per channel, all with the same dimensions and format
+     */
+    explicit PVMVolumeRAMLoader(std::vector<std::string> files);
+    virtual PVMVolumeRAMLoader* clone() const override;
+    virtual ~PVMVolumeRAMLoader() = default;
+
+    virtual std::shared_ptr<VolumeRepresentation> createRepresentation(
+        const VolumeRepresentation& src) const override;
+    virtual void updateRepresentation(std::shared_ptr<VolumeRepresentation> dest,
+                                      const VolumeRepresentation& src) const override;
+
+    /**
+     * Decode the files into the channels of \p dest, which must have the dimensions of the files
+     * and one channel per file.
+     * @return the strings stored after the voxels of each file
+     * @throws DataReaderException if a file could not be decoded or does not match \p dest
+     */
+    std::vector<PVMMetaData> read(VolumeRAM& dest) const;
+
+private:
+
+    std::vector<std::string> files_;
+};
+
+}  // namespace inviwo
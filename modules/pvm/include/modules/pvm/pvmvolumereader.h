@@ -49,9 +49,35 @@ public:
     virtual PVMVolumeReader* clone() const override;
     virtual ~PVMVolumeReader() = default;
 
+    /**
+     * Only reads the header of the file, the data is decoded when it is first used, see
+     * readPVMHeader. PVM3 files are decoded right away to read their meta data.
+     */
     virtual std::shared_ptr<Volume> readData(const std::string& filePath) override;
+
+    /**
+     * Decode \p filePath into a volume including the description, courtesy, parameter, and
+     * comment meta data.
+     */
     static std::shared_ptr<Volume> readPVMData(std::string filePath);
 
+    /**
+     * Decode \p files into a VolumeRAM of \p volume, one channel per file, and set the
+     * description, courtesy, parameter, and comment meta data. The descriptions of all files are
+     * merged, the other strings are taken from the first file.
+     */
+    static void readPVMData(Volume& volume, const std::vector<std::string>& files);
+
+    /**
+     * Create a volume from the header of \p filePath with a PVMVolumeRAMLoader that decodes the
+     * data when it is first used. Only the start of the file is decoded. PVM3 files store the
+     * description, courtesy, parameter, and comment after the voxels, those are not read, use
+     * readPVMData to get them.
+     * @param filePath the PVM file
+     * @param version set to the PVM version of the file, if given
+     */
+    static std::shared_ptr<Volume> readPVMHeader(std::string filePath, int* version = nullptr);
+
 protected:
     void printMetaInfo(const MetaDataOwner&, std::string) const;
 };
@@ -28,16 +28,18 @@
  *********************************************************************************/
 
 #include <modules/pvm/mpvmvolumereader.h>
-#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <modules/pvm/pvmvolumeramloader.h>
+#include <inviwo/core/datastructures/volume/volumedisk.h>
 #include <inviwo/core/util/exception.h>
 #include <inviwo/core/util/filesystem.h>
 #include <inviwo/core/util/formatconversion.h>
 #include <inviwo/core/util/stringconversion.h>
 #include <inviwo/core/io/datareaderexception.h>
 
-#include <tidds/ddsbase.h>
 #include <modules/pvm/pvmvolumereader.h>
 
+#include <algorithm>
+
 namespace inviwo {
 
 MPVMVolumeReader::MPVMVolumeReader() : DataReaderType<Volume>() {
@@ -63,7 +65,7 @@ std::shared_ptr<Volume> MPVMVolumeReader::readData(const std::string& filePath)
         while (!f.eof()) {
             getline(f, textLine);
             textLine = trim(textLine);
-            files.push_back(textLine);
+            if (!textLine.empty()) files.push_back(textLine);
         };
     }
 
@@ -74,22 +76,20 @@ std::shared_ptr<Volume> MPVMVolumeReader::readData(const std::string& filePath)
         throw DataReaderException("Error: Maximum 4 pvm files are supported, file: " + filePath,
                                   IVW_CONTEXT);
 
-    // Read all pvm volumes
+    // Read the headers of all pvm volumes, the data is decoded when first used, unless a PVM3
+    // file stores meta data after its voxels
+    std::vector<std::string> paths;
     std::vector<std::shared_ptr<Volume>> volumes;
-    for (size_t i = 0; i < files.size(); i++) {
-        auto newVol = PVMVolumeReader::readPVMData(fileDirectory + "/" + files[i]);
-        if (newVol)
-            volumes.push_back(newVol);
-        else
-            LogWarn("Could not load " << fileDirectory << "/" << files[i]);
+    std::vector<int> versions;
+    for (const auto& file : files) {
+        paths.push_back(fileDirectory + "/" + file);
+        versions.push_back(0);
+        volumes.push_back(PVMVolumeReader::readPVMHeader(paths.back(), &versions.back()));
     }
 
-    if (volumes.empty())
-        throw DataReaderException("No PVM volumes could be read from file: " + filePath,
-                                  IVW_CONTEXT);
-
     if (volumes.size() == 1) {
-        printPVMMeta(*volumes[0], fileDirectory + "/" + files[0]);
+        if (versions[0] == 3) PVMVolumeReader::readPVMData(*volumes[0], {paths[0]});
+        printPVMMeta(*volumes[0], paths[0]);
         return volumes[0];
     }
 
@@ -99,7 +99,8 @@ std::shared_ptr<Volume> MPVMVolumeReader::readData(const std::string& filePath)
     for (size_t i = 1; i < volumes.size(); i++) {
         if (format != volumes[i]->getDataFormat() || mdim != volumes[i]->getDimensions()) {
             LogWarn("PVM volumes did not have the same format or dimensions, using first volume.");
-            printPVMMeta(*volumes[0], fileDirectory + "/" + files[0]);
+            if (versions[0] == 3) PVMVolumeReader::readPVMData(*volumes[0], {paths[0]});
+            printPVMMeta(*volumes[0], paths[0]);
             return volumes[0];
         }
     }
@@ -108,47 +109,21 @@ std::shared_ptr<Volume> MPVMVolumeReader::readData(const std::string& filePath)
     const DataFormatBase* mformat =
         DataFormatBase::get(format->getNumericType(), volumes.size(), format->getSize() * 8);
 
-    // Create new volume
+    // Create new volume, the loader decodes the files concurrently into the channels
     auto volume = std::make_shared<Volume>(mdim, mformat);
     glm::mat3 basis = volumes[0]->getBasis();
     volume->setBasis(basis);
     volume->setOffset(-0.5f * (basis[0] + basis[1] + basis[2]));
-    volume->copyMetaDataFrom(*volumes[0]);
-
-    // Merge descriptions but ignore the rest
-    if (auto metaData = volume->getMetaData<StringMetaData>("description")) {
-        std::string descStr = metaData->get();
-        for (size_t i = 1; i < volumes.size(); i++) {
-            metaData = volumes[0]->getMetaData<StringMetaData>("description");
-            if (metaData) descStr = descStr + ", " + metaData->get();
-        }
-        volume->setMetaData<StringMetaData>("description", descStr);
-    }
-
-    // Create RAM volume
-    auto mvolRAM = createVolumeRAM(mdim, mformat);
-    unsigned char* dataPtr = static_cast<unsigned char*>(mvolRAM->getData());
 
-    std::vector<const unsigned char*> volumesDataPtr;
-    for (size_t i = 0; i < volumes.size(); i++) {
-        volumesDataPtr.push_back(static_cast<const unsigned char*>(
-            volumes[i]->getRepresentation<VolumeRAM>()->getData()));
-    }
+    auto vd = std::make_shared<VolumeDisk>(filePath, mdim, mformat);
+    vd->setLoader(new PVMVolumeRAMLoader(paths));
+    volume->addRepresentation(vd);
 
-    // Copy the data from the other volumes to the new multichannel volume
-    size_t mbytes = mformat->getSize();
-    size_t bytes = format->getSize();
-    size_t dims = mdim.x * mdim.y * mdim.z;
-    size_t vsize = volumesDataPtr.size();
-    for (size_t i = 0; i < dims; i++) {
-        for (size_t j = 0; j < vsize; j++) {
-            for (size_t b = 0; b < bytes; b++) {
-                dataPtr[i * mbytes + (j * bytes) + b] = volumesDataPtr[j][i * bytes + b];
-            }
-        }
+    // PVM3 files store their meta data after the voxels, decode them now to merge the descriptions
+    if (std::find(versions.begin(), versions.end(), 3) != versions.end()) {
+        PVMVolumeReader::readPVMData(*volume, paths);
     }
 
-    volume->addRepresentation(mvolRAM);
     printPVMMeta(*volume, filePath);
     return volume;
 }
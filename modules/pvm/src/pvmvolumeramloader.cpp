@@ -0,0 +1,105 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/pvm/pvmvolumeramloader.h>
+
+#include <inviwo/core/datastructures/volume/volumeram.h>
+#include <inviwo/core/io/datareaderexception.h>
+#include <inviwo/core/util/foreach.h>
+#include <inviwo/core/util/raiiutils.h>
+
+#include <tidds/ddsbase.h>
+
+#include <array>
+#include <cstdlib>
+
+namespace inviwo {
+
+PVMVolumeRAMLoader::PVMVolumeRAMLoader(std::vector<std::string> files)
+    : files_{std::move(files)} {}
+
+PVMVolumeRAMLoader* PVMVolumeRAMLoader::clone() const { return new PVMVolumeRAMLoader(*this); }
+
+std::shared_ptr<VolumeRepresentation> PVMVolumeRAMLoader::createRepresentation(
+    const VolumeRepresentation& src) const {
+    auto volumeRAM =
+        createVolumeRAM(src.getDimensions(), src.getDataFormat(), nullptr, src.getSwizzleMask(),
+                        src.getInterpolation(), src.getWrapping());
+    read(*volumeRAM);
+    return volumeRAM;
+}
+
+void PVMVolumeRAMLoader::updateRepresentation(std::shared_ptr<VolumeRepresentation> dest,
+                                              const VolumeRepresentation& src) const {
+    auto volumeDst = std::static_pointer_cast<VolumeRAM>(dest);
+    if (src.getDimensions() != volumeDst->getDimensions()) {
+        volumeDst->setDimensions(src.getDimensions());
+    }
+    read(*volumeDst);
+
+    volumeDst->setSwizzleMask(src.getSwizzleMask());
+    volumeDst->setInterpolation(src.getInterpolation());
+    volumeDst->setWrapping(src.getWrapping());
+}
+
+std::vector<PVMMetaData> PVMVolumeRAMLoader::read(VolumeRAM& dest) const {
+    const auto dims = dest.getDimensions();
+    const size_t bytes = dest.getDataFormat()->getSize();
+    const size_t channelBytes = bytes / files_.size();
+    auto data = static_cast<unsigned char*>(dest.getData());
+
+    std::vector<PVMMetaData> metaData(files_.size());
+    util::forEachRange(files_.size(), files_.size(), [&](size_t channel, size_t, size_t) {
+        const auto& file = files_[channel];
+        std::array<unsigned char*, 4> strings{};
+        util::OnScopeExit release([&]() {
+            for (auto str : strings) free(str);
+        });
+
+        const int version = decodePVMvolume(
+            file.c_str(), data + channel * channelBytes, bytes, static_cast<unsigned int>(dims.x),
+            static_cast<unsigned int>(dims.y), static_cast<unsigned int>(dims.z),
+            static_cast<unsigned int>(channelBytes), &strings[0], &strings[1], &strings[2],
+            &strings[3]);
+        if (version == 0) {
+            throw DataReaderException("Error: Could not decode PVM file: " + file +
+                                          ", or its dimensions or format changed since it was read",
+                                      IVW_CONTEXT);
+        }
+
+        auto asString = [](const unsigned char* str) {
+            return str ? std::string(reinterpret_cast<const char*>(str)) : std::string{};
+        };
+        metaData[channel] = PVMMetaData{asString(strings[0]), asString(strings[1]),
+                                        asString(strings[2]), asString(strings[3])};
+    });
+    return metaData;
+}
+
+}  // namespace inviwo
@@ -28,17 +28,48 @@
  *********************************************************************************/
 
 #include <modules/pvm/pvmvolumereader.h>
+#include <modules/pvm/pvmvolumeramloader.h>
+#include <inviwo/core/datastructures/volume/volumedisk.h>
 #include <inviwo/core/datastructures/volume/volumeramprecision.h>
 #include <inviwo/core/util/exception.h>
 #include <inviwo/core/util/filesystem.h>
 #include <inviwo/core/util/formatconversion.h>
-#include <inviwo/core/util/raiiutils.h>
 #include <inviwo/core/util/stringconversion.h>
 #include <inviwo/core/io/datareaderexception.h>
 #include <tidds/ddsbase.h>
 
 namespace inviwo {
 
+namespace {
+
+const DataFormatBase* pvmFormat(unsigned int bytesPerVoxel, const std::string& filePath) {
+    switch (bytesPerVoxel) {
+        case 1:
+            return DataUInt8::get();
+        case 2:
+            return DataUInt16::get();
+        case 3:
+            return DataVec3UInt8::get();
+        default:
+            throw DataReaderException(
+                "Error: Unsupported format (bytes per voxel) in .pvm file: " + filePath,
+                IVW_CONTEXT_CUSTOM("PVMVolumeReader"));
+    }
+}
+
+void setPVMBasis(Volume& volume, uvec3 udim, vec3 spacing) {
+    mat3 basis(2.0f);
+    if (spacing != vec3(0.0f)) {
+        basis[0][0] = udim.x * spacing.x;
+        basis[1][1] = udim.y * spacing.y;
+        basis[2][2] = udim.z * spacing.z;
+    }
+    volume.setBasis(basis);
+    volume.setOffset(-0.5f * (basis[0] + basis[1] + basis[2]));
+}
+
+}  // namespace
+
 PVMVolumeReader::PVMVolumeReader() : DataReaderType<Volume>() {
     addExtension(FileExtension("pvm", "PVM file format"));
 }
@@ -49,9 +80,9 @@ std::shared_ptr<Volume> PVMVolumeReader::readData(const std::string& filePath) {
     if (!filesystem::fileExists(filePath)) {
         throw DataReaderException("Error could not find input file: " + filePath, IVW_CONTEXT);
     }
-    auto volume = readPVMData(filePath);
-
-    if (!volume) return std::shared_ptr<Volume>();
+    int version = 0;
+    auto volume = readPVMHeader(filePath, &version);
+    if (version == 3) readPVMData(*volume, {filePath});
 
     // Print information
     size3_t dim = volume->getDimensions();
@@ -66,83 +97,61 @@ std::shared_ptr<Volume> PVMVolumeReader::readData(const std::string& filePath) {
     return volume;
 }
 
-std::shared_ptr<Volume> PVMVolumeReader::readPVMData(std::string filePath) {
+std::shared_ptr<Volume> PVMVolumeReader::readPVMHeader(std::string filePath, int* version) {
     uvec3 udim{0};
     vec3 spacing(0.0f);
     unsigned int bytesPerVoxel = 0;
 
-    // these pointers refer to positions within pvmdata
-    unsigned char* description = nullptr;
-    unsigned char* courtesy = nullptr;
-    unsigned char* parameter = nullptr;
-    unsigned char* comment = nullptr;
+    const int pvmVersion = readPVMheader(filePath.c_str(), &udim.x, &udim.y, &udim.z,
+                                         &bytesPerVoxel, &spacing.x, &spacing.y, &spacing.z);
+    if (pvmVersion == 0) {
+        throw DataReaderException("Error: Could not read header of PVM file: " + filePath,
+                                  IVW_CONTEXT_CUSTOM("PVMVolumeReader"));
+    }
+    if (version) *version = pvmVersion;
+    const auto format = pvmFormat(bytesPerVoxel, filePath);
 
-    unsigned char* pvmdata =
-        readPVMvolume(filePath.c_str(), &udim.x, &udim.y, &udim.z, &bytesPerVoxel, &spacing.x,
-                      &spacing.y, &spacing.z, &description, &courtesy, &parameter, &comment);
+    auto volume = std::make_shared<Volume>(size3_t(udim), format);
+    setPVMBasis(*volume, udim, spacing);
 
-    util::OnScopeExit release([&]() { free(pvmdata); });
+    auto vd = std::make_shared<VolumeDisk>(filePath, size3_t(udim), format);
+    vd->setLoader(new PVMVolumeRAMLoader({filePath}));
+    volume->addRepresentation(vd);
 
-    if (!pvmdata) {
-        throw DataReaderException("Error: Could not read data in PVM file: " + filePath,
-                                  IVW_CONTEXT_CUSTOM("PVMVolumeReader"));
-    }
-    if (udim == uvec3{0}) {
-        throw DataReaderException("Error: Unable to find dimensions in .pvm file: " + filePath,
-                                  IVW_CONTEXT_CUSTOM("PVMVolumeReader"));
-    }
-    const size_t volsize = glm::compMul(udim) * bytesPerVoxel;
-    if (bytesPerVoxel == 2) {
-        // swap byte order for DataUInt16,
-        swapbytes(pvmdata, static_cast<unsigned int>(volsize));
-    }
+    return volume;
+}
 
-    // re-allocate the volume using "new" and copy the data
-    auto data = std::make_unique<unsigned char[]>(volsize);
-    std::copy(pvmdata, pvmdata + volsize, data.get());
-
-    const DataFormatBase* format = [bytesPerVoxel, filePath]() -> const DataFormatBase* {
-        switch (bytesPerVoxel) {
-            case 1:
-                return DataUInt8::get();
-            case 2:
-                return DataUInt16::get();
-            case 3:
-                return DataVec3UInt8::get();
-            default:
-                throw DataReaderException(
-                    "Error: Unsupported format (bytes per voxel) in .pvm file: " + filePath,
-                    IVW_CONTEXT_CUSTOM("PVMVolumeReader"));
-        }
-    }();
-
-    auto volRAM = createVolumeRAM(size3_t(udim), format, data.release());
-    auto volume = std::make_shared<Volume>(volRAM);
+std::shared_ptr<Volume> PVMVolumeReader::readPVMData(std::string filePath) {
+    auto volume = readPVMHeader(filePath);
+    readPVMData(*volume, {filePath});
+    return volume;
+}
 
-    mat3 basis(2.0f);
-    if (spacing != vec3(0.0f)) {
-        basis[0][0] = udim.x * spacing.x;
-        basis[1][1] = udim.y * spacing.y;
-        basis[2][2] = udim.z * spacing.z;
+void PVMVolumeReader::readPVMData(Volume& volume, const std::vector<std::string>& files) {
+    auto volRAM = createVolumeRAM(volume.getDimensions(), volume.getDataFormat());
+    const auto metaData = PVMVolumeRAMLoader(files).read(*volRAM);
+    volume.addRepresentation(volRAM);
+
+    std::string description;
+    for (const auto& item : metaData) {
+        if (item.description.empty()) continue;
+        if (!description.empty()) description += ", ";
+        description += item.description;
     }
-    volume->setBasis(basis);
-    volume->setOffset(-0.5f * (basis[0] + basis[1] + basis[2]));
 
-    // Additional information
-    if (description) {
-        volume->setMetaData<StringMetaData>("description", toString(description));
+    const auto& first = metaData.front();
+    if (!description.empty()) {
+        volume.setMetaData<StringMetaData>("description", description);
     }
-    if (courtesy) {
-        volume->setMetaData<StringMetaData>("courtesy", toString(courtesy));
+    if (!first.courtesy.empty()) {
+        volume.setMetaData<StringMetaData>("courtesy", first.courtesy);
     }
-    if (parameter) {
-        volume->setMetaData<StringMetaData>("parameter", toString(parameter));
+    if (!first.parameter.empty()) {
+        volume.setMetaData<StringMetaData>("parameter", first.parameter);
     }
-    if (comment) {
-        volume->setMetaData<StringMetaData>("comment", toString(comment));
+    if (!first.comment.empty()) {
+        volume.setMetaData<StringMetaData>("comment", first.comment);
     }
-
-    return volume;
 }
 
 void PVMVolumeReader::printMetaInfo(const MetaDataOwner& metaDataOwner, std::string key) const {
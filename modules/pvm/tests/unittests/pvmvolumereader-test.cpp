@@ -0,0 +1,191 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/pvm/mpvmvolumereader.h>
+#include <modules/pvm/pvmvolumereader.h>
+#include <modules/pvm/pvmvolumewriter.h>
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/volumedisk.h>
+#include <inviwo/core/datastructures/volume/volumeram.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/io/tempfilehandle.h>
+#include <inviwo/core/metadata/metadata.h>
+#include <inviwo/core/util/filesystem.h>
+#include <inviwo/core/util/stringconversion.h>
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+namespace inviwo {
+
+namespace {
+
+// A pattern with some noise, such that neither byte of 16 bit voxels is constant
+template <typename T>
+T value(size_t i, size_t seed) {
+    const auto noise = (i * 2654435761u + seed * 40503u) >> 7;
+    return static_cast<T>(i * 7 + seed * 61 + (noise & 0x3f) * 1021);
+}
+
+template <typename T>
+std::shared_ptr<Volume> makeVolume(size3_t dims, size_t seed) {
+    auto ram = std::make_shared<VolumeRAMPrecision<T>>(dims);
+    auto data = ram->getDataTyped();
+    for (size_t i = 0; i < glm::compMul(dims); ++i) data[i] = value<T>(i, seed);
+    return std::make_shared<Volume>(ram);
+}
+
+void writePVM(const Volume& volume, const std::string& file) {
+    PVMVolumeWriter writer;
+    writer.setOverwrite(true);
+    writer.writeData(&volume, file);
+}
+
+template <typename T>
+void expectData(const Volume& volume, size_t channels, size_t channel, size_t seed) {
+    const auto ram = volume.getRepresentation<VolumeRAM>();
+    const auto data = static_cast<const T*>(ram->getData());
+    for (size_t i = 0; i < glm::compMul(volume.getDimensions()); ++i) {
+        ASSERT_EQ(data[i * channels + channel], value<T>(i, seed))
+            << "at voxel " << i << ", channel " << channel;
+    }
+}
+
+std::string metaData(const Volume& volume, const std::string& key) {
+    const auto item = volume.getMetaData<StringMetaData>(key);
+    return item ? item->get() : std::string{};
+}
+
+}  // namespace
+
+TEST(PVMVolumeReader, ReadsHeaderAndDecodesWhenUsed) {
+    util::TempFileHandle tmpFile("pvm", ".pvm");
+    const size3_t dims{23, 17, 11};
+    writePVM(*makeVolume<std::uint8_t>(dims, 1), tmpFile.getFileName());
+
+    PVMVolumeReader reader;
+    auto volume = reader.readData(tmpFile.getFileName());
+    ASSERT_TRUE(volume);
+    EXPECT_EQ(volume->getDimensions(), dims);
+    EXPECT_EQ(volume->getDataFormat(), DataUInt8::get());
+    EXPECT_TRUE(volume->hasRepresentation<VolumeDisk>());
+    EXPECT_FALSE(volume->hasRepresentation<VolumeRAM>());
+
+    expectData<std::uint8_t>(*volume, 1, 0, 1);
+}
+
+// A 16 bit volume larger than two 16 MB interleave blocks is stored as a v3e stream, which is
+// deinterleaved block by block. The header is only readable once the whole first block is
+// decoded, and the data continues over the block border into a partial last block.
+TEST(PVMVolumeReader, HeaderOfInterleavedBlocks) {
+    util::TempFileHandle tmpFile("pvm", ".pvm");
+    const size3_t dims{256, 256, 300};
+    writePVM(*makeVolume<std::uint16_t>(dims, 2), tmpFile.getFileName());
+
+    int version = 0;
+    auto volume = PVMVolumeReader::readPVMHeader(tmpFile.getFileName(), &version);
+    ASSERT_TRUE(volume);
+    EXPECT_EQ(version, 2);
+    EXPECT_EQ(volume->getDimensions(), dims);
+    EXPECT_EQ(volume->getDataFormat(), DataUInt16::get());
+    EXPECT_FALSE(volume->hasRepresentation<VolumeRAM>());
+
+    expectData<std::uint16_t>(*volume, 1, 0, 2);
+}
+
+// A small 16 bit volume is stored as a v3d stream, which is deinterleaved as a whole
+TEST(PVMVolumeReader, ReadsMetaDataOfPVM3) {
+    util::TempFileHandle tmpFile("pvm", ".pvm");
+    const size3_t dims{20, 30, 40};
+    auto source = makeVolume<std::uint16_t>(dims, 3);
+    source->setMetaData<StringMetaData>("description", "A test volume");
+    source->setMetaData<StringMetaData>("comment", "Line one\nLine two");
+    writePVM(*source, tmpFile.getFileName());
+
+    PVMVolumeReader reader;
+    auto volume = reader.readData(tmpFile.getFileName());
+    ASSERT_TRUE(volume);
+    EXPECT_EQ(volume->getDimensions(), dims);
+    EXPECT_TRUE(volume->hasRepresentation<VolumeRAM>());
+    EXPECT_EQ(metaData(*volume, "description"), "A test volume");
+    EXPECT_EQ(metaData(*volume, "courtesy"), "");
+    EXPECT_EQ(metaData(*volume, "comment"), "Line one\nLine two");
+
+    expectData<std::uint16_t>(*volume, 1, 0, 3);
+}
+
+class MPVMVolumeReaderTest : public ::testing::TestWithParam<bool> {};
+
+TEST_P(MPVMVolumeReaderTest, DecodesFilesIntoChannels) {
+    const bool withMetaData = GetParam();
+    const size3_t dims{31, 20, 9};
+    util::TempFileHandle first("pvm", ".pvm");
+    util::TempFileHandle second("pvm", ".pvm");
+    util::TempFileHandle mpvm("mpvm", ".mpvm");
+
+    for (auto&& [file, seed] : {std::make_pair(&first, size_t{4}),
+                                std::make_pair(&second, size_t{5})}) {
+        auto source = makeVolume<std::uint16_t>(dims, seed);
+        if (withMetaData) {
+            source->setMetaData<StringMetaData>("description", "channel " + toString(seed));
+            source->setMetaData<StringMetaData>("courtesy", "courtesy " + toString(seed));
+        }
+        writePVM(*source, file->getFileName());
+    }
+    {
+        std::ofstream list(mpvm.getFileName());
+        list << filesystem::getFileNameWithExtension(first.getFileName()) << "\n"
+             << filesystem::getFileNameWithExtension(second.getFileName()) << "\n";
+    }
+
+    MPVMVolumeReader reader;
+    auto volume = reader.readData(mpvm.getFileName());
+    ASSERT_TRUE(volume);
+    EXPECT_EQ(volume->getDimensions(), dims);
+    EXPECT_EQ(volume->getDataFormat(), DataVec2UInt16::get());
+    // Only PVM3 files with meta data are decoded right away
+    EXPECT_EQ(volume->hasRepresentation<VolumeRAM>(), withMetaData);
+    if (withMetaData) {
+        EXPECT_EQ(metaData(*volume, "description"), "channel 4, channel 5");
+        EXPECT_EQ(metaData(*volume, "courtesy"), "courtesy 4");
+    }
+
+    expectData<std::uint16_t>(*volume, 2, 0, 4);
+    expectData<std::uint16_t>(*volume, 2, 1, 5);
+}
+
+INSTANTIATE_TEST_SUITE_P(MPVMVolumeReader, MPVMVolumeReaderTest, ::testing::Bool());
+
+}  // namespace inviwo
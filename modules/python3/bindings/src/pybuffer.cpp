@@ -141,15 +141,25 @@ void exposeBuffer(pybind11::module &m) {
                               strides.push_back(df->getSize() / df->getComponents());
                           }
 
-                          auto data = buffer->getEditableRepresentation<BufferRAM>()->getData();
+                          void *data = nullptr;
+                          {
+                              py::gil_scoped_release release;
+                              data = buffer->getEditableRepresentation<BufferRAM>()->getData();
+                          }
                           return py::array(pyutil::toNumPyFormat(df), shape, strides, data,
                                            py::cast<>(1));
                       },
                       [](BufferBase *buffer, py::array data) {
-                          auto rep = buffer->getEditableRepresentation<BufferRAM>();
+                          auto rep = [&]() {
+                              py::gil_scoped_release release;
+                              return buffer->getEditableRepresentation<BufferRAM>();
+                          }();
                           pyutil::checkDataFormat<1>(rep->getDataFormat(), rep->getSize(), data);
 
-                          memcpy(rep->getData(), data.data(0), data.nbytes());
+                          const auto src = data.data(0);
+                          const auto size = static_cast<size_t>(data.nbytes());
+                          py::gil_scoped_release release;
+                          memcpy(rep->getData(), src, size);
                       })
         .def("__repr__", [](const BufferBase &self) {
             return fmt::format("<Buffer: target = {} usage = {} format = {} size = {}>",
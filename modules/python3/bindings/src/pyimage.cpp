@@ -162,14 +162,24 @@ void exposeImage(py::module& m) {
                     strides.push_back(df->getSize() / df->getComponents());
                 }
 
-                auto data = layer->getEditableRepresentation<LayerRAM>()->getData();
+                void* data = nullptr;
+                {
+                    py::gil_scoped_release release;
+                    data = layer->getEditableRepresentation<LayerRAM>()->getData();
+                }
                 return py::array(pyutil::toNumPyFormat(df), shape, strides, data, py::cast<>(1));
             },
             [](Layer* layer, py::array data) {
-                auto rep = layer->getEditableRepresentation<LayerRAM>();
+                auto rep = [&]() {
+                    py::gil_scoped_release release;
+                    return layer->getEditableRepresentation<LayerRAM>();
+                }();
                 pyutil::checkDataFormat<2>(rep->getDataFormat(), rep->getDimensions(), data);
 
-                memcpy(rep->getData(), data.data(0), data.nbytes());
+                const auto src = data.data(0);
+                const auto size = static_cast<size_t>(data.nbytes());
+                py::gil_scoped_release release;
+                memcpy(rep->getData(), src, size);
             })
         .def("__repr__", [](const Layer& self) {
             return fmt::format(
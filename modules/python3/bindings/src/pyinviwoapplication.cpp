@@ -32,6 +32,7 @@
 #include <inviwo/core/common/inviwoapplication.h>
 #include <inviwo/core/common/inviwomodule.h>
 #include <inviwo/core/network/processornetwork.h>
+#include <inviwo/core/network/processornetworkstatistics.h>
 #include <inviwopy/vectoridentifierwrapper.h>
 #include <inviwo/core/util/commandlineparser.h>
 
@@ -83,7 +84,8 @@ void exposeInviwoApplication(pybind11::module &m) {
         .def("getModuleSettings", &InviwoApplication::getModuleSettings,
              py::return_value_policy::reference)
 
-        .def("waitForPool", &InviwoApplication::waitForPool)
+        .def("waitForPool", &InviwoApplication::waitForPool,
+             py::call_guard<py::gil_scoped_release>())
         .def("closeInviwoApplication", &InviwoApplication::closeInviwoApplication)
 
         .def("getOutputPath",
@@ -91,6 +93,10 @@ void exposeInviwoApplication(pybind11::module &m) {
 
         .def_property_readonly("network", &InviwoApplication::getProcessorNetwork,
                                "Get the processor network", py::return_value_policy::reference)
+        .def_property_readonly("networkStatistics",
+                               &InviwoApplication::getProcessorNetworkStatistics,
+                               "Get the per processor performance statistics",
+                               py::return_value_policy::reference)
 
         .def_property_readonly("processorFactory", &InviwoApplication::getProcessorFactory,
                                py::return_value_policy::reference)
@@ -49,7 +49,13 @@ public:
         : ProcessorFactoryObject{pfo.cast<ProcessorFactoryObject*>()->getProcessorInfo()}
         , pfo_(pfo) {}
 
+    virtual ~ProcessorFactoryObjectPythonWrapper() {
+        pybind11::gil_scoped_acquire gil;
+        pfo_ = pybind11::object{};
+    }
+
     virtual std::unique_ptr<Processor> create(InviwoApplication* app) override {
+        pybind11::gil_scoped_acquire gil;
         return pfo_.cast<ProcessorFactoryObject*>()->create(app);
     }
 
@@ -65,6 +71,7 @@ public:
     }
 
     virtual std::unique_ptr<InviwoModule> create(InviwoApplication* app) override {
+        pybind11::gil_scoped_acquire gil;
         auto mod = createModule(app);
         auto m = std::unique_ptr<InviwoModule>(mod.cast<InviwoModule*>());
         mod.release();
@@ -35,12 +35,16 @@
 #include <inviwo/core/network/portconnection.h>
 #include <inviwo/core/links/propertylink.h>
 #include <inviwo/core/network/processornetwork.h>
+#include <inviwo/core/network/processornetworkstatistics.h>
 #include <inviwo/core/ports/port.h>
 #include <inviwo/core/ports/inport.h>
 #include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/util/stringconversion.h>
 
 #include <inviwopy/vectoridentifierwrapper.h>
 
+#include <sstream>
+
 namespace py = pybind11;
 
 namespace inviwo {
@@ -133,7 +137,8 @@ void exposeNetwork(py::module& m) {
         .def_property_readonly("invalidating", &ProcessorNetwork::isInvalidating)
         .def_property_readonly("linking", &ProcessorNetwork::isLinking)
         .def("lock", &ProcessorNetwork::lock)
-        .def("unlock", &ProcessorNetwork::unlock)
+        .def("unlock", &ProcessorNetwork::unlock,
+             py::call_guard<py::gil_scoped_release>())
         .def_property_readonly("locked", &ProcessorNetwork::islocked)
         .def_property_readonly("deserializing", &ProcessorNetwork::isDeserializing)
 
@@ -146,13 +151,66 @@ void exposeNetwork(py::module& m) {
                                                                       // re throwing (we just want
                                                                       // to pass the exception on to
                                                                       // python)
-             })
-        .def("load", [](ProcessorNetwork* network, std::string filename) {
-            network->clear();
-            network->getApplication()->getWorkspaceManager()->load(
-                filename, [&](ExceptionContext ec) { throw; });  // is this the correct way of re
-                                                                 // throwing (we just want to pass
-                                                                 // the exception on to python)
+             },
+             py::call_guard<py::gil_scoped_release>())
+        .def(
+            "load",
+            [](ProcessorNetwork* network, std::string filename) {
+                network->clear();
+                network->getApplication()->getWorkspaceManager()->load(
+                    filename, [&](ExceptionContext ec) { throw; });  // is this the correct way of
+                                                                     // re throwing (we just want
+                                                                     // to pass the exception on
+                                                                     // to python)
+            },
+            py::call_guard<py::gil_scoped_release>());
+
+    using Stats = ProcessorNetworkStatistics::ProcessorStatistics;
+    py::class_<Stats>(m, "ProcessorStatistics")
+        .def_readonly("identifier", &Stats::identifier)
+        .def_readonly("classIdentifier", &Stats::classIdentifier)
+        .def_readonly("count", &Stats::count)
+        .def_property_readonly("min", [](const Stats& s) { return s.min.count(); })
+        .def_property_readonly("mean", [](const Stats& s) { return s.mean.count(); })
+        .def_property_readonly("p95", [](const Stats& s) { return s.p95.count(); })
+        .def_property_readonly("max", [](const Stats& s) { return s.max.count(); })
+        .def_property_readonly("total", [](const Stats& s) { return s.total.count(); })
+        .def_property_readonly("conversionTime",
+                               [](const Stats& s) { return s.conversionTime.count(); })
+        .def_readonly("bytesProduced", &Stats::bytesProduced)
+        .def_readonly("totalBytesProduced", &Stats::totalBytesProduced)
+        .def("__repr__", [](const Stats& s) {
+            return "<ProcessorStatistics: " + s.identifier + " count: " + toString(s.count) +
+                   " mean: " + toString(s.mean.count()) + "ms>";
         });
+
+    py::class_<ProcessorNetworkStatistics>(m, "ProcessorNetworkStatistics")
+        .def_property("enabled", &ProcessorNetworkStatistics::isEnabled,
+                      &ProcessorNetworkStatistics::setEnabled)
+        .def_property_readonly(
+            "statistics",
+            py::overload_cast<>(&ProcessorNetworkStatistics::getStatistics, py::const_))
+        .def("getStatistics",
+             py::overload_cast<const Processor*>(&ProcessorNetworkStatistics::getStatistics,
+                                                 py::const_),
+             py::arg("processor"))
+        .def_property_readonly("evaluationCount", &ProcessorNetworkStatistics::getEvaluationCount)
+        .def_property_readonly(
+            "evaluationTime",
+            [](const ProcessorNetworkStatistics& s) { return s.getEvaluationTime().count(); })
+        .def("clear", &ProcessorNetworkStatistics::clear)
+        .def("toCSV",
+             [](const ProcessorNetworkStatistics& s) {
+                 std::stringstream ss;
+                 s.writeCSV(ss);
+                 return ss.str();
+             })
+        .def("toJSON",
+             [](const ProcessorNetworkStatistics& s) {
+                 std::stringstream ss;
+                 s.writeJSON(ss);
+                 return ss.str();
+             })
+        .def("save", &ProcessorNetworkStatistics::save, py::arg("filename"));
 }
 }  // namespace inviwo
@@ -37,6 +37,7 @@
 #include <inviwo/core/properties/cameraproperty.h>
 
 #include <inviwopy/pyflags.h>
+#include <modules/python3/pybindutils.h>
 
 #include <pybind11/stl.h>
 #include <pybind11/functional.h>
@@ -122,13 +123,7 @@ void exposePickingMapper(pybind11::module &m) {
 
     py::class_<PickingMapper>(m, "PickingMapper")
         .def(py::init([](Processor *p, size_t size, pybind11::function callback) {
-            return new PickingMapper(p, size, [callback](PickingEvent *e) {
-                try {
-                    callback(py::cast(e));
-                } catch (const py::error_already_set &e) {
-                    LogErrorCustom("pybind11", e.what());
-                }
-            });
+            return new PickingMapper(p, size, pyutil::toCallback<PickingEvent *>(callback));
         }))
         .def("resize", &PickingMapper::resize)
         .def_property("enabled", &PickingMapper::isEnabled, &PickingMapper::setEnabled)
@@ -348,6 +348,8 @@ void exposeProcessors(pybind11::module &m) {
     py::class_<PythonScriptProcessor, Processor, ProcessorPtr<PythonScriptProcessor>>(
         m, "PythonScriptProcessor", py::dynamic_attr{})
         .def("setInitializeResources", &PythonScriptProcessor::setInitializeResources)
-        .def("setProcess", &PythonScriptProcessor::setProcess);
+        .def("setProcess", &PythonScriptProcessor::setProcess)
+        .def("setBackgroundProcess", &PythonScriptProcessor::setBackgroundProcess,
+             py::arg("process"), py::arg("done"));
 }
 }  // namespace inviwo
@@ -31,6 +31,7 @@
 #include <inviwo/core/properties/propertyfactory.h>
 
 #include <inviwopy/inviwopy.h>
+#include <modules/python3/pybindutils.h>
 #include <inviwo/core/properties/constraintbehavior.h>
 
 #include <inviwo/core/properties/cameraproperty.h>
@@ -128,7 +129,8 @@ void exposeProperties(py::module& m) {
         .def("hasWidgets", &Property::hasWidgets)
         .def("setCurrentStateAsDefault", &Property::setCurrentStateAsDefault)
         .def("resetToDefaultState", &Property::resetToDefaultState)
-        .def("onChange", [](Property* p, std::function<void()> func) { p->onChange(func); });
+        .def("onChange",
+             [](Property* p, py::function func) { p->onChange(pyutil::toCallback<>(func)); });
 
     PyPropertyClass<CompositeProperty, Property, PropertyOwner>(m, "CompositeProperty")
         .def(py::init([](const std::string& identifier, const std::string& displayName,
@@ -485,10 +487,10 @@ void exposeProperties(py::module& m) {
              py::arg("invalidationLevel") = InvalidationLevel::InvalidOutput,
              py::arg("semantics") = PropertySemantics::Default)
         .def(py::init([](const std::string& identifier, const std::string& displayName,
-                         std::function<void()> action, InvalidationLevel invalidationLevel,
+                         py::function action, InvalidationLevel invalidationLevel,
                          PropertySemantics semantics) {
-                 return new ButtonProperty(identifier, displayName, action, invalidationLevel,
-                                           semantics);
+                 return new ButtonProperty(identifier, displayName, pyutil::toCallback<>(action),
+                                           invalidationLevel, semantics);
              }),
              py::arg("identifier"), py::arg("displayName"), py::arg("action"),
              py::arg("invalidationLevel") = InvalidationLevel::InvalidOutput,
@@ -496,8 +498,11 @@ void exposeProperties(py::module& m) {
         .def("press", &ButtonProperty::pressButton);
 
     py::class_<ButtonGroupProperty::Button>(m, "ButtonGroupPropertyButton")
-        .def(py::init<std::optional<std::string>, std::optional<std::string>,
-                      std::optional<std::string>, std::function<void()>>());
+        .def(py::init([](std::optional<std::string> name, std::optional<std::string> icon,
+                         std::optional<std::string> tooltip, py::function action) {
+            return ButtonGroupProperty::Button{std::move(name), std::move(icon),
+                                               std::move(tooltip), pyutil::toCallback<>(action)};
+        }));
 
     PyPropertyClass<ButtonGroupProperty, Property>(m, "ButtonGroupProperty")
         .def(py::init([](const std::string& identifier, const std::string& displayName,
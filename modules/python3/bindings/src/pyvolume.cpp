@@ -87,14 +87,25 @@ void exposeVolume(pybind11::module &m) {
                     strides.push_back(df->getSize() / df->getComponents());
                 }
 
-                auto data = volume->getEditableRepresentation<VolumeRAM>()->getData();
+                void *data = nullptr;
+                {
+                    // Fetching the representation might convert or download the data
+                    py::gil_scoped_release release;
+                    data = volume->getEditableRepresentation<VolumeRAM>()->getData();
+                }
                 return py::array(pyutil::toNumPyFormat(df), shape, strides, data, py::cast<>(1));
             },
             [](Volume *volume, py::array data) {
-                auto rep = volume->getEditableRepresentation<VolumeRAM>();
+                auto rep = [&]() {
+                    py::gil_scoped_release release;
+                    return volume->getEditableRepresentation<VolumeRAM>();
+                }();
                 pyutil::checkDataFormat<3>(rep->getDataFormat(), rep->getDimensions(), data);
 
-                memcpy(rep->getData(), data.data(0), data.nbytes());
+                const auto src = data.data(0);
+                const auto size = static_cast<size_t>(data.nbytes());
+                py::gil_scoped_release release;
+                memcpy(rep->getData(), src, size);
             })
         .def("__repr__", [](const Volume &volume) {
             std::ostringstream oss;
@@ -32,7 +32,7 @@
 
 #include <modules/python3/python3moduledefine.h>
 #include <inviwo/core/common/inviwo.h>
-#include <inviwo/core/processors/processor.h>
+#include <inviwo/core/processors/poolprocessor.h>
 #include <inviwo/core/properties/fileproperty.h>
 #include <modules/python3/pythonscript.h>
 #include <inviwo/core/ports/meshport.h>
@@ -91,6 +91,23 @@ namespace inviwo {
  * # Tell the PythonScriptProcessor about the 'process' function we want to use
  * self.setProcess(process)
  * \endcode
+ *
+ * Heavy work can be moved off the main thread with setBackgroundProcess. The first function
+ * is called on the main thread and returns a callable that runs in the thread pool, the second
+ * one receives its result on the main thread. The GIL is only held while python code executes,
+ * hence numpy and the inviwopy data accessors let other threads run in the meantime.
+ * \code{.py}
+ * def background(self):
+ *     dim = self.properties.dim.value  # read properties on the main thread
+ *     def job():
+ *         return numpy.random.rand(dim[0], dim[1], dim[2]).astype(numpy.float32)
+ *     return job
+ *
+ * def done(self, data):
+ *     self.outports.outport.setData(Volume(data))
+ *
+ * self.setBackgroundProcess(background, done)
+ * \endcode
  */
 
 /**
@@ -98,16 +115,23 @@ namespace inviwo {
  * \brief Loads a mesh and volume via a python script. The processor is invalidated
  * as soon as the script changes on disk.
  */
-class IVW_MODULE_PYTHON3_API PythonScriptProcessor : public Processor {
+class IVW_MODULE_PYTHON3_API PythonScriptProcessor : public PoolProcessor {
 public:
     PythonScriptProcessor(InviwoApplication* app);
-    virtual ~PythonScriptProcessor() = default;
+    virtual ~PythonScriptProcessor();
 
     virtual void initializeResources() override;
     virtual void process() override;
 
     void setInitializeResources(pybind11::function func);
     void setProcess(pybind11::function func);
+    /**
+     * Run the processing in the thread pool. \p process is called with the processor on the main
+     * thread and should return a callable without arguments, which is then called in a
+     * background thread. Its result is passed to \p done together with the processor, again on
+     * the main thread. When set, this replaces the function given to setProcess.
+     */
+    void setBackgroundProcess(pybind11::function process, pybind11::function done);
 
     virtual const ProcessorInfo getProcessorInfo() const override;
     static const ProcessorInfo processorInfo_;
@@ -118,6 +142,8 @@ private:
 
     pybind11::function initializeResources_;
     pybind11::function process_;
+    pybind11::function backgroundProcess_;
+    pybind11::function backgroundDone_;
 };
 
 }  // namespace inviwo
@@ -46,6 +46,8 @@
 #include <inviwo/core/util/formats.h>
 #include <inviwo/core/util/stringconversion.h>
 
+#include <functional>
+
 namespace inviwo {
 
 class BufferBase;
@@ -60,6 +62,29 @@ IVW_MODULE_PYTHON3_API std::unique_ptr<BufferBase> createBuffer(pybind11::array
 IVW_MODULE_PYTHON3_API std::unique_ptr<Layer> createLayer(pybind11::array &arr);
 IVW_MODULE_PYTHON3_API std::unique_ptr<Volume> createVolume(pybind11::array &arr);
 
+/**
+ * Wrap a python object in a shared_ptr that acquires the GIL before releasing the object. The
+ * returned pointer can be copied and destroyed in any thread, i.e. captured in a background job.
+ */
+IVW_MODULE_PYTHON3_API std::shared_ptr<pybind11::object> share(pybind11::object obj);
+
+/**
+ * Wrap a python callable in a std::function for use as a C++ callback. The callable is held
+ * through share() and the GIL is acquired for each call, hence the callback can be called,
+ * copied, and destroyed in any thread. Python errors raised by the call are logged.
+ */
+template <typename... Args>
+std::function<void(Args...)> toCallback(pybind11::function func) {
+    return [func = share(std::move(func))](Args... args) {
+        pybind11::gil_scoped_acquire gil;
+        try {
+            (*func)(std::forward<Args>(args)...);
+        } catch (const pybind11::error_already_set &e) {
+            LogErrorCustom("pybind11", e.what());
+        }
+    };
+}
+
 template <int Dim>
 void checkDataFormat(const DataFormatBase *format, const Vector<Dim, size_t> &dim,
                      const pybind11::array &data) {
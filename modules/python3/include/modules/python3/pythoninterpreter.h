@@ -37,6 +37,11 @@
 namespace inviwo {
 class Python3Module;
 
+/**
+ * Initializes the embedded python interpreter. Once initialized the main thread does not hold the
+ * GIL, code that calls into python has to acquire it with pybind11::gil_scoped_acquire. This lets
+ * python code run in other threads, for example in the thread pool.
+ */
 class IVW_MODULE_PYTHON3_API PythonInterpreter : public PythonExecutionOutputObservable {
 public:
     PythonInterpreter();
@@ -50,6 +55,7 @@ public:
 private:
     bool embedded_;
     bool isInit_;
+    void* mainThreadState_;
 };
 
 }  // namespace inviwo
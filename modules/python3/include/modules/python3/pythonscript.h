@@ -75,6 +75,7 @@ public:
     /**
      * Runs the script once.
      * If the script has changed since last compile a new compile call will be issued.
+     * The GIL is acquired while the script runs, hence the script can be run from any thread.
      *
      * If an error occurs, the error message is logged to the inviwo logger and python standard
      * output.
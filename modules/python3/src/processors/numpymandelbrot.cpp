@@ -67,6 +67,7 @@ NumpyMandelbrot::NumpyMandelbrot()
 
 void NumpyMandelbrot::process() {
     auto img = std::make_shared<Image>(size_.get(), DataFloat32::get());
+    pybind11::gil_scoped_acquire gil;
     script_.run({{"img", pybind11::cast(img->getColorLayer())},
                  {"p", pybind11::cast(static_cast<Processor*>(this))}});
 
@@ -29,6 +29,7 @@
 
 #include <modules/python3/processors/pythonscriptprocessor.h>
 #include <modules/python3/python3module.h>
+#include <modules/python3/pybindutils.h>
 #include <inviwo/core/common/inviwoapplication.h>
 #include <inviwo/core/datastructures/geometry/basicmesh.h>
 
@@ -45,7 +46,7 @@ const ProcessorInfo PythonScriptProcessor::processorInfo_{
 const ProcessorInfo PythonScriptProcessor::getProcessorInfo() const { return processorInfo_; }
 
 PythonScriptProcessor::PythonScriptProcessor(InviwoApplication* app)
-    : Processor()
+    : PoolProcessor()
     , scriptFileName_("scriptFileName", "File Name",
                       app->getModuleByType<Python3Module>()->getPath(ModulePath::Data) +
                           "/scripts/scriptprocessorexample.py",
@@ -57,12 +58,15 @@ PythonScriptProcessor::PythonScriptProcessor(InviwoApplication* app)
     isSink_.setUpdate([]() { return true; });
 
     auto runscript = [this]() {
-        auto locals = py::globals();
-        locals["self"] = pybind11::cast(this);
-        try {
-            script_.run(locals);
-        } catch (std::exception& e) {
-            LogError(e.what())
+        {
+            py::gil_scoped_acquire gil;
+            auto locals = py::globals();
+            locals["self"] = pybind11::cast(this);
+            try {
+                script_.run(locals);
+            } catch (std::exception& e) {
+                LogError(e.what())
+            }
         }
         invalidate(InvalidationLevel::InvalidOutput);
     };
@@ -78,12 +82,46 @@ PythonScriptProcessor::PythonScriptProcessor(InviwoApplication* app)
     runscript();
 }
 
+PythonScriptProcessor::~PythonScriptProcessor() {
+    pybind11::gil_scoped_acquire gil;
+    initializeResources_ = pybind11::function{};
+    process_ = pybind11::function{};
+    backgroundProcess_ = pybind11::function{};
+    backgroundDone_ = pybind11::function{};
+}
+
 void PythonScriptProcessor::initializeResources() {
+    pybind11::gil_scoped_acquire gil;
     if (initializeResources_) initializeResources_(pybind11::cast(this));
 }
 
 void PythonScriptProcessor::process() {
-    if (process_) process_(pybind11::cast(this));
+    namespace py = pybind11;
+    py::gil_scoped_acquire gil;
+
+    if (!backgroundProcess_) {
+        if (process_) process_(py::cast(this));
+        return;
+    }
+
+    // The job is shared so that it can be copied and released without holding the GIL.
+    auto job = pyutil::share(backgroundProcess_(py::cast(this)));
+    const auto calc = [job]() -> std::shared_ptr<py::object> {
+        py::gil_scoped_acquire gil;
+        try {
+            return pyutil::share((*job)());
+        } catch (const py::error_already_set& e) {
+            throw Exception(e.what(), IVW_CONTEXT_CUSTOM("PythonScriptProcessor"));
+        }
+    };
+
+    dispatchOne(calc, [this](std::shared_ptr<py::object> result) {
+        {
+            py::gil_scoped_acquire gil;
+            if (backgroundDone_) backgroundDone_(py::cast(this), *result);
+        }
+        newResults();
+    });
 }
 
 void PythonScriptProcessor::setInitializeResources(pybind11::function func) {
@@ -91,4 +129,10 @@ void PythonScriptProcessor::setInitializeResources(pybind11::function func) {
 }
 void PythonScriptProcessor::setProcess(pybind11::function func) { process_ = func; }
 
+void PythonScriptProcessor::setBackgroundProcess(pybind11::function process,
+                                                 pybind11::function done) {
+    backgroundProcess_ = process;
+    backgroundDone_ = done;
+}
+
 }  // namespace inviwo
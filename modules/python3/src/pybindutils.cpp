@@ -155,5 +155,13 @@ std::unique_ptr<Volume> createVolume(pybind11::array &arr) {
         df->getId(), dispatcher, arr);
 }
 
+std::shared_ptr<pybind11::object> share(pybind11::object obj) {
+    return std::shared_ptr<pybind11::object>(new pybind11::object(std::move(obj)),
+                                             [](pybind11::object *o) {
+                                                 pybind11::gil_scoped_acquire gil;
+                                                 delete o;
+                                             });
+}
+
 }  // namespace pyutil
 }  // namespace inviwo
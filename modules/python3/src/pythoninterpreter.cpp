@@ -44,7 +44,8 @@
 
 namespace inviwo {
 
-PythonInterpreter::PythonInterpreter() : embedded_{false}, isInit_(false) {
+PythonInterpreter::PythonInterpreter()
+    : embedded_{false}, isInit_(false), mainThreadState_{nullptr} {
     namespace py = pybind11;
 
     if (isInit_) {
@@ -108,12 +109,18 @@ sys.stderr = OutputRedirector(1)
         } catch (const py::error_already_set& e) {
             throw ModuleInitException(e.what(), IVW_CONTEXT);
         }
+
+        // Release the GIL, it is acquired again where needed.
+        mainThreadState_ = PyEval_SaveThread();
     }
 }
 
 PythonInterpreter::~PythonInterpreter() {
     namespace py = pybind11;
     if (embedded_) {
+        if (mainThreadState_) {
+            PyEval_RestoreThread(static_cast<PyThreadState*>(mainThreadState_));
+        }
         py::finalize_interpreter();
     }
 }
@@ -122,12 +129,14 @@ void PythonInterpreter::addModulePath(const std::string& path) { pyutil::addModu
 
 void PythonInterpreter::importModule(const std::string& moduleName) {
     namespace py = pybind11;
+    py::gil_scoped_acquire gil;
 
     auto dict = py::globals();
     dict[moduleName.c_str()] = py::module::import(moduleName.c_str());
 }
 
 bool PythonInterpreter::runString(std::string code) {
+    pybind11::gil_scoped_acquire gil;
     auto ret = PyRun_SimpleString(code.c_str());
     return ret == 0;
 }
@@ -59,6 +59,7 @@ PythonProcessorFactoryObject::PythonProcessorFactoryObject(InviwoApplication* ap
 std::unique_ptr<Processor> PythonProcessorFactoryObject::create(InviwoApplication*) {
     namespace py = pybind11;
     const auto pi = getProcessorInfo();
+    py::gil_scoped_acquire gil;
 
     try {
         py::object proc = py::eval<py::eval_expr>(fmt::format(
@@ -111,6 +112,8 @@ PythonProcessorFactoryObjectData PythonProcessorFactoryObject::load(const std::s
     ss << ifs.rdbuf();
     const auto script = std::move(ss).str();
 
+    py::gil_scoped_acquire gil;
+
     const auto nameLabel = std::string{"# Name: "};
 
     const auto name = [&]() {
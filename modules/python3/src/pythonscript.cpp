@@ -51,7 +51,12 @@ namespace inviwo {
 
 PythonScript::PythonScript() : source_(""), byteCode_(nullptr), isCompileNeeded_(false) {}
 
-PythonScript::~PythonScript() { Py_XDECREF(BYTE_CODE); }
+PythonScript::~PythonScript() {
+    if (byteCode_) {
+        pybind11::gil_scoped_acquire gil;
+        Py_XDECREF(BYTE_CODE);
+    }
+}
 
 bool PythonScript::compile() {
     Py_XDECREF(BYTE_CODE);
@@ -68,6 +73,7 @@ bool PythonScript::compile() {
 
 bool PythonScript::run(std::function<void(pybind11::dict)> callback) {
     namespace py = pybind11;
+    py::gil_scoped_acquire gil;
 
     // Copy the dict to get a clean slate every time we run the script
     py::dict global = py::cast<py::dict>(PyDict_Copy(py::globals().ptr()));
@@ -77,6 +83,7 @@ bool PythonScript::run(std::function<void(pybind11::dict)> callback) {
 bool PythonScript::run(std::unordered_map<std::string, pybind11::object> locals,
                        std::function<void(pybind11::dict)> callback) {
     namespace py = pybind11;
+    py::gil_scoped_acquire gil;
 
     // Copy the dict to get a clean slate every time we run the script
     py::dict global = py::cast<py::dict>(PyDict_Copy(py::globals().ptr()));
@@ -88,6 +95,7 @@ bool PythonScript::run(std::unordered_map<std::string, pybind11::object> locals,
 
 bool PythonScript::run(pybind11::dict locals, std::function<void(pybind11::dict)> callback) {
     namespace py = pybind11;
+    py::gil_scoped_acquire gil;
 
     if (isCompileNeeded_ && !compile()) {
         return false;
@@ -116,8 +124,11 @@ std::string PythonScript::getSource() const { return source_; }
 void PythonScript::setSource(const std::string& source) {
     source_ = source;
     isCompileNeeded_ = true;
-    Py_XDECREF(BYTE_CODE);
-    byteCode_ = nullptr;
+    if (byteCode_) {
+        pybind11::gil_scoped_acquire gil;
+        Py_XDECREF(BYTE_CODE);
+        byteCode_ = nullptr;
+    }
 }
 
 bool PythonScript::checkCompileError() {
@@ -0,0 +1,115 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/network/processornetwork.h>
+#include <inviwo/core/properties/boolproperty.h>
+#include <modules/python3/processors/pythonscriptprocessor.h>
+
+#include <pybind11/pybind11.h>
+#include <pybind11/eval.h>
+
+namespace inviwo {
+
+namespace py = pybind11;
+
+TEST(Python3Threading, CallbackAcquiresGIL) {
+    py::module::import("inviwopy");
+    BoolProperty property("property", "Property", false);
+
+    py::dict locals;
+    locals["p"] = py::cast(static_cast<Property*>(&property), py::return_value_policy::reference);
+    py::exec(R"(
+calls = []
+p.onChange(lambda: calls.append(p.identifier))
+)",
+             py::globals(), locals);
+
+    {
+        // The callback is invoked without the GIL, like on the main thread of the application
+        py::gil_scoped_release release;
+        property.set(true);
+    }
+    ASSERT_EQ(1, py::len(locals["calls"]));
+    EXPECT_EQ("property", locals["calls"].cast<py::list>()[0].cast<std::string>());
+}
+
+TEST(Python3Threading, BackgroundProcess) {
+    auto app = InviwoApplication::getPtr();
+    const auto poolSize = app->getPoolSize();
+    if (poolSize == 0) app->resizePool(1);
+
+    ProcessorNetwork network{app};
+    auto processor = static_cast<PythonScriptProcessor*>(
+        network.addProcessor(std::make_unique<PythonScriptProcessor>(app)));
+
+    py::dict locals;
+    locals["self"] = py::cast(processor);
+    py::exec(R"(
+import threading
+main = threading.get_ident()
+results = {}
+
+def background(self):
+    n = 1000
+    def job():
+        results['job'] = threading.get_ident()
+        return sum(range(n))
+    return job
+
+def done(self, value):
+    results['done'] = threading.get_ident()
+    results['value'] = value
+
+self.setBackgroundProcess(background, done)
+)",
+             py::globals(), locals);
+
+    processor->process();
+    {
+        // The job and the done callback need the GIL, which the tests hold otherwise
+        py::gil_scoped_release release;
+        app->waitForPool();
+    }
+
+    auto results = locals["results"].cast<py::dict>();
+    ASSERT_TRUE(results.contains("value"));
+    EXPECT_EQ(499500, results["value"].cast<int>());
+    EXPECT_NE(locals["main"].cast<size_t>(), results["job"].cast<size_t>());
+    EXPECT_EQ(locals["main"].cast<size_t>(), results["done"].cast<size_t>());
+
+    if (poolSize == 0) app->resizePool(0);
+}
+
+}  // namespace inviwo
@@ -70,6 +70,7 @@ Python3QtModule::Python3QtModule(InviwoApplication* app)
     , menu_(std::make_unique<PythonMenu>(this, app)) {
     namespace py = pybind11;
 
+    py::gil_scoped_acquire gil;
     try {
         auto inviwopy = py::module::import("inviwopy");
         auto m = inviwopy.def_submodule("qt", "Qt dependent stuff");
@@ -77,7 +78,11 @@ Python3QtModule::Python3QtModule(InviwoApplication* app)
         m.def("prompt", &prompt, py::arg("title"), py::arg("message"),
               py::arg("defaultResponse") = "");
         m.def("update", [this]() {
-            QCoreApplication::instance()->processEvents();
+            {
+                // Let other threads, and events that run python, use the interpreter meanwhile
+                py::gil_scoped_release release;
+                QCoreApplication::instance()->processEvents();
+            }
             if (abortPythonEvaluation_) {
                 abortPythonEvaluation_ = false;
                 throw PythonAbortException("Evaluation aborted");
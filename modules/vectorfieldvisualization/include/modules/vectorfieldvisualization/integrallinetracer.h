@@ -36,6 +36,7 @@
 #include <modules/vectorfieldvisualization/properties/integrallineproperties.h>
 #include <modules/vectorfieldvisualization/datastructures/integralline.h>
 
+#include <optional>
 #include <unordered_map>
 
 namespace inviwo {
@@ -64,11 +65,39 @@ public:
     using DataMatrix = Matrix<SpatialSampler::DataDimensions, double>;
     using DataHomogenouSpatialMatrixrix = Matrix<SpatialSampler::DataDimensions + 1, double>;
 
+    /**
+     * A line that is traced in parts, used to trace time-dependent lines time slab by time slab.
+     * The line is first traced backward and then forward, as in traceFrom.
+     * @see start, traceUntil
+     */
+    struct Partial {
+        Result result;
+        SpatialVector seed;
+        SpatialVector pos;
+        size_t stepsLeft{0};
+        size_t stepsFWD{0};
+        bool fwd{false};
+        bool done{false};
+    };
+
     IntegralLineTracer(std::shared_ptr<const Sampler> sampler,
                        const IntegralLineProperties& properties);
 
     Result traceFrom(const SpatialVector& pIn) const;
 
+    /**
+     * Start a partial line at the seed point, without taking any steps.
+     */
+    Partial start(const SpatialVector& pIn) const;
+    /**
+     * Continue tracing the partial line in its current direction until it reaches time t, or
+     * until it terminates. When the backward part terminates the line is switched to forward
+     * tracing, and the function returns. Tracing a line in parts gives the same result as
+     * traceFrom.
+     * @return true if the line is done
+     */
+    bool traceUntil(Partial& partial, double t) const;
+
     void addMetaDataSampler(const std::string& name, std::shared_ptr<const Sampler> sampler);
 
     const DataHomogenouSpatialMatrixrix& getSeedTransformationMatrix() const;
@@ -83,8 +112,14 @@ private:
     bool addPoint(IntegralLine& line, const SpatialVector& pos,
                   const DataVector& worldVelocity) const;
 
+    std::pair<size_t, size_t> stepCounts(IntegralLine& line) const;
+    bool initLine(IntegralLine& line, const SpatialVector& p) const;
+
     IntegralLine::TerminationReason integrate(size_t steps, SpatialVector pos, IntegralLine& line,
                                               bool fwd) const;
+    std::optional<IntegralLine::TerminationReason> integrateStep(SpatialVector& pos,
+                                                                 IntegralLine& line,
+                                                                 bool fwd) const;
 
     IntegralLineProperties::IntegrationScheme integrationScheme_;
 
@@ -120,22 +155,106 @@ IntegralLineTracer<SpatialSampler, TimeDependent>::traceFrom(const SpatialVector
     Result res;
     IntegralLine& line = res.line;
 
-    const auto [stepsBWD, stepsFWD] = [dir = dir_, steps = steps_,
-                                       &line]() -> std::pair<size_t, size_t> {
-        switch (dir) {
-            case inviwo::IntegralLineProperties::Direction::FWD:
-                line.setBackwardTerminationReason(IntegralLine::TerminationReason::StartPoint);
-                return {1, steps + 1};
-            case inviwo::IntegralLineProperties::Direction::BWD:
+    const auto [stepsBWD, stepsFWD] = stepCounts(line);
+
+    if (!initLine(line, p)) {
+        return res;  // Zero velocity at seed point
+    }
+
+    line.setBackwardTerminationReason(integrate(stepsBWD, p, line, false));
+
+    if (line.getPositions().size() > 1) {
+        line.reverse();
+        res.seedIndex = line.getPositions().size() - 1;
+    }
+
+    line.setForwardTerminationReason(integrate(stepsFWD, p, line, true));
+    return res;
+}
+
+template <typename SpatialSampler, bool TimeDependent>
+typename IntegralLineTracer<SpatialSampler, TimeDependent>::Partial
+IntegralLineTracer<SpatialSampler, TimeDependent>::start(const SpatialVector& pIn) const {
+    Partial partial;
+    partial.seed = seedTransform(pIn);
+    partial.pos = partial.seed;
+
+    const auto [stepsBWD, stepsFWD] = stepCounts(partial.result.line);
+    partial.stepsLeft = stepsBWD;
+    partial.stepsFWD = stepsFWD;
+
+    if (!initLine(partial.result.line, partial.seed)) {
+        partial.done = true;  // Zero velocity at seed point
+    } else if (stepsBWD == 0) {
+        partial.result.line.setBackwardTerminationReason(
+            IntegralLine::TerminationReason::StartPoint);
+        partial.fwd = true;
+        partial.stepsLeft = stepsFWD;
+    }
+    return partial;
+}
+
+template <typename SpatialSampler, bool TimeDependent>
+bool IntegralLineTracer<SpatialSampler, TimeDependent>::traceUntil(Partial& partial,
+                                                                   double t) const {
+    static_assert(TimeDependent, "Tracing in parts requires a time-dependent sampler");
+    IntegralLine& line = partial.result.line;
+
+    while (!partial.done) {
+        const auto time = partial.pos[Sampler::SpatialDimensions - 1];
+        if (partial.fwd ? time >= t : time <= t) return false;
+
+        std::optional<IntegralLine::TerminationReason> reason;
+        if (partial.stepsLeft == 0) {
+            reason = IntegralLine::TerminationReason::Steps;
+        } else {
+            reason = integrateStep(partial.pos, line, partial.fwd);
+            --partial.stepsLeft;
+        }
+        if (!reason) continue;
+
+        if (partial.fwd) {
+            line.setForwardTerminationReason(*reason);
+            partial.done = true;
+        } else {
+            line.setBackwardTerminationReason(*reason);
+            if (line.getPositions().size() > 1) {
+                line.reverse();
+                partial.result.seedIndex = line.getPositions().size() - 1;
+            }
+            partial.fwd = true;
+            partial.pos = partial.seed;
+            partial.stepsLeft = partial.stepsFWD;
+            if (partial.stepsLeft == 0) {
                 line.setForwardTerminationReason(IntegralLine::TerminationReason::StartPoint);
-                return {steps + 1, 1};
-            default:
-            case inviwo::IntegralLineProperties::Direction::BOTH: {
-                return {steps / 2 + 1, steps - (steps / 2) + 1};
+                partial.done = true;
             }
+            return partial.done;
+        }
+    }
+    return true;
+}
+
+template <typename SpatialSampler, bool TimeDependent>
+std::pair<size_t, size_t> IntegralLineTracer<SpatialSampler, TimeDependent>::stepCounts(
+    IntegralLine& line) const {
+    switch (dir_) {
+        case inviwo::IntegralLineProperties::Direction::FWD:
+            line.setBackwardTerminationReason(IntegralLine::TerminationReason::StartPoint);
+            return {1, steps_ + 1};
+        case inviwo::IntegralLineProperties::Direction::BWD:
+            line.setForwardTerminationReason(IntegralLine::TerminationReason::StartPoint);
+            return {steps_ + 1, 1};
+        default:
+        case inviwo::IntegralLineProperties::Direction::BOTH: {
+            return {steps_ / 2 + 1, steps_ - (steps_ / 2) + 1};
         }
-    }();
+    }
+}
 
+template <typename SpatialSampler, bool TimeDependent>
+bool IntegralLineTracer<SpatialSampler, TimeDependent>::initLine(IntegralLine& line,
+                                                                 const SpatialVector& p) const {
     line.getPositions().reserve(steps_ + 2);
     line.getMetaData<dvec3>("velocity", true).reserve(steps_ + 2);
 
@@ -147,19 +266,7 @@ IntegralLineTracer<SpatialSampler, TimeDependent>::traceFrom(const SpatialVector
         line.getMetaData<typename Sampler::ReturnType>(m.first, true).reserve(steps_ + 2);
     }
 
-    if (!addPoint(line, p)) {
-        return res;  // Zero velocity at seed point
-    }
-
-    line.setBackwardTerminationReason(integrate(stepsBWD, p, line, false));
-
-    if (line.getPositions().size() > 1) {
-        line.reverse();
-        res.seedIndex = line.getPositions().size() - 1;
-    }
-
-    line.setForwardTerminationReason(integrate(stepsFWD, p, line, true));
-    return res;
+    return addPoint(line, p);
 }
 
 template <typename SpatialSampler, bool TimeDependent>
@@ -268,19 +375,30 @@ IntegralLine::TerminationReason IntegralLineTracer<SpatialSampler, TimeDependent
     size_t steps, SpatialVector pos, IntegralLine& line, bool fwd) const {
     if (steps == 0) return IntegralLine::TerminationReason::StartPoint;
     for (size_t i = 0; i < steps; i++) {
-        if (!sampler_->withinBounds(pos)) {
-            return IntegralLine::TerminationReason::OutOfBounds;
-        }
-        auto res = step(pos, stepSize_ * (fwd ? 1.0 : -1.0));
-        pos = res.first;
-
-        if (!addPoint(line, pos, res.second)) {
-            return IntegralLine::TerminationReason::ZeroVelocity;
+        if (auto reason = integrateStep(pos, line, fwd)) {
+            return *reason;
         }
     }
     return IntegralLine::TerminationReason::Steps;
 }
 
+template <typename SpatialSampler, bool TimeDependent>
+std::optional<IntegralLine::TerminationReason>
+IntegralLineTracer<SpatialSampler, TimeDependent>::integrateStep(SpatialVector& pos,
+                                                                 IntegralLine& line,
+                                                                 bool fwd) const {
+    if (!sampler_->withinBounds(pos)) {
+        return IntegralLine::TerminationReason::OutOfBounds;
+    }
+    auto res = step(pos, stepSize_ * (fwd ? 1.0 : -1.0));
+    pos = res.first;
+
+    if (!addPoint(line, pos, res.second)) {
+        return IntegralLine::TerminationReason::ZeroVelocity;
+    }
+    return std::nullopt;
+}
+
 using StreamLine2DTracer = IntegralLineTracer<SpatialSampler<2, 2, double>>;
 using StreamLine3DTracer = IntegralLineTracer<SpatialSampler<3, 3, double>>;
 using PathLine3DTracer = IntegralLineTracer<Spatial4DSampler<3, double>>;
@@ -38,11 +38,16 @@
 #include <inviwo/core/ports/datainport.h>
 #include <inviwo/core/ports/imageport.h>
 #include <inviwo/core/util/utilities.h>
+#include <inviwo/core/util/stdextensions.h>
 #include <inviwo/core/util/foreach.h>
+#include <inviwo/core/util/volumesequencesampler.h>
 #include <modules/vectorfieldvisualization/algorithms/integrallineoperations.h>
 #include <modules/vectorfieldvisualization/integrallinetracer.h>
 #include <modules/vectorfieldvisualization/ports/seedpointsport.h>
 
+#include <algorithm>
+#include <numeric>
+
 namespace inviwo {
 
 template <typename Tracer>
@@ -56,6 +61,10 @@ public:
     virtual const ProcessorInfo getProcessorInfo() const override;
 
 private:
+    void traceInTimeSlabs(const Tracer& tracer,
+                          const std::vector<std::shared_ptr<VolumeSequenceSampler>>& samplers,
+                          IntegralLineSet& lines);
+
     DataInport<typename Tracer::Sampler> sampler_;
     SeedPointsInport<Tracer::Sampler::SpatialDimensions> seeds_;
     DataInport<typename Tracer::Sampler, 0> annotationSamplers_;
@@ -67,6 +76,16 @@ private:
     CompositeProperty metaData_;
     BoolProperty calculateCurvature_;
     BoolProperty calculateTortuosity_;
+
+    CompositeProperty streaming_;
+    BoolProperty timeSlabs_;
+    IntSizeTProperty prefetch_;
+
+    // The windowed copies of the sequence samplers of the inports, kept between evaluations so
+    // that the time steps of the last window stay loaded as long as the inputs do not change
+    std::vector<std::pair<std::weak_ptr<const typename Tracer::Sampler>,
+                          std::shared_ptr<VolumeSequenceSampler>>>
+        windowed_;
 };
 
 template <typename Tracer>
@@ -79,7 +98,10 @@ IntegralLineTracerProcessor<Tracer>::IntegralLineTracerProcessor()
 
     , metaData_("metaData", "Meta Data")
     , calculateCurvature_("calculateCurvature", "Calculate Curvature", false)
-    , calculateTortuosity_("calculateTortuosity", "Calculate Tortuosity", false) {
+    , calculateTortuosity_("calculateTortuosity", "Calculate Tortuosity", false)
+    , streaming_("streaming", "Streaming")
+    , timeSlabs_("timeSlabs", "Trace in Time Slabs", true)
+    , prefetch_("prefetch", "Prefetch Time Steps", 1, 0, 16) {
     addPort(sampler_);
     addPort(seeds_);
     addPort(annotationSamplers_);
@@ -93,6 +115,13 @@ IntegralLineTracerProcessor<Tracer>::IntegralLineTracerProcessor()
     properties_.normalizeSamples_.set(!Tracer::IsTimeDependent);
     properties_.normalizeSamples_.setCurrentStateAsDefault();
 
+    if constexpr (Tracer::IsTimeDependent) {
+        addProperty(streaming_);
+        streaming_.addProperties(timeSlabs_, prefetch_);
+        streaming_.setCollapsed(true);
+        prefetch_.readonlyDependsOn(timeSlabs_, [](const auto& p) { return !p.get(); });
+    }
+
     annotationSamplers_.setOptional(true);
 }
 
@@ -101,7 +130,33 @@ IntegralLineTracerProcessor<Tracer>::~IntegralLineTracerProcessor() {}
 
 template <typename Tracer>
 void IntegralLineTracerProcessor<Tracer>::process() {
-    auto sampler = sampler_.getData();
+    // Time-dependent lines over volume sequences are traced time slab by time slab, to only keep
+    // the time steps of the current slab in memory. Moving the time window changes the sampler,
+    // hence the sequence samplers of the inports are copied. The copies are reused by the next
+    // evaluation if the inport still has the same sampler.
+    using SamplerPtr = std::shared_ptr<const typename Tracer::Sampler>;
+    std::vector<std::shared_ptr<VolumeSequenceSampler>> sequenceSamplers;
+    decltype(windowed_) windowed;
+    const auto window = [&](SamplerPtr s) -> SamplerPtr {
+        if constexpr (std::is_base_of_v<typename Tracer::Sampler, VolumeSequenceSampler>) {
+            if (auto seq = std::dynamic_pointer_cast<const VolumeSequenceSampler>(s)) {
+                const auto same = [&](const auto& item) { return item.first.lock() == s; };
+                if (auto it = util::find_if(windowed, same); it != windowed.end()) {
+                    return it->second;
+                }
+                auto it = util::find_if(windowed_, same);
+                auto copy = it != windowed_.end() ? it->second
+                                                  : std::make_shared<VolumeSequenceSampler>(*seq);
+                sequenceSamplers.push_back(copy);
+                windowed.emplace_back(s, copy);
+                return copy;
+            }
+        }
+        return s;
+    };
+
+    auto sampler = timeSlabs_ ? window(sampler_.getData()) : sampler_.getData();
+    const bool windowing = !sequenceSamplers.empty();
     auto lines =
         std::make_shared<IntegralLineSet>(sampler->getModelMatrix(), sampler->getWorldMatrix());
 
@@ -110,21 +165,27 @@ void IntegralLineTracerProcessor<Tracer>::process() {
     for (auto meta : annotationSamplers_.getSourceVectorData()) {
         auto key = meta.first->getProcessor()->getIdentifier();
         key = util::stripIdentifier(key);
-        tracer.addMetaDataSampler(key, meta.second);
+        tracer.addMetaDataSampler(key, windowing ? window(meta.second) : meta.second);
     }
+    // Copies of samplers that are no longer connected are released
+    windowed_ = std::move(windowed);
 
-    std::mutex mutex;
-    size_t startID = 0;
-    for (const auto& seeds : seeds_) {
-        util::forEachParallel(*seeds, [&](const auto& p, size_t i) {
-            IntegralLine line = tracer.traceFrom(p);
-            auto size = line.getPositions().size();
-            if (size > 1) {
-                std::lock_guard<std::mutex> lock(mutex);
-                lines->push_back(std::move(line), startID + i);
-            }
-        });
-        startID += seeds->size();
+    if (!sequenceSamplers.empty()) {
+        traceInTimeSlabs(tracer, sequenceSamplers, *lines);
+    } else {
+        std::mutex mutex;
+        size_t startID = 0;
+        for (const auto& seeds : seeds_) {
+            util::forEachParallel(*seeds, [&](const auto& p, size_t i) {
+                IntegralLine line = tracer.traceFrom(p);
+                auto size = line.getPositions().size();
+                if (size > 1) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    lines->push_back(std::move(line), startID + i);
+                }
+            });
+            startID += seeds->size();
+        }
     }
 
     if (calculateCurvature_) {
@@ -137,6 +198,68 @@ void IntegralLineTracerProcessor<Tracer>::process() {
     lines_.setData(lines);
 }
 
+template <typename Tracer>
+void IntegralLineTracerProcessor<Tracer>::traceInTimeSlabs(
+    const Tracer& tracer, const std::vector<std::shared_ptr<VolumeSequenceSampler>>& samplers,
+    IntegralLineSet& lines) {
+    if constexpr (Tracer::IsTimeDependent) {
+        using Partial = typename Tracer::Partial;
+        constexpr auto timeDim = Tracer::Sampler::SpatialDimensions - 1;
+
+        // The index of a line is its seed id, as in process
+        std::vector<Partial> partials;
+        for (const auto& seeds : seeds_) {
+            const auto offset = partials.size();
+            partials.resize(offset + seeds->size());
+            util::forEachParallel(*seeds, [&](const auto& p, size_t i) {
+                partials[offset + i] = tracer.start(p);
+            });
+        }
+        std::vector<size_t> indices(partials.size());
+        std::iota(indices.begin(), indices.end(), size_t{0});
+
+        // Use the mean duration of the time steps as slab size, and add one integration step on
+        // both sides of the window to cover the samples of the last step
+        const auto& sequence = *samplers.front();
+        const auto range = sequence.getTimeRange();
+        const auto stepSize = std::abs(static_cast<double>(properties_.getStepSize()));
+        const auto slab = std::max(
+            (range.y - range.x) / static_cast<double>(std::max(sequence.getTimestamps().size(),
+                                                               size_t{1})),
+            std::max(stepSize, std::numeric_limits<double>::epsilon()));
+
+        for (const bool fwd : {false, true}) {
+            auto active = [fwd](const Partial& p) { return !p.done && p.fwd == fwd; };
+            if (std::none_of(partials.begin(), partials.end(), active)) continue;
+
+            auto t = fwd ? std::numeric_limits<double>::max()
+                         : std::numeric_limits<double>::lowest();
+            for (const auto& partial : partials) {
+                if (!active(partial)) continue;
+                t = fwd ? std::min(t, partial.pos[timeDim]) : std::max(t, partial.pos[timeDim]);
+            }
+
+            while (std::any_of(partials.begin(), partials.end(), active)) {
+                const auto next = fwd ? t + slab : t - slab;
+                for (const auto& s : samplers) {
+                    s->setTimeWindow(std::min(t, next) - stepSize, std::max(t, next) + stepSize,
+                                     fwd, prefetch_.get());
+                }
+                util::forEachParallel(indices, [&](size_t i) {
+                    if (active(partials[i])) tracer.traceUntil(partials[i], next);
+                });
+                t = next;
+            }
+        }
+
+        for (size_t i = 0; i < partials.size(); ++i) {
+            if (partials[i].result.line.getPositions().size() > 1) {
+                lines.push_back(std::move(partials[i].result.line), i);
+            }
+        }
+    }
+}
+
 using StreamLines2D = IntegralLineTracerProcessor<StreamLine2DTracer>;
 using StreamLines3D = IntegralLineTracerProcessor<StreamLine3DTracer>;
 using PathLines3D = IntegralLineTracerProcessor<PathLine3DTracer>;
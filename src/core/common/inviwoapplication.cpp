@@ -39,6 +39,8 @@
 #include <inviwo/core/network/processornetwork.h>
 #include <inviwo/core/network/networklock.h>
 #include <inviwo/core/network/processornetworkevaluator.h>
+#include <inviwo/core/network/processornetworkstatistics.h>
+#include <inviwo/core/datastructures/representationmemorymanager.h>
 #include <inviwo/core/ports/portfactory.h>
 #include <inviwo/core/ports/portinspectorfactory.h>
 #include <inviwo/core/ports/portinspectormanager.h>
@@ -69,9 +71,13 @@
 #include <inviwo/core/util/timer.h>
 #include <inviwo/core/util/settings/systemsettings.h>
 #include <inviwo/core/util/commandlineparser.h>
+#include <inviwo/core/util/tracing.h>
+#include <inviwo/core/util/imagecache.h>
 
 #include <inviwo/core/resourcemanager/resourcemanagerobserver.h>
 
+#include <limits>
+
 namespace inviwo {
 
 struct AppResourceManagerObserver : ResourceManagerObserver {
@@ -89,6 +95,30 @@ struct AppResourceManagerObserver : ResourceManagerObserver {
     ResourceManager* manager = nullptr;
 };
 
+namespace {
+
+/**
+ * Relative file names given on the command line are relative to the output path if given, else to
+ * the working directory.
+ */
+std::string outputFileName(const CommandLineParser& parser, std::string filename) {
+    if (!filesystem::isAbsolutePath(filename)) {
+        auto outputDir = parser.getOutputPath();
+        if (!outputDir.empty()) {
+            filename = outputDir + "/" + filename;
+        } else {
+            filename = filesystem::getWorkingDirectory() + "/" + filename;
+        }
+    }
+    auto dir = filesystem::getFileDirectory(filename);
+    if (!filesystem::directoryExists(dir)) {
+        filesystem::createDirectoryRecursively(dir);
+    }
+    return filename;
+}
+
+}  // namespace
+
 InviwoApplication* InviwoApplication::instance_ = nullptr;
 
 InviwoApplication::InviwoApplication(int argc, char** argv, std::string displayName)
@@ -105,19 +135,8 @@ InviwoApplication::InviwoApplication(int argc, char** argv, std::string displayN
     }()}
     , filelogger_{[&]() {
         if (commandLineParser_->getLogToFile()) {
-            auto filename = commandLineParser_->getLogToFileFileName();
-            if (!filesystem::isAbsolutePath(filename)) {
-                auto outputDir = commandLineParser_->getOutputPath();
-                if (!outputDir.empty()) {
-                    filename = outputDir + "/" + filename;
-                } else {
-                    filename = filesystem::getWorkingDirectory() + "/" + filename;
-                }
-            }
-            auto dir = filesystem::getFileDirectory(filename);
-            if (!filesystem::directoryExists(dir)) {
-                filesystem::createDirectoryRecursively(dir);
-            }
+            auto filename =
+                outputFileName(*commandLineParser_, commandLineParser_->getLogToFileFileName());
             auto flog = std::make_shared<FileLogger>(filename);
             LogCentral::getPtr()->registerLogger(flog);
             return flog;
@@ -159,6 +178,8 @@ InviwoApplication::InviwoApplication(int argc, char** argv, std::string displayN
     , processorNetwork_{std::make_unique<ProcessorNetwork>(this)}
     , processorNetworkEvaluator_{std::make_unique<ProcessorNetworkEvaluator>(
           processorNetwork_.get())}
+    , processorNetworkStatistics_{std::make_unique<ProcessorNetworkStatistics>(
+          processorNetwork_.get(), processorNetworkEvaluator_.get())}
     , workspaceManager_{std::make_unique<WorkspaceManager>(this)}
     , propertyPresetManager_{std::make_unique<PropertyPresetManager>(this)}
     , portInspectorManager_{std::make_unique<PortInspectorManager>(this)} {
@@ -177,6 +198,29 @@ InviwoApplication::InviwoApplication(int argc, char** argv, std::string displayN
         resourceManager_->setEnabled(false);
     }
 
+    const auto updateBudget = [this]() {
+        RepresentationMemoryManager::get().setBudget(
+            systemSettings_->representationMemoryBudget_.get() * 1024 * 1024);
+    };
+    updateBudget();
+    systemSettings_->representationMemoryBudget_.onChange(updateBudget);
+
+    const auto updateImageCacheBudget = [this]() {
+        const size_t budget = systemSettings_->imageCacheBudget_.get();
+        ImageCache::setDefaultMaxSizeInBytes(
+            budget == 0 ? std::numeric_limits<size_t>::max() : budget * 1024 * 1024);
+    };
+    updateImageCacheBudget();
+    systemSettings_->imageCacheBudget_.onChange(updateImageCacheBudget);
+
+    if (commandLineParser_->getTrace()) {
+        Tracer::get().setThreadName("Main Thread");
+        Tracer::setEnabled(true);
+    }
+    if (commandLineParser_->getStatistics()) {
+        processorNetworkStatistics_->setEnabled(true);
+    }
+
     moduleManager_.onModulesDidRegister([this]() {
         if (resourceManager_->isEnabled() && resourceManager_->numberOfResources() > 0) {
             LogWarn(
@@ -201,10 +245,11 @@ InviwoApplication::InviwoApplication(int argc, char** argv, std::string displayN
         portInspectorManager_->clear();
         processorNetwork_->clear();
     });
-    networkSerializationHandle_ = workspaceManager_->onSave([&](Serializer& s) {
-        s.serialize("ProcessorNetwork", *processorNetwork_);
-        s.serialize("PortInspectors", *portInspectorManager_);
-    });
+    networkSerializationHandle_ = workspaceManager_->onSave(
+        [&](Serializer& s) { s.serialize("ProcessorNetwork", *processorNetwork_); },
+        WorkspaceSaveMode::Disk | WorkspaceSaveMode::Undo);
+    portInspectorsSerializationHandle_ = workspaceManager_->onSave(
+        [&](Serializer& s) { s.serialize("PortInspectors", *portInspectorManager_); });
     networkDeserializationHandle_ = workspaceManager_->onLoad([&](Deserializer& d) {
         d.deserialize("ProcessorNetwork", *processorNetwork_);
         d.deserialize("PortInspectors", *portInspectorManager_);
@@ -230,15 +275,42 @@ InviwoApplication::InviwoApplication() : InviwoApplication(0, nullptr, "Inviwo")
 InviwoApplication::InviwoApplication(std::string displayName)
     : InviwoApplication(0, nullptr, displayName) {}
 
-InviwoApplication::~InviwoApplication() { resizePool(0); }
+InviwoApplication::~InviwoApplication() {
+    resizePool(0);
+
+    if (commandLineParser_->getStatistics()) {
+        try {
+            processorNetworkStatistics_->save(
+                outputFileName(*commandLineParser_, commandLineParser_->getStatisticsFileName()));
+        } catch (const Exception& e) {
+            LogError("Failed to write statistics: " << e.getMessage());
+        }
+    }
+
+    if (commandLineParser_->getTrace()) {
+        Tracer::setEnabled(false);
+        try {
+            Tracer::get().exportChromeTrace(
+                outputFileName(*commandLineParser_, commandLineParser_->getTraceFileName()));
+        } catch (const Exception& e) {
+            LogError("Failed to write trace: " << e.getMessage());
+        }
+    }
+}
 
 void InviwoApplication::registerModules(
     std::vector<std::unique_ptr<InviwoModuleFactoryObject>> moduleFactories) {
     moduleManager_.registerModules(std::move(moduleFactories));
+    if (commandLineParser_->getStartupReport()) {
+        LogInfo(moduleManager_.getStartupReport());
+    }
 }
 
 void InviwoApplication::registerModules(RuntimeModuleLoading token) {
     moduleManager_.registerModules(token);
+    if (commandLineParser_->getStartupReport()) {
+        LogInfo(moduleManager_.getStartupReport());
+    }
 }
 
 std::string InviwoApplication::getBasePath() const { return filesystem::findBasePath(); }
@@ -266,6 +338,10 @@ ProcessorNetworkEvaluator* InviwoApplication::getProcessorNetworkEvaluator() {
     return processorNetworkEvaluator_.get();
 }
 
+ProcessorNetworkStatistics* InviwoApplication::getProcessorNetworkStatistics() {
+    return processorNetworkStatistics_.get();
+}
+
 WorkspaceManager* InviwoApplication::getWorkspaceManager() { return workspaceManager_.get(); }
 
 PropertyPresetManager* InviwoApplication::getPropertyPresetManager() {
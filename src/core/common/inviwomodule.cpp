@@ -59,8 +59,12 @@
 
 namespace inviwo {
 
+namespace {
+thread_local bool deferModuleRegistrations = false;
+}
+
 InviwoModule::InviwoModule(InviwoApplication* app, const std::string& identifier)
-    : app_(app), identifier_(identifier) {}
+    : app_(app), identifier_(identifier), deferRegistrations_{deferModuleRegistrations} {}
 
 InviwoModule::~InviwoModule() {
     // unregister everything...
@@ -127,6 +131,21 @@ InviwoModule::~InviwoModule() {
     util::erase_remove_if(callbackActions, [&](auto& a) { return a->getModule() == this; });
 }
 
+void InviwoModule::setDeferRegistrations(bool defer) { deferModuleRegistrations = defer; }
+
+void InviwoModule::applyDeferredRegistrations() {
+    deferRegistrations_ = false;
+    auto registrations = std::move(deferredRegistrations_);
+    deferredRegistrations_.clear();
+    for (auto& registration : registrations) registration();
+}
+
+bool InviwoModule::deferRegistration(std::function<void()> registration) {
+    if (!deferRegistrations_) return false;
+    deferredRegistrations_.push_back(std::move(registration));
+    return true;
+}
+
 std::string InviwoModule::getIdentifier() const { return identifier_; }
 
 std::string InviwoModule::getPath() const {
@@ -252,48 +271,57 @@ void InviwoModule::registerCapabilities(std::unique_ptr<Capabilities> info) {
 }
 
 void InviwoModule::registerCamera(std::unique_ptr<CameraFactoryObject> camera) {
+    if (deferRegistration(&InviwoModule::registerCamera, camera)) return;
     if (app_->getCameraFactory()->registerObject(camera.get())) {
         cameras_.push_back(std::move(camera));
     }
 }
 
 void InviwoModule::registerDataReader(std::unique_ptr<DataReader> dataReader) {
+    if (deferRegistration(&InviwoModule::registerDataReader, dataReader)) return;
     if (app_->getDataReaderFactory()->registerObject(dataReader.get())) {
         dataReaders_.push_back(std::move(dataReader));
     }
 }
 void InviwoModule::registerDataWriter(std::unique_ptr<DataWriter> dataWriter) {
+    if (deferRegistration(&InviwoModule::registerDataWriter, dataWriter)) return;
     if (app_->getDataWriterFactory()->registerObject(dataWriter.get())) {
         dataWriters_.push_back(std::move(dataWriter));
     }
 }
 void InviwoModule::registerDialog(std::unique_ptr<DialogFactoryObject> dialog) {
+    if (deferRegistration(&InviwoModule::registerDialog, dialog)) return;
     if (app_->getDialogFactory()->registerObject(dialog.get())) {
         dialogs_.push_back(std::move(dialog));
     }
 }
 void InviwoModule::registerDrawer(std::unique_ptr<MeshDrawer> drawer) {
+    if (deferRegistration(&InviwoModule::registerDrawer, drawer)) return;
     if (app_->getMeshDrawerFactory()->registerObject(drawer.get())) {
         drawers_.push_back(std::move(drawer));
     }
 }
 void InviwoModule::registerMetaData(std::unique_ptr<MetaData> meta) {
+    if (deferRegistration(&InviwoModule::registerMetaData, meta)) return;
     if (app_->getMetaDataFactory()->registerObject(meta.get())) {
         metadata_.push_back(std::move(meta));
     }
 }
 void InviwoModule::registerProperty(std::unique_ptr<PropertyFactoryObject> property) {
+    if (deferRegistration(&InviwoModule::registerProperty, property)) return;
     if (app_->getPropertyFactory()->registerObject(property.get())) {
         properties_.push_back(std::move(property));
     }
 }
 void InviwoModule::registerPropertyWidget(
     std::unique_ptr<PropertyWidgetFactoryObject> propertyWidget) {
+    if (deferRegistration(&InviwoModule::registerPropertyWidget, propertyWidget)) return;
     if (app_->getPropertyWidgetFactory()->registerObject(propertyWidget.get())) {
         propertyWidgets_.push_back(std::move(propertyWidget));
     }
 }
 void InviwoModule::registerPropertyConverter(std::unique_ptr<PropertyConverter> propertyConverter) {
+    if (deferRegistration(&InviwoModule::registerPropertyConverter, propertyConverter)) return;
     if (app_->getPropertyConverterManager()->registerObject(propertyConverter.get())) {
         propertyConverters_.push_back(std::move(propertyConverter));
     }
@@ -301,6 +329,10 @@ void InviwoModule::registerPropertyConverter(std::unique_ptr<PropertyConverter>
 
 void InviwoModule::registerRepresentationFactory(
     std::unique_ptr<BaseRepresentationFactory> representationFactory) {
+    if (deferRegistration(&InviwoModule::registerRepresentationFactory,
+                          representationFactory)) {
+        return;
+    }
     if (app_->getRepresentationMetaFactory()->registerObject(representationFactory.get())) {
         representationFactories_.push_back(std::move(representationFactory));
     }
@@ -308,6 +340,10 @@ void InviwoModule::registerRepresentationFactory(
 
 void InviwoModule::registerRepresentationConverterFactory(
     std::unique_ptr<BaseRepresentationConverterFactory> converterFactory) {
+    if (deferRegistration(&InviwoModule::registerRepresentationConverterFactory,
+                          converterFactory)) {
+        return;
+    }
     if (app_->getRepresentationConverterMetaFactory()->registerObject(converterFactory.get())) {
         representationConverterFactories_.push_back(std::move(converterFactory));
     }
@@ -323,12 +359,14 @@ void InviwoModule::registerSettings(Settings* settings) { settings_.push_back(se
 InviwoApplication* InviwoModule::getInviwoApplication() const { return app_; }
 
 void InviwoModule::registerProcessor(std::unique_ptr<ProcessorFactoryObject> pfo) {
+    if (deferRegistration(&InviwoModule::registerProcessor, pfo)) return;
     if (app_->getProcessorFactory()->registerObject(pfo.get())) {
         processors_.push_back(std::move(pfo));
     }
 }
 
 void InviwoModule::registerCompositeProcessor(const std::string& file) {
+    if (deferRegistration([this, file]() { registerCompositeProcessor(file); })) return;
     auto processor = std::make_unique<CompositeProcessorFactoryObject>(file);
     if (app_->getProcessorFactory()->registerObject(processor.get())) {
         processors_.push_back(std::move(processor));
@@ -336,6 +374,7 @@ void InviwoModule::registerCompositeProcessor(const std::string& file) {
 }
 
 void InviwoModule::registerProcessorWidget(std::unique_ptr<ProcessorWidgetFactoryObject> widget) {
+    if (deferRegistration(&InviwoModule::registerProcessorWidget, widget)) return;
     if (app_->getProcessorWidgetFactory()->registerObject(widget.get())) {
         processorWidgets_.push_back(std::move(widget));
     }
@@ -343,6 +382,11 @@ void InviwoModule::registerProcessorWidget(std::unique_ptr<ProcessorWidgetFactor
 
 void InviwoModule::registerPortInspector(std::string portClassIdentifier,
                                          std::string inspectorPath) {
+    if (deferRegistration([this, portClassIdentifier, inspectorPath]() {
+            registerPortInspector(portClassIdentifier, inspectorPath);
+        })) {
+        return;
+    }
     auto portInspector =
         std::make_unique<PortInspectorFactoryObject>(portClassIdentifier, inspectorPath);
 
@@ -352,17 +396,20 @@ void InviwoModule::registerPortInspector(std::string portClassIdentifier,
 }
 
 void InviwoModule::registerDataVisualizer(std::unique_ptr<DataVisualizer> visualizer) {
+    if (deferRegistration(&InviwoModule::registerDataVisualizer, visualizer)) return;
     app_->getDataVisualizerManager()->registerObject(visualizer.get());
     dataVisualizers_.push_back(std::move(visualizer));
 }
 
 void InviwoModule::registerInport(std::unique_ptr<InportFactoryObject> inport) {
+    if (deferRegistration(&InviwoModule::registerInport, inport)) return;
     if (app_->getInportFactory()->registerObject(inport.get())) {
         inports_.push_back(std::move(inport));
     }
 }
 
 void InviwoModule::registerOutport(std::unique_ptr<OutportFactoryObject> outport) {
+    if (deferRegistration(&InviwoModule::registerOutport, outport)) return;
     if (app_->getOutportFactory()->registerObject(outport.get())) {
         outports_.push_back(std::move(outport));
     }
@@ -39,7 +39,8 @@ InviwoModuleFactoryObject::InviwoModuleFactoryObject(
     const std::string& name_, Version version_, const std::string& description_,
     Version inviwoCoreVersion_, std::vector<std::string> dependencies_,
     std::vector<Version> dependenciesVersion_, std::vector<std::string> aliases_,
-    std::vector<LicenseInfo> licenses_, ProtectedModule protectedModule_)
+    std::vector<LicenseInfo> licenses_, ProtectedModule protectedModule_,
+    ConcurrentModule concurrentModule_)
     : name(name_)
     , version(version_)
     , description(description_)
@@ -56,7 +57,8 @@ InviwoModuleFactoryObject::InviwoModuleFactoryObject(
     }())
     , aliases(aliases_)
     , licenses(licenses_)
-    , protectedModule(protectedModule_) {}
+    , protectedModule(protectedModule_)
+    , concurrentModule(concurrentModule_) {}
 
 /**
  * \brief Sorts modules according to their dependencies.
@@ -31,16 +31,22 @@
 #include <inviwo/core/common/inviwomodule.h>
 #include <inviwo/core/common/version.h>
 #include <inviwo/core/util/filesystem.h>
+#include <inviwo/core/util/foreach.h>
 #include <inviwo/core/util/settings/systemsettings.h>
 #include <inviwo/core/util/sharedlibrary.h>
 #include <inviwo/core/util/vectoroperations.h>
 #include <inviwo/core/util/utilities.h>
 #include <inviwo/core/util/capabilities.h>
+#include <inviwo/core/util/tracing.h>
 #include <inviwo/core/network/processornetwork.h>
 #include <inviwo/core/inviwocommondefines.h>
 
 #include <string>
 #include <functional>
+#include <iomanip>
+#include <future>
+#include <mutex>
+#include <condition_variable>
 
 namespace inviwo {
 
@@ -81,12 +87,22 @@ void ModuleManager::registerModules(std::vector<std::unique_ptr<InviwoModuleFact
     // Topological sort to make sure that we load modules in correct order
     topologicalModuleFactoryObjectSort(std::begin(factoryObjects_), std::end(factoryObjects_));
 
-    for (auto& obj : factoryObjects_) {
-        app_->postProgress("Loading module: " + obj->name);
-        if (getModuleByIdentifier(obj->name)) continue;  // already loaded
-        if (!checkDependencies(*obj)) continue;
+    struct Constructed {
+        std::unique_ptr<InviwoModule> module;
+        std::chrono::nanoseconds time;
+    };
+    const auto construct = [this](InviwoModuleFactoryObject* obj) {
+        IVW_TRACE_SCOPE("module", obj->name);
+        const auto start = std::chrono::steady_clock::now();
+        auto module = obj->create(app_);
+        return Constructed{std::move(module), std::chrono::steady_clock::now() - start};
+    };
+    const auto finish = [this](InviwoModuleFactoryObject* obj, auto&& getConstructed) {
         try {
-            registerModule(obj->create(app_));
+            auto constructed = getConstructed();
+            getModuleLoadTiming(obj->name).construction = constructed.time;
+            constructed.module->applyDeferredRegistrations();
+            registerModule(std::move(constructed.module));
         } catch (const ModuleInitException& e) {
             auto dereg = deregisterDependetModules(e.getModulesToDeregister());
             auto err = (!dereg.empty() ? "\nUnregistered dependent modules: " +
@@ -95,6 +111,75 @@ void ModuleManager::registerModules(std::vector<std::unique_ptr<InviwoModuleFact
             LogError("Failed to register module: " << obj->name << ". Reason:\n"
                                                    << e.getMessage() << err);
         }
+    };
+
+    // Modules marked as concurrent are constructed on the pool as soon as all their dependencies
+    // are registered, all others are constructed here on the main thread. Registration into the
+    // application factories always happens on the main thread, see ConcurrentModule.
+    std::vector<InviwoModuleFactoryObject*> pending;
+    for (auto& obj : factoryObjects_) {
+        if (!getModuleByIdentifier(obj->name)) pending.push_back(obj.get());  // not loaded
+    }
+    std::vector<std::pair<InviwoModuleFactoryObject*, std::future<Constructed>>> running;
+    std::vector<InviwoModuleFactoryObject*> finished;
+    std::mutex mutex;
+    std::condition_variable condition;
+    // Make sure no task refers to the state above if we leave due to an exception
+    util::OnScopeExit waitForRunning{[&]() {
+        for (auto& item : running) item.second.wait();
+    }};
+
+    // pending is in topological order, hence only earlier items can be dependencies
+    const auto isReady = [&](const InviwoModuleFactoryObject* obj, auto pos) {
+        return !util::contains_if(obj->dependencies, [&](const auto& dep) {
+            auto depObj = getFactoryObject(dep.first);
+            return depObj && (std::find(pending.begin(), pos, depObj) != pos ||
+                              util::contains_if(running, [&](const auto& item) {
+                                  return item.first == depObj;
+                              }));
+        });
+    };
+
+    while (!pending.empty() || !running.empty()) {
+        for (auto it = pending.begin(); it != pending.end();) {
+            auto obj = *it;
+            if (!isReady(obj, it)) {
+                ++it;
+                continue;
+            }
+            it = pending.erase(it);
+
+            app_->postProgress("Loading module: " + obj->name);
+            if (!checkDependencies(*obj)) continue;
+            if (obj->concurrentModule == ConcurrentModule::on) {
+                running.emplace_back(obj, app_->dispatchPool([&, obj]() {
+                    util::OnScopeExit notify{[&]() {
+                        std::scoped_lock lock{mutex};
+                        finished.push_back(obj);
+                        condition.notify_one();
+                    }};
+                    InviwoModule::setDeferRegistrations(true);
+                    util::OnScopeExit reset{[]() { InviwoModule::setDeferRegistrations(false); }};
+                    return construct(obj);
+                }));
+            } else {
+                finish(obj, [&]() { return construct(obj); });
+            }
+        }
+
+        if (running.empty()) continue;
+        std::vector<InviwoModuleFactoryObject*> done;
+        {
+            std::unique_lock lock{mutex};
+            condition.wait(lock, [&]() { return !finished.empty(); });
+            std::swap(done, finished);
+        }
+        for (auto obj : done) {
+            auto it = util::find_if(running, [&](const auto& item) { return item.first == obj; });
+            auto future = std::move(it->second);
+            running.erase(it);
+            finish(obj, [&]() { return future.get(); });
+        }
     }
 
     app_->postProgress("Loading Capabilities");
@@ -150,22 +235,36 @@ void ModuleManager::registerModules(RuntimeModuleLoading) {
     // 4. Start observing file if reloadLibrariesWhenChanged
     // 5. Pass module factories to registerModules
 
-    // Find unique files and directories in specified search paths
+    const auto searchStart = std::chrono::steady_clock::now();
+
+    // Find unique files and directories in specified search paths. The searches are independent
+    // and can be slow for large build directories, so we run them on the pool.
+    struct SearchPath {
+        std::string path;
+        std::vector<std::string> files;
+        std::vector<std::string> dirs;
+    };
     auto librarySearchPaths = util::getLibrarySearchPaths();
-    std::set<std::string> libraryFiles;
-    LibrarySearchDirs searchDirectories{librarySearchPaths};
-    for (auto path : librarySearchPaths) {
-        using namespace inviwo::filesystem;
+    std::vector<SearchPath> searchPaths;
+    for (const auto& path : librarySearchPaths) {
         // Make sure that we have an absolute path to avoid duplicates
-        path = cleanupPath(path);
+        searchPaths.push_back({filesystem::cleanupPath(path), {}, {}});
+    }
+    util::forEachRange(searchPaths.size(), searchPaths.size(), [&](size_t i, size_t, size_t) {
+        using namespace inviwo::filesystem;
+        auto& item = searchPaths[i];
         try {
-            auto files = getDirectoryContentsRecursively(path, ListMode::Files);
-            auto dirs = getDirectoryContentsRecursively(path, ListMode::Directories);
-            libraryFiles.insert(std::make_move_iterator(files.begin()),
-                                std::make_move_iterator(files.end()));
-            searchDirectories.add(dirs);
+            item.files = getDirectoryContentsRecursively(item.path, ListMode::Files);
+            item.dirs = getDirectoryContentsRecursively(item.path, ListMode::Directories);
         } catch (FileException&) {  // Invalid path, ignore it
         }
+    });
+    std::set<std::string> libraryFiles;
+    LibrarySearchDirs searchDirectories{librarySearchPaths};
+    for (auto& item : searchPaths) {
+        libraryFiles.insert(std::make_move_iterator(item.files.begin()),
+                            std::make_move_iterator(item.files.end()));
+        searchDirectories.add(item.dirs);
     }
     // Determines if a library is already loaded into the application
     auto isModuleLibraryLoaded = [&](const std::string path) {
@@ -203,34 +302,49 @@ void ModuleManager::registerModules(RuntimeModuleLoading) {
     auto isLoaded = [loaded = util::getLoadedLibraries()](const auto& path) {
         return util::contains_if(loaded, [&](const auto& lib) { return iCaseCmp(path, lib); });
     };
-    std::vector<std::unique_ptr<InviwoModuleFactoryObject>> modules;
+    struct LibraryFile {
+        std::string filePath;
+        std::string loadPath;
+        bool copy;
+    };
+    std::vector<LibraryFile> libraries;
     for (const auto& filePath : libraryFiles) {
-        const auto tmpPath = [&]() -> std::string {
-            if (isRuntimeModuleReloadingEnabled() && util::hasAddLibrarySearchDirsFunction()) {
-                auto dstPath = tmpDir + "/" + filesystem::getFileNameWithExtension(filePath);
-                if (isLoaded(filePath)) {
-                    // Already loaded modules are loaded from the application dir
-                    dstPath = filePath;
-                    protected_.insert(util::stripModuleFileNameDecoration(filePath));
-                } else if (filesystem::fileModificationTime(filePath) !=
-                           filesystem::fileModificationTime(dstPath)) {
-                    // Load a copy of the file to make sure that we can overwrite the file.
-                    filesystem::copyFile(filePath, dstPath);
-                }
-                return dstPath;
+        if (isRuntimeModuleReloadingEnabled() && util::hasAddLibrarySearchDirsFunction()) {
+            auto dstPath = tmpDir + "/" + filesystem::getFileNameWithExtension(filePath);
+            if (isLoaded(filePath)) {
+                // Already loaded modules are loaded from the application dir
+                protected_.insert(util::stripModuleFileNameDecoration(filePath));
+                libraries.push_back({filePath, filePath, false});
             } else {
-                return filePath;
+                // Load a copy of the file to make sure that we can overwrite the file.
+                const bool copy = filesystem::fileModificationTime(filePath) !=
+                                  filesystem::fileModificationTime(dstPath);
+                libraries.push_back({filePath, dstPath, copy});
             }
-        }();
+        } else {
+            libraries.push_back({filePath, filePath, false});
+        }
+    }
+    // Copying all libraries after a rebuild is IO bound, do the copies concurrently.
+    util::forEachRange(libraries.size(), libraries.size(), [&](size_t i, size_t, size_t) {
+        if (libraries[i].copy) filesystem::copyFile(libraries[i].filePath, libraries[i].loadPath);
+    });
+    librarySearchTime_ += std::chrono::steady_clock::now() - searchStart;
 
+    // Libraries are loaded serially, module libraries can have static initialization that is not
+    // safe to run concurrently.
+    std::vector<std::unique_ptr<InviwoModuleFactoryObject>> modules;
+    for (const auto& [filePath, tmpPath, copy] : libraries) {
         try {
+            const auto start = std::chrono::steady_clock::now();
             // Load library. Will throw exception if failed to load
             auto sharedLib = std::make_unique<SharedLibrary>(tmpPath);
             // Only consider libraries with Inviwo module creation function
             if (auto moduleFunc = sharedLib->findSymbolTyped<f_getModule>("createModule")) {
                 // Add module factory object
                 modules.emplace_back(moduleFunc());
-                auto moduleName = toLower(modules.back()->name);
+                getModuleLoadTiming(modules.back()->name).libraryLoad =
+                    std::chrono::steady_clock::now() - start;
                 if (modules.back()->protectedModule == ProtectedModule::on) {
                     protected_.insert(modules.back()->name);
                 }
@@ -281,6 +395,53 @@ void ModuleManager::registerModule(std::unique_ptr<InviwoModule> module) {
     modules_.push_back(std::move(module));
 }
 
+auto ModuleManager::getModuleLoadTiming(const std::string& name) -> ModuleLoadTiming& {
+    auto it = util::find_if(timings_, [&](const auto& t) { return iCaseCmp(t.name, name); });
+    if (it != timings_.end()) return *it;
+    return timings_.emplace_back(ModuleLoadTiming{name});
+}
+
+auto ModuleManager::getModuleLoadTimings() const -> const std::vector<ModuleLoadTiming>& {
+    return timings_;
+}
+
+std::chrono::nanoseconds ModuleManager::getLibrarySearchTime() const { return librarySearchTime_; }
+
+std::string ModuleManager::getStartupReport() const {
+    using ms = std::chrono::duration<double, std::milli>;
+
+    auto timings = timings_;
+    std::sort(timings.begin(), timings.end(), [](const auto& a, const auto& b) {
+        return a.libraryLoad + a.construction > b.libraryLoad + b.construction;
+    });
+
+    size_t width = 6;
+    for (const auto& t : timings) width = std::max(width, t.name.size());
+
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(1);
+    ss << "Module startup times (ms)\n";
+    ss << std::left << std::setw(width) << "Module" << std::right << std::setw(10) << "Library"
+       << std::setw(14) << "Construction" << std::setw(10) << "Total" << "\n";
+
+    std::chrono::nanoseconds libraryTotal{0};
+    std::chrono::nanoseconds constructionTotal{0};
+    for (const auto& t : timings) {
+        ss << std::left << std::setw(width) << t.name << std::right << std::setw(10)
+           << ms(t.libraryLoad).count() << std::setw(14) << ms(t.construction).count()
+           << std::setw(10) << ms(t.libraryLoad + t.construction).count() << "\n";
+        libraryTotal += t.libraryLoad;
+        constructionTotal += t.construction;
+    }
+    ss << std::left << std::setw(width) << "Total" << std::right << std::setw(10)
+       << ms(libraryTotal).count() << std::setw(14) << ms(constructionTotal).count()
+       << std::setw(10) << ms(libraryTotal + constructionTotal).count() << "\n";
+    if (librarySearchTime_.count() != 0) {
+        ss << "Library search and copy: " << ms(librarySearchTime_).count() << "\n";
+    }
+    return ss.str();
+}
+
 const std::vector<std::unique_ptr<InviwoModule>>& ModuleManager::getModules() const {
     return modules_;
 }
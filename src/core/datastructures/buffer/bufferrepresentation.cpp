@@ -37,6 +37,8 @@ BufferRepresentation::BufferRepresentation(const DataFormatBase* format, BufferU
 
 size_t BufferRepresentation::getSizeOfElement() const { return getDataFormat()->getSize(); }
 
+size_t BufferRepresentation::getSizeInBytes() const { return getSize() * getSizeOfElement(); }
+
 BufferUsage BufferRepresentation::getBufferUsage() const { return usage_; }
 
 BufferTarget BufferRepresentation::getBufferTarget() const { return target_; }
@@ -326,6 +326,13 @@ size_t Mesh::getNumberOfBuffers() const { return buffers_.size(); }
 
 size_t Mesh::getNumberOfIndicies() const { return indices_.size(); }
 
+size_t Mesh::getSizeInBytes() const {
+    size_t size = 0;
+    for (const auto& buffer : buffers_) size += buffer.second->getSizeInBytes();
+    for (const auto& index : indices_) size += index.second->getSizeInBytes();
+    return size;
+}
+
 void Mesh::append(const Mesh& mesh) {
     if (buffers_.size() != mesh.buffers_.size()) {
         throw Exception("Mismatched meshed, number of buffer does not match", IVW_CONTEXT);
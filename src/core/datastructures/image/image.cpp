@@ -165,6 +165,19 @@ Layer* Image::getPickingLayer() { return pickingLayer_.get(); }
 
 size2_t Image::getDimensions() const { return getColorLayer()->getDimensions(); }
 
+size_t Image::getSizeInBytes() const {
+    size_t size = 0;
+    for (const auto& layer : colorLayers_) size += layer->getSizeInBytes();
+    // depth and picking layers do not allocate any memory until they are used
+    if (depthLayer_ && depthLayer_->hasRepresentations()) {
+        size += depthLayer_->getSizeInBytes();
+    }
+    if (pickingLayer_ && pickingLayer_->hasRepresentations()) {
+        size += pickingLayer_->getSizeInBytes();
+    }
+    return size;
+}
+
 void Image::setDimensions(size2_t dimensions) {
     for (auto layer : colorLayers_) layer->setDimensions(dimensions);
     if (depthLayer_) depthLayer_->setDimensions(dimensions);
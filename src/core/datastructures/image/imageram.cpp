@@ -33,8 +33,25 @@
 #include <inviwo/core/datastructures/image/image.h>
 #include <inviwo/core/util/stdextensions.h>
 
+#include <algorithm>
+
 namespace inviwo {
 
+namespace {
+
+// Resize a layer and fill it like a newly created one, with 1 for depth and 0 otherwise
+void resetLayerRAM(LayerRAM& layer, size2_t dimensions) {
+    layer.setDimensions(dimensions);
+    layer.dispatch<void>([](auto layerpr) {
+        using ValueType = util::PrecisionValueType<decltype(layerpr)>;
+        auto data = layerpr->getDataTyped();
+        std::fill(data, data + glm::compMul(layerpr->getDimensions()),
+                  layerpr->getLayerType() == LayerType::Depth ? ValueType{1} : ValueType{0});
+    });
+}
+
+}  // namespace
+
 ImageRAM::ImageRAM() = default;
 
 ImageRAM::ImageRAM(const ImageRAM& rhs) : ImageRepresentation(rhs) { update(true); }
@@ -66,15 +83,24 @@ bool ImageRAM::copyRepresentationsTo(ImageRepresentation* targetRep) const {
             return false;
     }
 
-    // Copy and resize depth layer
-    if (source->getDepthLayerRAM() && target->getDepthLayerRAM())
-        if (!source->getDepthLayerRAM()->copyRepresentationsTo(target->getDepthLayerRAM()))
-            return false;
+    // Copy and resize depth layer, unless it has never been used in the source. A target layer
+    // that is in use is then reset to the content of a new layer, so it does not keep stale data.
+    if (source->hasLayerRAM(LayerType::Depth)) {
+        if (auto depth = target->getDepthLayerRAM()) {
+            if (!source->getDepthLayerRAM()->copyRepresentationsTo(depth)) return false;
+        }
+    } else if (target->hasLayerRAM(LayerType::Depth)) {
+        resetLayerRAM(*target->getDepthLayerRAM(), source->getDimensions());
+    }
 
-    // Copy and resize picking layer
-    if (source->getPickingLayerRAM() && target->getPickingLayerRAM())
-        if (!source->getPickingLayerRAM()->copyRepresentationsTo(target->getPickingLayerRAM()))
-            return false;
+    // Copy and resize picking layer, the same way as the depth layer
+    if (source->hasLayerRAM(LayerType::Picking)) {
+        if (auto picking = target->getPickingLayerRAM()) {
+            if (!source->getPickingLayerRAM()->copyRepresentationsTo(picking)) return false;
+        }
+    } else if (target->hasLayerRAM(LayerType::Picking)) {
+        resetLayerRAM(*target->getPickingLayerRAM(), source->getDimensions());
+    }
 
     return true;
 }
@@ -85,6 +111,7 @@ void ImageRAM::update(bool editable) {
     colorLayersRAM_.clear();
     depthLayerRAM_ = nullptr;
     pickingLayerRAM_ = nullptr;
+    editable_ = editable;
 
     if (editable) {
         auto owner = static_cast<Image*>(this->getOwner());
@@ -92,36 +119,58 @@ void ImageRAM::update(bool editable) {
             colorLayersRAM_.push_back(
                 owner->getColorLayer(i)->getEditableRepresentation<LayerRAM>());
         }
-
-        if (auto depthLayer = owner->getDepthLayer()) {
-            depthLayerRAM_ = depthLayer->getEditableRepresentation<LayerRAM>();
-        }
-
-        if (auto pickingLayer = owner->getPickingLayer()) {
-            pickingLayerRAM_ = pickingLayer->getEditableRepresentation<LayerRAM>();
-        }
     } else {
         auto owner = static_cast<const Image*>(this->getOwner());
         for (size_t i = 0; i < owner->getNumberOfColorLayers(); ++i) {
             colorLayersRAM_.push_back(
                 const_cast<LayerRAM*>(owner->getColorLayer(i)->getRepresentation<LayerRAM>()));
         }
+    }
 
-        if (auto depthLayer = owner->getDepthLayer()) {
-            depthLayerRAM_ = const_cast<LayerRAM*>(depthLayer->getRepresentation<LayerRAM>());
-        }
+    // Depth and picking layers that already hold data are updated right away, the others are
+    // only allocated once they are accessed.
+    if (hasLayerRAM(LayerType::Depth)) depthLayerRAM_ = layerRAM(LayerType::Depth);
+    if (hasLayerRAM(LayerType::Picking)) pickingLayerRAM_ = layerRAM(LayerType::Picking);
+}
 
-        if (auto pickingLayer = owner->getPickingLayer()) {
-            pickingLayerRAM_ = const_cast<LayerRAM*>(pickingLayer->getRepresentation<LayerRAM>());
-        }
+bool ImageRAM::hasLayerRAM(LayerType type) const {
+    const auto owner = static_cast<const Image*>(this->getOwner());
+    switch (type) {
+        case LayerType::Depth:
+            return depthLayerRAM_ ||
+                   (owner->getDepthLayer() && owner->getDepthLayer()->hasRepresentations());
+        case LayerType::Picking:
+            return pickingLayerRAM_ ||
+                   (owner->getPickingLayer() && owner->getPickingLayer()->hasRepresentations());
+        case LayerType::Color:
+        default:
+            return true;
+    }
+}
+
+LayerRAM* ImageRAM::layerRAM(LayerType type) const {
+    auto owner = const_cast<Image*>(static_cast<const Image*>(this->getOwner()));
+    auto layer = owner->getLayer(type);
+    if (!layer) return nullptr;
+    if (editable_) {
+        return layer->getEditableRepresentation<LayerRAM>();
+    } else {
+        return const_cast<LayerRAM*>(
+            static_cast<const Layer*>(layer)->getRepresentation<LayerRAM>());
     }
 }
 
 LayerRAM* ImageRAM::getColorLayerRAM(size_t idx) { return colorLayersRAM_.at(idx); }
 
-LayerRAM* ImageRAM::getDepthLayerRAM() { return depthLayerRAM_; }
+LayerRAM* ImageRAM::getDepthLayerRAM() {
+    if (!depthLayerRAM_) depthLayerRAM_ = layerRAM(LayerType::Depth);
+    return depthLayerRAM_;
+}
 
-LayerRAM* ImageRAM::getPickingLayerRAM() { return pickingLayerRAM_; }
+LayerRAM* ImageRAM::getPickingLayerRAM() {
+    if (!pickingLayerRAM_) pickingLayerRAM_ = layerRAM(LayerType::Picking);
+    return pickingLayerRAM_;
+}
 
 size_t ImageRAM::getNumberOfColorLayers() const { return colorLayersRAM_.size(); }
 
@@ -129,21 +178,31 @@ std::type_index ImageRAM::getTypeIndex() const { return std::type_index(typeid(I
 
 const LayerRAM* ImageRAM::getColorLayerRAM(size_t idx) const { return colorLayersRAM_.at(idx); }
 
-const LayerRAM* ImageRAM::getDepthLayerRAM() const { return depthLayerRAM_; }
+const LayerRAM* ImageRAM::getDepthLayerRAM() const {
+    if (!depthLayerRAM_) depthLayerRAM_ = layerRAM(LayerType::Depth);
+    return depthLayerRAM_;
+}
 
-const LayerRAM* ImageRAM::getPickingLayerRAM() const { return pickingLayerRAM_; }
+const LayerRAM* ImageRAM::getPickingLayerRAM() const {
+    if (!pickingLayerRAM_) pickingLayerRAM_ = layerRAM(LayerType::Picking);
+    return pickingLayerRAM_;
+}
 
 bool ImageRAM::isValid() const {
-    return depthLayerRAM_->isValid() && pickingLayerRAM_->isValid() &&
+    return (!depthLayerRAM_ || depthLayerRAM_->isValid()) &&
+           (!pickingLayerRAM_ || pickingLayerRAM_->isValid()) &&
            util::all_of(colorLayersRAM_, [](const auto& l) { return l->isValid(); });
 }
 
 dvec4 ImageRAM::readPixel(size2_t pos, LayerType layer, size_t index) const {
     switch (layer) {
         case LayerType::Depth:
-            return depthLayerRAM_->getAsDVec4(pos);
+            // a depth layer that was never used reads as cleared, i.e. at the far plane
+            return hasLayerRAM(LayerType::Depth) ? getDepthLayerRAM()->getAsDVec4(pos)
+                                                 : dvec4(1.0, 0.0, 0.0, 0.0);
         case LayerType::Picking:
-            return pickingLayerRAM_->getAsDVec4(pos);
+            return hasLayerRAM(LayerType::Picking) ? getPickingLayerRAM()->getAsDVec4(pos)
+                                                   : dvec4(0.0);
         case LayerType::Color:
         default:
             return colorLayersRAM_[index]->getAsDVec4(pos);
@@ -97,6 +97,10 @@ const DataFormatBase* Layer::getDataFormat() const {
     return defaultDataFormat_;
 }
 
+size_t Layer::getSizeInBytes() const {
+    return glm::compMul(getDimensions()) * getDataFormat()->getSize();
+}
+
 void Layer::setSwizzleMask(const SwizzleMask& mask) {
     defaultSwizzleMask_ = mask;
     if (lastValidRepresentation_) {
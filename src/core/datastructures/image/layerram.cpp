@@ -29,9 +29,7 @@
 
 #include <inviwo/core/datastructures/image/layerram.h>
 #include <inviwo/core/datastructures/image/layer.h>
-#include <inviwo/core/io/datawriterfactory.h>
-#include <inviwo/core/io/datawriter.h>
-#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/util/imageresample.h>
 
 namespace inviwo {
 
@@ -39,15 +37,13 @@ LayerRAM::LayerRAM(LayerType type, const DataFormatBase* format)
     : LayerRepresentation(type, format) {}
 
 bool LayerRAM::copyRepresentationsTo(LayerRepresentation* targetLayerRam) const {
-    // We use a LayerDataWriter to copy/resize one representation into another. By asking for the
-    // bmp file-extension we will get the LayerWriter defined in the CImg module which implements
-    // the writeDataToRepresentation method
-    static DataWriterType<Layer>* layerWriter_ = InviwoApplication::getPtr()
-                                                     ->getDataWriterFactory()
-                                                     ->getWriterForTypeAndExtension<Layer>("bmp")
-                                                     .release();
+    auto target = dynamic_cast<LayerRAM*>(targetLayerRam);
+    if (!target || !getData() || !target->getData()) return false;
+    if (getDataFormat() != target->getDataFormat()) return false;
 
-    return layerWriter_->writeDataToRepresentation(this, targetLayerRam);
+    // Resize into the target keeping the aspect ratio, the borders are filled with zeros
+    util::resampleToFit(*this, *target, util::ResampleFilter::Bilinear);
+    return true;
 }
 
 std::type_index LayerRAM::getTypeIndex() const { return std::type_index(typeid(LayerRAM)); }
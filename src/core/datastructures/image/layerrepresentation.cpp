@@ -29,6 +29,7 @@
 
 #include <inviwo/core/datastructures/image/layerrepresentation.h>
 #include <inviwo/core/datastructures/image/layer.h>
+#include <inviwo/core/util/glm.h>
 
 namespace inviwo {
 
@@ -37,4 +38,8 @@ LayerRepresentation::LayerRepresentation(LayerType type, const DataFormatBase* f
 
 LayerType LayerRepresentation::getLayerType() const { return layerType_; }
 
+size_t LayerRepresentation::getSizeInBytes() const {
+    return glm::compMul(getDimensions()) * getDataFormat()->getSize();
+}
+
 }  // namespace inviwo
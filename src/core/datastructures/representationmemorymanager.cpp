@@ -0,0 +1,223 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+
+#include <inviwo/core/datastructures/representationmemorymanager.h>
+#include <inviwo/core/util/stringconversion.h>
+
+#include <algorithm>
+
+namespace inviwo {
+
+std::atomic<std::uint64_t> RepresentationMemoryManager::epoch_{0};
+
+RepresentationMemoryManager::Owner::Owner(Evict evict) : evict_{std::move(evict)} {}
+
+void RepresentationMemoryManager::Owner::release() {
+    std::scoped_lock lock{mutex_};
+    evict_ = nullptr;
+}
+
+bool RepresentationMemoryManager::Owner::evict(const void* repr) {
+    std::scoped_lock lock{mutex_};
+    return evict_ ? evict_(repr) : false;
+}
+
+RepresentationMemoryManager::Record::Record(std::weak_ptr<const void> aRepr,
+                                            std::type_index aType, size_t aBytes,
+                                            std::weak_ptr<Owner> aOwner)
+    : repr{std::move(aRepr)}
+    , type{aType}
+    , bytes{aBytes}
+    , owner{std::move(aOwner)}
+    , lastUse{epoch_.load(std::memory_order_relaxed)} {}
+
+void RepresentationMemoryManager::Record::touch() noexcept {
+    // Only write when the epoch has changed to avoid contention between concurrent readers
+    const auto epoch = epoch_.load(std::memory_order_relaxed);
+    if (lastUse.load(std::memory_order_relaxed) != epoch) {
+        lastUse.store(epoch, std::memory_order_relaxed);
+    }
+}
+
+RepresentationMemoryManager& RepresentationMemoryManager::get() {
+    static RepresentationMemoryManager manager;
+    return manager;
+}
+
+std::shared_ptr<RepresentationMemoryManager::Record> RepresentationMemoryManager::add(
+    std::weak_ptr<const void> repr, std::type_index type, size_t bytes,
+    std::weak_ptr<Owner> owner) {
+    auto record = std::make_shared<Record>(std::move(repr), type, bytes, std::move(owner));
+    std::scoped_lock lock{mutex_};
+    // Prune before growing to keep the list from accumulating expired records
+    if (records_.size() == records_.capacity()) prune();
+    records_.push_back(record);
+    return record;
+}
+
+void RepresentationMemoryManager::setBudget(size_t bytes) {
+    std::scoped_lock lock{mutex_};
+    budget_ = bytes;
+}
+
+size_t RepresentationMemoryManager::getBudget() const {
+    std::scoped_lock lock{mutex_};
+    return budget_;
+}
+
+size_t RepresentationMemoryManager::enforceBudget() {
+    const auto epoch = epoch_.fetch_add(1, std::memory_order_relaxed);
+
+    // Snapshot the last use since it might change while sorting
+    std::vector<std::pair<std::uint64_t, std::shared_ptr<Record>>> candidates;
+    size_t used = 0;
+    size_t budget = 0;
+    {
+        std::scoped_lock lock{mutex_};
+        prune();
+        budget = budget_;
+        if (budget == 0) return 0;
+        for (auto& item : records_) {
+            if (auto record = item.lock()) {
+                used += record->bytes;
+                const auto lastUse = record->lastUse.load(std::memory_order_relaxed);
+                if (record->bytes > 0 && lastUse + 1 < epoch) {
+                    candidates.emplace_back(lastUse, std::move(record));
+                }
+            }
+        }
+    }
+    if (used <= budget) return 0;
+
+    std::sort(candidates.begin(), candidates.end(),
+              [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    size_t evicted = 0;
+    size_t count = 0;
+    for (auto& [lastUse, record] : candidates) {
+        if (used - evicted <= budget) break;
+        // Keep the representation alive while evicting, the Data object might otherwise delete it
+        // while we still use its address as identifier.
+        auto repr = record->repr.lock();
+        auto owner = record->owner.lock();
+        if (!repr || !owner) continue;
+        if (owner->evict(repr.get())) {
+            evicted += record->bytes;
+            ++count;
+        }
+    }
+
+    std::scoped_lock lock{mutex_};
+    evictions_ += count;
+    evictedBytes_ += evicted;
+    return evicted;
+}
+
+size_t RepresentationMemoryManager::getUsedBytes() const {
+    std::scoped_lock lock{mutex_};
+    size_t used = 0;
+    for (auto& item : records_) {
+        if (auto record = item.lock(); record && !record->repr.expired()) used += record->bytes;
+    }
+    return used;
+}
+
+size_t RepresentationMemoryManager::getEvictionCount() const {
+    std::scoped_lock lock{mutex_};
+    return evictions_;
+}
+
+size_t RepresentationMemoryManager::getEvictedBytes() const {
+    std::scoped_lock lock{mutex_};
+    return evictedBytes_;
+}
+
+auto RepresentationMemoryManager::getMemoryStatistics() const -> std::vector<MemoryStatistics> {
+    std::map<std::type_index, MemoryStatistics> stats;
+    {
+        std::scoped_lock lock{mutex_};
+        for (auto& item : records_) {
+            if (auto record = item.lock(); record && !record->repr.expired()) {
+                auto& stat = stats[record->type];
+                ++stat.count;
+                stat.bytes += record->bytes;
+            }
+        }
+    }
+    std::vector<MemoryStatistics> res;
+    for (auto& [type, stat] : stats) {
+        stat.type = parseTypeIdName(type.name());
+        res.push_back(stat);
+    }
+    std::sort(res.begin(), res.end(),
+              [](const auto& a, const auto& b) { return a.bytes > b.bytes; });
+    return res;
+}
+
+void RepresentationMemoryManager::recordConversion(std::type_index source, std::type_index target,
+                                                   std::chrono::nanoseconds time) {
+    std::scoped_lock lock{mutex_};
+    auto& conversion = conversions_[{source, target}];
+    ++conversion.count;
+    conversion.time += time;
+}
+
+auto RepresentationMemoryManager::getConversionStatistics() const
+    -> std::vector<ConversionStatistics> {
+    std::vector<ConversionStatistics> res;
+    {
+        std::scoped_lock lock{mutex_};
+        for (const auto& [types, conversion] : conversions_) {
+            res.push_back({parseTypeIdName(types.first.name()),
+                           parseTypeIdName(types.second.name()), conversion.count,
+                           std::chrono::duration_cast<duration>(conversion.time)});
+        }
+    }
+    std::sort(res.begin(), res.end(), [](const auto& a, const auto& b) { return a.time > b.time; });
+    return res;
+}
+
+void RepresentationMemoryManager::clearStatistics() {
+    std::scoped_lock lock{mutex_};
+    conversions_.clear();
+    evictions_ = 0;
+    evictedBytes_ = 0;
+}
+
+void RepresentationMemoryManager::prune() {
+    records_.erase(std::remove_if(records_.begin(), records_.end(),
+                                  [](const auto& item) {
+                                      auto record = item.lock();
+                                      return !record || record->repr.expired();
+                                  }),
+                   records_.end());
+}
+
+}  // namespace inviwo
@@ -91,6 +91,10 @@ const DataFormatBase* Volume::getDataFormat() const {
     return defaultDataFormat_;
 }
 
+size_t Volume::getSizeInBytes() const {
+    return glm::compMul(getDimensions()) * getDataFormat()->getSize();
+}
+
 void Volume::setSwizzleMask(const SwizzleMask& mask) {
     defaultSwizzleMask_ = mask;
     if (lastValidRepresentation_) {
@@ -29,10 +29,15 @@
 
 #include <inviwo/core/datastructures/volume/volumerepresentation.h>
 #include <inviwo/core/datastructures/datarepresentation.h>
+#include <inviwo/core/util/glm.h>
 
 namespace inviwo {
 
 VolumeRepresentation::VolumeRepresentation(const DataFormatBase* format)
     : DataRepresentation(format) {}
 
+size_t VolumeRepresentation::getSizeInBytes() const {
+    return glm::compMul(getDimensions()) * getDataFormat()->getSize();
+}
+
 }  // namespace inviwo
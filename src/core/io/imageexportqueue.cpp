@@ -0,0 +1,161 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/io/imageexportqueue.h>
+#include <inviwo/core/io/imagewriterutil.h>
+#include <inviwo/core/datastructures/image/layerram.h>
+#include <inviwo/core/util/exception.h>
+#include <inviwo/core/util/filesystem.h>
+#include <inviwo/core/util/logcentral.h>
+#include <inviwo/core/util/threadutil.h>
+
+#include <algorithm>
+
+namespace inviwo {
+
+ImageExportQueue::ImageExportQueue(size_t threads, size_t maxPending)
+    : maxPending_{std::max(size_t{1}, maxPending)} {
+    threads = std::max(size_t{1}, threads);
+    threads_.reserve(threads);
+    for (size_t i = 0; i < threads; ++i) {
+        threads_.emplace_back([this]() { work(); });
+        util::setThreadDescription(threads_.back(), "Inviwo Image Export Thread");
+    }
+}
+
+ImageExportQueue::~ImageExportQueue() {
+    wait();
+    {
+        std::scoped_lock lock{mutex_};
+        stop_ = true;
+    }
+    hasWork_.notify_all();
+    for (auto& thread : threads_) thread.join();
+}
+
+bool ImageExportQueue::enqueue(const Layer& layer, std::string_view path,
+                               const FileExtension& extension, bool overwrite) {
+    auto writer = util::getLayerWriter(path, extension);
+    if (!writer) {
+        LogErrorCustom("ImageExportQueue",
+                       "Could not find a writer for the specified file extension (\""
+                           << filesystem::getFileExtension(path) << "\")");
+        return false;
+    }
+    writer->setOverwrite(overwrite);
+    enqueue(layer, path, std::move(writer));
+    return true;
+}
+
+void ImageExportQueue::enqueue(const Layer& layer, std::string_view path,
+                               std::unique_ptr<DataWriterType<Layer>> writer,
+                               std::function<void(const std::string& path)> written) {
+    // Take the snapshot on the calling thread, this is where any GL download has to happen. The
+    // encoder threads only ever see the copy.
+    auto ram = std::shared_ptr<LayerRAM>(layer.getRepresentation<LayerRAM>()->clone());
+    auto snapshot = std::make_shared<const Layer>(ram);
+
+    {
+        std::unique_lock lock{mutex_};
+        hasSpace_.wait(lock, [&]() { return jobs_.size() + active_ < maxPending_; });
+        if (!start_) start_ = Clock::now();
+        jobs_.push_back(
+            Job{std::move(snapshot), std::move(writer), std::string{path}, std::move(written)});
+    }
+    hasWork_.notify_one();
+}
+
+void ImageExportQueue::wait() {
+    std::unique_lock lock{mutex_};
+    finished_.wait(lock, [&]() { return jobs_.empty() && active_ == 0; });
+}
+
+size_t ImageExportQueue::getPending() const {
+    std::scoped_lock lock{mutex_};
+    return jobs_.size() + active_;
+}
+
+size_t ImageExportQueue::getWritten() const {
+    std::scoped_lock lock{mutex_};
+    return written_;
+}
+
+size_t ImageExportQueue::getFailed() const {
+    std::scoped_lock lock{mutex_};
+    return failed_;
+}
+
+double ImageExportQueue::getFramesPerSecond() const {
+    std::scoped_lock lock{mutex_};
+    if (!start_ || written_ == 0) return 0.0;
+    const std::chrono::duration<double> elapsed = last_ - *start_;
+    return elapsed.count() > 0.0 ? static_cast<double>(written_) / elapsed.count() : 0.0;
+}
+
+void ImageExportQueue::work() {
+    while (true) {
+        Job job;
+        {
+            std::unique_lock lock{mutex_};
+            hasWork_.wait(lock, [&]() { return stop_ || !jobs_.empty(); });
+            if (jobs_.empty()) return;
+            job = std::move(jobs_.front());
+            jobs_.pop_front();
+            ++active_;
+        }
+
+        bool success = false;
+        try {
+            job.writer->writeData(job.layer.get(), job.path);
+            success = true;
+            if (job.written) job.written(job.path);
+        } catch (const Exception& e) {
+            util::log(e.getContext(), e.getMessage(), LogLevel::Error, LogAudience::User);
+        } catch (const std::exception& e) {
+            LogErrorCustom("ImageExportQueue", "Could not write " << job.path << ": " << e.what());
+        }
+        // release the snapshot before making room for the next one
+        job = Job{};
+
+        {
+            std::scoped_lock lock{mutex_};
+            --active_;
+            if (success) {
+                ++written_;
+            } else {
+                ++failed_;
+            }
+            last_ = Clock::now();
+        }
+        hasSpace_.notify_one();
+        finished_.notify_all();
+    }
+}
+
+}  // namespace inviwo
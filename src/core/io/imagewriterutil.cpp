@@ -41,24 +41,20 @@ namespace inviwo {
 
 namespace util {
 
-void saveLayer(const Layer& layer, std::string_view path, const FileExtension& extension) {
+std::unique_ptr<DataWriterType<Layer>> getLayerWriter(std::string_view path,
+                                                      const FileExtension& extension) {
     auto factory = InviwoApplication::getPtr()->getDataWriterFactory();
+    return factory->getWriterForTypeAndExtension<Layer>(extension,
+                                                        filesystem::getFileExtension(path));
+}
 
-    auto writer = std::shared_ptr<DataWriterType<Layer>>(
-        factory->getWriterForTypeAndExtension<Layer>(extension));
-
+void saveLayer(const Layer& layer, std::string_view path, const FileExtension& extension) {
+    auto writer = getLayerWriter(path, extension);
     if (!writer) {
-        // could not find a reader for the given extension, extension might be invalid
-        // try to get reader for the extension extracted from the file name, i.e. path
-        const auto ext = filesystem::getFileExtension(path);
-        writer = std::shared_ptr<DataWriterType<Layer>>(
-            factory->getWriterForTypeAndExtension<Layer>(ext));
-        if (!writer) {
-            LogInfoCustom(
-                "ImageWriterUtil",
-                "Could not find a writer for the specified file extension (\"" << ext << "\")");
-            return;
-        }
+        LogInfoCustom("ImageWriterUtil",
+                      "Could not find a writer for the specified file extension (\""
+                          << filesystem::getFileExtension(path) << "\")");
+        return;
     }
 
     try {
@@ -0,0 +1,613 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/io/serialization/binaryxml.h>
+#include <inviwo/core/io/serialization/lazyxml.h>
+#include <inviwo/core/io/serialization/serializationexception.h>
+#include <inviwo/core/io/serialization/ticpp.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <type_traits>
+#include <unordered_map>
+
+namespace inviwo {
+
+namespace binaryxml {
+
+namespace {
+
+constexpr std::string_view magic = "\x89IVWB";
+constexpr char version = 2;
+
+// Runs of at least this many equal leaf elements are written as one block
+constexpr size_t minRunLength = 4;
+
+enum class Tag : char { End = 0, Element, Text, Comment, Declaration, Run };
+
+// How a value is stored. Single attribute values are written as one varint with the kind in the
+// lowest two bits, followed by the binary number for Float and Double.
+enum class Kind : unsigned char { String = 0, Int, Float, Double };
+
+// Integers are only stored inline if the shifted zigzag value fits in 64 bits
+constexpr int64_t maxInlineInt = int64_t{1} << 60;
+
+uint64_t zigzag(int64_t value) {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+int64_t unzigzag(uint64_t value) {
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+// Parses str as a T if formatting the number again gives back exactly the same text
+template <typename T>
+std::optional<T> asNumber(const std::string& str) {
+    if (str.empty() || str.size() > 32 ||
+        str.find_first_not_of("0123456789+-.eE") != std::string::npos) {
+        return std::nullopt;
+    }
+    T value{};
+    try {
+        detail::fromStr(str, value);
+    } catch (const SerializationException&) {
+        return std::nullopt;
+    }
+    if (detail::toStr(value) != str) return std::nullopt;
+    return value;
+}
+
+template <typename T>
+bool isKind(const std::string& str) {
+    if constexpr (std::is_same_v<T, int64_t>) {
+        const auto value = asNumber<int64_t>(str);
+        return value && *value > -maxInlineInt && *value < maxInlineInt;
+    } else {
+        return asNumber<T>(str).has_value();
+    }
+}
+
+void putSize(std::string& out, uint64_t value) {
+    do {
+        char byte = static_cast<char>(value & 0x7f);
+        value >>= 7;
+        if (value) byte |= static_cast<char>(0x80);
+        out.push_back(byte);
+    } while (value);
+}
+
+void putRaw(std::string& out, std::string_view str) {
+    putSize(out, str.size());
+    out.append(str);
+}
+
+// Little endian, independent of the platform
+template <typename T>
+void putFixed(std::string& out, T value) {
+    using Bits = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+    static_assert(sizeof(T) == sizeof(Bits));
+    Bits bits;
+    std::memcpy(&bits, &value, sizeof(T));
+    for (size_t i = 0; i < sizeof(T); ++i, bits >>= 8) {
+        out.push_back(static_cast<char>(bits & 0xff));
+    }
+}
+
+class Writer {
+public:
+    void writeChildren(const TiXmlNode& parent) {
+        auto node = parent.FirstChild();
+        while (node) {
+            const auto runEnd = findRun(node);
+            if (runEnd.second >= minRunLength) {
+                writeRun(node->ToElement(), runEnd.second);
+                node = runEnd.first;
+            } else {
+                writeNode(*node);
+                node = node->NextSibling();
+            }
+        }
+        writeTag(Tag::End);
+    }
+
+    // Writes the string table followed by the encoded nodes
+    void finish(std::ostream& stream) const {
+        std::string table;
+        putSize(table, strings_.size());
+        for (auto str : strings_) putRaw(table, *str);
+        stream.write(table.data(), static_cast<std::streamsize>(table.size()));
+        stream.write(out_.data(), static_cast<std::streamsize>(out_.size()));
+    }
+
+private:
+    void writeNode(const TiXmlNode& node) {
+        switch (node.Type()) {
+            case TiXmlNode::ELEMENT: {
+                const auto& elem = *node.ToElement();
+                writeTag(Tag::Element);
+                writeString(elem.ValueStr());
+                putSize(out_, countAttributes(elem));
+                for (auto attr = elem.FirstAttribute(); attr; attr = attr->Next()) {
+                    writeString(attr->NameTStr());
+                    writeValue(attr->ValueStr());
+                }
+                if (!elem.FirstChild()) {
+                    putSize(out_, 0);
+                } else {
+                    // prefix the content with its size so that readers can skip it
+                    const auto begin = out_.size();
+                    writeChildren(elem);
+                    std::string size;
+                    putSize(size, out_.size() - begin);
+                    out_.insert(begin, size);
+                }
+                break;
+            }
+            case TiXmlNode::TEXT:
+                writeTag(Tag::Text);
+                writeString(node.ValueStr());
+                break;
+            case TiXmlNode::COMMENT:
+                writeTag(Tag::Comment);
+                writeString(node.ValueStr());
+                break;
+            case TiXmlNode::DECLARATION: {
+                const auto& decl = *node.ToDeclaration();
+                writeTag(Tag::Declaration);
+                writeString(decl.Version());
+                writeString(decl.Encoding());
+                writeString(decl.Standalone());
+                break;
+            }
+            default:
+                throw SerializationException("Unsupported xml node in binary encoding",
+                                             IVW_CONTEXT_CUSTOM("binaryxml::write"));
+        }
+    }
+
+    static size_t countAttributes(const TiXmlElement& elem) {
+        size_t count = 0;
+        for (auto attr = elem.FirstAttribute(); attr; attr = attr->Next()) ++count;
+        return count;
+    }
+
+    static bool isLeaf(const TiXmlNode* node) {
+        return node && node->Type() == TiXmlNode::ELEMENT && !node->FirstChild() &&
+               node->ToElement()->FirstAttribute();
+    }
+
+    static bool sameLayout(const TiXmlElement& a, const TiXmlElement& b) {
+        if (a.ValueStr() != b.ValueStr()) return false;
+        auto aa = a.FirstAttribute();
+        auto ba = b.FirstAttribute();
+        while (aa && ba) {
+            if (aa->NameTStr() != ba->NameTStr()) return false;
+            aa = aa->Next();
+            ba = ba->Next();
+        }
+        return !aa && !ba;
+    }
+
+    // returns the node after the run of equal leaf elements starting at node, and its length
+    static std::pair<const TiXmlNode*, size_t> findRun(const TiXmlNode* node) {
+        if (!isLeaf(node)) return {node, 0};
+        const auto& first = *node->ToElement();
+        size_t count = 1;
+        auto next = node->NextSibling();
+        while (isLeaf(next) && sameLayout(first, *next->ToElement())) {
+            ++count;
+            next = next->NextSibling();
+        }
+        return {next, count};
+    }
+
+    // Writes the values of each attribute as one contiguous array, typed if all values allow it
+    void writeRun(const TiXmlElement* first, size_t count) {
+        writeTag(Tag::Run);
+        writeString(first->ValueStr());
+        putSize(out_, count);
+        putSize(out_, countAttributes(*first));
+
+        std::vector<const TiXmlAttribute*> attrs;
+        for (auto elem = first; attrs.size() < count; elem = elem->NextSiblingElement()) {
+            attrs.push_back(elem->FirstAttribute());
+        }
+        std::vector<const std::string*> column(count);
+        while (attrs.front()) {
+            writeString(attrs.front()->NameTStr());
+            for (size_t i = 0; i < count; ++i) {
+                column[i] = &attrs[i]->ValueStr();
+                attrs[i] = attrs[i]->Next();
+            }
+            writeColumn(column);
+        }
+    }
+
+    void writeColumn(const std::vector<const std::string*>& column) {
+        const auto all = [&](auto pred) {
+            return std::all_of(column.begin(), column.end(), [&](auto str) { return pred(*str); });
+        };
+        if (all(isKind<int64_t>)) {
+            out_.push_back(static_cast<char>(Kind::Int));
+            for (auto str : column) putSize(out_, zigzag(*asNumber<int64_t>(*str)));
+        } else if (all(isKind<float>)) {
+            out_.push_back(static_cast<char>(Kind::Float));
+            for (auto str : column) putFixed(out_, *asNumber<float>(*str));
+        } else if (all(isKind<double>)) {
+            out_.push_back(static_cast<char>(Kind::Double));
+            for (auto str : column) putFixed(out_, *asNumber<double>(*str));
+        } else {
+            // The values of a run are mostly unique, write them inline instead of interning
+            out_.push_back(static_cast<char>(Kind::String));
+            for (auto str : column) putRaw(out_, *str);
+        }
+    }
+
+    void writeValue(const std::string& str) {
+        if (isKind<int64_t>(str)) {
+            putSize(out_, zigzag(*asNumber<int64_t>(str)) << 2 | static_cast<uint64_t>(Kind::Int));
+        } else if (auto f = asNumber<float>(str)) {
+            putSize(out_, static_cast<uint64_t>(Kind::Float));
+            putFixed(out_, *f);
+        } else if (auto d = asNumber<double>(str)) {
+            putSize(out_, static_cast<uint64_t>(Kind::Double));
+            putFixed(out_, *d);
+        } else {
+            putSize(out_, intern(str) << 2 | static_cast<uint64_t>(Kind::String));
+        }
+    }
+
+    void writeTag(Tag tag) { out_.push_back(static_cast<char>(tag)); }
+
+    void writeString(const std::string& str) { putSize(out_, intern(str)); }
+
+    uint64_t intern(const std::string& str) {
+        auto [it, added] = index_.try_emplace(str, strings_.size());
+        if (added) strings_.push_back(&it->first);
+        return it->second;
+    }
+
+    std::string out_;
+    std::unordered_map<std::string, uint64_t> index_;
+    // keys of index_ in order of first use, node based map keys are stable
+    std::vector<const std::string*> strings_;
+};
+
+// Visits the document node and writes its content, TiXmlDocument is not otherwise accessible
+// through the ticpp wrapper.
+class DocumentVisitor : public TiXmlVisitor {
+public:
+    explicit DocumentVisitor(Writer& writer) : writer_{writer} {}
+    virtual bool VisitEnter(const TiXmlDocument& doc) override {
+        writer_.writeChildren(doc);
+        return false;
+    }
+
+private:
+    Writer& writer_;
+};
+
+[[noreturn]] void error(std::string_view message) {
+    throw SerializationException(message, IVW_CONTEXT_CUSTOM("binaryxml::read"));
+}
+
+class Decoder {
+public:
+    Decoder(std::string_view data, size_t pos, const std::vector<std::string_view>& strings)
+        : data_{data}, pos_{pos}, strings_{strings} {}
+
+    // Elements at minDepth or deeper with content larger than minSize are added to deferred as
+    // placeholders instead of being decoded
+    void setDeferral(std::vector<LazyReader::Range>* deferred, size_t minDepth, size_t minSize) {
+        deferred_ = deferred;
+        minDepth_ = minDepth;
+        minSize_ = minSize;
+    }
+
+    // depth is the number of element ancestors of the children
+    void readChildren(TxNode& parent, size_t depth) {
+        for (auto tag = readTag(); tag != Tag::End; tag = readTag()) {
+            switch (tag) {
+                case Tag::Element:
+                    readElement(parent, depth);
+                    break;
+                case Tag::Text: {
+                    auto text = std::make_unique<ticpp::Text>(std::string{readString()});
+                    parent.LinkEndChild(text.get());
+                    break;
+                }
+                case Tag::Comment: {
+                    auto comment = std::make_unique<TxComment>(std::string{readString()});
+                    parent.LinkEndChild(comment.get());
+                    break;
+                }
+                case Tag::Declaration: {
+                    const auto ver = readString();
+                    const auto encoding = readString();
+                    const auto standalone = readString();
+                    auto decl = std::make_unique<TxDeclaration>(
+                        std::string{ver}, std::string{encoding}, std::string{standalone});
+                    parent.LinkEndChild(decl.get());
+                    break;
+                }
+                case Tag::Run:
+                    readRun(parent);
+                    break;
+                default:
+                    error("Invalid node tag");
+            }
+        }
+    }
+
+    size_t readSize() {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            const auto byte = static_cast<unsigned char>(readByte());
+            value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+            if (!(byte & 0x80)) return static_cast<size_t>(value);
+        }
+        error("Invalid size");
+    }
+
+    std::string_view readRaw() {
+        const auto size = readSize();
+        if (size > data_.size() - pos_) error("Unexpected end of data");
+        const auto str = data_.substr(pos_, size);
+        pos_ += size;
+        return str;
+    }
+
+    size_t pos() const { return pos_; }
+
+private:
+    void readElement(TxNode& parent, size_t depth) {
+        if (depth >= maxDepth) error("Elements are nested too deep");
+
+        auto elem = std::make_unique<TxElement>(std::string{readString()});
+        parent.LinkEndChild(elem.get());
+        const auto attributes = readSize();
+        for (size_t i = 0; i < attributes; ++i) {
+            const auto key = readString();
+            elem->SetAttribute(std::string{key}, readValue());
+        }
+
+        const auto size = readSize();
+        if (size == 0) return;
+        if (size > data_.size() - pos_) error("Unexpected end of data");
+        const auto end = pos_ + size;
+        if (deferred_ && depth >= minDepth_ && size >= minSize_) {
+            elem->SetAttribute(std::string{LazyXml::marker}, std::to_string(deferred_->size()));
+            deferred_->push_back({pos_, end, depth + 1});
+            pos_ = end;
+        } else {
+            readChildren(*elem, depth + 1);
+            if (pos_ != end) error("Invalid element size");
+        }
+    }
+
+    void readRun(TxNode& parent) {
+        const auto name = std::string{readString()};
+        const auto count = readSize();
+        const auto attributes = readSize();
+        // every value takes at least one byte
+        if (attributes == 0 || count > (data_.size() - pos_) / attributes) error("Invalid run");
+
+        std::vector<std::string> keys;
+        std::vector<std::vector<std::string>> columns(attributes);
+        for (auto& column : columns) {
+            keys.emplace_back(readString());
+            column.reserve(count);
+            const auto kind = static_cast<Kind>(readByte());
+            for (size_t i = 0; i < count; ++i) column.push_back(readValue(kind));
+        }
+
+        for (size_t i = 0; i < count; ++i) {
+            auto elem = std::make_unique<TxElement>(name);
+            parent.LinkEndChild(elem.get());
+            for (size_t j = 0; j < attributes; ++j) {
+                elem->SetAttribute(keys[j], columns[j][i]);
+            }
+        }
+    }
+
+    std::string readValue() {
+        const auto value = readSize();
+        const auto kind = static_cast<Kind>(value & 3);
+        switch (kind) {
+            case Kind::String:
+                return std::string{string(value >> 2)};
+            case Kind::Int:
+                return detail::toStr(unzigzag(value >> 2));
+            default:
+                return readValue(kind);
+        }
+    }
+
+    std::string readValue(Kind kind) {
+        switch (kind) {
+            case Kind::String:
+                return std::string{readRaw()};
+            case Kind::Int:
+                return detail::toStr(unzigzag(readSize()));
+            case Kind::Float:
+                return detail::toStr(readFixed<float>());
+            case Kind::Double:
+                return detail::toStr(readFixed<double>());
+            default:
+                error("Invalid value kind");
+        }
+    }
+
+    template <typename T>
+    T readFixed() {
+        using Bits = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+        if (sizeof(T) > data_.size() - pos_) error("Unexpected end of data");
+        Bits bits = 0;
+        for (size_t i = 0; i < sizeof(T); ++i) {
+            bits |= static_cast<Bits>(static_cast<unsigned char>(data_[pos_ + i])) << (8 * i);
+        }
+        pos_ += sizeof(T);
+        T value;
+        std::memcpy(&value, &bits, sizeof(T));
+        return value;
+    }
+
+    char readByte() {
+        if (pos_ >= data_.size()) error("Unexpected end of data");
+        return data_[pos_++];
+    }
+
+    Tag readTag() { return static_cast<Tag>(readByte()); }
+
+    std::string_view string(size_t index) const {
+        if (index >= strings_.size()) error("Invalid string index");
+        return strings_[index];
+    }
+
+    std::string_view readString() { return string(readSize()); }
+
+    std::string_view data_;
+    size_t pos_;
+    const std::vector<std::string_view>& strings_;
+    std::vector<LazyReader::Range>* deferred_ = nullptr;
+    size_t minDepth_ = 0;
+    size_t minSize_ = 0;
+};
+
+}  // namespace
+
+bool isBinary(std::istream& stream) {
+    return stream.peek() == static_cast<unsigned char>(magic[0]);
+}
+
+void write(const TxDocument& doc, std::ostream& stream) {
+    Writer writer;
+    DocumentVisitor visitor{writer};
+    doc.Accept(&visitor);
+
+    stream.write(magic.data(), magic.size());
+    stream.put(version);
+    writer.finish(stream);
+}
+
+void read(std::istream& stream, TxDocument& doc) {
+    std::string data{std::istreambuf_iterator<char>{stream}, std::istreambuf_iterator<char>{}};
+    LazyReader{std::move(data), doc, std::numeric_limits<size_t>::max()};
+}
+
+void fromXml(std::istream& xml, std::ostream& binary) {
+    TxDocument doc;
+    xml >> doc;
+    write(doc, binary);
+}
+
+void toXml(std::istream& binary, std::ostream& xml) {
+    TxDocument doc;
+    read(binary, doc);
+    TiXmlPrinter printer;
+    printer.SetIndent("    ");
+    doc.Accept(&printer);
+    xml << printer.Str();
+}
+
+LazyReader::LazyReader(std::string data, TxDocument& doc, size_t minDepth, size_t minSize)
+    : data_{std::move(data)}, minDepth_{minDepth}, minSize_{minSize} {
+
+    const auto header = std::string_view{data_}.substr(0, magic.size() + 1);
+    if (header.substr(0, magic.size()) != magic || header.size() != magic.size() + 1) {
+        error("Not a binary xml stream");
+    }
+    if (header.back() != version) error("Unsupported binary xml version");
+
+    Decoder decoder{data_, header.size(), strings_};
+    const auto count = decoder.readSize();
+    // every string takes at least one byte
+    if (count > data_.size()) error("Invalid string table");
+    strings_.reserve(count);
+    for (size_t i = 0; i < count; ++i) strings_.push_back(decoder.readRaw());
+
+    decoder.setDeferral(&deferred_, minDepth_, minSize_);
+    decoder.readChildren(doc, 0);
+    remaining_ = deferred_.size();
+
+    if (remaining_ == 0) {
+        data_.clear();
+        data_.shrink_to_fit();
+    }
+}
+
+void LazyReader::materialize(TxElement& node) {
+    if (remaining_ == 0) return;
+
+    size_t index = deferred_.size();
+    node.GetAttribute(std::string{LazyXml::marker}, &index, false);
+    if (index >= deferred_.size()) return;
+
+    node.RemoveAttribute(std::string{LazyXml::marker});
+    const auto range = deferred_[index];
+    Decoder decoder{data_, range.begin, strings_};
+    decoder.readChildren(node, range.depth);
+    if (decoder.pos() != range.end) error("Invalid element size");
+
+    if (--remaining_ == 0) {
+        strings_.clear();
+        data_.clear();
+        data_.shrink_to_fit();
+    }
+}
+
+void LazyReader::materializeAll(TxElement& node) {
+    if (remaining_ == 0) return;
+
+    // Placeholders are materialized completely, there is no need to look below them
+    const std::string marker{LazyXml::marker};
+    const auto visit = [&](auto& self, TxElement& elem) -> void {
+        if (elem.HasAttribute(marker)) {
+            materialize(elem);
+            return;
+        }
+        for (auto child = elem.FirstChildElement(false); child;
+             child = child->NextSiblingElement(false)) {
+            self(self, *child);
+        }
+    };
+    visit(visit, node);
+}
+
+size_t LazyReader::getDeferred() const { return remaining_; }
+
+}  // namespace binaryxml
+
+}  // namespace inviwo
@@ -29,6 +29,7 @@
 
 #include <inviwo/core/io/serialization/deserializer.h>
 #include <inviwo/core/io/serialization/serializable.h>
+#include <inviwo/core/io/serialization/lazyxml.h>
 #include <inviwo/core/io/serialization/versionconverter.h>
 #include <inviwo/core/common/inviwoapplication.h>
 #include <inviwo/core/processors/processorfactory.h>
@@ -39,6 +40,7 @@
 #include <inviwo/core/util/exception.h>
 #include <inviwo/core/util/stringconversion.h>
 #include <inviwo/core/util/safecstr.h>
+#include <inviwo/core/util/filesystem.h>
 
 #include <inviwo/core/io/serialization/ticpp.h>
 
@@ -46,7 +48,12 @@ namespace inviwo {
 
 Deserializer::Deserializer(std::string_view fileName) : SerializeBase(fileName) {
     try {
-        doc_->LoadFile();
+        auto stream = filesystem::ifstream(getFileName(), std::ios::in | std::ios::binary);
+        if (stream.is_open()) {
+            read(stream);
+        } else {
+            doc_->LoadFile();
+        }
         rootElement_ = doc_->FirstChildElement();
         rootElement_->GetAttribute(std::string{SerializeConstants::VersionAttribute},
                                    &inviwoWorkspaceVersion_, false);
@@ -90,7 +97,11 @@ void Deserializer::deserialize(std::string_view key, unsigned char& data,
 
 void Deserializer::setExceptionHandler(ExceptionHandler handler) { exceptionHandler_ = handler; }
 
-void Deserializer::convertVersion(VersionConverter* converter) { converter->convert(rootElement_); }
+void Deserializer::convertVersion(VersionConverter* converter) {
+    // converters can touch any node below the current one
+    materializeAll(rootElement_);
+    converter->convert(rootElement_);
+}
 
 void Deserializer::handleError(const ExceptionContext& context) {
     if (exceptionHandler_) {
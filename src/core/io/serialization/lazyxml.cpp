@@ -0,0 +1,207 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/io/serialization/lazyxml.h>
+#include <inviwo/core/io/serialization/ticpp.h>
+
+namespace inviwo {
+
+namespace {
+
+struct ElementExtent {
+    size_t contentBegin;
+    size_t contentEnd;
+    size_t end;
+    size_t depth;
+};
+
+// Finds the content range of every non-empty element, in document order. Returns an empty list
+// if the source is not well formed.
+std::vector<ElementExtent> scan(std::string_view src) {
+    std::vector<ElementExtent> elements;
+    std::vector<size_t> open;
+
+    const auto skipPast = [&](size_t pos, std::string_view end) {
+        const auto found = src.find(end, pos);
+        return found == std::string_view::npos ? found : found + end.size();
+    };
+
+    size_t pos = src.find('<');
+    while (pos != std::string_view::npos) {
+        const auto rest = src.substr(pos);
+        if (rest.substr(0, 4) == "<!--") {
+            pos = skipPast(pos + 4, "-->");
+        } else if (rest.substr(0, 9) == "<![CDATA[") {
+            pos = skipPast(pos + 9, "]]>");
+        } else if (rest.substr(0, 2) == "<?") {
+            pos = skipPast(pos + 2, "?>");
+        } else if (rest.substr(0, 2) == "<!") {
+            pos = skipPast(pos + 2, ">");
+        } else if (rest.substr(0, 2) == "</") {
+            if (open.empty()) return {};
+            const auto gt = src.find('>', pos);
+            if (gt == std::string_view::npos) return {};
+            auto& elem = elements[open.back()];
+            elem.contentEnd = pos;
+            elem.end = gt + 1;
+            open.pop_back();
+            pos = gt + 1;
+        } else {
+            // start tag, attribute values may contain '>'
+            char quote = 0;
+            auto i = pos + 1;
+            for (; i < src.size(); ++i) {
+                const auto c = src[i];
+                if (quote) {
+                    if (c == quote) quote = 0;
+                } else if (c == '"' || c == '\'') {
+                    quote = c;
+                } else if (c == '>') {
+                    break;
+                }
+            }
+            if (i == src.size()) return {};
+            if (src[i - 1] != '/') {
+                open.push_back(elements.size());
+                elements.push_back({i + 1, 0, 0, open.size() - 1});
+            }
+            pos = i + 1;
+        }
+        if (pos != std::string_view::npos) pos = src.find('<', pos);
+    }
+    if (!open.empty()) return {};
+    return elements;
+}
+
+// Counts the element ancestors of an element. Walks the TinyXML nodes directly, asking ticpp for
+// the parent of the root element creates a second wrapper of the document, which then leaks.
+class DepthVisitor : public TiXmlVisitor {
+public:
+    virtual bool VisitEnter(const TiXmlElement& elem, const TiXmlAttribute*) override {
+        for (auto parent = elem.Parent(); parent && parent->Type() == TiXmlNode::ELEMENT;
+             parent = parent->Parent()) {
+            ++depth;
+        }
+        return false;
+    }
+    size_t depth = 0;
+};
+
+size_t depthOf(const TxElement& node) {
+    DepthVisitor visitor;
+    node.Accept(&visitor);
+    return visitor.depth;
+}
+
+}  // namespace
+
+LazyXml::LazyXml(std::string source, TxDocument& doc, size_t minDepth, size_t minSize)
+    : minDepth_{minDepth} {
+
+    const auto elements = scan(source);
+    if (elements.empty()) {
+        doc.Parse(source);
+        return;
+    }
+
+    std::string skeleton;
+    skeleton.reserve(source.size() / 4);
+    size_t pos = 0;
+    for (const auto& elem : elements) {
+        if (elem.contentBegin < pos || elem.depth < minDepth ||
+            elem.contentEnd - elem.contentBegin < minSize) {
+            continue;
+        }
+        // copy up to the end of the start tag and add the marker attribute
+        skeleton.append(source, pos, elem.contentBegin - 1 - pos);
+        skeleton.append(" ");
+        skeleton.append(marker);
+        skeleton.append("=\"");
+        skeleton.append(std::to_string(deferred_.size()));
+        skeleton.append("\">");
+        skeleton.append(source, elem.contentEnd, elem.end - elem.contentEnd);
+        deferred_.push_back(source.substr(elem.contentBegin, elem.contentEnd - elem.contentBegin));
+        pos = elem.end;
+    }
+    skeleton.append(source, pos, std::string::npos);
+    remaining_ = deferred_.size();
+
+    // only the deferred content is kept
+    source = std::string{};
+    doc.Parse(skeleton);
+}
+
+void LazyXml::materialize(TxElement& node) {
+    if (remaining_ == 0) return;
+
+    size_t index = deferred_.size();
+    node.GetAttribute(std::string{marker}, &index, false);
+    if (index >= deferred_.size()) return;
+
+    auto& content = deferred_[index];
+    const auto name = node.Value();
+    TxDocument fragment;
+    fragment.Parse("<" + name + ">" + content + "</" + name + ">");
+    std::string{}.swap(content);
+
+    node.RemoveAttribute(std::string{marker});
+    ticpp::Iterator<ticpp::Node> child;
+    for (child = child.begin(fragment.FirstChildElement()); child != child.end(); ++child) {
+        node.InsertEndChild(*child);
+    }
+
+    if (--remaining_ == 0) deferred_.clear();
+}
+
+void LazyXml::materializeAll(TxElement& node) {
+    if (remaining_ == 0) return;
+
+    // Elements deeper than minDepth are either placeholders or complete
+    const auto visit = [&](auto& self, TxElement& elem, size_t depth) -> void {
+        if (depth >= minDepth_) {
+            materialize(elem);
+            return;
+        }
+        for (auto child = elem.FirstChildElement(false); child;
+             child = child->NextSiblingElement(false)) {
+            self(self, *child, depth + 1);
+        }
+    };
+    visit(visit, node, depthOf(node));
+}
+
+size_t LazyXml::getDeferred() const { return remaining_; }
+
+size_t LazyXml::getDeferredBytes() const {
+    size_t bytes = 0;
+    for (const auto& content : deferred_) bytes += content.size();
+    return bytes;
+}
+
+}  // namespace inviwo
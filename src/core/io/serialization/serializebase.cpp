@@ -28,8 +28,12 @@
  *********************************************************************************/
 
 #include <inviwo/core/io/serialization/serializebase.h>
+#include <inviwo/core/io/serialization/binaryxml.h>
+#include <inviwo/core/io/serialization/lazyxml.h>
 #include <inviwo/core/io/serialization/ticpp.h>
 
+#include <iterator>
+
 namespace inviwo {
 
 SerializeBase::SerializeBase()
@@ -46,7 +50,7 @@ SerializeBase::SerializeBase(std::istream& stream, std::string_view path)
     , doc_{std::make_unique<TxDocument>()}
     , rootElement_{nullptr}
     , retrieveChild_{true} {
-    stream >> *doc_;
+    read(stream);
 }
 
 SerializeBase::~SerializeBase() = default;
@@ -55,6 +59,28 @@ SerializeBase& SerializeBase::operator=(SerializeBase&&) noexcept = default;
 
 const std::string& SerializeBase::getFileName() const { return fileName_; }
 
+void SerializeBase::read(std::istream& stream) {
+    const bool binary = binaryxml::isBinary(stream);
+    std::string source{std::istreambuf_iterator<char>{stream}, std::istreambuf_iterator<char>{}};
+    if (binary) {
+        lazyBinary_ = std::make_unique<binaryxml::LazyReader>(std::move(source), *doc_);
+    } else {
+        lazy_ = std::make_unique<LazyXml>(std::move(source), *doc_);
+    }
+}
+
+void SerializeBase::materialize(TxElement* node) {
+    if (!node) return;
+    if (lazy_) lazy_->materialize(*node);
+    if (lazyBinary_) lazyBinary_->materialize(*node);
+}
+
+void SerializeBase::materializeAll(TxElement* node) {
+    if (!node) return;
+    if (lazy_) lazy_->materializeAll(*node);
+    if (lazyBinary_) lazyBinary_->materializeAll(*node);
+}
+
 std::string SerializeBase::nodeToString(const TxElement& node) {
     try {
         TiXmlPrinter printer;
@@ -98,6 +124,7 @@ NodeSwitch::NodeSwitch(SerializeBase& serializer, TxElement* node, bool retrieve
 
     serializer_->rootElement_ = node;
     serializer_->retrieveChild_ = retrieveChild;
+    serializer_->materialize(node);
 }
 
 NodeSwitch::NodeSwitch(SerializeBase& serializer, std::unique_ptr<TxElement> node,
@@ -121,6 +148,7 @@ NodeSwitch::NodeSwitch(SerializeBase& serializer, std::string_view key, bool ret
             : serializer_->rootElement_;
 
     serializer_->retrieveChild_ = retrieveChild;
+    serializer_->materialize(serializer_->rootElement_);
 }
 
 NodeSwitch::~NodeSwitch() {
@@ -33,6 +33,7 @@
 #include <inviwo/core/properties/propertyconverter.h>
 #include <inviwo/core/util/raiiutils.h>
 #include <inviwo/core/util/stdextensions.h>
+#include <inviwo/core/util/tracing.h>
 #include <inviwo/core/properties/property.h>
 #include <inviwo/core/processors/processor.h>
 #include <inviwo/core/network/processornetwork.h>
@@ -196,6 +197,7 @@ void LinkEvaluator::evaluateLinksFromProperty(Property* modifiedProperty) {
     auto& links = getTriggerdLinksForProperty(modifiedProperty);
     VisitedHelper helper(visited_, links);
 
+    IVW_TRACE_SCOPE("links", modifiedProperty->getIdentifier());
     for (auto& link : links) {
         link.converter_->convert(link.src_, link.dst_);
     }
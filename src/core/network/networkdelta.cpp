@@ -0,0 +1,310 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/network/networkdelta.h>
+
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/io/serialization/serialization.h>
+#include <inviwo/core/links/propertylink.h>
+#include <inviwo/core/network/networkedge.h>
+#include <inviwo/core/network/networklock.h>
+#include <inviwo/core/network/portconnection.h>
+#include <inviwo/core/network/processornetwork.h>
+#include <inviwo/core/network/workspacemanager.h>
+#include <inviwo/core/processors/processor.h>
+#include <inviwo/core/properties/property.h>
+#include <inviwo/core/properties/propertyowner.h>
+#include <inviwo/core/util/logcentral.h>
+#include <inviwo/core/util/rendercontext.h>
+
+#include <algorithm>
+#include <iterator>
+#include <sstream>
+#include <string_view>
+
+namespace inviwo {
+
+namespace {
+
+std::set<NetworkSnapshot::Edge> getEdges(const ProcessorNetwork& network, bool links) {
+    std::set<NetworkSnapshot::Edge> edges;
+    if (links) {
+        for (const auto& link : network.getLinks()) {
+            NetworkEdge edge{link};
+            edges.emplace(std::move(edge.srcPath), std::move(edge.dstPath));
+        }
+    } else {
+        for (const auto& connection : network.getConnections()) {
+            NetworkEdge edge{connection};
+            edges.emplace(std::move(edge.srcPath), std::move(edge.dstPath));
+        }
+    }
+    return edges;
+}
+
+std::vector<NetworkSnapshot::Edge> difference(const std::set<NetworkSnapshot::Edge>& a,
+                                              const std::set<NetworkSnapshot::Edge>& b) {
+    std::vector<NetworkSnapshot::Edge> res;
+    std::set_difference(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(res));
+    return res;
+}
+
+template <typename Func>
+void forEachEdge(const std::vector<NetworkSnapshot::Edge>& edges, Func func) {
+    for (const auto& edge : edges) {
+        try {
+            func(NetworkEdge{edge.first, edge.second});
+        } catch (const Exception& e) {
+            util::log(e.getContext(), e.getMessage(), LogLevel::Warn);
+        }
+    }
+}
+
+/**
+ * The identifiers of the serialized properties of a PropertyOwner and their children
+ */
+struct SerializedProperties : Serializable {
+    std::string identifier;
+    std::vector<SerializedProperties> properties;
+
+    virtual void serialize(Serializer&) const override {}
+    virtual void deserialize(Deserializer& d) override {
+        d.deserialize("identifier", identifier, SerializationTarget::Attribute);
+        d.deserialize("Properties", properties, "Property");
+    }
+};
+
+/**
+ * Properties in their default state are not serialized, and hence not touched when deserializing
+ * into an existing owner. Reset those that are missing from the serialized state but that have
+ * been modified in the live owner.
+ */
+void resetMissing(PropertyOwner& owner, const std::vector<SerializedProperties>& serialized) {
+    for (auto property : owner.getProperties()) {
+        auto it = std::find_if(serialized.begin(), serialized.end(), [&](const auto& item) {
+            return item.identifier == property->getIdentifier();
+        });
+        if (it == serialized.end()) {
+            if (property->getSerializationMode() == PropertySerializationMode::Default &&
+                !property->isDefaultState()) {
+                property->resetToDefaultState();
+            }
+        } else if (auto composite = dynamic_cast<PropertyOwner*>(property)) {
+            resetMissing(*composite, it->properties);
+        }
+    }
+}
+
+}  // namespace
+
+NetworkSnapshot::NetworkSnapshot(const ProcessorNetwork& network, const std::string& refPath)
+    : NetworkSnapshot(network, refPath, NetworkSnapshot{},
+                      [](const Processor&) { return true; }) {}
+
+NetworkSnapshot::NetworkSnapshot(const ProcessorNetwork& network, const std::string& refPath,
+                                 const NetworkSnapshot& previous,
+                                 const std::function<bool(const Processor&)>& isDirty)
+    : connections_{getEdges(network, false)}, links_{getEdges(network, true)} {
+
+    for (auto processor : network.getProcessors()) {
+        const auto& id = processor->getIdentifier();
+        auto it = previous.processors_.find(id);
+        if (it == previous.processors_.end()) {
+            processors_.emplace(id, serialize(*processor, refPath));
+        } else if (isDirty(*processor)) {
+            auto state = serialize(*processor, refPath);
+            processors_.emplace(id, *state == *it->second ? it->second : state);
+        } else {
+            processors_.emplace(id, it->second);
+        }
+    }
+}
+
+auto NetworkSnapshot::getProcessors() const -> const Processors& { return processors_; }
+
+auto NetworkSnapshot::getConnections() const -> const std::set<Edge>& { return connections_; }
+
+auto NetworkSnapshot::getLinks() const -> const std::set<Edge>& { return links_; }
+
+std::shared_ptr<const std::string> NetworkSnapshot::serialize(const Processor& processor,
+                                                              const std::string& refPath) {
+    Serializer serializer(refPath);
+    serializer.serialize("Processor", processor);
+    std::stringstream stream;
+    serializer.writeFile(stream);
+    return std::make_shared<const std::string>(std::move(stream).str());
+}
+
+NetworkDelta::NetworkDelta(const NetworkSnapshot& before, const NetworkSnapshot& after,
+                           const Renames& renames) {
+    const auto& bp = before.processors_;
+    const auto& ap = after.processors_;
+
+    std::set<std::string_view> renamedBefore;
+    std::set<std::string_view> renamedAfter;
+    for (const auto& [from, to] : renames) {
+        auto bit = bp.find(from);
+        auto ait = ap.find(to);
+        if (from == to || bit == bp.end() || ait == ap.end() || bp.count(to) != 0 ||
+            ap.count(from) != 0 || renamedBefore.count(from) != 0 || renamedAfter.count(to) != 0) {
+            continue;
+        }
+        renamedBefore.insert(bit->first);
+        renamedAfter.insert(ait->first);
+        processors_.push_back({ait->first, bit->first, bit->second, ait->second});
+    }
+
+    auto bit = bp.begin();
+    auto ait = ap.begin();
+    while (bit != bp.end() || ait != ap.end()) {
+        if (bit != bp.end() && renamedBefore.count(bit->first) != 0) {
+            ++bit;
+        } else if (ait != ap.end() && renamedAfter.count(ait->first) != 0) {
+            ++ait;
+        } else if (ait == ap.end() || (bit != bp.end() && bit->first < ait->first)) {
+            processors_.push_back({bit->first, {}, bit->second, nullptr});
+            ++bit;
+        } else if (bit == bp.end() || ait->first < bit->first) {
+            processors_.push_back({ait->first, {}, nullptr, ait->second});
+            ++ait;
+        } else {
+            // Unchanged processors share the same string, only compare content if they do not
+            if (bit->second != ait->second && *bit->second != *ait->second) {
+                processors_.push_back({bit->first, {}, bit->second, ait->second});
+            }
+            ++bit;
+            ++ait;
+        }
+    }
+
+    edges_.removedConnections = difference(before.connections_, after.connections_);
+    edges_.addedConnections = difference(after.connections_, before.connections_);
+    edges_.removedLinks = difference(before.links_, after.links_);
+    edges_.addedLinks = difference(after.links_, before.links_);
+}
+
+bool NetworkDelta::empty() const { return processors_.empty() && getChangedEdges() == 0; }
+
+void NetworkDelta::undo(ProcessorNetwork& network, NetworkSnapshot& snapshot,
+                        const std::string& refPath) const {
+    apply(network, snapshot, refPath, false);
+}
+
+void NetworkDelta::redo(ProcessorNetwork& network, NetworkSnapshot& snapshot,
+                        const std::string& refPath) const {
+    apply(network, snapshot, refPath, true);
+}
+
+std::vector<std::string> NetworkDelta::getProcessors() const {
+    std::vector<std::string> ids;
+    std::transform(processors_.begin(), processors_.end(), std::back_inserter(ids),
+                   [](const ProcessorChange& change) { return change.identifier; });
+    return ids;
+}
+
+size_t NetworkDelta::getChangedEdges() const {
+    return edges_.removedConnections.size() + edges_.addedConnections.size() +
+           edges_.removedLinks.size() + edges_.addedLinks.size();
+}
+
+void NetworkDelta::apply(ProcessorNetwork& network, NetworkSnapshot& snapshot,
+                         const std::string& refPath, bool forward) const {
+    NetworkLock lock(&network);
+
+    const auto& removedLinks = forward ? edges_.removedLinks : edges_.addedLinks;
+    const auto& addedLinks = forward ? edges_.addedLinks : edges_.removedLinks;
+    const auto& removedConnections =
+        forward ? edges_.removedConnections : edges_.addedConnections;
+    const auto& addedConnections = forward ? edges_.addedConnections : edges_.removedConnections;
+
+    // Remove links and connections first, they might refer to processors that are removed below
+    forEachEdge(removedLinks,
+                [&](const NetworkEdge& edge) { network.removeLink(edge.toLink(network)); });
+    forEachEdge(removedConnections, [&](const NetworkEdge& edge) {
+        network.removeConnection(edge.toConnection(network));
+    });
+
+    for (const auto& change : processors_) {
+        if (forward ? change.after : change.before) continue;
+        if (auto processor = network.getProcessorByIdentifier(change.identifier)) {
+            network.removeAndDeleteProcessor(processor);
+        }
+        snapshot.processors_.erase(change.identifier);
+    }
+
+    auto app = network.getApplication();
+    for (const auto& change : processors_) {
+        const auto& state = forward ? change.after : change.before;
+        if (!state) continue;
+
+        const auto& beforeId =
+            change.previousIdentifier.empty() ? change.identifier : change.previousIdentifier;
+        const auto& currentId = forward ? beforeId : change.identifier;
+        const auto& targetId = forward ? change.identifier : beforeId;
+
+        try {
+            rendercontext::activateDefault();
+            std::stringstream stream{*state};
+            auto deserializer =
+                app->getWorkspaceManager()->createWorkspaceDeserializer(stream, refPath);
+
+            if (auto processor = network.getProcessorByIdentifier(currentId)) {
+                if (currentId != targetId) {
+                    processor->setIdentifier(targetId);
+                    snapshot.processors_.erase(currentId);
+                }
+                deserializer.deserialize("Processor", *processor);
+                SerializedProperties serialized;
+                deserializer.deserialize("Processor", serialized);
+                resetMissing(*processor, serialized.properties);
+            } else {
+                std::unique_ptr<Processor> created;
+                deserializer.deserialize("Processor", created);
+                if (created) network.addProcessor(std::move(created));
+            }
+        } catch (const Exception& e) {
+            util::log(e.getContext(), e.getMessage(), LogLevel::Error);
+        }
+        snapshot.processors_[targetId] = state;
+    }
+
+    forEachEdge(addedConnections, [&](const NetworkEdge& edge) {
+        network.addConnection(edge.toConnection(network));
+    });
+    forEachEdge(addedLinks,
+                [&](const NetworkEdge& edge) { network.addLink(edge.toLink(network)); });
+
+    // Keep the snapshot in sync with the state we restored
+    for (const auto& edge : removedLinks) snapshot.links_.erase(edge);
+    for (const auto& edge : removedConnections) snapshot.connections_.erase(edge);
+    snapshot.connections_.insert(addedConnections.begin(), addedConnections.end());
+    snapshot.links_.insert(addedLinks.begin(), addedLinks.end());
+}
+
+}  // namespace inviwo
@@ -28,13 +28,15 @@
  *********************************************************************************/
 
 #include <inviwo/core/network/processornetworkevaluator.h>
+#include <inviwo/core/datastructures/representationmemorymanager.h>
 #include <inviwo/core/network/processornetwork.h>
+#include <inviwo/core/common/inviwoapplication.h>
 #include <inviwo/core/processors/processor.h>
 #include <inviwo/core/util/raiiutils.h>
 #include <inviwo/core/util/stdextensions.h>
 #include <inviwo/core/network/networkutils.h>
 #include <inviwo/core/network/networklock.h>
-#include <inviwo/core/util/clock.h>
+#include <inviwo/core/util/tracing.h>
 
 namespace inviwo {
 
@@ -99,7 +101,7 @@ void ProcessorNetworkEvaluator::evaluate() {
 
     notifyObserversProcessorNetworkEvaluationBegin();
 
-    IVW_CPU_PROFILING_IF(500, "Evaluated Processor Network");
+    IVW_TRACE_SCOPE("network", "Evaluate Processor Network");
 
     for (auto processor : processorsSorted_) {
         if (!processor->isValid()) {
@@ -107,6 +109,8 @@ void ProcessorNetworkEvaluator::evaluate() {
                 try {
                     // re-initialize resources (e.g., shaders) if necessary
                     if (processor->getInvalidationLevel() >= InvalidationLevel::InvalidResources) {
+                        IVW_TRACE_SCOPE("processor.initializeResources",
+                                        processor->getIdentifier());
                         processor->initializeResources();
                     }
                 } catch (...) {
@@ -116,6 +120,7 @@ void ProcessorNetworkEvaluator::evaluate() {
 
                 try {
                     // call onChange for all invalid inports
+                    IVW_TRACE_SCOPE("inport.onChange", processor->getIdentifier());
                     for (auto inport : processor->getInports()) {
                         inport->callOnChangeIfChanged();
                     }
@@ -127,7 +132,7 @@ void ProcessorNetworkEvaluator::evaluate() {
                 processor->notifyObserversAboutToProcess(processor);
 
                 try {
-                    IVW_CPU_PROFILING_IF(500, "Processed " << processor->getIdentifier());
+                    IVW_TRACE_SCOPE("processor.process", processor->getIdentifier());
                     // do the actual processing
                     processor->process();
 
@@ -152,6 +157,14 @@ void ProcessorNetworkEvaluator::evaluate() {
         }
     }
 
+    // All processors are done with their representations, evict unused ones if over budget.
+    // Background jobs, e.g. of PoolProcessors, might still use raw pointers to representations,
+    // hence only evict when the pool is idle. Otherwise a later evaluation will do it.
+    if (processorNetwork_->runningBackgroundJobs() == 0 &&
+        processorNetwork_->getApplication()->getThreadPool().isIdle()) {
+        RepresentationMemoryManager::get().enforceBudget();
+    }
+
     notifyObserversProcessorNetworkEvaluationEnd();
 }
 
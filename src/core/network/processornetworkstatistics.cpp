@@ -0,0 +1,232 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+
+#include <inviwo/core/network/processornetworkstatistics.h>
+#include <inviwo/core/network/processornetwork.h>
+#include <inviwo/core/network/processornetworkevaluator.h>
+#include <inviwo/core/processors/processor.h>
+#include <inviwo/core/ports/outport.h>
+#include <inviwo/core/datastructures/representationconverter.h>
+#include <inviwo/core/util/filesystem.h>
+#include <inviwo/core/util/exception.h>
+#include <inviwo/core/util/stringconversion.h>
+
+#include <algorithm>
+#include <cmath>
+#include <ostream>
+
+namespace inviwo {
+
+namespace {
+
+struct CSVField {
+    const std::string& str;
+};
+
+std::ostream& operator<<(std::ostream& os, CSVField s) {
+    if (s.str.find_first_of(",\"\r\n") == std::string::npos) return os << s.str;
+    os << '"';
+    for (const char c : s.str) {
+        if (c == '"') os << '"';
+        os << c;
+    }
+    return os << '"';
+}
+
+}  // namespace
+
+ProcessorNetworkStatistics::ProcessorNetworkStatistics(ProcessorNetwork* network,
+                                                       ProcessorNetworkEvaluator* evaluator)
+    : network_{network}, evaluator_{evaluator} {}
+
+ProcessorNetworkStatistics::~ProcessorNetworkStatistics() = default;
+
+void ProcessorNetworkStatistics::setEnabled(bool enabled) {
+    if (enabled_ == enabled) return;
+    enabled_ = enabled;
+    if (enabled_) {
+        network_->addObserver(this);
+        evaluator_->addObserver(this);
+        network_->forEachProcessor(
+            [this](Processor* p) { p->ProcessorObservable::addObserver(this); });
+    } else {
+        ProcessorNetworkObserver::removeObservations();
+        ProcessorObserver::removeObservations();
+        ProcessorNetworkEvaluationObserver::removeObservations();
+    }
+}
+
+bool ProcessorNetworkStatistics::isEnabled() const { return enabled_; }
+
+auto ProcessorNetworkStatistics::getStatistics() const -> std::vector<ProcessorStatistics> {
+    std::vector<ProcessorStatistics> res{removed_};
+    for (const auto& item : entries_) {
+        if (item.second.stats.count > 0) res.push_back(summarize(item.second));
+    }
+    std::stable_sort(res.begin(), res.end(),
+                     [](const auto& a, const auto& b) { return a.total > b.total; });
+    return res;
+}
+
+auto ProcessorNetworkStatistics::getStatistics(const Processor* processor) const
+    -> std::optional<ProcessorStatistics> {
+    auto it = entries_.find(processor);
+    if (it == entries_.end() || it->second.stats.count == 0) return std::nullopt;
+    return summarize(it->second);
+}
+
+size_t ProcessorNetworkStatistics::getEvaluationCount() const { return evaluations_; }
+
+auto ProcessorNetworkStatistics::getEvaluationTime() const -> duration { return evaluationTime_; }
+
+void ProcessorNetworkStatistics::clear() {
+    entries_.clear();
+    removed_.clear();
+    evaluations_ = 0;
+    evaluationTime_ = duration{0};
+}
+
+void ProcessorNetworkStatistics::writeCSV(std::ostream& os) const {
+    os << "Identifier,Class Identifier,Count,Min (ms),Mean (ms),P95 (ms),Max (ms),Total (ms),"
+          "Conversion (ms),Bytes Produced,Total Bytes Produced\n";
+    for (const auto& s : getStatistics()) {
+        os << CSVField{s.identifier} << ',' << CSVField{s.classIdentifier} << ',' << s.count << ','
+           << s.min.count() << ',' << s.mean.count() << ',' << s.p95.count() << ','
+           << s.max.count() << ',' << s.total.count() << ',' << s.conversionTime.count() << ','
+           << s.bytesProduced << ',' << s.totalBytesProduced << '\n';
+    }
+}
+
+void ProcessorNetworkStatistics::writeJSON(std::ostream& os) const {
+    os << "{\n  \"evaluations\": " << evaluations_
+       << ",\n  \"evaluationTime\": " << evaluationTime_.count() << ",\n  \"processors\": [";
+    bool first = true;
+    for (const auto& s : getStatistics()) {
+        os << (first ? "\n" : ",\n");
+        first = false;
+        os << "    {\"identifier\": ";
+        util::writeJsonString(os, s.identifier);
+        os << ", \"classIdentifier\": ";
+        util::writeJsonString(os, s.classIdentifier);
+        os << ", \"count\": " << s.count << ", \"min\": " << s.min.count()
+           << ", \"mean\": " << s.mean.count() << ", \"p95\": " << s.p95.count()
+           << ", \"max\": " << s.max.count() << ", \"total\": " << s.total.count()
+           << ", \"conversionTime\": " << s.conversionTime.count()
+           << ", \"bytesProduced\": " << s.bytesProduced
+           << ", \"totalBytesProduced\": " << s.totalBytesProduced << "}";
+    }
+    os << "\n  ]\n}\n";
+}
+
+void ProcessorNetworkStatistics::save(const std::string& filename) const {
+    auto file = filesystem::ofstream(filename);
+    if (!file) {
+        throw Exception("Could not open file \"" + filename + "\" for writing", IVW_CONTEXT);
+    }
+    if (iCaseCmp(filesystem::getFileExtension(filename), "json")) {
+        writeJSON(file);
+    } else {
+        writeCSV(file);
+    }
+}
+
+void ProcessorNetworkStatistics::onProcessorNetworkDidAddProcessor(Processor* processor) {
+    processor->ProcessorObservable::addObserver(this);
+}
+
+void ProcessorNetworkStatistics::onProcessorNetworkWillRemoveProcessor(Processor* processor) {
+    processor->ProcessorObservable::removeObserver(this);
+    auto it = entries_.find(processor);
+    if (it != entries_.end()) {
+        if (it->second.stats.count > 0) removed_.push_back(summarize(it->second));
+        entries_.erase(it);
+    }
+}
+
+void ProcessorNetworkStatistics::onProcessorAboutToProcess(Processor* processor) {
+    auto& entry = entries_[processor];
+    entry.conversionStart = util::representationConversionTime();
+    entry.start = std::chrono::steady_clock::now();
+}
+
+void ProcessorNetworkStatistics::onProcessorFinishedProcess(Processor* processor) {
+    const auto end = std::chrono::steady_clock::now();
+    auto& entry = entries_[processor];
+    auto& stats = entry.stats;
+
+    const auto time = std::chrono::duration_cast<duration>(end - entry.start);
+    stats.min = stats.count == 0 ? time : std::min(stats.min, time);
+    stats.max = stats.count == 0 ? time : std::max(stats.max, time);
+    stats.total += time;
+    ++stats.count;
+    stats.conversionTime += std::chrono::duration_cast<duration>(
+        util::representationConversionTime() - entry.conversionStart);
+
+    if (entry.samples.size() < window) {
+        entry.samples.push_back(time.count());
+    } else {
+        entry.samples[entry.next] = time.count();
+    }
+    entry.next = (entry.next + 1) % window;
+
+    size_t bytes = 0;
+    for (auto outport : processor->getOutports()) {
+        bytes += outport->getDataSizeInBytes();
+    }
+    stats.bytesProduced = bytes;
+    stats.totalBytesProduced += bytes;
+
+    stats.identifier = processor->getIdentifier();
+    stats.classIdentifier = processor->getClassIdentifier();
+}
+
+void ProcessorNetworkStatistics::onProcessorNetworkEvaluationBegin() {
+    evaluationStart_ = std::chrono::steady_clock::now();
+}
+
+void ProcessorNetworkStatistics::onProcessorNetworkEvaluationEnd() {
+    ++evaluations_;
+    evaluationTime_ +=
+        std::chrono::duration_cast<duration>(std::chrono::steady_clock::now() - evaluationStart_);
+}
+
+auto ProcessorNetworkStatistics::summarize(const Entry& entry) -> ProcessorStatistics {
+    auto stats = entry.stats;
+    if (stats.count == 0) return stats;
+    stats.mean = stats.total / static_cast<double>(stats.count);
+
+    auto samples = entry.samples;
+    const auto rank = static_cast<size_t>(std::ceil(0.95 * samples.size())) - 1;
+    std::nth_element(samples.begin(), samples.begin() + rank, samples.end());
+    stats.p95 = duration{samples[rank]};
+    return stats;
+}
+
+}  // namespace inviwo
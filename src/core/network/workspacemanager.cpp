@@ -35,6 +35,8 @@
 #include <inviwo/core/util/inviwosetupinfo.h>
 #include <inviwo/core/util/rendercontext.h>
 #include <inviwo/core/util/filesystem.h>
+#include <inviwo/core/util/stringconversion.h>
+#include <inviwo/core/util/tracing.h>
 #include <inviwo/core/io/serialization/serialization.h>
 
 #include <fmt/format.h>
@@ -143,7 +145,9 @@ void WorkspaceManager::clear() {
 }
 
 void WorkspaceManager::save(std::ostream& stream, const std::string& refPath,
-                            const ExceptionHandler& exceptionHandler, WorkspaceSaveMode mode) {
+                            const ExceptionHandler& exceptionHandler, WorkspaceSaveMode mode,
+                            WorkspaceFormat format) {
+    IVW_TRACE_SCOPE("serialization", "Save Workspace");
     Serializer serializer(refPath);
 
     if (mode != WorkspaceSaveMode::Undo) {
@@ -152,11 +156,16 @@ void WorkspaceManager::save(std::ostream& stream, const std::string& refPath,
     }
 
     serializers_.invoke(serializer, exceptionHandler, mode);
-    serializer.writeFile(stream, true);
+    if (format == WorkspaceFormat::Binary) {
+        serializer.writeBinaryFile(stream);
+    } else {
+        serializer.writeFile(stream, true);
+    }
 }
 
 void WorkspaceManager::load(std::istream& stream, const std::string& refPath,
                             const ExceptionHandler& exceptionHandler) {
+    IVW_TRACE_SCOPE("serialization", "Load Workspace");
     RenderContext::getPtr()->activateDefaultRenderContext();
 
     auto deserializer = createWorkspaceDeserializer(stream, refPath);
@@ -171,16 +180,20 @@ void WorkspaceManager::load(std::istream& stream, const std::string& refPath,
 
 void WorkspaceManager::save(const std::string& path, const ExceptionHandler& exceptionHandler,
                             WorkspaceSaveMode mode) {
-    auto ostream = filesystem::ofstream(path);
+    const auto format = iCaseCmp(filesystem::getFileExtension(path), "invb")
+                            ? WorkspaceFormat::Binary
+                            : WorkspaceFormat::Xml;
+    auto ostream = filesystem::ofstream(
+        path, format == WorkspaceFormat::Binary ? std::ios::out | std::ios::binary : std::ios::out);
     if (ostream.is_open()) {
-        save(ostream, path, exceptionHandler, mode);
+        save(ostream, path, exceptionHandler, mode, format);
     } else {
         throw AbortException("Could not open workspace file: " + path, IVW_CONTEXT);
     }
 }
 
 void WorkspaceManager::load(const std::string& path, const ExceptionHandler& exceptionHandler) {
-    auto istream = filesystem::ifstream(path);
+    auto istream = filesystem::ifstream(path, std::ios::in | std::ios::binary);
     if (istream.is_open()) {
         load(istream, path, exceptionHandler);
     } else {
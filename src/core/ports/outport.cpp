@@ -47,6 +47,8 @@ Outport::~Outport() = default;
 
 bool Outport::isConnected() const { return !(connectedInports_.empty()); }
 
+size_t Outport::getDataSizeInBytes() const { return 0; }
+
 bool Outport::isReady() const { return isReady_; }
 
 bool Outport::isConnectedTo(const Inport* port) const {
@@ -42,6 +42,7 @@
 #include <inviwo/core/util/filedialog.h>
 #include <inviwo/core/util/dialogfactory.h>
 #include <inviwo/core/io/imagewriterutil.h>
+#include <inviwo/core/io/imageexportqueue.h>
 #include <inviwo/core/network/networklock.h>
 
 namespace inviwo {
@@ -274,7 +275,14 @@ void CanvasProcessor::saveImageLayer() {
 
     std::string snapshotPath(saveLayerDirectory_.get() + "/" + toLower(getIdentifier()) + "-" +
                              currentDateTime() + "." + imageTypeExt_->extension_);
-    saveImageLayer(snapshotPath, imageTypeExt_);
+    if (auto layer = getVisibleLayer()) {
+        if (!snapshotQueue_) snapshotQueue_ = std::make_unique<ImageExportQueue>(1, 4);
+        if (snapshotQueue_->enqueue(*layer, snapshotPath, imageTypeExt_)) {
+            LogInfo("Saving canvas layer to: " << snapshotPath);
+        }
+    } else {
+        LogError("Could not find visible layer");
+    }
 }
 
 void CanvasProcessor::saveImageLayer(std::string_view snapshotPath,
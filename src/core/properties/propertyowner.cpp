@@ -259,8 +259,12 @@ void PropertyOwner::serialize(Serializer& s) const {
 
 void PropertyOwner::deserialize(Deserializer& d) {
     // This is for finding renamed composites, and moving old properties to new composites.
-    NodeVersionConverter tvc(this, &PropertyOwner::findPropsForComposites);
-    d.convertVersion(&tvc);
+    // Without composites there is nothing to find, skip it since converting makes the
+    // Deserializer parse any deferred content below the node.
+    if (!compositeProperties_.empty()) {
+        NodeVersionConverter tvc(this, &PropertyOwner::findPropsForComposites);
+        d.convertVersion(&tvc);
+    }
 
     std::vector<std::string> ownedIdentifiers;
     d.deserialize("OwnedPropertyIdentifiers", ownedIdentifiers, "PropertyIdentifier");
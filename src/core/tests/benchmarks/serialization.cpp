@@ -0,0 +1,129 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include <inviwo/core/io/serialization/binaryxml.h>
+#include <inviwo/core/io/serialization/lazyxml.h>
+#include <inviwo/core/io/serialization/ticpp.h>
+
+#include <sstream>
+#include <string>
+
+namespace {
+
+using namespace inviwo;
+
+// A workspace like document with the given number of processors, each with a few properties and
+// a list of numbers, like a transfer function or a camera path
+std::string makeXml(int processors) {
+    std::ostringstream xml;
+    xml << "<?xml version=\"1.0\" ?>\n<InviwoWorkspace version=\"2\">\n<ProcessorNetwork>\n"
+        << "<Processors>\n";
+    for (int p = 0; p < processors; ++p) {
+        xml << "<Processor type=\"org.inviwo.Processor\" identifier=\"Processor" << p << "\">\n"
+            << "<Properties>\n";
+        for (int i = 0; i < 10; ++i) {
+            xml << "<Property type=\"org.inviwo.FloatProperty\" identifier=\"prop" << i << "\">\n"
+                << "<value content=\"" << 0.1 * (p + i) << "\" />\n"
+                << "<minvalue content=\"0\" />\n<maxvalue content=\"1\" />\n"
+                << "</Property>\n";
+        }
+        xml << "<Property type=\"org.inviwo.TransferFunctionProperty\" identifier=\"tf\">\n"
+            << "<Points>\n";
+        for (int i = 0; i < 100; ++i) {
+            xml << "<Point pos=\"" << i / 100.0 << "\" r=\"" << i * 0.0123 << "\" g=\"0.5\" "
+                << "b=\"" << i << "\" a=\"1\" />\n";
+        }
+        xml << "</Points>\n</Property>\n</Properties>\n</Processor>\n";
+    }
+    xml << "</Processors>\n</ProcessorNetwork>\n</InviwoWorkspace>\n";
+    return xml.str();
+}
+
+std::string toBinary(const std::string& xml) {
+    std::istringstream in{xml};
+    std::ostringstream out;
+    binaryxml::fromXml(in, out);
+    return out.str();
+}
+
+void XmlParse(benchmark::State& state) {
+    const auto xml = makeXml(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        TxDocument doc;
+        doc.Parse(xml);
+        benchmark::DoNotOptimize(doc.FirstChildElement(false));
+    }
+    state.SetBytesProcessed(state.iterations() * xml.size());
+}
+
+void BinaryRead(benchmark::State& state) {
+    const auto bin = toBinary(makeXml(static_cast<int>(state.range(0))));
+    for (auto _ : state) {
+        TxDocument doc;
+        std::istringstream in{bin};
+        binaryxml::read(in, doc);
+        benchmark::DoNotOptimize(doc.FirstChildElement(false));
+    }
+    state.SetBytesProcessed(state.iterations() * bin.size());
+}
+
+void XmlLazy(benchmark::State& state) {
+    const auto xml = makeXml(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        TxDocument doc;
+        LazyXml lazy{xml, doc};
+        benchmark::DoNotOptimize(lazy.getDeferred());
+    }
+    state.SetBytesProcessed(state.iterations() * xml.size());
+}
+
+void BinaryLazy(benchmark::State& state) {
+    const auto bin = toBinary(makeXml(static_cast<int>(state.range(0))));
+    for (auto _ : state) {
+        TxDocument doc;
+        binaryxml::LazyReader lazy{bin, doc};
+        benchmark::DoNotOptimize(lazy.getDeferred());
+    }
+    state.SetBytesProcessed(state.iterations() * bin.size());
+}
+
+}  // namespace
+
+BENCHMARK(XmlParse)->RangeMultiplier(4)->Range(4, 256);
+BENCHMARK(BinaryRead)->RangeMultiplier(4)->Range(4, 256);
+BENCHMARK(XmlLazy)->RangeMultiplier(4)->Range(4, 256);
+BENCHMARK(BinaryLazy)->RangeMultiplier(4)->Range(4, 256);
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
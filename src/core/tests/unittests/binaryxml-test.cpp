@@ -0,0 +1,191 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/io/serialization/serialization.h>
+#include <inviwo/core/io/serialization/binaryxml.h>
+#include <inviwo/core/io/serialization/lazyxml.h>
+#include <inviwo/core/io/serialization/ticpp.h>
+#include <inviwo/core/util/filesystem.h>
+
+#include <sstream>
+
+namespace inviwo {
+
+namespace {
+
+std::string serializeValues(const std::vector<float>& values, const std::string& name,
+                            bool binary) {
+    const std::string refpath = filesystem::findBasePath();
+    std::stringstream ss;
+    Serializer serializer(refpath);
+    serializer.serialize("name", name);
+    serializer.serialize("values", values, "value");
+    if (binary) {
+        serializer.writeBinaryFile(ss);
+    } else {
+        serializer.writeFile(ss, true);
+    }
+    return ss.str();
+}
+
+}  // namespace
+
+TEST(BinaryXmlTest, RoundTrip) {
+    std::vector<float> values(100);
+    for (size_t i = 0; i < values.size(); ++i) values[i] = 0.5f * static_cast<float>(i);
+
+    const auto xml = serializeValues(values, "test", false);
+    const auto binary = serializeValues(values, "test", true);
+    EXPECT_LT(binary.size(), xml.size());
+
+    std::stringstream bs{binary};
+    EXPECT_TRUE(binaryxml::isBinary(bs));
+    std::stringstream xs{xml};
+    EXPECT_FALSE(binaryxml::isBinary(xs));
+
+    std::stringstream converted;
+    binaryxml::toXml(bs, converted);
+    EXPECT_EQ(xml, converted.str());
+
+    std::stringstream in{xml};
+    std::stringstream out;
+    binaryxml::fromXml(in, out);
+    EXPECT_EQ(binary, out.str());
+}
+
+TEST(BinaryXmlTest, Deserialize) {
+    std::vector<float> values{1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+    std::stringstream ss{serializeValues(values, "test", true)};
+
+    Deserializer deserializer(ss, filesystem::findBasePath());
+    std::string name;
+    std::vector<float> result;
+    deserializer.deserialize("name", name);
+    deserializer.deserialize("values", result, "value");
+    EXPECT_EQ("test", name);
+    EXPECT_EQ(values, result);
+}
+
+TEST(BinaryXmlTest, TypedValues) {
+    // numbers are stored in binary form, everything that does not format back exactly as text
+    const std::string xml =
+        "<root>"
+        "<v a=\"1\" b=\"0.5\" c=\"0.1\" d=\"007\" e=\"-0\" f=\"1e400\" g=\"\" />"
+        "<v a=\"-2\" b=\"3.4028235e+38\" c=\"1.0000000000000002\" d=\"x\" e=\"1\" "
+        "f=\"4\" g=\"+1\" />"
+        "<v a=\"40000000000\" b=\"-7\" c=\"2\" d=\"1\" e=\"1.5\" f=\"5\" g=\"1.\" />"
+        "<v a=\"9223372036854775807\" b=\"1e+20\" c=\"0\" d=\"\" e=\"2\" f=\"6\" "
+        "g=\"-\" />"
+        "<w a=\"1\" b=\"0.25\" c=\"0.1\" d=\"9223372036854775807\" e=\"text &amp; more\" />"
+        "</root>";
+
+    TxDocument doc;
+    std::stringstream in{xml};
+    in >> doc;
+    TiXmlPrinter printer;
+    printer.SetIndent("    ");
+    doc.Accept(&printer);
+
+    std::stringstream xs{xml};
+    std::stringstream binary;
+    binaryxml::fromXml(xs, binary);
+    std::stringstream converted;
+    binaryxml::toXml(binary, converted);
+    EXPECT_EQ(printer.Str(), converted.str());
+}
+
+TEST(BinaryXmlTest, LazyReader) {
+    std::string xml = "<root><a><b><c x=\"1\">";
+    for (int i = 0; i < 100; ++i) xml += "<d><e>" + std::to_string(i) + "</e></d>";
+    xml += "</c><small><e>1</e></small></b></a></root>";
+    std::stringstream xs{xml};
+    std::stringstream bs;
+    binaryxml::fromXml(xs, bs);
+
+    TxDocument expected;
+    std::stringstream es{bs.str()};
+    binaryxml::read(es, expected);
+
+    TxDocument doc;
+    binaryxml::LazyReader reader{bs.str(), doc, 3, 64};
+    EXPECT_EQ(size_t{1}, reader.getDeferred());
+
+    auto c = doc.FirstChildElement()->FirstChildElement()->FirstChildElement()->FirstChildElement();
+    EXPECT_EQ("c", c->Value());
+    EXPECT_EQ("1", c->GetAttribute("x"));
+    EXPECT_EQ(nullptr, c->FirstChildElement(false));
+
+    reader.materialize(*c);
+    EXPECT_EQ(size_t{0}, reader.getDeferred());
+    EXPECT_FALSE(c->HasAttribute(std::string{LazyXml::marker}));
+    EXPECT_EQ(SerializeBase::nodeToString(*expected.FirstChildElement()),
+              SerializeBase::nodeToString(*doc.FirstChildElement()));
+}
+
+TEST(BinaryXmlTest, NestingLimit) {
+    const auto nested = [](size_t depth) {
+        std::string xml;
+        for (size_t i = 0; i < depth; ++i) xml += "<a>";
+        for (size_t i = 0; i < depth; ++i) xml += "</a>";
+        std::stringstream xs{xml};
+        std::stringstream bs;
+        binaryxml::fromXml(xs, bs);
+        return bs.str();
+    };
+
+    {
+        std::stringstream ss{nested(binaryxml::maxDepth)};
+        TxDocument doc;
+        EXPECT_NO_THROW(binaryxml::read(ss, doc));
+    }
+    {
+        std::stringstream ss{nested(binaryxml::maxDepth + 1)};
+        TxDocument doc;
+        EXPECT_THROW(binaryxml::read(ss, doc), SerializationException);
+    }
+    {
+        // deferred subtrees are checked when they are decoded
+        TxDocument doc;
+        binaryxml::LazyReader reader{nested(binaryxml::maxDepth + 1), doc, 3, 0};
+        EXPECT_THROW(reader.materializeAll(*doc.FirstChildElement()), SerializationException);
+    }
+}
+
+TEST(BinaryXmlTest, InvalidData) {
+    std::stringstream ss{std::string{"\x89IVWB\x02\x01", 7}};
+    TxDocument doc;
+    EXPECT_THROW(binaryxml::read(ss, doc), SerializationException);
+}
+
+}  // namespace inviwo
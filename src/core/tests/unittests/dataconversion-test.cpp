@@ -0,0 +1,113 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/util/dataconversion.h>
+#include <inviwo/core/util/exception.h>
+#include <inviwo/core/util/formats.h>
+
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+namespace inviwo {
+
+TEST(DataConversion, SaturateCast) {
+    EXPECT_EQ(std::uint8_t{255}, util::saturate_cast<std::uint8_t>(300.0f));
+    EXPECT_EQ(std::uint8_t{0}, util::saturate_cast<std::uint8_t>(-5.0f));
+    EXPECT_EQ(std::uint8_t{12}, util::saturate_cast<std::uint8_t>(12.7));
+    EXPECT_EQ(std::uint8_t{0},
+              util::saturate_cast<std::uint8_t>(std::numeric_limits<double>::quiet_NaN()));
+    EXPECT_EQ(std::uint8_t{0}, util::saturate_cast<std::uint8_t>(-1));
+    EXPECT_EQ(std::uint8_t{255}, util::saturate_cast<std::uint8_t>(1000));
+    EXPECT_EQ(std::int8_t{127}, util::saturate_cast<std::int8_t>(std::uint32_t{200}));
+    EXPECT_EQ(std::int8_t{-128}, util::saturate_cast<std::int8_t>(std::int64_t{-1000}));
+    EXPECT_EQ(std::numeric_limits<std::int32_t>::max(),
+              util::saturate_cast<std::int32_t>(std::numeric_limits<std::int64_t>::max()));
+    EXPECT_EQ(std::numeric_limits<std::int64_t>::max(),
+              util::saturate_cast<std::int64_t>(1.0e30));
+    EXPECT_EQ(std::uint64_t{42}, util::saturate_cast<std::uint64_t>(std::int8_t{42}));
+
+    EXPECT_EQ(2.5f, static_cast<float>(util::saturate_cast<f16>(2.5)));
+    EXPECT_EQ(std::uint8_t{3}, util::saturate_cast<std::uint8_t>(f16{3.5f}));
+    EXPECT_EQ(-2.0, util::saturate_cast<double>(f16{-2.0f}));
+}
+
+TEST(DataConversion, LinearMapping) {
+    const util::LinearMapping mapping{dvec2{0.0, 255.0}, dvec2{-1.0, 1.0}};
+    EXPECT_DOUBLE_EQ(-1.0, mapping(0.0));
+    EXPECT_DOUBLE_EQ(1.0, mapping(255.0));
+    EXPECT_DOUBLE_EQ(0.0, mapping(127.5));
+
+    const std::vector<std::uint8_t> src{0, 51, 255};
+    std::vector<float> dst(src.size());
+    util::convertValues(src.data(), dst.data(), src.size(),
+                        util::LinearMapping{dvec2{0.0, 255.0}, dvec2{0.0, 1.0}});
+    EXPECT_FLOAT_EQ(0.0f, dst[0]);
+    EXPECT_FLOAT_EQ(0.2f, dst[1]);
+    EXPECT_FLOAT_EQ(1.0f, dst[2]);
+}
+
+TEST(DataConversion, ConvertData) {
+    const std::vector<vec3> src{vec3{-1.0f, 0.5f, 300.0f}, vec3{10.0f, 20.0f, 30.0f}};
+    std::vector<u8vec3> dst(src.size());
+    util::convertData(DataVec3Float32::get(), src.data(), DataVec3UInt8::get(), dst.data(),
+                      src.size());
+    EXPECT_EQ(u8vec3(0, 0, 255), dst[0]);
+    EXPECT_EQ(u8vec3(10, 20, 30), dst[1]);
+
+    std::vector<std::uint8_t> scalars(src.size());
+    EXPECT_THROW(util::convertData(DataVec3Float32::get(), src.data(), DataUInt8::get(),
+                                   scalars.data(), scalars.size()),
+                 Exception);
+}
+
+TEST(DataConversion, ConvertLargeData) {
+    std::vector<std::int32_t> src(size_t{1} << 21);
+    std::iota(src.begin(), src.end(), -static_cast<std::int32_t>(src.size() / 2));
+    std::vector<std::int16_t> dst(src.size());
+    util::convertData(DataInt32::get(), src.data(), DataInt16::get(), dst.data(), src.size());
+    for (size_t i = 0; i < src.size(); ++i) {
+        ASSERT_EQ(util::saturate_cast<std::int16_t>(src[i]), dst[i]) << "at " << i;
+    }
+
+    std::vector<double> mapped(src.size());
+    util::convertData(DataInt32::get(), src.data(), DataFloat64::get(), mapped.data(),
+                      src.size(), util::LinearMapping{dvec2{0.0, 1.0}, dvec2{1.0, 3.0}});
+    for (size_t i = 0; i < src.size(); ++i) {
+        ASSERT_DOUBLE_EQ(2.0 * src[i] + 1.0, mapped[i]) << "at " << i;
+    }
+}
+
+}  // namespace inviwo
@@ -0,0 +1,89 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/util/foreach.h>
+#include <inviwo/core/util/exception.h>
+
+#include <atomic>
+#include <future>
+#include <vector>
+
+namespace inviwo {
+
+TEST(ForEachRange, coversAllItems) {
+    for (size_t jobs : {size_t{0}, size_t{1}, size_t{3}, size_t{16}, size_t{200}}) {
+        std::vector<std::atomic<int>> hits(100);
+        std::vector<std::atomic<int>> jobHits(std::max(jobs, size_t{1}));
+        util::forEachRange(hits.size(), jobs, [&](size_t begin, size_t end, size_t job) {
+            ++jobHits[job];
+            for (size_t i = begin; i < end; ++i) ++hits[i];
+        });
+        for (auto& hit : hits) EXPECT_EQ(hit, 1);
+        for (size_t job = 0; job < std::min(std::max(jobs, size_t{1}), hits.size()); ++job) {
+            EXPECT_EQ(jobHits[job], 1);
+        }
+    }
+}
+
+TEST(ForEachRange, rethrows) {
+    std::atomic<size_t> done{0};
+    EXPECT_THROW(util::forEachRange(8, 8,
+                                    [&](size_t begin, size_t, size_t) {
+                                        if (begin == 3) throw Exception("Job failed");
+                                        ++done;
+                                    }),
+                 Exception);
+    EXPECT_EQ(done, 7);
+}
+
+TEST(ForEachRange, nestedInPoolTasks) {
+    auto app = InviwoApplication::getPtr();
+    const size_t tasks = std::max(app->getPoolSize(), size_t{1}) * 2;
+
+    // Occupy every pool thread with a task that itself waits on a forEachRange
+    std::vector<std::future<size_t>> futures;
+    for (size_t task = 0; task < tasks; ++task) {
+        futures.push_back(app->dispatchPool([]() {
+            std::atomic<size_t> sum{0};
+            util::forEachRange(64, 16, [&](size_t begin, size_t end, size_t) {
+                for (size_t i = begin; i < end; ++i) sum += i;
+            });
+            return sum.load();
+        }));
+    }
+    for (auto& future : futures) EXPECT_EQ(future.get(), 64 * 63 / 2);
+}
+
+}  // namespace inviwo
@@ -0,0 +1,99 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/datastructures/image/image.h>
+#include <inviwo/core/datastructures/image/imageram.h>
+#include <inviwo/core/datastructures/image/layerramprecision.h>
+
+namespace inviwo {
+
+TEST(ImageTests, LazyDepthAndPickingLayers) {
+    Image image(size2_t{16, 8}, DataVec4UInt8::get());
+    ASSERT_NE(image.getDepthLayer(), nullptr);
+    ASSERT_NE(image.getPickingLayer(), nullptr);
+
+    auto ram = image.getEditableRepresentation<ImageRAM>();
+    EXPECT_TRUE(image.getColorLayer()->hasRepresentations());
+    EXPECT_FALSE(image.getDepthLayer()->hasRepresentations());
+    EXPECT_FALSE(image.getPickingLayer()->hasRepresentations());
+    EXPECT_EQ(size_t{16 * 8 * 4}, image.getSizeInBytes());
+    // an unused depth layer reads the same as a newly allocated one
+    EXPECT_EQ(dvec4(1.0, 0.0, 0.0, 0.0), image.readPixel(size2_t{1, 1}, LayerType::Depth));
+    EXPECT_EQ(dvec4(0.0), image.readPixel(size2_t{1, 1}, LayerType::Picking));
+    EXPECT_FALSE(image.getDepthLayer()->hasRepresentations());
+
+    auto depth = ram->getDepthLayerRAM();
+    ASSERT_NE(depth, nullptr);
+    EXPECT_EQ(size2_t(16, 8), depth->getDimensions());
+    EXPECT_EQ(dvec4(1.0, 0.0, 0.0, 0.0), image.readPixel(size2_t{1, 1}, LayerType::Depth));
+    EXPECT_TRUE(image.getDepthLayer()->hasRepresentations());
+    EXPECT_FALSE(image.getPickingLayer()->hasRepresentations());
+    EXPECT_EQ(size_t{16 * 8 * 8}, image.getSizeInBytes());
+}
+
+TEST(ImageTests, CopyKeepsUnusedLayersEmpty) {
+    Image image(size2_t{4, 4}, DataFloat32::get());
+    static_cast<LayerRAMPrecision<float>*>(
+        image.getEditableRepresentation<ImageRAM>()->getColorLayerRAM())
+        ->getDataTyped()[5] = 2.0f;
+
+    Image copy(image);
+    EXPECT_FALSE(copy.getDepthLayer()->hasRepresentations());
+    EXPECT_FALSE(copy.getPickingLayer()->hasRepresentations());
+    EXPECT_EQ(2.0, copy.readPixel(size2_t{1, 1}, LayerType::Color).x);
+
+    Image resized(size2_t{8, 8}, DataFloat32::get());
+    image.copyRepresentationsTo(&resized);
+    EXPECT_FALSE(resized.getDepthLayer()->hasRepresentations());
+    EXPECT_FALSE(resized.getPickingLayer()->hasRepresentations());
+}
+
+TEST(ImageTests, CopyResetsStaleLayers) {
+    Image image(size2_t{4, 4}, DataFloat32::get());
+    image.getRepresentation<ImageRAM>();
+
+    Image target(size2_t{8, 8}, DataFloat32::get());
+    auto targetRAM = target.getEditableRepresentation<ImageRAM>();
+    targetRAM->getDepthLayerRAM()->setFromDouble(size2_t{1, 1}, 0.5);
+    targetRAM->getPickingLayerRAM()->setFromDVec4(size2_t{1, 1}, dvec4{1.0, 2.0, 3.0, 4.0});
+
+    // The source never used its depth and picking layers, the target ones are reset
+    image.copyRepresentationsTo(&target);
+    EXPECT_EQ(size2_t(4, 4), targetRAM->getDepthLayerRAM()->getDimensions());
+    EXPECT_EQ(size2_t(4, 4), targetRAM->getPickingLayerRAM()->getDimensions());
+    EXPECT_EQ(1.0, target.readPixel(size2_t{1, 1}, LayerType::Depth).x);
+    EXPECT_EQ(dvec4(0.0), target.readPixel(size2_t{1, 1}, LayerType::Picking));
+}
+
+}  // namespace inviwo
@@ -0,0 +1,152 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/util/imagecache.h>
+#include <inviwo/core/datastructures/image/image.h>
+#include <inviwo/core/datastructures/image/imageram.h>
+
+#include <limits>
+
+namespace inviwo {
+
+namespace {
+
+// All sizes have 16 pixels, i.e. 64 bytes for a vec4 uint8 color layer
+const size2_t a{4, 4};
+const size2_t b{2, 8};
+const size2_t c{8, 2};
+const size2_t d{1, 16};
+constexpr size_t imageBytes = 16 * 4;
+
+std::shared_ptr<Image> makeMaster() {
+    auto master = std::make_shared<Image>(size2_t{8, 8}, DataVec4UInt8::get());
+    master->getRepresentation<ImageRAM>();
+    return master;
+}
+
+}  // namespace
+
+TEST(ImageCacheTests, CountsCachedBytes) {
+    auto master = makeMaster();
+    ImageCache cache{master};
+    EXPECT_EQ(std::numeric_limits<size_t>::max(), cache.getMaxSizeInBytes());
+
+    // The master is returned as is and not counted
+    EXPECT_EQ(master, cache.getImage(master->getDimensions()));
+    EXPECT_EQ(size_t{0}, cache.getSizeInBytes());
+
+    cache.getImage(a);
+    cache.getImage(b);
+    EXPECT_EQ(size_t{2}, cache.size());
+    EXPECT_EQ(2 * imageBytes, cache.getSizeInBytes());
+
+    cache.releaseImage(a);
+    EXPECT_EQ(imageBytes, cache.getSizeInBytes());
+}
+
+TEST(ImageCacheTests, EvictsLeastRecentlyUsed) {
+    ImageCache cache{makeMaster()};
+    cache.setMaxSizeInBytes(3 * imageBytes);
+
+    cache.getImage(a);
+    cache.getImage(b);
+    cache.getImage(c);
+    cache.getImage(a);
+    cache.getImage(d);
+    EXPECT_TRUE(cache.hasImage(a));
+    EXPECT_FALSE(cache.hasImage(b));
+    EXPECT_TRUE(cache.hasImage(c));
+    EXPECT_TRUE(cache.hasImage(d));
+    EXPECT_EQ(3 * imageBytes, cache.getSizeInBytes());
+
+    // A size that was pruned and requested again counts as the most recent one
+    cache.prune({a, d});
+    cache.getImage(c);
+    cache.getImage(b);
+    EXPECT_FALSE(cache.hasImage(a));
+    EXPECT_TRUE(cache.hasImage(b));
+    EXPECT_TRUE(cache.hasImage(c));
+    EXPECT_TRUE(cache.hasImage(d));
+
+    // Lowering the limit evicts right away
+    cache.setMaxSizeInBytes(imageBytes);
+    EXPECT_EQ(size_t{1}, cache.size());
+    EXPECT_TRUE(cache.hasImage(b));
+    EXPECT_EQ(imageBytes, cache.getSizeInBytes());
+
+    cache.setMaxSizeInBytes(std::numeric_limits<size_t>::max());
+    cache.getImage(a);
+    cache.getImage(c);
+    cache.getImage(d);
+    EXPECT_EQ(4 * imageBytes, cache.getSizeInBytes());
+}
+
+TEST(ImageCacheTests, KeepsRequestedImageOverLimit) {
+    ImageCache cache{makeMaster()};
+    cache.setMaxSizeInBytes(imageBytes / 2);
+
+    auto image = cache.getImage(a);
+    ASSERT_NE(nullptr, image);
+    EXPECT_EQ(a, image->getDimensions());
+    EXPECT_TRUE(cache.hasImage(a));
+
+    cache.getImage(b);
+    EXPECT_FALSE(cache.hasImage(a));
+    EXPECT_TRUE(cache.hasImage(b));
+}
+
+TEST(ImageCacheTests, UsesDefaultLimit) {
+    const auto oldDefault = ImageCache::getDefaultMaxSizeInBytes();
+    ImageCache::setDefaultMaxSizeInBytes(2 * imageBytes);
+
+    ImageCache cache{makeMaster()};
+    EXPECT_EQ(2 * imageBytes, cache.getMaxSizeInBytes());
+    cache.getImage(a);
+    cache.getImage(b);
+    cache.getImage(c);
+    EXPECT_FALSE(cache.hasImage(a));
+    EXPECT_EQ(2 * imageBytes, cache.getSizeInBytes());
+
+    // A limit of its own takes precedence
+    ImageCache unlimited{makeMaster()};
+    unlimited.setMaxSizeInBytes(std::numeric_limits<size_t>::max());
+    unlimited.getImage(a);
+    unlimited.getImage(b);
+    unlimited.getImage(c);
+    EXPECT_EQ(3 * imageBytes, unlimited.getSizeInBytes());
+
+    ImageCache::setDefaultMaxSizeInBytes(oldDefault);
+}
+
+}  // namespace inviwo
@@ -0,0 +1,125 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/io/imageexportqueue.h>
+#include <inviwo/core/io/datawriterexception.h>
+#include <inviwo/core/datastructures/image/layer.h>
+#include <inviwo/core/datastructures/image/layerramprecision.h>
+
+#include <atomic>
+#include <map>
+
+namespace inviwo {
+
+namespace {
+
+struct WriteRecord {
+    std::mutex mutex;
+    std::map<std::string, double> values;
+    std::atomic<int> active{0};
+    std::atomic<int> maxActive{0};
+};
+
+class RecordingWriter : public DataWriterType<Layer> {
+public:
+    RecordingWriter(std::shared_ptr<WriteRecord> record) : record_{record} {}
+    virtual RecordingWriter* clone() const override { return new RecordingWriter(*this); }
+
+    virtual void writeData(const Layer* layer, const std::string filePath) const override {
+        const int active = ++record_->active;
+        int prev = record_->maxActive;
+        while (prev < active && !record_->maxActive.compare_exchange_weak(prev, active)) {
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+
+        if (filePath.find("fail") != std::string::npos) {
+            --record_->active;
+            throw DataWriterException("Failed", IVW_CONTEXT_CUSTOM("RecordingWriter"));
+        }
+        const auto value = layer->getRepresentation<LayerRAM>()->getAsDouble(size2_t{0});
+        {
+            std::scoped_lock lock{record_->mutex};
+            record_->values[filePath] = value;
+        }
+        --record_->active;
+    }
+
+private:
+    std::shared_ptr<WriteRecord> record_;
+};
+
+}  // namespace
+
+TEST(ImageExportQueueTests, WritesSnapshotsWithBoundedPending) {
+    auto record = std::make_shared<WriteRecord>();
+    auto ram = std::make_shared<LayerRAMPrecision<float>>(size2_t{4, 4});
+    Layer layer(ram);
+
+    const size_t maxPending = 3;
+    ImageExportQueue queue(2, maxPending);
+    for (int i = 0; i < 20; ++i) {
+        // the queue has to copy the data, later changes must not affect queued frames
+        ram->getDataTyped()[0] = static_cast<float>(i);
+        queue.enqueue(layer, "frame" + std::to_string(i),
+                      std::make_unique<RecordingWriter>(record));
+        EXPECT_LE(queue.getPending(), maxPending);
+    }
+    queue.wait();
+
+    EXPECT_EQ(size_t{0}, queue.getPending());
+    EXPECT_EQ(size_t{20}, queue.getWritten());
+    EXPECT_EQ(size_t{0}, queue.getFailed());
+    EXPECT_LE(record->maxActive, 2);
+    EXPECT_GT(queue.getFramesPerSecond(), 0.0);
+
+    ASSERT_EQ(size_t{20}, record->values.size());
+    for (int i = 0; i < 20; ++i) {
+        EXPECT_EQ(static_cast<double>(i), record->values["frame" + std::to_string(i)]);
+    }
+}
+
+TEST(ImageExportQueueTests, CountsFailedFrames) {
+    auto record = std::make_shared<WriteRecord>();
+    Layer layer(std::make_shared<LayerRAMPrecision<float>>(size2_t{2, 2}));
+
+    ImageExportQueue queue(1, 2);
+    queue.enqueue(layer, "ok", std::make_unique<RecordingWriter>(record));
+    queue.enqueue(layer, "fail", std::make_unique<RecordingWriter>(record));
+    queue.wait();
+
+    EXPECT_EQ(size_t{1}, queue.getWritten());
+    EXPECT_EQ(size_t{1}, queue.getFailed());
+}
+
+}  // namespace inviwo
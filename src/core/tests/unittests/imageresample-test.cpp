@@ -0,0 +1,109 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/util/imageresample.h>
+#include <inviwo/core/datastructures/image/layerramprecision.h>
+#include <inviwo/core/util/exception.h>
+
+#include <algorithm>
+
+namespace inviwo {
+
+namespace {
+
+template <typename T>
+LayerRAMPrecision<T> makeLayer(size2_t dims, std::vector<T> values) {
+    LayerRAMPrecision<T> layer(dims);
+    std::copy(values.begin(), values.end(), layer.getDataTyped());
+    return layer;
+}
+
+}  // namespace
+
+TEST(ImageResample, Identity) {
+    const std::vector<float> values{0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f};
+    const auto src = makeLayer(size2_t{3, 2}, values);
+    for (auto filter : {util::ResampleFilter::Nearest, util::ResampleFilter::Box,
+                        util::ResampleFilter::Bilinear, util::ResampleFilter::Lanczos3}) {
+        LayerRAMPrecision<float> dst(size2_t{3, 2});
+        util::resample(src, dst, filter);
+        for (size_t i = 0; i < values.size(); ++i) {
+            EXPECT_FLOAT_EQ(values[i], dst.getDataTyped()[i]);
+        }
+    }
+}
+
+TEST(ImageResample, BoxAverages) {
+    const auto src = makeLayer<unsigned char>(size2_t{4, 2}, {0, 10, 20, 30, 2, 12, 22, 32});
+    LayerRAMPrecision<unsigned char> dst(size2_t{2, 1});
+    util::resample(src, dst, util::ResampleFilter::Box);
+    EXPECT_EQ(6, dst.getDataTyped()[0]);
+    EXPECT_EQ(26, dst.getDataTyped()[1]);
+}
+
+TEST(ImageResample, ConstantStaysConstant) {
+    LayerRAMPrecision<vec4> src(size2_t{300, 200});
+    std::fill(src.getDataTyped(), src.getDataTyped() + 300 * 200, vec4{0.25f, 0.5f, 0.75f, 1.0f});
+    for (auto dims : {size2_t{1024, 768}, size2_t{77, 33}}) {
+        for (auto filter : {util::ResampleFilter::Box, util::ResampleFilter::Bilinear,
+                            util::ResampleFilter::Lanczos3}) {
+            LayerRAMPrecision<vec4> dst(dims);
+            util::resample(src, dst, filter);
+            const auto data = dst.getDataTyped();
+            for (size_t i = 0; i < glm::compMul(dims); ++i) {
+                ASSERT_NEAR(0.25f, data[i].x, 1.0e-5f);
+                ASSERT_NEAR(1.0f, data[i].w, 1.0e-5f);
+            }
+        }
+    }
+}
+
+TEST(ImageResample, ResampleToFit) {
+    const auto src = makeLayer<float>(size2_t{4, 2}, {1, 1, 1, 1, 1, 1, 1, 1});
+    LayerRAMPrecision<float> dst(size2_t{4, 4});
+    std::fill(dst.getDataTyped(), dst.getDataTyped() + 16, 5.0f);
+    util::resampleToFit(src, dst);
+    const auto data = dst.getDataTyped();
+    for (size_t x = 0; x < 4; ++x) {
+        EXPECT_EQ(0.0f, data[x]);
+        EXPECT_EQ(1.0f, data[4 + x]);
+        EXPECT_EQ(1.0f, data[8 + x]);
+        EXPECT_EQ(0.0f, data[12 + x]);
+    }
+
+    LayerRAMPrecision<unsigned char> other(size2_t{4, 4});
+    EXPECT_THROW(util::resample(src, other), Exception);
+}
+
+}  // namespace inviwo
@@ -0,0 +1,161 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/io/serialization/serialization.h>
+#include <inviwo/core/io/serialization/lazyxml.h>
+#include <inviwo/core/io/serialization/ticpp.h>
+#include <inviwo/core/util/filesystem.h>
+
+#include <sstream>
+
+namespace inviwo {
+
+namespace {
+
+std::string print(const TxDocument& doc) {
+    TiXmlPrinter printer;
+    doc.Accept(&printer);
+    return printer.Str();
+}
+
+class Item : public Serializable {
+public:
+    Item() = default;
+    Item(std::string name, size_t size) : name_{std::move(name)}, values_(size) {
+        for (size_t i = 0; i < size; ++i) values_[i] = static_cast<int>(i);
+    }
+    virtual void serialize(Serializer& s) const override {
+        s.serialize("name", name_);
+        s.serialize("values", values_, "value");
+    }
+    virtual void deserialize(Deserializer& d) override {
+        d.deserialize("name", name_);
+        d.deserialize("values", values_, "value");
+    }
+
+    std::string name_;
+    std::vector<int> values_;
+};
+
+}  // namespace
+
+TEST(LazyXmlTest, DeferAndMaterialize) {
+    const std::string xml =
+        "<?xml version=\"1.0\" ?>\n"
+        "<Root>\n"
+        "  <A>\n"
+        "    <B>\n"
+        "      <C id=\"large\"><D a=\"1\"/><D a=\"2\"><!-- > --><E b=\"&lt;/D&gt;\"/></D></C>\n"
+        "      <C id=\"small\"><D/></C>\n"
+        "    </B>\n"
+        "  </A>\n"
+        "</Root>\n";
+
+    TxDocument full;
+    full.Parse(xml);
+
+    TxDocument doc;
+    LazyXml lazy(xml, doc, 3, 40);
+    EXPECT_EQ(size_t{1}, lazy.getDeferred());
+    EXPECT_GT(lazy.getDeferredBytes(), size_t{40});
+    EXPECT_LT(lazy.getDeferredBytes(), size_t{100});
+
+    auto large =
+        doc.FirstChildElement()->FirstChildElement()->FirstChildElement()->FirstChildElement();
+    EXPECT_EQ("large", large->GetAttribute("id"));
+    EXPECT_EQ(nullptr, large->FirstChildElement(false));
+    EXPECT_NE(print(full), print(doc));
+
+    lazy.materialize(*large);
+    EXPECT_EQ(size_t{0}, lazy.getDeferred());
+    EXPECT_EQ(size_t{0}, lazy.getDeferredBytes());
+    EXPECT_FALSE(large->HasAttribute(std::string{LazyXml::marker}));
+    EXPECT_EQ(print(full), print(doc));
+}
+
+TEST(LazyXmlTest, MaterializeAll) {
+    const std::string xml = "<Root><A><B><C>" + std::string(2000, ' ') + "<D x=\"1\"/></C>" +
+                            "<C><D x=\"2\"/>" + std::string(2000, ' ') + "</C></B></A></Root>";
+    TxDocument full;
+    full.Parse(xml);
+
+    TxDocument doc;
+    LazyXml lazy(xml, doc);
+    EXPECT_EQ(size_t{2}, lazy.getDeferred());
+    lazy.materializeAll(*doc.FirstChildElement());
+    EXPECT_EQ(size_t{0}, lazy.getDeferred());
+    EXPECT_EQ(print(full), print(doc));
+}
+
+TEST(LazyXmlTest, MaterializeAllBelowNode) {
+    const std::string xml = "<Root><A><B><C>" + std::string(2000, ' ') + "<D x=\"1\"/></C>" +
+                            "<C><D x=\"2\"/>" + std::string(2000, ' ') + "</C></B></A></Root>";
+    TxDocument doc;
+    LazyXml lazy(xml, doc);
+    EXPECT_EQ(size_t{2}, lazy.getDeferred());
+
+    // only the subtree of the given node is parsed
+    auto c = doc.FirstChildElement()->FirstChildElement()->FirstChildElement()->FirstChildElement();
+    lazy.materializeAll(*c);
+    EXPECT_EQ(size_t{1}, lazy.getDeferred());
+    EXPECT_EQ("1", c->FirstChildElement()->GetAttribute("x"));
+    EXPECT_EQ(nullptr, c->NextSiblingElement()->FirstChildElement(false));
+}
+
+TEST(LazyXmlTest, Malformed) {
+    TxDocument doc;
+    EXPECT_THROW(LazyXml("<Root><A></Root>", doc), TxException);
+}
+
+TEST(LazyXmlTest, Deserialize) {
+    std::vector<Item> items{{"a", 500}, {"b", 10}, {"c", 500}};
+
+    const std::string refpath = filesystem::findBasePath();
+    std::stringstream ss;
+    Serializer serializer(refpath);
+    serializer.serialize("Items", items, "Item");
+    serializer.writeFile(ss, true);
+
+    Deserializer deserializer(ss, refpath);
+    std::vector<Item> result;
+    deserializer.deserialize("Items", result, "Item");
+
+    ASSERT_EQ(items.size(), result.size());
+    for (size_t i = 0; i < items.size(); ++i) {
+        EXPECT_EQ(items[i].name_, result[i].name_);
+        EXPECT_EQ(items[i].values_, result[i].values_);
+    }
+}
+
+}  // namespace inviwo
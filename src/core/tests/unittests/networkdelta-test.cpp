@@ -0,0 +1,153 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/network/networkdelta.h>
+#include <inviwo/core/network/processornetwork.h>
+#include <inviwo/core/processors/processor.h>
+#include <inviwo/core/properties/ordinalproperty.h>
+#include <inviwo/core/ports/datainport.h>
+#include <inviwo/core/ports/dataoutport.h>
+
+namespace inviwo {
+
+namespace {
+
+struct DeltaTestProcessor : Processor {
+    DeltaTestProcessor(const std::string& id) : Processor(id, id), value("value", "Value", 0) {
+        addProperty(value);
+    }
+
+    virtual const ProcessorInfo getProcessorInfo() const override { return processorInfo_; }
+    static const ProcessorInfo processorInfo_;
+
+    virtual void process() override {}
+
+    IntProperty value;
+};
+
+const ProcessorInfo DeltaTestProcessor::processorInfo_{
+    "org.inviwo.DeltaTestProcessor",  // Class identifier
+    "DeltaTestProcessor",             // Display name
+    "Testing",                        // Category
+    CodeState::Stable,                // Code state
+    Tags::CPU,                        // Tags
+};
+
+}  // namespace
+
+TEST(NetworkDeltaTests, UndoRedoPropertiesAndConnections) {
+    ProcessorNetwork network{InviwoApplication::getPtr()};
+
+    auto at = std::make_unique<DeltaTestProcessor>("a");
+    at->addPort(std::make_unique<DataOutport<int>>("out"));
+    auto a = static_cast<DeltaTestProcessor*>(network.addProcessor(std::move(at)));
+
+    auto bt = std::make_unique<DeltaTestProcessor>("b");
+    bt->addPort(std::make_unique<DataInport<int>>("in"));
+    auto b = static_cast<DeltaTestProcessor*>(network.addProcessor(std::move(bt)));
+
+    a->value.set(3);
+    const NetworkSnapshot before(network, "");
+
+    a->value.set(0);
+    b->value.set(5);
+    network.addConnection(a->getOutports()[0], b->getInports()[0]);
+    const NetworkSnapshot after(network, "", before,
+                                [&](const Processor& p) { return &p != b; });
+
+    // b was not marked as dirty so its state is shared and missed
+    EXPECT_EQ(before.getProcessors().at("b"), after.getProcessors().at("b"));
+
+    const NetworkSnapshot complete(network, "", before, [](const Processor&) { return true; });
+    const NetworkDelta delta(before, complete);
+    EXPECT_FALSE(delta.empty());
+    EXPECT_EQ(std::vector<std::string>({"a", "b"}), delta.getProcessors());
+    EXPECT_EQ(size_t{1}, delta.getChangedEdges());
+
+    NetworkSnapshot current = complete;
+    delta.undo(network, current, "");
+    EXPECT_EQ(3, a->value.get());
+    EXPECT_EQ(0, b->value.get());
+    EXPECT_FALSE(network.isConnected(a->getOutports()[0], b->getInports()[0]));
+    EXPECT_TRUE(NetworkDelta(before, current).empty());
+    EXPECT_TRUE(NetworkDelta(before, NetworkSnapshot(network, "")).empty());
+
+    delta.redo(network, current, "");
+    EXPECT_EQ(0, a->value.get());
+    EXPECT_EQ(5, b->value.get());
+    EXPECT_TRUE(network.isConnected(a->getOutports()[0], b->getInports()[0]));
+    EXPECT_TRUE(NetworkDelta(complete, current).empty());
+    EXPECT_TRUE(NetworkDelta(complete, NetworkSnapshot(network, "")).empty());
+}
+
+TEST(NetworkDeltaTests, RenameInPlace) {
+    ProcessorNetwork network{InviwoApplication::getPtr()};
+
+    auto at = std::make_unique<DeltaTestProcessor>("a");
+    at->addPort(std::make_unique<DataOutport<int>>("out"));
+    auto a = static_cast<DeltaTestProcessor*>(network.addProcessor(std::move(at)));
+
+    auto bt = std::make_unique<DeltaTestProcessor>("b");
+    bt->addPort(std::make_unique<DataInport<int>>("in"));
+    auto b = static_cast<DeltaTestProcessor*>(network.addProcessor(std::move(bt)));
+    network.addConnection(a->getOutports()[0], b->getInports()[0]);
+
+    const NetworkSnapshot before(network, "");
+    a->setIdentifier("c");
+    a->value.set(4);
+    const NetworkSnapshot after(network, "", before, [](const Processor&) { return false; });
+
+    // Without the rename the processor is recorded as removed and added
+    EXPECT_EQ(std::vector<std::string>({"a", "c"}), NetworkDelta(before, after).getProcessors());
+
+    const NetworkDelta delta(before, after, {{"a", "c"}});
+    EXPECT_EQ(std::vector<std::string>({"c"}), delta.getProcessors());
+
+    NetworkSnapshot current = after;
+    delta.undo(network, current, "");
+    EXPECT_EQ(a, network.getProcessorByIdentifier("a"));
+    EXPECT_EQ(nullptr, network.getProcessorByIdentifier("c"));
+    EXPECT_EQ(0, a->value.get());
+    EXPECT_TRUE(network.isConnected(a->getOutports()[0], b->getInports()[0]));
+    EXPECT_TRUE(NetworkDelta(before, current).empty());
+
+    delta.redo(network, current, "");
+    EXPECT_EQ(a, network.getProcessorByIdentifier("c"));
+    EXPECT_EQ(4, a->value.get());
+    EXPECT_TRUE(network.isConnected(a->getOutports()[0], b->getInports()[0]));
+    EXPECT_TRUE(NetworkDelta(after, current).empty());
+}
+
+}  // namespace inviwo
@@ -0,0 +1,163 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/datastructures/representationconverter.h>
+#include <inviwo/core/network/processornetwork.h>
+#include <inviwo/core/network/processornetworkevaluator.h>
+#include <inviwo/core/network/processornetworkstatistics.h>
+#include <inviwo/core/ports/datainport.h>
+#include <inviwo/core/ports/dataoutport.h>
+#include <inviwo/core/processors/processor.h>
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <sstream>
+#include <thread>
+
+namespace inviwo {
+
+namespace {
+
+struct StatisticsProcessor : Processor {
+    StatisticsProcessor(const std::string& id) : Processor(id, id) {}
+
+    virtual const ProcessorInfo getProcessorInfo() const override { return processorInfo_; }
+
+    static const ProcessorInfo processorInfo_;
+
+    virtual void process() override {
+        if (onProcess) onProcess(*this);
+        for (auto outport : getOutports()) {
+            static_cast<DataOutport<int>*>(outport)->setData(std::make_shared<int>(0));
+        }
+    }
+
+    std::function<void(StatisticsProcessor&)> onProcess;
+};
+
+// A class identifier that needs escaping in both JSON and CSV
+const ProcessorInfo StatisticsProcessor::processorInfo_{
+    "org.inviwo.\"Statistics\"\\Test,Processor",  // Class identifier
+    "Statistics Processor",                        // Display name
+    "Testing",                                     // Category
+    CodeState::Stable,                             // Code state
+    Tags::CPU,                                     // Tags
+};
+
+// Add a processor "a" connected to a processor "b", which evaluates both once
+std::pair<StatisticsProcessor*, StatisticsProcessor*> addConnected(
+    ProcessorNetwork& network, std::function<void(StatisticsProcessor&)> onProcessA = {}) {
+    auto at = std::make_unique<StatisticsProcessor>("a");
+    at->addPort(std::make_unique<DataOutport<int>>("out"));
+    at->onProcess = std::move(onProcessA);
+    auto a = at.get();
+    auto bt = std::make_unique<StatisticsProcessor>("b");
+    bt->addPort(std::make_unique<DataInport<int>>("in"));
+    auto b = bt.get();
+
+    network.addProcessor(std::move(at));
+    network.addProcessor(std::move(bt));
+    network.addConnection(a->getOutports()[0], b->getInports()[0]);
+    return {a, b};
+}
+
+}  // namespace
+
+TEST(ProcessorNetworkStatistics, CollectsProcessStatistics) {
+    ProcessorNetwork network{InviwoApplication::getPtr()};
+    ProcessorNetworkEvaluator evaluator{&network};
+    ProcessorNetworkStatistics statistics{&network, &evaluator};
+    statistics.setEnabled(true);
+
+    // Representation conversions done by other threads, like thread pool jobs, are included
+    const auto [a, b] = addConnected(network, [](StatisticsProcessor&) {
+        std::thread job{
+            []() { util::addRepresentationConversionTime(std::chrono::milliseconds{5}); }};
+        job.join();
+    });
+    a->invalidate(InvalidationLevel::InvalidOutput);
+
+    const auto as = statistics.getStatistics(a);
+    ASSERT_TRUE(as);
+    EXPECT_EQ(as->identifier, "a");
+    EXPECT_EQ(as->classIdentifier, StatisticsProcessor::processorInfo_.classIdentifier);
+    EXPECT_EQ(as->count, size_t{2});
+    EXPECT_LE(as->min, as->mean);
+    EXPECT_LE(as->mean, as->max);
+    EXPECT_LE(as->p95, as->max);
+    EXPECT_GE(as->conversionTime, std::chrono::milliseconds{10});
+
+    const auto bs = statistics.getStatistics(b);
+    ASSERT_TRUE(bs);
+    EXPECT_EQ(bs->count, size_t{2});
+    EXPECT_GE(statistics.getEvaluationCount(), size_t{2});
+
+    // Statistics of removed processors are kept
+    network.removeAndDeleteProcessor(b);
+    const auto all = statistics.getStatistics();
+    ASSERT_EQ(all.size(), size_t{2});
+    EXPECT_TRUE(std::any_of(all.begin(), all.end(),
+                            [](const auto& s) { return s.identifier == "b"; }));
+
+    statistics.clear();
+    EXPECT_TRUE(statistics.getStatistics().empty());
+    EXPECT_EQ(statistics.getEvaluationCount(), size_t{0});
+}
+
+TEST(ProcessorNetworkStatistics, EscapesIdentifiers) {
+    ProcessorNetwork network{InviwoApplication::getPtr()};
+    ProcessorNetworkEvaluator evaluator{&network};
+    ProcessorNetworkStatistics statistics{&network, &evaluator};
+    statistics.setEnabled(true);
+
+    const auto [a, b] = addConnected(network);
+    ASSERT_TRUE(statistics.getStatistics(a));
+    ASSERT_TRUE(statistics.getStatistics(b));
+
+    std::stringstream json;
+    statistics.writeJSON(json);
+    EXPECT_NE(json.str().find(R"("classIdentifier": "org.inviwo.\"Statistics\"\\Test,Processor")"),
+              std::string::npos)
+        << json.str();
+
+    std::stringstream csv;
+    statistics.writeCSV(csv);
+    EXPECT_NE(csv.str().find(R"(a,"org.inviwo.""Statistics""\Test,Processor",1,)"),
+              std::string::npos)
+        << csv.str();
+}
+
+}  // namespace inviwo
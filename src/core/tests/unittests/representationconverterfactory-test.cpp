@@ -0,0 +1,102 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/datastructures/representationconverterfactory.h>
+
+namespace inviwo {
+
+namespace {
+
+struct Base {
+    virtual ~Base() = default;
+};
+struct Repr1 : Base {};
+struct Repr2 : Base {};
+struct Repr3 : Base {};
+struct Repr4 : Base {};
+
+template <typename From, typename To>
+struct Converter : RepresentationConverter<Base> {
+    virtual ConverterID getConverterID() const override { return {typeid(From), typeid(To)}; }
+    virtual std::shared_ptr<Base> createFrom(std::shared_ptr<const Base>) const override {
+        return std::make_shared<To>();
+    }
+    virtual void update(std::shared_ptr<const Base>, std::shared_ptr<Base>) const override {}
+};
+
+}  // namespace
+
+TEST(RepresentationConverterFactory, ShortestChain) {
+    RepresentationConverterFactory<Base> factory;
+    Converter<Repr1, Repr2> c12;
+    Converter<Repr2, Repr3> c23;
+    Converter<Repr1, Repr3> c13;
+    factory.registerObject(&c12);
+    factory.registerObject(&c23);
+
+    auto package = factory.getRepresentationConverter(typeid(Repr1), typeid(Repr3));
+    ASSERT_NE(nullptr, package);
+    EXPECT_EQ(size_t{2}, package->steps());
+    EXPECT_EQ(package, factory.getRepresentationConverter(typeid(Repr1), typeid(Repr3)));
+
+    factory.registerObject(&c13);
+    // Packages handed out before stay valid
+    EXPECT_EQ(size_t{2}, package->steps());
+    package = factory.getRepresentationConverter(typeid(Repr1), typeid(Repr3));
+    ASSERT_NE(nullptr, package);
+    EXPECT_EQ(size_t{1}, package->steps());
+
+    factory.unRegisterObject(&c13);
+    package = factory.getRepresentationConverter(typeid(Repr1), typeid(Repr3));
+    ASSERT_NE(nullptr, package);
+    EXPECT_EQ(size_t{2}, package->steps());
+}
+
+TEST(RepresentationConverterFactory, MissingChain) {
+    RepresentationConverterFactory<Base> factory;
+    Converter<Repr1, Repr2> c12;
+    Converter<Repr2, Repr4> c24;
+    factory.registerObject(&c12);
+
+    EXPECT_EQ(nullptr, factory.getRepresentationConverter(typeid(Repr1), typeid(Repr4)));
+    EXPECT_EQ(nullptr, factory.getRepresentationConverter(typeid(Repr1), typeid(Repr4)));
+
+    // Registering a converter should invalidate the cached missing chain
+    factory.registerObject(&c24);
+    auto package = factory.getRepresentationConverter(typeid(Repr1), typeid(Repr4));
+    ASSERT_NE(nullptr, package);
+    EXPECT_EQ(size_t{2}, package->steps());
+}
+
+}  // namespace inviwo
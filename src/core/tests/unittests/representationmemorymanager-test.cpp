@@ -0,0 +1,154 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/datastructures/representationmemorymanager.h>
+
+#include <map>
+#include <string>
+
+namespace inviwo {
+
+namespace {
+
+struct FakeRepr {
+    std::type_index getTypeIndex() const { return std::type_index(typeid(FakeRepr)); }
+};
+
+struct RepresentationMemoryManagerFixture : public ::testing::Test {
+    RepresentationMemoryManagerFixture()
+        : owner{std::make_shared<RepresentationMemoryManager::Owner>([this](const void* repr) {
+            for (auto& [name, item] : reprs) {
+                if (item.get() == repr) {
+                    evicted.push_back(name);
+                    item.reset();
+                    return true;
+                }
+            }
+            return false;
+        })} {
+        manager.setBudget(0);
+        manager.clearStatistics();
+    }
+    ~RepresentationMemoryManagerFixture() { manager.setBudget(0); }
+
+    void add(const std::string& name, size_t bytes) {
+        reprs[name] = std::make_shared<FakeRepr>();
+        records[name] = manager.add(reprs[name], bytes, owner);
+    }
+
+    RepresentationMemoryManager& manager = RepresentationMemoryManager::get();
+    std::shared_ptr<RepresentationMemoryManager::Owner> owner;
+    std::map<std::string, std::shared_ptr<FakeRepr>> reprs;
+    std::map<std::string, std::shared_ptr<RepresentationMemoryManager::Record>> records;
+    std::vector<std::string> evicted;
+};
+
+}  // namespace
+
+TEST_F(RepresentationMemoryManagerFixture, Accounting) {
+    const auto before = manager.getUsedBytes();
+    add("a", 10);
+    add("b", 20);
+    EXPECT_EQ(before + 30, manager.getUsedBytes());
+
+    reprs["a"].reset();
+    EXPECT_EQ(before + 20, manager.getUsedBytes());
+
+    records.erase("b");
+    EXPECT_EQ(before, manager.getUsedBytes());
+}
+
+TEST_F(RepresentationMemoryManagerFixture, NoBudget) {
+    add("a", 100);
+    manager.enforceBudget();
+    manager.enforceBudget();
+    EXPECT_EQ(size_t{0}, manager.enforceBudget());
+    EXPECT_TRUE(evicted.empty());
+}
+
+TEST_F(RepresentationMemoryManagerFixture, LeastRecentlyUsed) {
+    add("a", 60);
+    add("b", 60);
+    add("c", 60);
+    manager.enforceBudget();
+    records["a"]->touch();
+    manager.enforceBudget();
+    manager.enforceBudget();
+    manager.enforceBudget();
+    records["b"]->touch();
+
+    manager.setBudget(manager.getUsedBytes() - 50);
+    EXPECT_EQ(size_t{60}, manager.enforceBudget());
+    ASSERT_EQ(size_t{1}, evicted.size());
+    EXPECT_EQ("c", evicted[0]);
+    EXPECT_EQ(size_t{1}, manager.getEvictionCount());
+    EXPECT_EQ(size_t{60}, manager.getEvictedBytes());
+}
+
+TEST_F(RepresentationMemoryManagerFixture, RecentlyUsedIsKept) {
+    add("a", 60);
+    records["a"]->touch();
+    manager.setBudget(1);
+    manager.enforceBudget();
+    EXPECT_TRUE(evicted.empty());
+}
+
+TEST_F(RepresentationMemoryManagerFixture, ReleasedOwner) {
+    add("a", 60);
+    owner->release();
+    manager.setBudget(1);
+    manager.enforceBudget();
+    manager.enforceBudget();
+    manager.enforceBudget();
+    EXPECT_TRUE(evicted.empty());
+    EXPECT_TRUE(reprs["a"]);
+}
+
+TEST_F(RepresentationMemoryManagerFixture, ConversionStatistics) {
+    using namespace std::chrono_literals;
+    manager.recordConversion(typeid(int), typeid(float), 2ms);
+    manager.recordConversion(typeid(int), typeid(float), 4ms);
+    manager.recordConversion(typeid(float), typeid(int), 1ms);
+
+    const auto stats = manager.getConversionStatistics();
+    ASSERT_EQ(size_t{2}, stats.size());
+    EXPECT_EQ(size_t{2}, stats[0].count);
+    EXPECT_DOUBLE_EQ(6.0, stats[0].time.count());
+    EXPECT_EQ(size_t{1}, stats[1].count);
+
+    manager.clearStatistics();
+    EXPECT_TRUE(manager.getConversionStatistics().empty());
+}
+
+}  // namespace inviwo
@@ -34,6 +34,7 @@
 
 #include <inviwo/core/util/stringconversion.h>
 
+#include <sstream>
 #include <string>
 
 namespace inviwo {
@@ -52,4 +53,10 @@ TEST(StringConversion, toWstring) {
     EXPECT_EQ(wstr, conv);
 }
 
+TEST(StringConversion, writeJsonString) {
+    std::stringstream ss;
+    util::writeJsonString(ss, std::string("a\"b\\c\nd\x01\x1f") + '\0' + u8"\U000000E5");
+    EXPECT_EQ(std::string(R"("a\"b\\c\nd\u0001\u001f\u0000)") + u8"\U000000E5\"", ss.str());
+}
+
 }  // namespace inviwo
@@ -0,0 +1,119 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/util/tracing.h>
+
+#include <sstream>
+#include <thread>
+
+namespace inviwo {
+
+namespace {
+
+struct TracerFixture : public ::testing::Test {
+    TracerFixture() {
+        Tracer::get().clear();
+        Tracer::setEnabled(true);
+    }
+    ~TracerFixture() {
+        Tracer::setEnabled(false);
+        Tracer::get().setBufferCapacity(1 << 16);
+        Tracer::get().clear();
+    }
+};
+
+}  // namespace
+
+TEST_F(TracerFixture, NestedScopes) {
+    {
+        TraceScope outer("test", "outer");
+        { TraceScope inner("test", "inner"); }
+    }
+
+    auto events = Tracer::get().getEvents();
+    ASSERT_EQ(size_t{2}, events.size());
+    EXPECT_EQ("outer", events[0].name);
+    EXPECT_EQ("inner", events[1].name);
+    EXPECT_LE(events[0].start, events[1].start);
+    EXPECT_GE(events[0].start + events[0].duration, events[1].start + events[1].duration);
+}
+
+TEST_F(TracerFixture, Disabled) {
+    Tracer::setEnabled(false);
+    bool called = false;
+    {
+        TraceScope scope("test", [&]() {
+            called = true;
+            return std::string{"name"};
+        });
+    }
+    EXPECT_FALSE(called);
+    EXPECT_TRUE(Tracer::get().getEvents().empty());
+}
+
+TEST_F(TracerFixture, RingBuffer) {
+    Tracer::get().setBufferCapacity(4);
+    for (int i = 0; i < 10; ++i) {
+        TraceScope scope("test", std::to_string(i));
+    }
+    auto events = Tracer::get().getEvents();
+    ASSERT_EQ(size_t{4}, events.size());
+    EXPECT_EQ("6", events[0].name);
+    EXPECT_EQ("9", events[3].name);
+}
+
+TEST_F(TracerFixture, Threads) {
+    std::thread worker{[]() { TraceScope scope("test", "worker"); }};
+    worker.join();
+    { TraceScope scope("test", "main"); }
+
+    auto events = Tracer::get().getEvents();
+    ASSERT_EQ(size_t{2}, events.size());
+    EXPECT_NE(events[0].threadId, events[1].threadId);
+}
+
+TEST_F(TracerFixture, ChromeTraceExport) {
+    { TraceScope scope("test", "a \"quoted\" name"); }
+
+    std::stringstream ss;
+    Tracer::get().exportChromeTrace(ss);
+    const auto json = ss.str();
+
+    EXPECT_NE(std::string::npos, json.find("\"traceEvents\""));
+    EXPECT_NE(std::string::npos, json.find("\"name\":\"a \\\"quoted\\\" name\""));
+    EXPECT_NE(std::string::npos, json.find("\"ph\":\"X\""));
+    EXPECT_NE(std::string::npos, json.find("\"cat\":\"test\""));
+}
+
+}  // namespace inviwo
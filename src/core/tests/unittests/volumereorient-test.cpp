@@ -0,0 +1,145 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/util/volumereorient.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/util/exception.h>
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include <vector>
+
+namespace inviwo {
+
+namespace {
+
+std::vector<char> makeData(size3_t dims, size_t elemSize) {
+    std::vector<char> data(glm::compMul(dims) * elemSize);
+    std::iota(data.begin(), data.end(), char{0});
+    return data;
+}
+
+// Voxel by voxel reference implementation
+std::vector<char> reference(const std::vector<char>& src, size3_t srcDims, size_t elemSize,
+                            const util::AxisReorientation& reorientation) {
+    const auto dims = reorientation.apply(srcDims);
+    std::vector<char> dst(src.size());
+    for (size_t z = 0; z < dims.z; ++z) {
+        for (size_t y = 0; y < dims.y; ++y) {
+            for (size_t x = 0; x < dims.x; ++x) {
+                const size3_t pos{x, y, z};
+                size3_t srcPos{0};
+                for (size_t i = 0; i < 3; ++i) {
+                    srcPos[reorientation.permutation[i]] =
+                        reorientation.flip[i] ? dims[i] - 1 - pos[i] : pos[i];
+                }
+                const auto from =
+                    srcPos.x + srcPos.y * srcDims.x + srcPos.z * srcDims.x * srcDims.y;
+                const auto to = x + y * dims.x + z * dims.x * dims.y;
+                std::memcpy(dst.data() + to * elemSize, src.data() + from * elemSize, elemSize);
+            }
+        }
+    }
+    return dst;
+}
+
+template <typename F>
+void forEachReorientation(F&& func) {
+    std::array<size_t, 3> permutation{0, 1, 2};
+    do {
+        for (int flips = 0; flips < 8; ++flips) {
+            func(util::AxisReorientation{
+                permutation, {(flips & 1) != 0, (flips & 2) != 0, (flips & 4) != 0}});
+        }
+    } while (std::next_permutation(permutation.begin(), permutation.end()));
+}
+
+}  // namespace
+
+TEST(VolumeReorient, MatchesReference) {
+    for (auto dims : {size3_t{7, 5, 3}, size3_t{40, 1, 66}}) {
+        for (size_t elemSize : {1, 3, 4, 5, 8, 12, 32}) {
+            const auto src = makeData(dims, elemSize);
+            forEachReorientation([&](const util::AxisReorientation& reorientation) {
+                std::vector<char> dst(src.size());
+                util::reorient(src.data(), dst.data(), dims, elemSize, reorientation);
+                EXPECT_EQ(reference(src, dims, elemSize, reorientation), dst);
+            });
+        }
+    }
+}
+
+TEST(VolumeReorient, InPlaceMatchesReference) {
+    const size3_t dims{7, 5, 3};
+    for (size_t elemSize : {1, 4, 5}) {
+        const auto src = makeData(dims, elemSize);
+        forEachReorientation([&](const util::AxisReorientation& reorientation) {
+            auto data = src;
+            util::reorientInPlace(data.data(), dims, elemSize, reorientation);
+            EXPECT_EQ(reference(src, dims, elemSize, reorientation), data);
+        });
+    }
+}
+
+TEST(VolumeReorient, VolumeRAM) {
+    VolumeRAMPrecision<float> volume(size3_t{4, 3, 2}, swizzlemasks::rgba,
+                                     InterpolationType::Linear,
+                                     {Wrapping::Clamp, Wrapping::Repeat, Wrapping::Mirror});
+    std::iota(volume.getDataTyped(), volume.getDataTyped() + 24, 0.0f);
+
+    const util::AxisReorientation reorientation{{2, 0, 1}, {true, false, false}};
+    auto result = util::reorient(volume, reorientation);
+    EXPECT_EQ(size3_t(2, 4, 3), result->getDimensions());
+    EXPECT_EQ(Wrapping::Mirror, result->getWrapping()[0]);
+    EXPECT_EQ(Wrapping::Clamp, result->getWrapping()[1]);
+    EXPECT_EQ(Wrapping::Repeat, result->getWrapping()[2]);
+    // The first voxel of the result is the last slice of the source
+    EXPECT_EQ(12.0f, static_cast<const float*>(result->getData())[0]);
+
+    util::reorientInPlace(volume, reorientation);
+    EXPECT_EQ(result->getDimensions(), volume.getDimensions());
+    EXPECT_EQ(result->getWrapping(), volume.getWrapping());
+    EXPECT_TRUE(std::equal(volume.getDataTyped(), volume.getDataTyped() + 24,
+                           static_cast<const float*>(result->getData())));
+}
+
+TEST(VolumeReorient, InvalidPermutation) {
+    std::vector<char> data(8);
+    EXPECT_THROW(util::reorientInPlace(data.data(), size3_t{2, 2, 2}, 1,
+                                       util::AxisReorientation{{0, 0, 1}, {false, false, false}}),
+                 Exception);
+}
+
+}  // namespace inviwo
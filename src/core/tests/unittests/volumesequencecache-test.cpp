@@ -0,0 +1,139 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/util/volumesequencecache.h>
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/volumedisk.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/util/raiiutils.h>
+
+namespace inviwo {
+
+namespace {
+
+class TestVolumeLoader : public DiskRepresentationLoader<VolumeRepresentation> {
+public:
+    virtual TestVolumeLoader* clone() const override { return new TestVolumeLoader(*this); }
+    virtual std::shared_ptr<VolumeRepresentation> createRepresentation(
+        const VolumeRepresentation& src) const override {
+        return std::make_shared<VolumeRAMPrecision<unsigned char>>(src.getDimensions());
+    }
+    virtual void updateRepresentation(std::shared_ptr<VolumeRepresentation>,
+                                      const VolumeRepresentation&) const override {}
+};
+
+std::shared_ptr<VolumeSequence> createDiskSequence(size_t size) {
+    auto seq = std::make_shared<VolumeSequence>();
+    for (size_t i = 0; i < size; ++i) {
+        auto disk = std::make_shared<VolumeDisk>(size3_t{4, 4, 4}, DataUInt8::get());
+        disk->setLoader(new TestVolumeLoader());
+        seq->push_back(std::make_shared<Volume>(disk));
+    }
+    return seq;
+}
+
+}  // namespace
+
+TEST(VolumeSequenceCache, LoadsRequestedTimeStep) {
+    auto seq = createDiskSequence(5);
+    VolumeSequenceCache cache(0, 0);
+    cache.setSequence(seq);
+
+    auto volume = cache.get(2);
+    EXPECT_EQ(volume, (*seq)[2]);
+    EXPECT_TRUE(volume->hasRepresentation<VolumeRAM>());
+    EXPECT_FALSE((*seq)[3]->hasRepresentation<VolumeRAM>());
+    EXPECT_EQ(cache.getUsedBytes(), size_t{64});
+    EXPECT_EQ(cache.get(5), nullptr);
+}
+
+TEST(VolumeSequenceCache, PrefetchesInPlaybackDirection) {
+    // Prefetching needs pool threads, start some if the pool is not running
+    auto app = InviwoApplication::getPtr();
+    const auto poolSize = app->getPoolSize();
+    if (poolSize == 0) app->resizePool(2);
+    util::OnScopeExit restorePool{[&]() { app->resizePool(poolSize); }};
+    ASSERT_LT(size_t{0}, app->getPoolSize());
+
+    auto seq = createDiskSequence(10);
+    {
+        VolumeSequenceCache cache(0, 2);
+        cache.setSequence(seq);
+        cache.get(5);
+        cache.get(4);
+    }  // Waits for the prefetches
+    EXPECT_TRUE((*seq)[3]->hasRepresentation<VolumeRAM>());
+    EXPECT_TRUE((*seq)[2]->hasRepresentation<VolumeRAM>());
+    EXPECT_FALSE((*seq)[1]->hasRepresentation<VolumeRAM>());
+    EXPECT_FALSE((*seq)[8]->hasRepresentation<VolumeRAM>());
+}
+
+TEST(VolumeSequenceCache, EvictsPlayedTimeSteps) {
+    auto seq = createDiskSequence(10);
+    VolumeSequenceCache cache(3 * 64, 0);
+    cache.setSequence(seq);
+
+    for (size_t i = 0; i < seq->size(); ++i) {
+        cache.get(i);
+        EXPECT_LE(cache.getUsedBytes(), cache.getBudget());
+    }
+    // The time steps that were just played are the furthest away when looping, and are evicted
+    // first, while the first time steps are kept.
+    EXPECT_EQ(cache.getEvictionCount(), size_t{7});
+    EXPECT_TRUE((*seq)[9]->hasRepresentation<VolumeRAM>());
+    EXPECT_TRUE((*seq)[0]->hasRepresentation<VolumeRAM>());
+    EXPECT_TRUE((*seq)[1]->hasRepresentation<VolumeRAM>());
+    EXPECT_FALSE((*seq)[8]->hasRepresentation<VolumeRAM>());
+    EXPECT_TRUE((*seq)[8]->hasRepresentation<VolumeDisk>());
+
+    // Evicted time steps are loaded again
+    EXPECT_TRUE(cache.get(8)->hasRepresentation<VolumeRAM>());
+}
+
+TEST(VolumeSequenceCache, KeepsTimeStepsWithoutDiskRepresentation) {
+    auto seq = std::make_shared<VolumeSequence>();
+    for (size_t i = 0; i < 4; ++i) {
+        seq->push_back(std::make_shared<Volume>(size3_t{4, 4, 4}, DataUInt8::get()));
+    }
+    VolumeSequenceCache cache(64, 0);
+    cache.setSequence(seq);
+    for (size_t i = 0; i < seq->size(); ++i) cache.get(i);
+
+    EXPECT_EQ(cache.getEvictionCount(), size_t{0});
+    EXPECT_EQ(cache.getUsedBytes(), size_t{4 * 64});
+}
+
+}  // namespace inviwo
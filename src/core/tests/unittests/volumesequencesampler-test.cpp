@@ -0,0 +1,162 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/util/volumesequencesampler.h>
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/volumedisk.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+
+#include <algorithm>
+
+namespace inviwo {
+
+namespace {
+
+class ConstantVolumeLoader : public DiskRepresentationLoader<VolumeRepresentation> {
+public:
+    ConstantVolumeLoader(unsigned char value) : value_{value} {}
+    virtual ConstantVolumeLoader* clone() const override {
+        return new ConstantVolumeLoader(*this);
+    }
+    virtual std::shared_ptr<VolumeRepresentation> createRepresentation(
+        const VolumeRepresentation& src) const override {
+        auto ram = std::make_shared<VolumeRAMPrecision<unsigned char>>(src.getDimensions());
+        std::fill_n(ram->getDataTyped(), ram->getNumberOfBytes(), value_);
+        return ram;
+    }
+    virtual void updateRepresentation(std::shared_ptr<VolumeRepresentation>,
+                                      const VolumeRepresentation&) const override {}
+
+private:
+    unsigned char value_;
+};
+
+std::shared_ptr<VolumeSequence> createSequence(const std::vector<unsigned char>& values) {
+    auto seq = std::make_shared<VolumeSequence>();
+    for (size_t i = 0; i < values.size(); ++i) {
+        auto disk = std::make_shared<VolumeDisk>(size3_t{4, 4, 4}, DataUInt8::get());
+        disk->setLoader(new ConstantVolumeLoader(values[i]));
+        auto volume = std::make_shared<Volume>(disk);
+        volume->setMetaData<DoubleMetaData, double>("timestamp", static_cast<double>(i));
+        seq->push_back(volume);
+    }
+    return seq;
+}
+
+std::shared_ptr<VolumeSequence> createSequence(size_t size) {
+    std::vector<unsigned char> values(size);
+    for (size_t i = 0; i < size; ++i) values[i] = static_cast<unsigned char>(10 * i);
+    return createSequence(values);
+}
+
+}  // namespace
+
+TEST(VolumeSequenceSampler, LoadsTimeStepsWhenSampled) {
+    auto seq = createSequence(6);
+    VolumeSequenceSampler sampler(seq, false);
+    EXPECT_EQ(sampler.getResidentCount(), size_t{0});
+    EXPECT_FALSE((*seq)[2]->hasRepresentation<VolumeRAM>());
+
+    sampler.sample(dvec4{0.5, 0.5, 0.5, 2.5});
+    EXPECT_EQ(sampler.getResidentCount(), size_t{2});
+    // Time steps on disk are loaded into volumes of the sampler, the input is not modified
+    EXPECT_FALSE((*seq)[2]->hasRepresentation<VolumeRAM>());
+    EXPECT_FALSE((*seq)[3]->hasRepresentation<VolumeRAM>());
+}
+
+TEST(VolumeSequenceSampler, KeepsRepresentationsOfInput) {
+    auto seq = createSequence(4);
+    (*seq)[1]->getRepresentation<VolumeRAM>();
+    VolumeSequenceSampler sampler(seq, false);
+
+    sampler.sample(dvec4{0.5, 0.5, 0.5, 1.5});
+    sampler.clearTimeWindow();
+    EXPECT_EQ(sampler.getResidentCount(), size_t{0});
+    EXPECT_TRUE((*seq)[1]->hasValidRepresentation<VolumeRAM>());
+    EXPECT_FALSE((*seq)[2]->hasRepresentation<VolumeRAM>());
+}
+
+TEST(VolumeSequenceSampler, DropsDuplicateLastTimeStep) {
+    auto seq = createSequence({0, 10, 20, 0});
+    VolumeSequenceSampler sampler(seq, true);
+    EXPECT_EQ(sampler.getResidentCount(), size_t{0});
+
+    EXPECT_EQ(sampler.getTimestamps(), std::vector<double>({0.0, 1.0, 2.0}));
+    EXPECT_EQ(sampler.getTimeRange(), dvec2(0.0, 3.0));
+    EXPECT_EQ(sampler.getResidentCount(), size_t{0});
+    EXPECT_FALSE((*seq)[3]->hasRepresentation<VolumeRAM>());
+
+    auto loop = createSequence({0, 10, 20, 30});
+    EXPECT_EQ(VolumeSequenceSampler(loop, true).getTimestamps().size(), size_t{4});
+}
+
+TEST(VolumeSequenceSampler, CopyHasItsOwnTimeWindow) {
+    auto seq = createSequence(6);
+    VolumeSequenceSampler sampler(seq, false);
+    const dvec4 pos{0.5, 0.5, 0.5, 2.5};
+    const auto value = sampler.sample(pos);
+
+    VolumeSequenceSampler copy(sampler);
+    EXPECT_EQ(copy.getTimestamps(), sampler.getTimestamps());
+    EXPECT_EQ(copy.getResidentCount(), size_t{0});
+    EXPECT_EQ(copy.sample(pos), value);
+
+    copy.setTimeWindow(4.0, 4.5, true, 0);
+    EXPECT_EQ(copy.getResidentCount(), size_t{0});
+    EXPECT_EQ(sampler.getResidentCount(), size_t{2});
+}
+
+TEST(VolumeSequenceSampler, TimeWindowReleasesTimeSteps) {
+    auto seq = createSequence(6);
+    VolumeSequenceSampler sampler(seq, false);
+
+    const dvec4 pos{0.5, 0.5, 0.5, 2.5};
+    const auto value = sampler.sample(pos);
+
+    sampler.setTimeWindow(4.0, 4.5, true, 0);
+    EXPECT_EQ(sampler.getResidentCount(), size_t{0});
+    EXPECT_FALSE((*seq)[2]->hasRepresentation<VolumeRAM>());
+    EXPECT_TRUE((*seq)[2]->hasRepresentation<VolumeDisk>());
+
+    // Released time steps are loaded again when sampled
+    EXPECT_EQ(sampler.sample(pos), value);
+    EXPECT_EQ(sampler.getResidentCount(), size_t{2});
+
+    // Time steps inside of the window are kept
+    sampler.setTimeWindow(2.0, 2.9, true, 0);
+    EXPECT_EQ(sampler.getResidentCount(), size_t{2});
+}
+
+}  // namespace inviwo
@@ -63,6 +63,16 @@ CommandLineParser::CommandLineParser(int argc, char** argv)
     , outputPath_("o", "output", "Specify output path", false, "", "output path")
     , logfile_("l", "logfile", "Write log messages to file.", false, "", "logfile")
     , logConsole_("c", "logconsole", "Write log messages to console (cout)", false)
+    , trace_("", "trace",
+             "Record trace events and write them to file in the Chrome trace event format on exit. "
+             "Requires a build with IVW_CFG_PROFILING enabled.",
+             false, "", "trace file")
+    , statistics_("", "statistics",
+                  "Collect per processor performance statistics and write them to file on exit. "
+                  "Written as JSON if the file extension is .json otherwise as CSV.",
+                  false, "", "statistics file")
+    , startupReport_("", "startup-report",
+                     "Log the time spent loading and constructing each module at startup.", false)
     , noSplashScreen_("n", "nosplash", "Pass this flag if you do not want to show a splash screen.")
     , quitAfterStartup_("q", "quit", "Pass this flag if you want to close inviwo after startup.")
     , wildcard_()
@@ -76,6 +86,9 @@ CommandLineParser::CommandLineParser(int argc, char** argv)
     cmdQuiet_.add(noSplashScreen_);
     cmdQuiet_.add(logfile_);
     cmdQuiet_.add(logConsole_);
+    cmdQuiet_.add(trace_);
+    cmdQuiet_.add(statistics_);
+    cmdQuiet_.add(startupReport_);
     cmdQuiet_.add(helpQuiet_);
     cmdQuiet_.add(versionQuiet_);
     cmdQuiet_.add(disableResourceManager_);
@@ -87,6 +100,9 @@ CommandLineParser::CommandLineParser(int argc, char** argv)
     cmd_.add(noSplashScreen_);
     cmd_.add(logfile_);
     cmd_.add(logConsole_);
+    cmd_.add(trace_);
+    cmd_.add(statistics_);
+    cmd_.add(startupReport_);
     cmd_.add(disableResourceManager_);
 
     parse(Mode::Quiet);
@@ -149,6 +165,16 @@ const std::string CommandLineParser::getLogToFileFileName() const {
         return "";
 }
 
+const std::string CommandLineParser::getTraceFileName() const {
+    if (trace_.isSet()) return trace_.getValue();
+    return "";
+}
+
+const std::string CommandLineParser::getStatisticsFileName() const {
+    if (statistics_.isSet()) return statistics_.getValue();
+    return "";
+}
+
 bool CommandLineParser::getQuitApplicationAfterStartup() const {
     return quitAfterStartup_.getValue();
 }
@@ -182,6 +208,12 @@ bool CommandLineParser::getLogToFile() const {
 
 bool CommandLineParser::getLogToConsole() const { return logConsole_.isSet(); }
 
+bool CommandLineParser::getTrace() const { return trace_.isSet(); }
+
+bool CommandLineParser::getStatistics() const { return statistics_.isSet(); }
+
+bool CommandLineParser::getStartupReport() const { return startupReport_.isSet(); }
+
 bool CommandLineParser::getDisableResourceManager() const {
     return disableResourceManager_.isSet();
 }
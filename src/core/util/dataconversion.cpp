@@ -0,0 +1,102 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/util/dataconversion.h>
+
+#include <inviwo/core/util/exception.h>
+#include <inviwo/core/util/foreach.h>
+#include <inviwo/core/util/formatdispatching.h>
+#include <inviwo/core/util/formats.h>
+
+#include <algorithm>
+
+namespace inviwo {
+
+namespace util {
+
+LinearMapping::LinearMapping(dvec2 from, dvec2 to)
+    : scale{(to.y - to.x) / (from.y - from.x)}, offset{to.x - from.x * scale} {}
+
+namespace {
+
+constexpr size_t minValuesPerJob = size_t{1} << 18;
+
+template <typename Dst, typename Src>
+void convertChunks(const Src* src, Dst* dst, size_t size,
+                   const std::optional<LinearMapping>& mapping) {
+    forEachRange(size, jobCount(size, 1, minValuesPerJob), [&](size_t begin, size_t end, size_t) {
+        if (mapping) {
+            convertValues(src + begin, dst + begin, end - begin, *mapping);
+        } else {
+            convertValues(src + begin, dst + begin, end - begin);
+        }
+    });
+}
+
+struct ConvertDst {
+    template <typename Result, typename DstFormat, typename Src>
+    void operator()(const Src* src, void* dst, size_t size,
+                    const std::optional<LinearMapping>& mapping) {
+        convertChunks(src, static_cast<typename DstFormat::type*>(dst), size, mapping);
+    }
+};
+
+struct ConvertSrc {
+    template <typename Result, typename SrcFormat>
+    void operator()(const void* src, DataFormatId dstId, void* dst, size_t size,
+                    const std::optional<LinearMapping>& mapping) {
+        dispatching::dispatch<void, dispatching::filter::Scalars>(
+            dstId, ConvertDst{}, static_cast<const typename SrcFormat::type*>(src), dst, size,
+            mapping);
+    }
+};
+
+}  // namespace
+
+void convertData(const DataFormatBase* srcFormat, const void* src,
+                 const DataFormatBase* dstFormat, void* dst, size_t size,
+                 std::optional<LinearMapping> mapping) {
+    if (srcFormat->getComponents() != dstFormat->getComponents()) {
+        throw Exception("Cannot convert " + std::string(srcFormat->getString()) + " to " +
+                            std::string(dstFormat->getString()) +
+                            ", the number of components differ",
+                        IVW_CONTEXT_CUSTOM("util::convertData"));
+    }
+    // glm vectors are tightly packed, convert all components as a flat array of scalars
+    const auto components = srcFormat->getComponents();
+    const auto scalar = [&](const DataFormatBase* format) {
+        return DataFormatBase::get(format->getNumericType(), 1, format->getPrecision())->getId();
+    };
+    dispatching::dispatch<void, dispatching::filter::Scalars>(
+        scalar(srcFormat), ConvertSrc{}, src, scalar(dstFormat), dst, size * components, mapping);
+}
+
+}  // namespace util
+
+}  // namespace inviwo
@@ -0,0 +1,95 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/util/foreach.h>
+#include <inviwo/core/common/inviwoapplication.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+
+namespace inviwo {
+
+void util::forEachRange(size_t count, size_t jobs,
+                        const std::function<void(size_t, size_t, size_t)>& func) {
+    if (count == 0) return;
+    jobs = std::clamp(jobs, size_t{1}, count);
+    if (jobs == 1 || !InviwoApplication::isInitialized() ||
+        InviwoApplication::getPtr()->getPoolSize() == 0) {
+        for (size_t job = 0; job < jobs; ++job) {
+            func(count * job / jobs, count * (job + 1) / jobs, job);
+        }
+        return;
+    }
+
+    struct State {
+        std::atomic<size_t> next{0};
+        std::mutex mutex;
+        std::condition_variable finished;
+        size_t done = 0;
+        std::exception_ptr error;
+    };
+    auto state = std::make_shared<State>();
+
+    // Pool tasks that start after all jobs are claimed return without touching func
+    auto work = [state, count, jobs, func = &func]() {
+        for (size_t job = state->next++; job < jobs; job = state->next++) {
+            std::exception_ptr error;
+            try {
+                (*func)(count * job / jobs, count * (job + 1) / jobs, job);
+            } catch (...) {
+                error = std::current_exception();
+            }
+            std::scoped_lock lock{state->mutex};
+            if (error && !state->error) state->error = error;
+            if (++state->done == jobs) state->finished.notify_all();
+        }
+    };
+
+    auto app = InviwoApplication::getPtr();
+    const size_t helpers = std::min(jobs - 1, app->getPoolSize());
+    for (size_t i = 0; i < helpers; ++i) app->dispatchPool(work);
+    work();
+
+    std::unique_lock lock{state->mutex};
+    state->finished.wait(lock, [&]() { return state->done == jobs; });
+    if (state->error) std::rethrow_exception(state->error);
+}
+
+size_t util::jobCount(size_t count, size_t costPerItem, size_t minCostPerJob) {
+    const size_t poolSize =
+        InviwoApplication::isInitialized() ? InviwoApplication::getPtr()->getPoolSize() : 0;
+    const size_t maxJobs = count * costPerItem / std::max(size_t{1}, minCostPerJob);
+    return std::max(size_t{1}, std::min({4 * poolSize, count, maxJobs}));
+}
+
+}  // namespace inviwo
@@ -31,8 +31,14 @@
 #include <inviwo/core/datastructures/image/image.h>
 #include <inviwo/core/util/stdextensions.h>
 
+#include <atomic>
+
 namespace inviwo {
 
+namespace {
+std::atomic<size_t> defaultMaxSizeInBytes{std::numeric_limits<size_t>::max()};
+}
+
 ImageCache::ImageCache(std::shared_ptr<const Image> master) : valid_(true), master_(master) {}
 
 void ImageCache::setMaster(std::shared_ptr<const Image> master) {
@@ -60,12 +66,15 @@ std::shared_ptr<const Image> ImageCache::getImage(const size2_t dimensions) cons
     // look for size in cache_
     auto it = cache_.find(dimensions);
     if (it != cache_.end()) {
+        touch(dimensions);
         return it->second;
     } else {
         auto newImage = std::shared_ptr<Image>(master_->clone());
         newImage->setDimensions(dimensions);
         master_->copyRepresentationsTo(newImage.get());
         cache_[newImage->getDimensions()] = newImage;
+        touch(dimensions);
+        evict(dimensions);
         return newImage;
     }
 }
@@ -119,7 +128,12 @@ bool ImageCache::hasImage(const size2_t dimensions) {
     return cache_.find(dimensions) != cache_.end();
 }
 
-void ImageCache::addImage(std::shared_ptr<Image> image) { cache_[image->getDimensions()] = image; }
+void ImageCache::addImage(std::shared_ptr<Image> image) {
+    const auto dimensions = image->getDimensions();
+    cache_[dimensions] = image;
+    touch(dimensions);
+    evict(dimensions);
+}
 
 std::shared_ptr<Image> ImageCache::releaseImage(const size2_t dimensions) {
     auto it = cache_.find(dimensions);
@@ -149,4 +163,61 @@ std::shared_ptr<Image> ImageCache::getUnusedImage(const std::vector<size2_t>& di
 
 size_t ImageCache::size() const { return cache_.size(); }
 
+void ImageCache::setMaxSizeInBytes(size_t bytes) {
+    maxSizeInBytes_ = bytes;
+    if (bytes == std::numeric_limits<size_t>::max()) lastUse_.clear();
+    evict(master_ ? master_->getDimensions() : size2_t{0});
+}
+
+size_t ImageCache::getMaxSizeInBytes() const {
+    return maxSizeInBytes_ ? *maxSizeInBytes_ : getDefaultMaxSizeInBytes();
+}
+
+void ImageCache::setDefaultMaxSizeInBytes(size_t bytes) { defaultMaxSizeInBytes = bytes; }
+
+size_t ImageCache::getDefaultMaxSizeInBytes() { return defaultMaxSizeInBytes; }
+
+size_t ImageCache::getSizeInBytes() const {
+    size_t size = 0;
+    for (const auto& elem : cache_) size += elem.second->getSizeInBytes();
+    return size;
+}
+
+void ImageCache::touch(const size2_t dimensions) const {
+    // the order of use is only needed to evict images when there is a limit
+    if (getMaxSizeInBytes() == std::numeric_limits<size_t>::max()) return;
+
+    lastUse_[dimensions] = ++useCounter_;
+
+    // forget the use of sizes that are no longer cached, to keep lastUse_ as small as cache_
+    if (lastUse_.size() > cache_.size()) {
+        util::map_erase_remove_if(
+            lastUse_, [&](const auto& elem) { return cache_.find(elem.first) == cache_.end(); });
+    }
+}
+
+void ImageCache::evict(const size2_t keep) const {
+    const auto maxSizeInBytes = getMaxSizeInBytes();
+    if (maxSizeInBytes == std::numeric_limits<size_t>::max()) return;
+
+    auto size = getSizeInBytes();
+    while (size > maxSizeInBytes) {
+        auto lru = cache_.end();
+        size_t lruUse = std::numeric_limits<size_t>::max();
+        for (auto it = cache_.begin(); it != cache_.end(); ++it) {
+            if (it->first == keep) continue;
+            const auto found = lastUse_.find(it->first);
+            const size_t use = found != lastUse_.end() ? found->second : 0;
+            if (use < lruUse) {
+                lruUse = use;
+                lru = it;
+            }
+        }
+        if (lru == cache_.end()) break;
+        size -= lru->second->getSizeInBytes();
+        lastUse_.erase(lru->first);
+        cache_.erase(lru);
+    }
+}
+
 }  // namespace inviwo
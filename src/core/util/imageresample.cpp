@@ -0,0 +1,262 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/util/imageresample.h>
+
+#include <inviwo/core/datastructures/image/layerram.h>
+#include <inviwo/core/util/dataconversion.h>
+#include <inviwo/core/util/exception.h>
+#include <inviwo/core/util/foreach.h>
+#include <inviwo/core/util/formatdispatching.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+namespace inviwo {
+
+namespace util {
+
+namespace {
+
+constexpr size_t minValuesPerJob = size_t{1} << 16;
+
+double filterRadius(ResampleFilter filter) {
+    switch (filter) {
+        case ResampleFilter::Box:
+            return 0.5;
+        case ResampleFilter::Bilinear:
+            return 1.0;
+        case ResampleFilter::Lanczos3:
+            return 3.0;
+        case ResampleFilter::Nearest:
+        default:
+            return 0.0;
+    }
+}
+
+double filterWeight(ResampleFilter filter, double x) {
+    constexpr double pi = 3.14159265358979323846;
+    const auto sinc = [&](double v) {
+        if (v == 0.0) return 1.0;
+        // exact zeros at the integers, keeps resampling to the same size lossless
+        if (v == std::round(v)) return 0.0;
+        return std::sin(pi * v) / (pi * v);
+    };
+    switch (filter) {
+        case ResampleFilter::Box:
+            return x > -0.5 && x <= 0.5 ? 1.0 : 0.0;
+        case ResampleFilter::Bilinear:
+            return std::max(0.0, 1.0 - std::abs(x));
+        case ResampleFilter::Lanczos3:
+            return std::abs(x) < 3.0 ? sinc(x) * sinc(x / 3.0) : 0.0;
+        case ResampleFilter::Nearest:
+        default:
+            return 0.0;
+    }
+}
+
+/**
+ * Filter weights along one axis, output pixel i is the weighted sum of the source pixels
+ * [first[i], first[i] + count[i]) with the weights starting at weights[i * taps].
+ */
+struct AxisWeights {
+    AxisWeights(size_t srcSize, size_t dstSize, ResampleFilter filter)
+        : first(dstSize), count(dstSize) {
+        const double scale = static_cast<double>(srcSize) / static_cast<double>(dstSize);
+        const auto last = static_cast<long long>(srcSize) - 1;
+        const auto clampIndex = [&](long long j) { return std::clamp(j, 0LL, last); };
+
+        if (filter == ResampleFilter::Nearest) {
+            taps = 1;
+            weights.assign(dstSize, 1.0f);
+            for (size_t i = 0; i < dstSize; ++i) {
+                first[i] = static_cast<size_t>(
+                    clampIndex(static_cast<long long>(std::floor((i + 0.5) * scale))));
+                count[i] = 1;
+            }
+            return;
+        }
+
+        // widen the filter when minifying to average over all covered source pixels
+        const double filterScale = std::max(1.0, scale);
+        const double radius = filterRadius(filter) * filterScale;
+        taps = static_cast<size_t>(std::ceil(2.0 * radius)) + 1;
+        weights.assign(dstSize * taps, 0.0f);
+
+        std::vector<double> w(taps);
+        for (size_t i = 0; i < dstSize; ++i) {
+            const double center = (i + 0.5) * scale - 0.5;
+            const auto lo = static_cast<long long>(std::ceil(center - radius));
+            const auto hi = static_cast<long long>(std::floor(center + radius));
+            const auto begin = clampIndex(lo);
+            std::fill(w.begin(), w.end(), 0.0);
+            double sum = 0.0;
+            // samples outside of the source are clamped to the border pixels
+            for (auto j = lo; j <= hi; ++j) {
+                const double weight =
+                    filterWeight(filter, (static_cast<double>(j) - center) / filterScale);
+                w[static_cast<size_t>(clampIndex(j) - begin)] += weight;
+                sum += weight;
+            }
+            first[i] = static_cast<size_t>(begin);
+            count[i] = static_cast<size_t>(clampIndex(hi) - begin) + 1;
+            if (sum == 0.0) {
+                first[i] = static_cast<size_t>(clampIndex(std::llround(center)));
+                count[i] = 1;
+                weights[i * taps] = 1.0f;
+            } else {
+                for (size_t k = 0; k < count[i]; ++k) {
+                    weights[i * taps + k] = static_cast<float>(w[k] / sum);
+                }
+            }
+        }
+    }
+
+    std::vector<size_t> first;
+    std::vector<size_t> count;
+    std::vector<float> weights;
+    size_t taps = 1;
+};
+
+template <typename P, typename Acc>
+P fromAccumulator(Acc v) {
+    if constexpr (std::is_integral_v<P>) {
+        return saturate_cast<P>(std::round(v));
+    } else {
+        return saturate_cast<P>(v);
+    }
+}
+
+}  // namespace
+
+void resample(const LayerRAM& src, LayerRAM& dst, size2_t offset, size2_t size,
+              ResampleFilter filter) {
+    if (src.getDataFormat() != dst.getDataFormat()) {
+        throw Exception("Cannot resample " + std::string(src.getDataFormat()->getString()) +
+                            " into " + std::string(dst.getDataFormat()->getString()),
+                        IVW_CONTEXT_CUSTOM("util::resample"));
+    }
+    const size2_t dstDims = dst.getDimensions();
+    if (glm::any(glm::greaterThan(offset + size, dstDims))) {
+        throw Exception("Resample region is outside of the destination",
+                        IVW_CONTEXT_CUSTOM("util::resample"));
+    }
+    const size2_t srcDims = src.getDimensions();
+    if (glm::compMul(size) == 0 || glm::compMul(srcDims) == 0) return;
+
+    const AxisWeights wx(srcDims.x, size.x, filter);
+    const AxisWeights wy(srcDims.y, size.y, filter);
+
+    src.dispatch<void, dispatching::filter::All>([&](auto srcPr) {
+        using ValueType = util::PrecisionValueType<decltype(srcPr)>;
+        using P = typename util::value_type<ValueType>::type;
+        // accumulate in double for types where float would lose precision
+        using Acc = std::conditional_t<(sizeof(P) >= 4 && !std::is_same_v<P, float>), double,
+                                       float>;
+        constexpr size_t C = util::extent<ValueType>::value;
+
+        const auto srcData = reinterpret_cast<const P*>(srcPr->getDataTyped());
+        const auto dstData = static_cast<P*>(dst.getData());
+
+        // horizontal pass: every source row to the destination width
+        std::vector<Acc> tmp(srcDims.y * size.x * C);
+        const size_t xJobs = jobCount(srcDims.y, size.x * C * wx.taps, minValuesPerJob);
+        forEachRange(srcDims.y, xJobs, [&](size_t begin, size_t end, size_t) {
+            for (size_t y = begin; y < end; ++y) {
+                const P* srcRow = srcData + y * srcDims.x * C;
+                Acc* tmpRow = tmp.data() + y * size.x * C;
+                for (size_t x = 0; x < size.x; ++x) {
+                    const float* w = wx.weights.data() + x * wx.taps;
+                    const P* s = srcRow + wx.first[x] * C;
+                    Acc acc[C] = {};
+                    for (size_t k = 0; k < wx.count[x]; ++k) {
+                        for (size_t c = 0; c < C; ++c) {
+                            acc[c] += static_cast<Acc>(w[k]) * static_cast<Acc>(s[k * C + c]);
+                        }
+                    }
+                    std::copy(acc, acc + C, tmpRow + x * C);
+                }
+            }
+        });
+
+        // vertical pass: blend whole rows, the inner loop runs over contiguous memory
+        const size_t rowValues = size.x * C;
+        const size_t yJobs = jobCount(size.y, rowValues * wy.taps, minValuesPerJob);
+        forEachRange(size.y, yJobs, [&](size_t begin, size_t end, size_t) {
+            std::vector<Acc> acc(rowValues);
+            for (size_t y = begin; y < end; ++y) {
+                std::fill(acc.begin(), acc.end(), Acc{0});
+                const float* w = wy.weights.data() + y * wy.taps;
+                for (size_t k = 0; k < wy.count[y]; ++k) {
+                    const Acc* tmpRow = tmp.data() + (wy.first[y] + k) * rowValues;
+                    const auto weight = static_cast<Acc>(w[k]);
+                    for (size_t i = 0; i < rowValues; ++i) {
+                        acc[i] += weight * tmpRow[i];
+                    }
+                }
+                P* dstRow = dstData + ((offset.y + y) * dstDims.x + offset.x) * C;
+                for (size_t i = 0; i < rowValues; ++i) {
+                    dstRow[i] = fromAccumulator<P>(acc[i]);
+                }
+            }
+        });
+    });
+}
+
+void resample(const LayerRAM& src, LayerRAM& dst, ResampleFilter filter) {
+    resample(src, dst, size2_t{0}, dst.getDimensions(), filter);
+}
+
+void resampleToFit(const LayerRAM& src, LayerRAM& dst, ResampleFilter filter) {
+    const dvec2 srcDims{src.getDimensions()};
+    const size2_t dstDims = dst.getDimensions();
+    if (glm::compMul(srcDims) == 0.0 || glm::compMul(dstDims) == 0) return;
+    const double srcAspect = srcDims.x / srcDims.y;
+    const double dstAspect = static_cast<double>(dstDims.x) / static_cast<double>(dstDims.y);
+
+    const size2_t size = glm::min(
+        glm::max(srcAspect > dstAspect
+                     ? size2_t{dstDims.x, static_cast<size_t>(dstDims.x / srcAspect)}
+                     : size2_t{static_cast<size_t>(dstDims.y * srcAspect), dstDims.y},
+                 size2_t{1}),
+        dstDims);
+    const size2_t offset = dstDims / size_t{2} - size / size_t{2};
+
+    if (size != dstDims) {
+        std::memset(dst.getData(), 0, glm::compMul(dstDims) * dst.getDataFormat()->getSize());
+    }
+    resample(src, dst, offset, size, filter);
+}
+
+}  // namespace util
+
+}  // namespace inviwo
@@ -53,6 +53,10 @@ SystemSettings::SystemSettings(InviwoApplication* app)
     , logStackTraceProperty_("logStackTraceProperty", "Error stack trace log", false)
     , runtimeModuleReloading_("runtimeModuleReloding", "Runtime Module Reloading", false)
     , enableResourceManager_("enableResourceManager", "Enable Resource Manager", false)
+    , representationMemoryBudget_("representationMemoryBudget",
+                                  "Representation Memory Budget (MB, 0 = unlimited)", 0, 0, 262144)
+    , imageCacheBudget_("imageCacheBudget", "Image Cache Budget (MB per cache, 0 = unlimited)", 0,
+                        0, 65536)
     , breakOnMessage_{"breakOnMessage",
                       "Break on Message",
                       {MessageBreakLevel::Off, MessageBreakLevel::Error, MessageBreakLevel::Warn,
@@ -74,6 +78,8 @@ SystemSettings::SystemSettings(InviwoApplication* app)
     addProperty(logStackTraceProperty_);
     addProperty(runtimeModuleReloading_);
     addProperty(enableResourceManager_);
+    addProperty(representationMemoryBudget_);
+    addProperty(imageCacheBudget_);
     addProperty(breakOnMessage_);
     addProperty(breakOnException_);
     addProperty(stackTraceInException_);
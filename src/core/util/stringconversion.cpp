@@ -345,6 +345,37 @@ std::string_view util::trim(std::string_view s) {
     return s.substr(std::distance(s.begin(), left), std::distance(left, right) + 1);
 }
 
+void util::writeJsonString(std::ostream& os, std::string_view str) {
+    constexpr char hex[] = "0123456789abcdef";
+    os << '"';
+    for (const char c : str) {
+        switch (c) {
+            case '"':
+                os << "\\\"";
+                break;
+            case '\\':
+                os << "\\\\";
+                break;
+            case '\n':
+                os << "\\n";
+                break;
+            case '\r':
+                os << "\\r";
+                break;
+            case '\t':
+                os << "\\t";
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    os << "\\u00" << hex[(c >> 4) & 0xf] << hex[c & 0xf];
+                } else {
+                    os << c;
+                }
+        }
+    }
+    os << '"';
+}
+
 std::string removeSubString(std::string_view str, std::string_view strToRemove) {
     std::string newString(str);
     size_t pos;
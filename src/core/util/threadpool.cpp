@@ -31,6 +31,9 @@
 #include <inviwo/core/util/raiiutils.h>
 #include <inviwo/core/util/stdextensions.h>
 #include <inviwo/core/util/threadutil.h>
+#include <inviwo/core/util/tracing.h>
+
+#include <algorithm>
 
 namespace inviwo {
 
@@ -75,6 +78,13 @@ size_t ThreadPool::getQueueSize() {
     return tasks.size();
 }
 
+bool ThreadPool::isIdle() {
+    std::unique_lock<std::mutex> lock(queue_mutex);
+    return tasks.empty() && std::none_of(workers.begin(), workers.end(), [](const auto& worker) {
+               return worker->state == State::Working;
+           });
+}
+
 ThreadPool::~ThreadPool() {
     for (auto& worker : workers) worker->state = State::Abort;
     condition.notify_all();
@@ -86,6 +96,9 @@ ThreadPool::Worker::~Worker() { thread.join(); }
 ThreadPool::Worker::Worker(ThreadPool& pool)
     : state{State::Free}, thread{[this, &pool]() {
         pool.onThreadStart_();
+#if IVW_PROFILING
+        Tracer::get().setThreadName("Inviwo Worker Thread");
+#endif
         util::OnScopeExit cleanup{[&pool]() { pool.onThreadStop_(); }};
 
         for (;;) {
@@ -99,9 +112,11 @@ ThreadPool::Worker::Worker(ThreadPool& pool)
                 if (state == State::Abort || (state == State::Stop && pool.tasks.empty())) break;
                 task = std::move(pool.tasks.front());
                 pool.tasks.pop();
+                // Set while locked, so that isIdle() never misses a dequeued task
+                state = State::Working;
             }
-            state = State::Working;
             try {
+                IVW_TRACE_SCOPE("pool", "Task");
                 task();
             } catch (...) {  // Make sure we don't leak any exceptions.
             }
@@ -0,0 +1,200 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/util/tracing.h>
+#include <inviwo/core/util/filesystem.h>
+#include <inviwo/core/util/exception.h>
+#include <inviwo/core/util/stringconversion.h>
+
+#include <algorithm>
+#include <ostream>
+#include <iomanip>
+
+namespace inviwo {
+
+namespace {
+
+constexpr size_t defaultCapacity = 1 << 16;
+
+}  // namespace
+
+struct Tracer::ThreadBuffer {
+    ThreadBuffer(std::uint32_t aId, size_t aCapacity) : id{aId}, capacity{aCapacity} {}
+
+    std::mutex mutex;
+    const std::uint32_t id;
+    std::string name;
+    size_t capacity;
+    std::vector<Event> events;
+    size_t next = 0;  //< index of the oldest event when the buffer is full
+};
+
+std::atomic<bool> Tracer::enabled_{false};
+
+Tracer::Tracer() : epoch_{clock::now()}, capacity_{defaultCapacity} {}
+
+Tracer& Tracer::get() {
+    static Tracer tracer;
+    return tracer;
+}
+
+void Tracer::setEnabled(bool enabled) { enabled_.store(enabled, std::memory_order_relaxed); }
+
+void Tracer::setBufferCapacity(size_t capacity) {
+    std::scoped_lock lock{mutex_};
+    capacity_ = std::max(size_t{1}, capacity);
+    for (auto& buffer : buffers_) {
+        std::scoped_lock bufferLock{buffer->mutex};
+        buffer->capacity = capacity_;
+        buffer->events.clear();
+        buffer->events.shrink_to_fit();
+        buffer->next = 0;
+    }
+}
+
+size_t Tracer::getBufferCapacity() const {
+    std::scoped_lock lock{mutex_};
+    return capacity_;
+}
+
+auto Tracer::threadBuffer() -> ThreadBuffer& {
+    thread_local std::shared_ptr<ThreadBuffer> buffer = [this]() {
+        std::scoped_lock lock{mutex_};
+        auto buff = std::make_shared<ThreadBuffer>(static_cast<std::uint32_t>(buffers_.size() + 1),
+                                                   capacity_);
+        buffers_.push_back(buff);
+        return buff;
+    }();
+    return *buffer;
+}
+
+void Tracer::setThreadName(std::string_view name) {
+    auto& buffer = threadBuffer();
+    std::scoped_lock lock{buffer.mutex};
+    buffer.name = name;
+}
+
+void Tracer::record(std::string_view category, std::string_view name, clock::time_point start,
+                    clock::time_point end) {
+    auto& buffer = threadBuffer();
+    using std::chrono::duration_cast;
+    using std::chrono::nanoseconds;
+    const auto startNs = duration_cast<nanoseconds>(start - epoch_).count();
+    const auto durationNs = duration_cast<nanoseconds>(end - start).count();
+
+    std::scoped_lock lock{buffer.mutex};
+    if (buffer.events.size() < buffer.capacity) {
+        buffer.events.push_back(Event{category, std::string{name}, buffer.id, startNs, durationNs});
+    } else {
+        auto& event = buffer.events[buffer.next];
+        event.category = category;
+        event.name.assign(name.begin(), name.end());
+        event.start = startNs;
+        event.duration = durationNs;
+        buffer.next = (buffer.next + 1) % buffer.capacity;
+    }
+}
+
+void Tracer::clear() {
+    std::scoped_lock lock{mutex_};
+    for (auto& buffer : buffers_) {
+        std::scoped_lock bufferLock{buffer->mutex};
+        buffer->events.clear();
+        buffer->next = 0;
+    }
+}
+
+auto Tracer::getEvents() const -> std::vector<Event> {
+    std::vector<Event> events;
+    {
+        std::scoped_lock lock{mutex_};
+        for (auto& buffer : buffers_) {
+            std::scoped_lock bufferLock{buffer->mutex};
+            events.insert(events.end(), buffer->events.begin(), buffer->events.end());
+        }
+    }
+    // Sort enclosing scopes before nested ones when they start at the same time
+    std::stable_sort(events.begin(), events.end(), [](const Event& a, const Event& b) {
+        return a.start < b.start || (a.start == b.start && a.duration > b.duration);
+    });
+    return events;
+}
+
+void Tracer::exportChromeTrace(std::ostream& os) const {
+    const auto events = getEvents();
+
+    std::vector<std::pair<std::uint32_t, std::string>> threadNames;
+    {
+        std::scoped_lock lock{mutex_};
+        for (auto& buffer : buffers_) {
+            std::scoped_lock bufferLock{buffer->mutex};
+            if (!buffer->name.empty()) threadNames.emplace_back(buffer->id, buffer->name);
+        }
+    }
+
+    const auto flags = os.flags();
+    const auto precision = os.precision();
+    os << std::fixed << std::setprecision(3);
+
+    os << "{\"traceEvents\":[\n";
+    bool first = true;
+    for (const auto& [id, name] : threadNames) {
+        if (!first) os << ",\n";
+        first = false;
+        os << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << id
+           << ",\"args\":{\"name\":";
+        util::writeJsonString(os, name);
+        os << "}}";
+    }
+    for (const auto& event : events) {
+        if (!first) os << ",\n";
+        first = false;
+        os << "{\"name\":";
+        util::writeJsonString(os, event.name);
+        os << ",\"cat\":";
+        util::writeJsonString(os, event.category);
+        os << ",\"ph\":\"X\",\"ts\":" << static_cast<double>(event.start) / 1000.0
+           << ",\"dur\":" << static_cast<double>(event.duration) / 1000.0
+           << ",\"pid\":1,\"tid\":" << event.threadId << "}";
+    }
+    os << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+    os.flags(flags);
+    os.precision(precision);
+}
+
+void Tracer::exportChromeTrace(const std::string& filename) const {
+    auto ofs = filesystem::ofstream(filename);
+    if (!ofs) {
+        throw Exception("Could not open file \"" + filename + "\" for writing", IVW_CONTEXT);
+    }
+    exportChromeTrace(ofs);
+}
+
+}  // namespace inviwo
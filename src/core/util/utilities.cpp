@@ -34,6 +34,7 @@
 #include <inviwo/core/processors/canvasprocessor.h>
 #include <inviwo/core/processors/processorwidget.h>
 #include <inviwo/core/util/stringconversion.h>
+#include <inviwo/core/io/imageexportqueue.h>
 
 #include <inviwo/core/properties/property.h>
 #include <fmt/format.h>
@@ -55,7 +56,7 @@ void saveNetwork(ProcessorNetwork* network, std::string_view filename) {
 }
 
 void saveAllCanvases(ProcessorNetwork* network, std::string_view dir, std::string_view name,
-                     std::string_view ext, bool onlyActiveCanvases) {
+                     std::string_view ext, bool onlyActiveCanvases, ImageExportQueue* queue) {
 
     // Get all canvases, possibly only the active ones. We need their count below.
     auto allCanvases = network->getProcessorsByType<inviwo::CanvasProcessor>();
@@ -101,7 +102,13 @@ void saveAllCanvases(ProcessorNetwork* network, std::string_view dir, std::strin
             }
 
             LogInfoCustom("util::saveAllCanvases", "Saving canvas to: " << filepath.view());
-            cp->saveImageLayer(filepath.view());
+            if (!queue) {
+                cp->saveImageLayer(filepath.view());
+            } else if (auto layer = cp->getVisibleLayer()) {
+                queue->enqueue(*layer, filepath.view());
+            } else {
+                LogErrorCustom("util::saveAllCanvases", "Could not find visible layer");
+            }
         }
         i++;
     }
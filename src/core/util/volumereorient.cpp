@@ -0,0 +1,295 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/util/volumereorient.h>
+
+#include <inviwo/core/datastructures/volume/volumeram.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/util/exception.h>
+#include <inviwo/core/util/foreach.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+namespace inviwo {
+
+namespace util {
+
+namespace {
+
+constexpr size_t tileSize = 32;
+
+/**
+ * A voxel of N bytes, or of a size only known at runtime if N is zero. Fixed sizes let the
+ * compiler turn the copies into plain moves.
+ */
+template <size_t N>
+struct Voxel {
+    size_t size;
+
+    size_t bytes() const {
+        if constexpr (N == 0) {
+            return size;
+        } else {
+            return N;
+        }
+    }
+    void copy(char* dst, const char* src) const { std::memcpy(dst, src, bytes()); }
+    void swap(char* a, char* b) const {
+        if constexpr (N == 0) {
+            std::swap_ranges(a, a + size, b);
+        } else {
+            std::array<char, N> tmp;
+            std::memcpy(tmp.data(), a, N);
+            std::memcpy(a, b, N);
+            std::memcpy(b, tmp.data(), N);
+        }
+    }
+};
+
+template <typename F>
+void dispatchVoxel(size_t elemSize, F&& func) {
+    switch (elemSize) {
+        case 1:
+            return func(Voxel<1>{1});
+        case 2:
+            return func(Voxel<2>{2});
+        case 3:
+            return func(Voxel<3>{3});
+        case 4:
+            return func(Voxel<4>{4});
+        case 6:
+            return func(Voxel<6>{6});
+        case 8:
+            return func(Voxel<8>{8});
+        case 12:
+            return func(Voxel<12>{12});
+        case 16:
+            return func(Voxel<16>{16});
+        case 24:
+            return func(Voxel<24>{24});
+        case 32:
+            return func(Voxel<32>{32});
+        default:
+            return func(Voxel<0>{elemSize});
+    }
+}
+
+void validate(const AxisReorientation& reorientation) {
+    auto permutation = reorientation.permutation;
+    std::sort(permutation.begin(), permutation.end());
+    if (permutation != std::array<size_t, 3>{0, 1, 2}) {
+        throw Exception("Invalid axis permutation", IVW_CONTEXT_CUSTOM("util::reorient"));
+    }
+}
+
+template <size_t N>
+void copyReoriented(const char* src, char* dst, size3_t srcDims, Voxel<N> voxel,
+                    const AxisReorientation& reorientation) {
+    using index = std::ptrdiff_t;
+    const auto dims = reorientation.apply(srcDims);
+    const auto bytes = static_cast<index>(voxel.bytes());
+    const std::array<index, 3> srcStrides{1, static_cast<index>(srcDims.x),
+                                          static_cast<index>(srcDims.x * srcDims.y)};
+
+    // The source step, in voxels, along each axis of the result, and the source voxel of the
+    // first voxel of the result
+    std::array<index, 3> step{};
+    index origin = 0;
+    for (size_t i = 0; i < 3; ++i) {
+        step[i] = srcStrides[reorientation.permutation[i]];
+        if (reorientation.flip[i]) {
+            origin += step[i] * static_cast<index>(dims[i] - 1);
+            step[i] = -step[i];
+        }
+    }
+
+    if (reorientation.permutation[0] == 0) {
+        // Rows stay rows, copy them as a whole or reversed
+        const size_t rowBytes = dims.x * voxel.bytes();
+        const size_t rows = dims.y * dims.z;
+        forEachRange(rows, jobCount(rows, rowBytes), [&](size_t begin, size_t end, size_t) {
+            for (size_t row = begin; row < end; ++row) {
+                const auto y = static_cast<index>(row % dims.y);
+                const auto z = static_cast<index>(row / dims.y);
+                const char* from = src + (origin + y * step[1] + z * step[2]) * bytes;
+                char* to = dst + row * rowBytes;
+                if (step[0] == 1) {
+                    std::memcpy(to, from, rowBytes);
+                } else {
+                    for (index x = 0; x < static_cast<index>(dims.x); ++x) {
+                        voxel.copy(to + x * bytes, from - x * bytes);
+                    }
+                }
+            }
+        });
+    } else {
+        // Transpose tiles of x and the axis that runs along the rows of the source, such that
+        // both the reads and the writes of a tile stay in the cache
+        const size_t a = reorientation.permutation[1] == 0 ? 1 : 2;
+        const size_t b = 3 - a;
+        const std::array<index, 3> dstStrides{1, static_cast<index>(dims.x),
+                                              static_cast<index>(dims.x * dims.y)};
+        const auto sizeX = static_cast<index>(dims.x);
+        const auto sizeA = static_cast<index>(dims[a]);
+
+        const size_t sliceBytes = dims.x * dims[a] * voxel.bytes();
+        forEachRange(dims[b], jobCount(dims[b], sliceBytes), [&](size_t begin, size_t end, size_t) {
+            for (auto k = static_cast<index>(begin); k < static_cast<index>(end); ++k) {
+                for (index a0 = 0; a0 < sizeA; a0 += tileSize) {
+                    const auto a1 = std::min(sizeA, a0 + static_cast<index>(tileSize));
+                    for (index x0 = 0; x0 < sizeX; x0 += tileSize) {
+                        const auto x1 = std::min(sizeX, x0 + static_cast<index>(tileSize));
+                        for (index j = a0; j < a1; ++j) {
+                            const char* from = src + (origin + k * step[b] + j * step[a]) * bytes;
+                            char* to = dst + (k * dstStrides[b] + j * dstStrides[a]) * bytes;
+                            for (index x = x0; x < x1; ++x) {
+                                voxel.copy(to + x * bytes, from + x * step[0] * bytes);
+                            }
+                        }
+                    }
+                }
+            }
+        });
+    }
+}
+
+template <size_t N>
+void flipInPlace(char* data, size3_t dims, Voxel<N> voxel, std::array<bool, 3> flip) {
+    const size_t bytes = voxel.bytes();
+    const size_t rowBytes = dims.x * bytes;
+    const auto mirror = [&](size_t y, size_t z) {
+        return (flip[1] ? dims.y - 1 - y : y) + (flip[2] ? dims.z - 1 - z : z) * dims.y;
+    };
+
+    // Every row is swapped with its mirrored row, only visit the first row of each pair
+    const size_t rows = (flip[2] ? (dims.z + 1) / 2 : dims.z) * dims.y;
+    forEachRange(rows, jobCount(rows, rowBytes), [&](size_t begin, size_t end, size_t) {
+        for (size_t row = begin; row < end; ++row) {
+            const auto other = mirror(row % dims.y, row / dims.y);
+            if (other < row) continue;
+
+            char* a = data + row * rowBytes;
+            char* b = data + other * rowBytes;
+            if (other == row) {
+                if (!flip[0]) continue;
+                for (size_t x = 0; x < dims.x / 2; ++x) {
+                    voxel.swap(a + x * bytes, a + (dims.x - 1 - x) * bytes);
+                }
+            } else if (flip[0]) {
+                for (size_t x = 0; x < dims.x; ++x) {
+                    voxel.swap(a + x * bytes, b + (dims.x - 1 - x) * bytes);
+                }
+            } else {
+                std::swap_ranges(a, a + rowBytes, b);
+            }
+        }
+    });
+}
+
+Wrapping3D permute(const Wrapping3D& wrapping, const AxisReorientation& reorientation) {
+    return {wrapping[reorientation.permutation[0]], wrapping[reorientation.permutation[1]],
+            wrapping[reorientation.permutation[2]]};
+}
+
+}  // namespace
+
+bool AxisReorientation::isIdentity() const {
+    return isFlipOnly() && !flip[0] && !flip[1] && !flip[2];
+}
+
+bool AxisReorientation::isFlipOnly() const {
+    return permutation == std::array<size_t, 3>{0, 1, 2};
+}
+
+size3_t AxisReorientation::apply(size3_t dims) const {
+    return {dims[permutation[0]], dims[permutation[1]], dims[permutation[2]]};
+}
+
+void reorient(const void* src, void* dst, size3_t srcDims, size_t elemSize,
+              const AxisReorientation& reorientation) {
+    validate(reorientation);
+    dispatchVoxel(elemSize, [&](auto voxel) {
+        copyReoriented(static_cast<const char*>(src), static_cast<char*>(dst), srcDims, voxel,
+                       reorientation);
+    });
+}
+
+void reorientInPlace(void* data, size3_t dims, size_t elemSize,
+                     const AxisReorientation& reorientation) {
+    validate(reorientation);
+    if (reorientation.isIdentity()) return;
+
+    if (reorientation.isFlipOnly()) {
+        dispatchVoxel(elemSize, [&](auto voxel) {
+            flipInPlace(static_cast<char*>(data), dims, voxel, reorientation.flip);
+        });
+    } else {
+        const auto size = glm::compMul(dims) * elemSize;
+        auto copy = std::make_unique<char[]>(size);
+        std::memcpy(copy.get(), data, size);
+        reorient(copy.get(), data, dims, elemSize, reorientation);
+    }
+}
+
+std::shared_ptr<VolumeRAM> reorient(const VolumeRAM& volume,
+                                    const AxisReorientation& reorientation) {
+    validate(reorientation);
+    auto result = createVolumeRAM(reorientation.apply(volume.getDimensions()),
+                                  volume.getDataFormat(), nullptr, volume.getSwizzleMask(),
+                                  volume.getInterpolation(),
+                                  permute(volume.getWrapping(), reorientation));
+    reorient(volume.getData(), result->getData(), volume.getDimensions(),
+             volume.getDataFormat()->getSize(), reorientation);
+    return result;
+}
+
+void reorientInPlace(VolumeRAM& volume, const AxisReorientation& reorientation) {
+    validate(reorientation);
+    if (reorientation.isIdentity()) return;
+
+    const auto dims = volume.getDimensions();
+    const auto elemSize = volume.getDataFormat()->getSize();
+    if (reorientation.isFlipOnly()) {
+        reorientInPlace(volume.getData(), dims, elemSize, reorientation);
+    } else {
+        const auto size = glm::compMul(dims) * elemSize;
+        auto copy = std::make_unique<char[]>(size);
+        std::memcpy(copy.get(), volume.getData(), size);
+        volume.setDimensions(reorientation.apply(dims));
+        volume.setWrapping(permute(volume.getWrapping(), reorientation));
+        reorient(copy.get(), volume.getData(), dims, elemSize, reorientation);
+    }
+}
+
+}  // namespace util
+
+}  // namespace inviwo
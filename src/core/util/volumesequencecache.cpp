@@ -0,0 +1,170 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+
+#include <inviwo/core/util/volumesequencecache.h>
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/volumeram.h>
+#include <inviwo/core/datastructures/volume/volumedisk.h>
+#include <inviwo/core/util/tracing.h>
+
+#include <algorithm>
+#include <chrono>
+
+namespace inviwo {
+
+VolumeSequenceCache::VolumeSequenceCache(size_t budget, size_t prefetch)
+    : budget_{budget}, prefetch_{prefetch} {}
+
+VolumeSequenceCache::~VolumeSequenceCache() { waitAll(); }
+
+void VolumeSequenceCache::setSequence(std::shared_ptr<const VolumeSequence> sequence) {
+    if (sequence == sequence_) return;
+    waitAll();
+    sequence_ = std::move(sequence);
+    lastIndex_ = 0;
+    forward_ = true;
+}
+
+const std::shared_ptr<const VolumeSequence>& VolumeSequenceCache::getSequence() const {
+    return sequence_;
+}
+
+void VolumeSequenceCache::setBudget(size_t bytes) { budget_ = bytes; }
+
+size_t VolumeSequenceCache::getBudget() const { return budget_; }
+
+void VolumeSequenceCache::setPrefetchCount(size_t count) { prefetch_ = count; }
+
+size_t VolumeSequenceCache::getPrefetchCount() const { return prefetch_; }
+
+std::shared_ptr<Volume> VolumeSequenceCache::get(size_t index) {
+    if (!sequence_ || index >= sequence_->size()) return nullptr;
+    const auto size = sequence_->size();
+
+    // Take the shortest way around the sequence as the playback direction, to handle looping
+    if (index != lastIndex_) {
+        const auto steps = (index + size - lastIndex_) % size;
+        forward_ = steps <= size - steps;
+    }
+    lastIndex_ = index;
+
+    // Drop finished prefetches
+    for (auto it = pending_.begin(); it != pending_.end();) {
+        if (it->second.wait_for(std::chrono::seconds{0}) == std::future_status::ready) {
+            it = pending_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    wait(index);
+    auto volume = (*sequence_)[index];
+    volume->getRepresentation<VolumeRAM>();
+
+    for (size_t i = 1; i <= std::min(prefetch_, size - 1); ++i) {
+        prefetch(forward_ ? (index + i) % size : (index + size - i) % size);
+    }
+    evict(index);
+
+    return volume;
+}
+
+size_t VolumeSequenceCache::getUsedBytes() const {
+    if (!sequence_) return 0;
+    size_t bytes = 0;
+    for (const auto& volume : *sequence_) {
+        if (volume->hasRepresentation<VolumeRAM>()) bytes += volume->getSizeInBytes();
+    }
+    return bytes;
+}
+
+size_t VolumeSequenceCache::getEvictionCount() const { return evictions_; }
+
+void VolumeSequenceCache::wait(size_t index) {
+    if (auto it = pending_.find(index); it != pending_.end()) {
+        // A failed load will be retried, and reported, by the caller
+        it->second.wait();
+        pending_.erase(it);
+    }
+}
+
+void VolumeSequenceCache::waitAll() {
+    for (auto& item : pending_) item.second.wait();
+    pending_.clear();
+}
+
+void VolumeSequenceCache::prefetch(size_t index) {
+    if (pending_.count(index) != 0) return;
+    auto volume = (*sequence_)[index];
+    if (volume->hasValidRepresentation<VolumeRAM>()) return;
+
+    // Without pool threads the time step will be loaded when requested instead
+    auto app = InviwoApplication::getPtr();
+    if (!app || app->getPoolSize() == 0) return;
+
+    pending_.emplace(index, app->dispatchPool([volume]() {
+        IVW_TRACE_SCOPE("sequence", "prefetch");
+        volume->getRepresentation<VolumeRAM>();
+    }));
+}
+
+void VolumeSequenceCache::evict(size_t index) {
+    if (budget_ == 0) return;
+    auto used = getUsedBytes();
+    if (used <= budget_) return;
+
+    std::vector<size_t> candidates;
+    for (size_t i = 0; i < sequence_->size(); ++i) {
+        const auto& volume = (*sequence_)[i];
+        if (distance(index, i) > prefetch_ && pending_.count(i) == 0 &&
+            volume->hasValidRepresentation<VolumeRAM>() &&
+            volume->hasValidRepresentation<VolumeDisk>()) {
+            candidates.push_back(i);
+        }
+    }
+    std::sort(candidates.begin(), candidates.end(),
+              [&](size_t a, size_t b) { return distance(index, a) > distance(index, b); });
+
+    for (auto i : candidates) {
+        if (used <= budget_) break;
+        const auto& volume = (*sequence_)[i];
+        used -= std::min(used, volume->getSizeInBytes());
+        volume->removeRepresentation(volume->getRepresentation<VolumeRAM>());
+        ++evictions_;
+    }
+}
+
+size_t VolumeSequenceCache::distance(size_t from, size_t to) const {
+    const auto size = sequence_->size();
+    return forward_ ? (to + size - from) % size : (from + size - to) % size;
+}
+
+}  // namespace inviwo
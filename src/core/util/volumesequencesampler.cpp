@@ -28,10 +28,61 @@
  *********************************************************************************/
 
 #include <inviwo/core/datastructures/volume/volumeram.h>
+#include <inviwo/core/datastructures/volume/volumedisk.h>
 #include <inviwo/core/util/volumesequencesampler.h>
+#include <inviwo/core/common/inviwoapplication.h>
+
+#include <cstring>
+#include <unordered_set>
 
 namespace inviwo {
 
+VolumeSequenceSampler::Wrapper::~Wrapper() {
+    if (prefetch_.valid()) prefetch_.wait();
+}
+
+const VolumeDoubleSampler<4> &VolumeSequenceSampler::Wrapper::sampler() {
+    if (auto sampler = sampler_.load(std::memory_order_acquire)) return *sampler;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!storage_) {
+        storage_ = std::make_unique<VolumeDoubleSampler<4>>(load());
+        sampler_.store(storage_.get(), std::memory_order_release);
+    }
+    return *storage_;
+}
+
+std::shared_ptr<const Volume> VolumeSequenceSampler::Wrapper::load() const {
+    if (volume_->hasValidRepresentation<VolumeRAM>() ||
+        !volume_->hasValidRepresentation<VolumeDisk>()) {
+        return volume_;
+    }
+    // Load the time step into a volume of our own, which can be released without affecting other
+    // users of the input volume
+    auto volume = std::make_shared<Volume>(
+        std::shared_ptr<VolumeRepresentation>(volume_->getRepresentation<VolumeDisk>()->clone()));
+    volume->setModelMatrix(volume_->getModelMatrix());
+    volume->setWorldMatrix(volume_->getWorldMatrix());
+    return volume;
+}
+
+void VolumeSequenceSampler::Wrapper::prefetch() {
+    if (isResident() || prefetch_.valid()) return;
+    // Without pool threads the time step will be loaded when sampled instead
+    auto app = InviwoApplication::getPtr();
+    if (!app || app->getPoolSize() == 0) return;
+    prefetch_ = app->dispatchPool([this]() { sampler(); });
+}
+
+void VolumeSequenceSampler::Wrapper::release() {
+    if (prefetch_.valid()) {
+        prefetch_.wait();
+        prefetch_ = {};
+    }
+    sampler_.store(nullptr, std::memory_order_release);
+    storage_.reset();
+}
+
 VolumeSequenceSampler::VolumeSequenceSampler(
     std::shared_ptr<const std::vector<std::shared_ptr<Volume>>> volumeSequence, bool allowLooping)
     : Spatial4DSampler<3, double>(volumeSequence->front())
@@ -44,7 +95,9 @@ VolumeSequenceSampler::VolumeSequenceSampler(
         wrappers_.emplace_back(std::make_shared<Wrapper>(vol));
     }
 
-    auto lastWrapper = wrappers_.back();
+    // The input order decides if the sequence loops, see removeDuplicateLastTimeStep()
+    const auto first = wrappers_.front();
+    const auto last = wrappers_.back();
 
     auto infsTime = std::count_if(
         wrappers_.begin(), wrappers_.end(), [&](const std::shared_ptr<Wrapper> &w) -> bool {
@@ -72,21 +125,6 @@ VolumeSequenceSampler::VolumeSequenceSampler(
         return;
     }
 
-    bool firstAndLastAreSame = true;
-    if (volumeSequence->size() >= 2) {
-        auto firstVol = volumeSequence->front();
-        auto lastVol = volumeSequence->back();
-        auto firstVolRam = firstVol->getRepresentation<VolumeRAM>();
-        auto firstData = static_cast<const char *>(firstVolRam->getData());
-        auto lastData =
-            static_cast<const char *>(lastVol->getRepresentation<VolumeRAM>()->getData());
-        auto dataSize1 = firstVolRam->getNumberOfBytes();
-
-        for (size_t i = 0; i < dataSize1 && firstAndLastAreSame; i++) {
-            firstAndLastAreSame &= firstData[i] == lastData[i];
-        }
-    }
-
     auto prev = wrappers_.begin();
     for (auto it = prev + 1; it != wrappers_.end(); ++it) {
         prev->get()->next_ = *it;
@@ -118,10 +156,57 @@ VolumeSequenceSampler::VolumeSequenceSampler(
         }
     }
 
-    if (firstAndLastAreSame && wrappers_.size() > 1) {
-        wrappers_.pop_back();
+    // Volumes of different size or format can not be the same, no need to load them
+    if (wrappers_.size() > 1 &&
+        first->volume_->getDimensions() == last->volume_->getDimensions() &&
+        first->volume_->getDataFormat() == last->volume_->getDataFormat()) {
+        first_ = first;
+        last_ = last;
     }
 
+    updateTimeRange();
+}
+
+VolumeSequenceSampler::VolumeSequenceSampler(const VolumeSequenceSampler &rhs)
+    : Spatial4DSampler<3, double>(rhs)
+    , wrappers_()
+    , allowLooping_(rhs.allowLooping_)
+    , timeRange_(rhs.getTimeRange())
+    , totDuration_(rhs.totDuration_) {
+
+    for (const auto &w : rhs.wrappers_) {
+        auto wrapper = std::make_shared<Wrapper>(w->volume_);
+        wrapper->timestamp_ = w->timestamp_;
+        wrapper->duration_ = w->duration_;
+        wrappers_.push_back(wrapper);
+    }
+    for (size_t i = 0; i + 1 < wrappers_.size(); ++i) {
+        if (!rhs.wrappers_[i]->next_.expired()) wrappers_[i]->next_ = wrappers_[i + 1];
+    }
+}
+
+VolumeSequenceSampler::~VolumeSequenceSampler() {}
+
+void VolumeSequenceSampler::removeDuplicateLastTimeStep() const {
+    std::call_once(duplicateCheck_, [this]() {
+        if (!first_ || !last_) return;
+        // Only loaded for the comparison, time steps loaded from disk are freed again afterwards
+        const auto firstVolume = first_->load();
+        const auto lastVolume = last_->load();
+        const auto firstRam = firstVolume->getRepresentation<VolumeRAM>();
+        const auto lastRam = lastVolume->getRepresentation<VolumeRAM>();
+        if (firstRam->getNumberOfBytes() == lastRam->getNumberOfBytes() &&
+            std::memcmp(firstRam->getData(), lastRam->getData(), firstRam->getNumberOfBytes()) ==
+                0) {
+            wrappers_.pop_back();
+            updateTimeRange();
+        }
+        first_.reset();
+        last_.reset();
+    });
+}
+
+void VolumeSequenceSampler::updateTimeRange() const {
     totDuration_ = 0;
     for (auto &w : wrappers_) {
         totDuration_ += w->duration_;
@@ -131,15 +216,10 @@ VolumeSequenceSampler::VolumeSequenceSampler(
     timeRange_.y = wrappers_.back()->timestamp_ + wrappers_.back()->duration_;
 }
 
-VolumeSequenceSampler::~VolumeSequenceSampler() {}
-
-dvec3 VolumeSequenceSampler::sampleDataSpace(const dvec4 &pos) const {
-    auto spatialPos = dvec3(pos);
-    double t = pos.w;
-
+size_t VolumeSequenceSampler::indexOf(double t) const {
     if (t < timeRange_.x || t > timeRange_.y) {
         if (!allowLooping_) {
-            return dvec3(0);
+            return wrappers_.size();
         }
         while (t < timeRange_.x) {
             t += totDuration_;
@@ -152,14 +232,99 @@ dvec3 VolumeSequenceSampler::sampleDataSpace(const dvec4 &pos) const {
     auto it = std::upper_bound(
         wrappers_.begin(), wrappers_.end(), t,
         [](double t2, const std::shared_ptr<Wrapper> a) { return t2 < a->timestamp_; });
-    --it;
-    auto wrapper = *it;
+    if (it != wrappers_.begin()) --it;
+    return static_cast<size_t>(std::distance(wrappers_.begin(), it));
+}
+
+void VolumeSequenceSampler::setTimeWindow(double t0, double t1, bool forward, size_t prefetch) {
+    removeDuplicateLastTimeStep();
+    const auto size = wrappers_.size();
+    if (size == 0) return;
+    if (t1 < t0) std::swap(t0, t1);
+
+    std::unordered_set<size_t> keep;
+    auto first = indexOf(t0);
+    auto last = indexOf(t1);
+    if (t1 - t0 >= totDuration_) {
+        for (size_t i = 0; i < size; ++i) keep.insert(i);
+    } else if (first < size || last < size) {
+        // Outside of the sequence without looping, clamp to the ends
+        if (first == size) first = t0 < timeRange_.x ? 0 : size - 1;
+        if (last == size) last = t1 < timeRange_.x ? 0 : size - 1;
+        for (auto i = first;; i = (i + 1) % size) {
+            keep.insert(i);
+            if (i == last) break;
+        }
+        // The next time step is needed for interpolation
+        if (!wrappers_[last]->next_.expired()) keep.insert(last + 1);
+    }
+
+    std::unordered_set<size_t> prefetched;
+    if (!keep.empty()) {
+        auto i = forward ? last : first;
+        for (size_t steps = 1; steps < size && prefetched.size() < prefetch; ++steps) {
+            const auto next = forward ? (i + 1) % size : (i + size - 1) % size;
+            if (!allowLooping_ && (forward ? next < i : next > i)) break;
+            i = next;
+            if (keep.count(i) == 0) prefetched.insert(i);
+        }
+    }
+
+    for (size_t i = 0; i < size; ++i) {
+        if (keep.count(i) == 0 && prefetched.count(i) == 0) {
+            wrappers_[i]->release();
+        }
+    }
+    for (auto i : prefetched) wrappers_[i]->prefetch();
+}
+
+void VolumeSequenceSampler::clearTimeWindow() {
+    for (auto &wrapper : wrappers_) wrapper->release();
+}
+
+std::vector<double> VolumeSequenceSampler::getTimestamps() const {
+    removeDuplicateLastTimeStep();
+    std::vector<double> timestamps;
+    for (auto &wrapper : wrappers_) timestamps.push_back(wrapper->timestamp_);
+    return timestamps;
+}
+
+dvec2 VolumeSequenceSampler::getTimeRange() const {
+    removeDuplicateLastTimeStep();
+    return timeRange_;
+}
+
+size_t VolumeSequenceSampler::getResidentCount() const {
+    return static_cast<size_t>(
+        std::count_if(wrappers_.begin(), wrappers_.end(),
+                      [](const auto &wrapper) { return wrapper->isResident(); }));
+}
+
+dvec3 VolumeSequenceSampler::sampleDataSpace(const dvec4 &pos) const {
+    auto spatialPos = dvec3(pos);
+    double t = pos.w;
+
+    removeDuplicateLastTimeStep();
+    const auto index = indexOf(t);
+    if (index == wrappers_.size()) {
+        return dvec3(0);
+    }
+    auto &wrapper = wrappers_[index];
+    if (t < timeRange_.x || t > timeRange_.y) {  // Wrap t to the same loop as the time step
+        while (t < timeRange_.x) {
+            t += totDuration_;
+        }
+        while (t > timeRange_.y) {
+            t -= totDuration_;
+        }
+    }
 
-    auto val0 = dvec3(wrapper->sampler_.sample(spatialPos));
-    if (wrapper->next_.expired()) {
+    auto val0 = dvec3(wrapper->sampler().sample(spatialPos));
+    auto next = wrapper->next_.lock();
+    if (!next) {
         return val0;
     }
-    auto val1 = dvec3(wrapper->next_.lock()->sampler_.sample(spatialPos));
+    auto val1 = dvec3(next->sampler().sample(spatialPos));
 
     double x = (t - wrapper->timestamp_) / wrapper->duration_;
     return Interpolation<dvec3>::linear(val0, val1, x);
@@ -29,6 +29,8 @@
 
 #include <inviwo/core/util/volumeutils.h>
 #include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/volumedisk.h>
+#include <inviwo/core/datastructures/volume/volumeram.h>
 
 namespace inviwo {
 
@@ -98,6 +100,22 @@ double voxelVolume(const Volume &volume) {
     return glm::dot(glm::cross(a, b), c);
 }
 
+std::shared_ptr<VolumeRAM> readVolumeRegion(const Volume &volume, size3_t offset, size3_t dims) {
+    if (glm::any(glm::greaterThan(offset + dims, volume.getDimensions()))) {
+        throw Exception("Region outside of volume", IVW_CONTEXT_CUSTOM("readVolumeRegion"));
+    }
+    if (volume.hasValidRepresentation<VolumeRAM>() ||
+        !volume.hasValidRepresentation<VolumeDisk>()) {
+        return nullptr;
+    }
+
+    const auto disk = volume.getRepresentation<VolumeDisk>();
+    if (auto loader = dynamic_cast<const VolumeRegionLoader *>(disk->getLoader())) {
+        return loader->readRegion(*disk, offset, dims);
+    }
+    return nullptr;
+}
+
 }  // namespace util
 
 }  // namespace inviwo
@@ -998,6 +998,7 @@ bool InviwoMainWindow::openWorkspace() {
         openFileDialog.addSidebarPath(PathType::Workspaces);
         openFileDialog.addSidebarPath(workspaceFileDir_);
         openFileDialog.addExtension("inv", "Inviwo File");
+        openFileDialog.addExtension("invb", "Inviwo Binary File");
         openFileDialog.setFileMode(FileMode::AnyFile);
 
         if (openFileDialog.exec()) {
@@ -1055,7 +1056,7 @@ bool InviwoMainWindow::openWorkspace(QString workspaceFileName, bool isExample)
 
 void InviwoMainWindow::appendWorkspace(const std::string& file) {
     NetworkLock lock(app_->getProcessorNetwork());
-    std::ifstream fs(file);
+    auto fs = filesystem::ifstream(file, std::ios::in | std::ios::binary);
     if (!fs) {
         LogError("Could not open workspace file: " << file);
         return;
@@ -1106,10 +1107,14 @@ void InviwoMainWindow::saveWorkspaceAs() {
     saveFileDialog.addSidebarPath(workspaceFileDir_);
 
     saveFileDialog.addExtension("inv", "Inviwo File");
+    saveFileDialog.addExtension("invb", "Inviwo Binary File");
 
     if (saveFileDialog.exec()) {
         QString path = saveFileDialog.selectedFiles().at(0);
-        if (!path.endsWith(".inv")) path.append(".inv");
+        if (!path.endsWith(".inv") && !path.endsWith(".invb")) {
+            path.append(saveFileDialog.getSelectedFileExtension().extension_ == "invb" ? ".invb"
+                                                                                       : ".inv");
+        }
 
         saveWorkspace(path);
         setCurrentWorkspace(path);
@@ -1128,11 +1133,15 @@ void InviwoMainWindow::saveWorkspaceAsCopy() {
     saveFileDialog.addSidebarPath(workspaceFileDir_);
 
     saveFileDialog.addExtension("inv", "Inviwo File");
+    saveFileDialog.addExtension("invb", "Inviwo Binary File");
 
     if (saveFileDialog.exec()) {
         QString path = saveFileDialog.selectedFiles().at(0);
 
-        if (!path.endsWith(".inv")) path.append(".inv");
+        if (!path.endsWith(".inv") && !path.endsWith(".invb")) {
+            path.append(saveFileDialog.getSelectedFileExtension().extension_ == "invb" ? ".invb"
+                                                                                       : ".inv");
+        }
 
         saveWorkspace(path);
         addToRecentWorkspaces(path);
@@ -1342,7 +1351,7 @@ void InviwoMainWindow::dragMoveEvent(QDragMoveEvent* event) {
         auto filename = urlList.front().toLocalFile();
         auto ext = toLower(filesystem::getFileExtension(utilqt::fromQString(filename)));
 
-        if (ext == "inv" ||
+        if (ext == "inv" || ext == "invb" ||
             !app_->getDataVisualizerManager()->getDataVisualizersForExtension(ext).empty()) {
 
             if (event->keyboardModifiers() & Qt::ControlModifier) {
@@ -1373,7 +1382,9 @@ void InviwoMainWindow::dropEvent(QDropEvent* event) {
             for (auto& file : urlList) {
                 auto filename = file.toLocalFile();
 
-                if (toLower(filesystem::getFileExtension(utilqt::fromQString(filename))) == "inv") {
+                const auto ext =
+                    toLower(filesystem::getFileExtension(utilqt::fromQString(filename)));
+                if (ext == "inv" || ext == "invb") {
                     if (!first || keyModifiers & Qt::ControlModifier) {
                         appendWorkspace(utilqt::fromQString(filename));
                     } else {
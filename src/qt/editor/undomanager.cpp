@@ -29,9 +29,14 @@
 
 #include <inviwo/core/common/inviwoapplication.h>
 #include <inviwo/core/network/processornetwork.h>
+#include <inviwo/core/metadata/processormetadata.h>
+#include <inviwo/core/processors/processor.h>
+#include <inviwo/core/processors/processorobserver.h>
+#include <inviwo/core/properties/propertyownerobserver.h>
 #include <inviwo/qt/editor/inviwomainwindow.h>
 #include <inviwo/qt/editor/undomanager.h>
 #include <inviwo/core/util/raiiutils.h>
+#include <inviwo/core/util/stdextensions.h>
 #include <inviwo/core/util/filesystem.h>
 #include <inviwo/qt/applicationbase/inviwoapplicationqt.h>
 
@@ -43,6 +48,7 @@
 #include <QGuiApplication>
 #include <warn/pop>
 
+#include <functional>
 #include <thread>
 #include <mutex>
 #include <condition_variable>
@@ -120,6 +126,50 @@ private:
     std::thread saver_;
 };
 
+/**
+ * Marks a processor as changed when any of its properties, ports, identifier, or its processor
+ * meta data change, so that only changed processors have to be serialized when pushing a new
+ * state. Renames are reported to the UndoManager so that they can be undone in place.
+ */
+class UndoManager::ProcessorTracker : public ProcessorObserver,
+                                      public ProcessorMetaDataObserver,
+                                      public PropertyOwnerObserver {
+public:
+    ProcessorTracker(UndoManager &manager, Processor *processor)
+        : manager_{manager}, processor_{processor} {
+        processor->ProcessorObservable::addObserver(this);
+        processor->PropertyOwnerObservable::addObserver(this);
+        processor->getMetaData<ProcessorMetaData>(ProcessorMetaData::CLASS_IDENTIFIER)
+            ->addObserver(this);
+    }
+
+    virtual void onAboutPropertyChange(Property *) override { changed(); }
+    virtual void onProcessorIdentifierChanged(Processor *processor,
+                                              const std::string &old) override {
+        manager_.renamed(old, processor->getIdentifier());
+        changed();
+    }
+    virtual void onProcessorDisplayNameChanged(Processor *, const std::string &) override {
+        changed();
+    }
+    virtual void onProcessorPortAdded(Processor *, Port *) override { changed(); }
+    virtual void onProcessorPortRemoved(Processor *, Port *) override { changed(); }
+    virtual void onDidAddProperty(Property *, size_t) override { changed(); }
+    virtual void onDidRemoveProperty(Property *, size_t) override { changed(); }
+    virtual void onProcessorMetaDataPositionChange() override { changed(); }
+    virtual void onProcessorMetaDataVisibilityChange() override { changed(); }
+    virtual void onProcessorMetaDataSelectionChange() override { changed(); }
+
+private:
+    void changed() {
+        manager_.dirtyProcessors_.insert(processor_);
+        manager_.dirty_ = true;
+    }
+
+    UndoManager &manager_;
+    Processor *processor_;
+};
+
 UndoManager::UndoManager(InviwoMainWindow *mainWindow)
     : mainWindow_(mainWindow)
     , manager_{mainWindow_->getInviwoApplication()->getWorkspaceManager()}
@@ -127,7 +177,9 @@ UndoManager::UndoManager(InviwoMainWindow *mainWindow)
     , autoSaver_{std::make_unique<AutoSaver>()} {
 
     mainWindow_->getInviwoApplicationQt()->setUndoTrigger([this]() { pushStateIfDirty(); });
-    mainWindow_->getInviwoApplication()->getProcessorNetwork()->addObserver(this);
+    auto network = mainWindow_->getInviwoApplication()->getProcessorNetwork();
+    network->addObserver(this);
+    for (auto processor : network->getProcessors()) track(processor);
 
     undoAction_ = new QAction(QIcon(":/svgicons/undo.svg"), QAction::tr("&Undo"), mainWindow_);
     undoAction_->setShortcut(QKeySequence::Undo);
@@ -156,63 +208,154 @@ UndoManager::~UndoManager() = default;
 void UndoManager::pushStateIfDirty() {
     if (dirty_) pushState();
 }
-void UndoManager::markDirty() { dirty_ = true; }
+void UndoManager::markDirty() {
+    dirty_ = true;
+    refreshAll_ = true;
+}
 
 void UndoManager::pushState() {
     if (isRestoring) return;
 
-    std::stringstream stream;
+    auto network = mainWindow_->getInviwoApplication()->getProcessorNetwork();
+    const bool refreshAll = refreshAll_ || ++sinceRefresh_ >= checkpointInterval_;
+    if (refreshAll) sinceRefresh_ = 0;
+    NetworkSnapshot snapshot;
+    std::shared_ptr<const std::string> workspaceState;
     try {
-        manager_->save(stream, refPath_, [](ExceptionContext context) -> void { throw; },
-                       WorkspaceSaveMode::Undo);
+        if (reset_) {
+            snapshot = NetworkSnapshot(*network, refPath_);
+        } else {
+            snapshot = NetworkSnapshot(*network, refPath_, snapshot_, [&](const Processor &p) {
+                return refreshAll || dirtyProcessors_.count(&p) != 0;
+            });
+        }
+        workspaceState = serializeWorkspaceState();
     } catch (...) {
         return;
     }
-    auto str = std::make_shared<const std::string>(std::move(stream).str());
-
     dirty_ = false;
-    if (head_ >= 0 && *str == *undoBuffer_[head_]) return;  // No Change
+    refreshAll_ = false;
+    dirtyProcessors_.clear();
+    auto renames = std::move(renames_);
+    renames_.clear();
+
+    if (reset_) {
+        reset_ = false;
+        snapshot_ = std::move(snapshot);
+        workspaceState_ = std::move(workspaceState);
+        saveCheckpoint();
+        updateActions();
+        return;
+    }
 
+    Step step{NetworkDelta(snapshot_, snapshot, renames), nullptr, nullptr};
+    snapshot_ = std::move(snapshot);
+    if (*workspaceState != *workspaceState_) {
+        step.before = std::move(workspaceState_);
+        step.after = workspaceState;
+    }
+    workspaceState_ = std::move(workspaceState);
+    if (step.network.empty() && !step.after) return;  // No Change
+
+    undoBuffer_.erase(undoBuffer_.begin() + head_, undoBuffer_.end());
+    undoBuffer_.push_back(std::move(step));
     ++head_;
-    auto offset = std::min(std::distance(undoBuffer_.begin(), undoBuffer_.end()), head_);
-    undoBuffer_.erase(undoBuffer_.begin() + offset, undoBuffer_.end());
-    undoBuffer_.push_back(str);
 
-    autoSaver_->save(str);
+    if (++sinceCheckpoint_ >= checkpointInterval_) saveCheckpoint();
 
     updateActions();
 }
+
 void UndoManager::undoState() {
     if (head_ > 0) {
         util::KeepTrueWhileInScope restore(&isRestoring);
         --head_;
 
-        std::stringstream stream;
-        stream << *undoBuffer_[head_];
-        manager_->load(stream, refPath_);
+        auto network = mainWindow_->getInviwoApplication()->getProcessorNetwork();
+        const auto &step = undoBuffer_[head_];
+        step.network.undo(*network, snapshot_, refPath_);
+        if (step.before) {
+            loadWorkspaceState(*step.before);
+            workspaceState_ = step.before;
+        }
 
+        dirtyProcessors_.clear();
+        renames_.clear();
         dirty_ = false;
         updateActions();
     }
 }
-void UndoManager::redoState() {
-    if (head_ >= -1 && head_ < static_cast<DiffType>(undoBuffer_.size()) - 1) {
 
+void UndoManager::redoState() {
+    if (head_ < undoBuffer_.size()) {
         util::KeepTrueWhileInScope restore(&isRestoring);
-        ++head_;
 
-        std::stringstream stream;
-        stream << *undoBuffer_[head_];
-        manager_->load(stream, refPath_);
+        auto network = mainWindow_->getInviwoApplication()->getProcessorNetwork();
+        const auto &step = undoBuffer_[head_];
+        step.network.redo(*network, snapshot_, refPath_);
+        if (step.after) {
+            loadWorkspaceState(*step.after);
+            workspaceState_ = step.after;
+        }
+        ++head_;
 
+        dirtyProcessors_.clear();
+        renames_.clear();
         dirty_ = false;
         updateActions();
     }
 }
 
 void UndoManager::clear() {
-    head_ = -1;
+    head_ = 0;
     undoBuffer_.clear();
+    snapshot_ = NetworkSnapshot{};
+    workspaceState_.reset();
+    dirtyProcessors_.clear();
+    renames_.clear();
+    reset_ = true;
+}
+
+void UndoManager::saveCheckpoint() {
+    sinceCheckpoint_ = 0;
+
+    std::stringstream stream;
+    try {
+        manager_->save(stream, refPath_, [](ExceptionContext context) -> void { throw; },
+                       WorkspaceSaveMode::Undo);
+    } catch (...) {
+        return;
+    }
+    autoSaver_->save(std::make_shared<const std::string>(std::move(stream).str()));
+}
+
+void UndoManager::track(Processor *processor) {
+    trackers_[processor] = std::make_unique<ProcessorTracker>(*this, processor);
+}
+
+void UndoManager::renamed(const std::string &from, const std::string &to) {
+    if (isRestoring) return;
+    // Combine consecutive renames of the same processor into one
+    auto it = util::find_if(renames_, [&](const auto &rename) { return rename.second == from; });
+    if (it == renames_.end()) {
+        renames_.emplace_back(from, to);
+    } else if (it->first == to) {
+        renames_.erase(it);
+    } else {
+        it->second = to;
+    }
+}
+
+std::shared_ptr<const std::string> UndoManager::serializeWorkspaceState() const {
+    std::stringstream stream;
+    manager_->save(stream, refPath_, [](ExceptionContext context) -> void { throw; },
+                   WorkspaceSaveMode::UndoWithoutNetwork);
+    return std::make_shared<const std::string>(std::move(stream).str());
+}
+
+void UndoManager::loadWorkspaceState(const std::string &state) {
+    std::stringstream stream{state};
+    manager_->load(stream, refPath_);
 }
 
 QAction *UndoManager::getUndoAction() const { return undoAction_; }
@@ -238,11 +381,18 @@ void UndoManager::restore() {
 
 void UndoManager::updateActions() {
     undoAction_->setEnabled(head_ > 0);
-    redoAction_->setEnabled(head_ >= -1 && head_ < static_cast<DiffType>(undoBuffer_.size()) - 1);
+    redoAction_->setEnabled(head_ < undoBuffer_.size());
 }
 
 void UndoManager::onProcessorNetworkChange() { dirty_ = true; }
-void UndoManager::onProcessorNetworkDidAddProcessor(Processor *) { dirty_ = true; }
+void UndoManager::onProcessorNetworkDidAddProcessor(Processor *processor) {
+    track(processor);
+    dirty_ = true;
+}
+void UndoManager::onProcessorNetworkWillRemoveProcessor(Processor *processor) {
+    trackers_.erase(processor);
+    dirtyProcessors_.erase(processor);
+}
 void UndoManager::onProcessorNetworkDidRemoveProcessor(Processor *) { dirty_ = true; }
 void UndoManager::onProcessorNetworkDidAddConnection(const PortConnection &) { dirty_ = true; }
 void UndoManager::onProcessorNetworkDidRemoveConnection(const PortConnection &) { dirty_ = true; }
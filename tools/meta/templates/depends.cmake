@@ -14,6 +14,12 @@ set(dependencies
 # when using runtime module reloading. 
 #set(protected ON)
 
+# Construct the module on the thread pool, concurrently with other modules,
+# as soon as the modules it depends on are registered. Only for modules
+# whose constructor does nothing but call the InviwoModule register
+# functions: no logging, and no access to other modules or the application.
+#set(concurrent ON)
+
 # By calling set(EnableByDefault ON) the module will be set to enabled 
 # when initially being added to CMake. Default OFF.
 #set(EnableByDefault OFF)
\ No newline at end of file